@@ -1603,6 +1603,14 @@ SOURCE=.\src\sat\bsat\satClause.h
 # End Source File
 # Begin Source File
 
+SOURCE=.\src\sat\bsat\satElim.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\sat\bsat\satElim.h
+# End Source File
+# Begin Source File
+
 SOURCE=.\src\sat\bsat\satInter.c
 # End Source File
 # Begin Source File
@@ -1627,6 +1635,10 @@ SOURCE=.\src\sat\bsat\satMem.h
 # End Source File
 # Begin Source File
 
+SOURCE=.\src\sat\bsat\satPort.c
+# End Source File
+# Begin Source File
+
 SOURCE=.\src\sat\bsat\satProof.c
 # End Source File
 # Begin Source File
@@ -3363,6 +3375,14 @@ SOURCE=.\src\misc\util\utilNam.h
 # End Source File
 # Begin Source File
 
+SOURCE=.\src\misc\util\utilPool.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\misc\util\utilPool.h
+# End Source File
+# Begin Source File
+
 SOURCE=.\src\misc\util\utilSignal.c
 # End Source File
 # Begin Source File
@@ -3375,6 +3395,14 @@ SOURCE=.\src\misc\util\utilSort.c
 # End Source File
 # Begin Source File
 
+SOURCE=.\src\misc\util\utilStream.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\misc\util\utilStream.h
+# End Source File
+# Begin Source File
+
 SOURCE=.\src\misc\util\utilTruth.h
 # End Source File
 # End Group
@@ -107,8 +107,8 @@ struct Gia_Man_t_
     int            nBufs;         // the number of buffers
     Vec_Int_t *    vCis;          // the vector of CIs (PIs + LOs)
     Vec_Int_t *    vCos;          // the vector of COs (POs + LIs)
-    int *          pHTable;       // hash table
-    int            nHTable;       // hash table size 
+    int *          pHTable;       // hash table (two ints per entry, see giaHash.c)
+    int            nHTable;       // hash table size (the number of entries)
     int            fAddStrash;    // performs additional structural hashing
     int            fSweeper;      // sweeper is running
     int *          pRefs;         // the reference count
@@ -250,9 +250,13 @@ struct Gia_ParSim_t_
     int            RandSeed;      // seed to generate random numbers
     int            TimeLimit;     // time limit in seconds
     int            fCheckMiter;   // check if miter outputs are non-zero
+    int            nThreads;      // the number of simulation threads
     int            fVerbose;      // enables verbose output
     int            iOutFail;      // index of the failed output
 };
+
+// simulates words w0 <= w < w1 of the simulation manager
+typedef void (*Gia_ManSimRange_f)( void * pMan, int w0, int w1 );
 
 typedef struct Gia_ManSim_t_ Gia_ManSim_t;
 struct Gia_ManSim_t_
@@ -1069,7 +1073,10 @@ static inline int         Gia_ObjCellId( Gia_Man_t * p, int iLit )          { re
 
 /*=== giaAiger.c ===========================================================*/
 extern int                 Gia_FileSize( char * pFileName );
-extern Gia_Man_t *         Gia_AigerReadFromMemory( char * pContents, int nFileSize, int fSkipStrash, int fCheck );
+extern char *              Gia_FileMap( char * pFileName, size_t * pnFileSize );
+extern void                Gia_FileUnmap( char * pContents, size_t nFileSize );
+extern char *              Gia_FileReadGz( char * pFileName, int * pnFileSize );
+extern Gia_Man_t *         Gia_AigerReadFromMemory( char * pContents, size_t nFileSize, int fSkipStrash, int fCheck );
 extern Gia_Man_t *         Gia_AigerRead( char * pFileName, int fSkipStrash, int fCheck );
 extern void                Gia_AigerWrite( Gia_Man_t * p, char * pFileName, int fWriteSymbols, int fCompact );
 extern void                Gia_DumpAiger( Gia_Man_t * p, char * pFilePrefix, int iFileNum, int nFileNumDigits );
@@ -1341,7 +1348,9 @@ extern unsigned *          Gia_SimDataCiExt( Gia_ManSim_t * p, int i );
 extern unsigned *          Gia_SimDataCoExt( Gia_ManSim_t * p, int i );
 extern void                Gia_ManSimInfoInit( Gia_ManSim_t * p );
 extern void                Gia_ManSimInfoTransfer( Gia_ManSim_t * p );
-extern void                Gia_ManSimulateRound( Gia_ManSim_t * p );
+extern void                Gia_ManSimulateRound( Gia_ManSim_t * p );
+extern const char *        Gia_ManSimSelectKernel();
+extern void                Gia_ManSimRunRanges( Gia_ManSimRange_f pFunc, void * pMan, int nWords, int nThreads, int nAlign );
 /*=== giaSpeedup.c ============================================================*/
 extern float               Gia_ManDelayTraceLut( Gia_Man_t * p );
 extern float               Gia_ManDelayTraceLutPrint( Gia_Man_t * p, int fVerbose );
@@ -22,6 +22,15 @@
 #include "gia.h"
 #include "misc/tim/tim.h"
 #include "base/main/main.h"
+#include "misc/util/utilStream.h"
+#include "misc/zlib/zlib.h"
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 ABC_NAMESPACE_IMPL_START
 
@@ -83,6 +92,102 @@ void Gia_FileWriteBufferSize( FILE * pFile, int nSize )
     fwrite( Buffer, 1, 4, pFile );
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Maps the file into memory.]
+
+  Description [Returns NULL if mapping is not available, in which case
+  the caller reads the file into a buffer. The mapping is private and
+  writable because the reader may overwrite the symbol table in place;
+  the pages are copied only if this happens.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+char * Gia_FileMap( char * pFileName, size_t * pnFileSize )
+{
+#if !defined(_WIN32)
+    struct stat Stat;
+    void * pMap;
+    int fd = open( pFileName, O_RDONLY );
+    *pnFileSize = 0;
+    if ( fd < 0 )
+        return NULL;
+    if ( fstat( fd, &Stat ) != 0 || Stat.st_size == 0 || (off_t)(size_t)Stat.st_size != Stat.st_size )
+    {
+        close( fd );
+        return NULL;
+    }
+    pMap = mmap( NULL, (size_t)Stat.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0 );
+    close( fd );
+    if ( pMap == MAP_FAILED )
+        return NULL;
+#ifdef MADV_SEQUENTIAL
+    madvise( pMap, (size_t)Stat.st_size, MADV_SEQUENTIAL );
+#endif
+    *pnFileSize = (size_t)Stat.st_size;
+    return (char *)pMap;
+#else
+    *pnFileSize = 0;
+    return NULL;
+#endif
+}
+void Gia_FileUnmap( char * pContents, size_t nFileSize )
+{
+#if !defined(_WIN32)
+    munmap( pContents, nFileSize );
+#endif
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Reads the gzip-compressed file into memory.]
+
+  Description [Returns NULL if the uncompressed file is larger than 2 GB,
+  because the AIGER parser takes the size as an int.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+char * Gia_FileReadGz( char * pFileName, int * pnFileSize )
+{
+    size_t nBlockSize = (1 << 20), nFileSize = 0;
+    int nRead;
+    char * pContents;
+    gzFile pFile = gzopen( pFileName, "rb" );
+    *pnFileSize = 0;
+    if ( pFile == NULL )
+        return NULL;
+    pContents = ABC_ALLOC( char, nBlockSize );
+    while ( (nRead = gzread( pFile, pContents + nFileSize, (unsigned)(nBlockSize - nFileSize) )) > 0 )
+    {
+        nFileSize += nRead;
+        if ( nFileSize > 0x7FFFFFFF )
+        {
+            printf( "Gia_FileReadGz(): The uncompressed file \"%s\" is larger than 2 GB.\n", pFileName );
+            gzclose( pFile );
+            ABC_FREE( pContents );
+            return NULL;
+        }
+        if ( nFileSize < nBlockSize )
+            continue;
+        nBlockSize *= 2;
+        pContents = ABC_REALLOC( char, pContents, nBlockSize );
+    }
+    gzclose( pFile );
+    if ( nRead < 0 || nFileSize == 0 )
+    {
+        ABC_FREE( pContents );
+        return NULL;
+    }
+    *pnFileSize = (int)nFileSize;
+    return pContents;
+}
+
 /**Function*************************************************************
 
   Synopsis    [Create the array of literals to be written.]
@@ -162,6 +267,25 @@ Vec_Str_t * Gia_AigerWriteLiterals( Vec_Int_t * vLits )
     return vBinary;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Returns the size-prefixed section as a string.]
+
+  Description [The string points into the input buffer, so the section
+  is decoded in place instead of being copied out of the file image.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline Vec_Str_t * Gia_AigerReadSection( Vec_Str_t * vStr, unsigned char ** ppPos )
+{
+    vStr->nCap   = vStr->nSize = Gia_AigerReadInt( *ppPos );  *ppPos += 4;
+    vStr->pArray = (char *)*ppPos;                           *ppPos += vStr->nSize;
+    return vStr;
+}
+
 /**Function*************************************************************
 
   Synopsis    [Reads the AIG in the binary AIGER format.]
@@ -173,7 +297,7 @@ Vec_Str_t * Gia_AigerWriteLiterals( Vec_Int_t * vLits )
   SeeAlso     []
 
 ***********************************************************************/
-Gia_Man_t * Gia_AigerReadFromMemory( char * pContents, int nFileSize, int fSkipStrash, int fCheck )
+Gia_Man_t * Gia_AigerReadFromMemory( char * pContents, size_t nFileSize, int fSkipStrash, int fCheck )
 {
     Gia_Man_t * pNew, * pTemp;
     Vec_Int_t * vLits = NULL, * vPoTypes = NULL;
@@ -511,7 +635,7 @@ Gia_Man_t * Gia_AigerReadFromMemory( char * pContents, int nFileSize, int fSkipS
     if ( pCur + 1 < (unsigned char *)pContents + nFileSize && *pCur == 'c' )
     {
         int fVerbose = XAIG_VERBOSE;
-        Vec_Str_t * vStr;
+        Vec_Str_t Str, * vStr;
         unsigned char * pCurTemp;
         pCur++;
         // skip new line if present
@@ -523,11 +647,8 @@ Gia_Man_t * Gia_AigerReadFromMemory( char * pContents, int nFileSize, int fSkipS
             if ( *pCur == 'a' )
             {
                 pCur++;
-                vStr = Vec_StrStart( Gia_AigerReadInt(pCur) );             pCur += 4;
-                memcpy( Vec_StrArray(vStr), pCur, Vec_StrSize(vStr) );
-                pCur += Vec_StrSize(vStr);
+                vStr = Gia_AigerReadSection( &Str, &pCur );
                 pNew->pAigExtra = Gia_AigerReadFromMemory( Vec_StrArray(vStr), Vec_StrSize(vStr), 0, 0 );
-                Vec_StrFree( vStr );
                 if ( fVerbose ) printf( "Finished reading extension \"a\".\n" );
             }
             // read number of constraints
@@ -595,11 +716,8 @@ Gia_Man_t * Gia_AigerReadFromMemory( char * pContents, int nFileSize, int fSkipS
             else if ( *pCur == 'h' )
             {
                 pCur++;
-                vStr = Vec_StrStart( Gia_AigerReadInt(pCur) );          pCur += 4;
-                memcpy( Vec_StrArray(vStr), pCur, Vec_StrSize(vStr) );
-                pCur += Vec_StrSize(vStr);
+                vStr = Gia_AigerReadSection( &Str, &pCur );
                 pNew->pManTime = Tim_ManLoad( vStr, 1 );
-                Vec_StrFree( vStr );
                 fHieOnly = 1;
                 if ( fVerbose ) printf( "Finished reading extension \"h\".\n" );
             }
@@ -735,10 +853,8 @@ Gia_Man_t * Gia_AigerReadFromMemory( char * pContents, int nFileSize, int fSkipS
             else if ( *pCur == 't' )
             {
                 pCur++;
-                vStr = Vec_StrStart( Gia_AigerReadInt(pCur) );          pCur += 4;
-                memcpy( Vec_StrArray(vStr), pCur, Vec_StrSize(vStr) );  pCur += Vec_StrSize(vStr);
+                vStr = Gia_AigerReadSection( &Str, &pCur );
                 pNew->pManTime = Tim_ManLoad( vStr, 0 );
-                Vec_StrFree( vStr );
                 if ( fVerbose ) printf( "Finished reading extension \"t\".\n" );
             }
             // read object classes
@@ -856,19 +972,40 @@ Gia_Man_t * Gia_AigerRead( char * pFileName, int fSkipStrash, int fCheck )
     FILE * pFile;
     Gia_Man_t * pNew;
     char * pName, * pContents;
-    int nFileSize;
+    size_t nMapSize;
+    int nFileSize, nLength;
     int RetValue;
 
-    // read the file into the buffer
     Gia_FileFixName( pFileName );
-    nFileSize = Gia_FileSize( pFileName );
-    pFile = fopen( pFileName, "rb" );
-    pContents = ABC_ALLOC( char, nFileSize );
-    RetValue = fread( pContents, nFileSize, 1, pFile );
-    fclose( pFile );
-
-    pNew = Gia_AigerReadFromMemory( pContents, nFileSize, fSkipStrash, fCheck );
-    ABC_FREE( pContents );
+    nLength = strlen( pFileName );
+    if ( nLength > 3 && !strcmp( pFileName + nLength - 3, ".gz" ) )
+    {
+        // decompress the file into the buffer
+        pContents = Gia_FileReadGz( pFileName, &nFileSize );
+        if ( pContents == NULL )
+            return NULL;
+        pNew = Gia_AigerReadFromMemory( pContents, nFileSize, fSkipStrash, fCheck );
+        ABC_FREE( pContents );
+    }
+    // decode the file directly from the mapping when possible
+    else if ( (pContents = Gia_FileMap( pFileName, &nMapSize )) )
+    {
+        pNew = Gia_AigerReadFromMemory( pContents, nMapSize, fSkipStrash, fCheck );
+        Gia_FileUnmap( pContents, nMapSize );
+    }
+    else
+    {
+        // read the file into the buffer
+        nFileSize = Gia_FileSize( pFileName );
+        pFile = fopen( pFileName, "rb" );
+        if ( pFile == NULL )
+            return NULL;
+        pContents = ABC_ALLOC( char, nFileSize );
+        RetValue = fread( pContents, nFileSize, 1, pFile );
+        fclose( pFile );
+        pNew = Gia_AigerReadFromMemory( pContents, nFileSize, fSkipStrash, fCheck );
+        ABC_FREE( pContents );
+    }
     if ( pNew )
     {
         ABC_FREE( pNew->pName );
@@ -1043,6 +1180,37 @@ Vec_Str_t * Gia_AigerWriteIntoMemoryStrPart( Gia_Man_t * p, Vec_Int_t * vCis, Ve
     return vBuffer;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Stream writing primitives.]
+
+  Description [Gia_AigerPutUnsigned() assumes that the caller has
+  reserved room for the encoded number in the stream buffer.]
+  
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline void Gia_AigerPutUnsigned( Abc_Ostr_t * pFile, unsigned x )
+{
+    pFile->nUsed = Gia_AigerWriteUnsignedBuffer( (unsigned char *)pFile->pBuffer, pFile->nUsed, x );
+}
+static inline void Gia_AigerPutInt( Abc_Ostr_t * pFile, int Value )
+{
+    Abc_OstrReserve( pFile, 4 );
+    Gia_AigerWriteInt( (unsigned char *)pFile->pBuffer + pFile->nUsed, Value );
+    pFile->nUsed += 4;
+}
+static inline void Gia_AigerPutSymbol( Abc_Ostr_t * pFile, char Type, int i, char * pName )
+{
+    Abc_OstrPutC( pFile, Type );
+    Abc_OstrPutNum( pFile, i );
+    Abc_OstrPutC( pFile, ' ' );
+    Abc_OstrPutS( pFile, pName );
+    Abc_OstrPutC( pFile, '\n' );
+}
+
 /**Function*************************************************************
 
   Synopsis    [Writes the AIG in the binary AIGER format.]
@@ -1056,14 +1224,13 @@ Vec_Str_t * Gia_AigerWriteIntoMemoryStrPart( Gia_Man_t * p, Vec_Int_t * vCis, Ve
 ***********************************************************************/
 void Gia_AigerWrite( Gia_Man_t * pInit, char * pFileName, int fWriteSymbols, int fCompact )
 {
-    int fVerbose = XAIG_VERBOSE;
-    FILE * pFile;
+    int fVerbose = XAIG_VERBOSE;
+    Abc_Ostr_t * pFile;
     Gia_Man_t * p;
-    Gia_Obj_t * pObj;
+    Gia_Obj_t * pObj;
     Vec_Str_t * vStrExt;
-    int i, nBufferSize, Pos;
-    unsigned char * pBuffer;
-    unsigned uLit0, uLit1, uLit;
+    int i;
+    unsigned uLit0, uLit1, uLit;
     assert( pInit->nXors == 0 && pInit->nMuxes == 0 );
 
     if ( Gia_ManCoNum(pInit) == 0 )
@@ -1072,8 +1239,8 @@ void Gia_AigerWrite( Gia_Man_t * pInit, char * pFileName, int fWriteSymbols, int
         return;
     }
 
-    // start the output stream
-    pFile = fopen( pFileName, "wb" );
+    // start the output stream (compressed if the file name ends in ".gz")
+    pFile = Abc_OstrStart( pFileName, 0 );
     if ( pFile == NULL )
     {
         fprintf( stdout, "Gia_AigerWrite(): Cannot open the output file \"%s\".\n", pFileName );
@@ -1096,7 +1263,7 @@ void Gia_AigerWrite( Gia_Man_t * pInit, char * pFileName, int fWriteSymbols, int
         p = pInit;
 
     // write the header "M I L O A" where M = I + L + A
-    fprintf( pFile, "aig%s %u %u %u %u %u", 
+    Abc_OstrPrintf( pFile, "aig%s %u %u %u %u %u", 
         fCompact? "2" : "",
         Gia_ManCiNum(p) + Gia_ManAndNum(p), 
         Gia_ManPiNum(p),
@@ -1105,55 +1272,40 @@ void Gia_AigerWrite( Gia_Man_t * pInit, char * pFileName, int fWriteSymbols, int
         Gia_ManAndNum(p) );
     // write the extended header "B C J F"
     if ( Gia_ManConstrNum(p) )
-        fprintf( pFile, " %u %u", Gia_ManPoNum(p) - Gia_ManConstrNum(p), Gia_ManConstrNum(p) );
-    fprintf( pFile, "\n" ); 
+        Abc_OstrPrintf( pFile, " %u %u", Gia_ManPoNum(p) - Gia_ManConstrNum(p), Gia_ManConstrNum(p) );
+    Abc_OstrPrintf( pFile, "\n" ); 
 
     Gia_ManInvertConstraints( p );
     if ( !fCompact ) 
     {
         // write latch drivers
         Gia_ManForEachRi( p, pObj, i )
-            fprintf( pFile, "%u\n", Gia_ObjFaninLit0p(p, pObj) );
+            Abc_OstrPutNum( pFile, Gia_ObjFaninLit0p(p, pObj) ), Abc_OstrPutC( pFile, '\n' );
         // write PO drivers
         Gia_ManForEachPo( p, pObj, i )
-            fprintf( pFile, "%u\n", Gia_ObjFaninLit0p(p, pObj) );
+            Abc_OstrPutNum( pFile, Gia_ObjFaninLit0p(p, pObj) ), Abc_OstrPutC( pFile, '\n' );
     }
     else
     {
         Vec_Int_t * vLits = Gia_AigerCollectLiterals( p );
         Vec_Str_t * vBinary = Gia_AigerWriteLiterals( vLits );
-        fwrite( Vec_StrArray(vBinary), 1, Vec_StrSize(vBinary), pFile );
+        Abc_OstrPutBuf( pFile, Vec_StrArray(vBinary), Vec_StrSize(vBinary) );
         Vec_StrFree( vBinary );
         Vec_IntFree( vLits );
     }
     Gia_ManInvertConstraints( p );
 
-    // write the nodes into the buffer
-    Pos = 0;
-    nBufferSize = 8 * Gia_ManAndNum(p) + 100; // skeptically assuming 3 chars per one AIG edge
-    pBuffer = ABC_ALLOC( unsigned char, nBufferSize );
+    // write the nodes directly into the stream buffer
     Gia_ManForEachAnd( p, pObj, i )
     {
         uLit  = Abc_Var2Lit( i, 0 );
         uLit0 = Gia_ObjFaninLit0( pObj, i );
         uLit1 = Gia_ObjFaninLit1( pObj, i );
         assert( Gia_ManBufNum(p) || uLit0 < uLit1 );
-        Pos = Gia_AigerWriteUnsignedBuffer( pBuffer, Pos, uLit  - uLit1 );
-        Pos = Gia_AigerWriteUnsignedBuffer( pBuffer, Pos, uLit1 - uLit0 );
-        if ( Pos > nBufferSize - 10 )
-        {
-            printf( "Gia_AigerWrite(): AIGER generation has failed because the allocated buffer is too small.\n" );
-	        fclose( pFile );
-            if ( p != pInit )
-                Gia_ManStop( p );
-            return;
-        }
+        Abc_OstrReserve( pFile, 10 );
+        Gia_AigerPutUnsigned( pFile, uLit  - uLit1 );
+        Gia_AigerPutUnsigned( pFile, uLit1 - uLit0 );
     }
-    assert( Pos < nBufferSize );
-
-    // write the buffer
-    fwrite( pBuffer, 1, Pos, pFile );
-    ABC_FREE( pBuffer );
 
     // write the symbol table
     if ( p->vNamesIn && p->vNamesOut )
@@ -1162,42 +1314,42 @@ void Gia_AigerWrite( Gia_Man_t * pInit, char * pFileName, int fWriteSymbols, int
         assert( Vec_PtrSize(p->vNamesOut) == Gia_ManCoNum(p) );
         // write PIs
         Gia_ManForEachPi( p, pObj, i )
-            fprintf( pFile, "i%d %s\n", i, (char *)Vec_PtrEntry(p->vNamesIn, i) );
+            Gia_AigerPutSymbol( pFile, 'i', i, (char *)Vec_PtrEntry(p->vNamesIn, i) );
         // write latches
         Gia_ManForEachRo( p, pObj, i )
-            fprintf( pFile, "l%d %s\n", i, (char *)Vec_PtrEntry(p->vNamesIn, Gia_ManPiNum(p) + i) );
+            Gia_AigerPutSymbol( pFile, 'l', i, (char *)Vec_PtrEntry(p->vNamesIn, Gia_ManPiNum(p) + i) );
         // write POs
         Gia_ManForEachPo( p, pObj, i )
-            fprintf( pFile, "o%d %s\n", i, (char *)Vec_PtrEntry(p->vNamesOut, i) );
+            Gia_AigerPutSymbol( pFile, 'o', i, (char *)Vec_PtrEntry(p->vNamesOut, i) );
     }
 
     // write the comment
 //    fprintf( pFile, "c\n" );
-    fprintf( pFile, "c" );
+    Abc_OstrPutC( pFile, 'c' );
 
     // write additional AIG
     if ( p->pAigExtra )
     {
-        fprintf( pFile, "a" );
+        Abc_OstrPutC( pFile, 'a' );
         vStrExt = Gia_AigerWriteIntoMemoryStr( p->pAigExtra );
-        Gia_FileWriteBufferSize( pFile, Vec_StrSize(vStrExt) );
-        fwrite( Vec_StrArray(vStrExt), 1, Vec_StrSize(vStrExt), pFile );
+        Gia_AigerPutInt( pFile, Vec_StrSize(vStrExt) );
+        Abc_OstrPutBuf( pFile, Vec_StrArray(vStrExt), Vec_StrSize(vStrExt) );
         Vec_StrFree( vStrExt );
         if ( fVerbose ) printf( "Finished writing extension \"a\".\n" );
     }
     // write constraints
     if ( p->nConstrs )
     {
-        fprintf( pFile, "c" );
-        Gia_FileWriteBufferSize( pFile, 4 );
-        Gia_FileWriteBufferSize( pFile, p->nConstrs );
+        Abc_OstrPutC( pFile, 'c' );
+        Gia_AigerPutInt( pFile, 4 );
+        Gia_AigerPutInt( pFile, p->nConstrs );
     }
     // write timing information
     if ( p->nAnd2Delay )
     {
-        fprintf( pFile, "d" );
-        Gia_FileWriteBufferSize( pFile, 4 );
-        Gia_FileWriteBufferSize( pFile, p->nAnd2Delay );
+        Abc_OstrPutC( pFile, 'd' );
+        Gia_AigerPutInt( pFile, 4 );
+        Gia_AigerPutInt( pFile, p->nAnd2Delay );
     }
     if ( p->pManTime )
     {
@@ -1205,18 +1357,18 @@ void Gia_AigerWrite( Gia_Man_t * pInit, char * pFileName, int fWriteSymbols, int
         pTimes = Tim_ManGetArrTimes( (Tim_Man_t *)p->pManTime );
         if ( pTimes )
         {
-            fprintf( pFile, "i" );
-            Gia_FileWriteBufferSize( pFile, 4*Tim_ManPiNum((Tim_Man_t *)p->pManTime) );
-            fwrite( pTimes, 1, 4*Tim_ManPiNum((Tim_Man_t *)p->pManTime), pFile );
+            Abc_OstrPutC( pFile, 'i' );
+            Gia_AigerPutInt( pFile, 4*Tim_ManPiNum((Tim_Man_t *)p->pManTime) );
+            Abc_OstrPutBuf( pFile, (char *)pTimes, 4*Tim_ManPiNum((Tim_Man_t *)p->pManTime) );
             ABC_FREE( pTimes );
             if ( fVerbose ) printf( "Finished writing extension \"i\".\n" );
         }
         pTimes = Tim_ManGetReqTimes( (Tim_Man_t *)p->pManTime );
         if ( pTimes )
         {
-            fprintf( pFile, "o" );
-            Gia_FileWriteBufferSize( pFile, 4*Tim_ManPoNum((Tim_Man_t *)p->pManTime) );
-            fwrite( pTimes, 1, 4*Tim_ManPoNum((Tim_Man_t *)p->pManTime), pFile );
+            Abc_OstrPutC( pFile, 'o' );
+            Gia_AigerPutInt( pFile, 4*Tim_ManPoNum((Tim_Man_t *)p->pManTime) );
+            Abc_OstrPutBuf( pFile, (char *)pTimes, 4*Tim_ManPoNum((Tim_Man_t *)p->pManTime) );
             ABC_FREE( pTimes );
             if ( fVerbose ) printf( "Finished writing extension \"o\".\n" );
         }
@@ -1225,35 +1377,35 @@ void Gia_AigerWrite( Gia_Man_t * pInit, char * pFileName, int fWriteSymbols, int
     if ( p->pReprs && p->pNexts )
     {
         extern Vec_Str_t * Gia_WriteEquivClasses( Gia_Man_t * p );
-        fprintf( pFile, "e" );
+        Abc_OstrPutC( pFile, 'e' );
         vStrExt = Gia_WriteEquivClasses( p );
-        Gia_FileWriteBufferSize( pFile, Vec_StrSize(vStrExt) );
-        fwrite( Vec_StrArray(vStrExt), 1, Vec_StrSize(vStrExt), pFile );
+        Gia_AigerPutInt( pFile, Vec_StrSize(vStrExt) );
+        Abc_OstrPutBuf( pFile, Vec_StrArray(vStrExt), Vec_StrSize(vStrExt) );
         Vec_StrFree( vStrExt );
     }
     // write flop classes
     if ( p->vFlopClasses )
     {
-        fprintf( pFile, "f" );
-        Gia_FileWriteBufferSize( pFile, 4*Gia_ManRegNum(p) );
+        Abc_OstrPutC( pFile, 'f' );
+        Gia_AigerPutInt( pFile, 4*Gia_ManRegNum(p) );
         assert( Vec_IntSize(p->vFlopClasses) == Gia_ManRegNum(p) );
-        fwrite( Vec_IntArray(p->vFlopClasses), 1, 4*Gia_ManRegNum(p), pFile );
+        Abc_OstrPutBuf( pFile, (char *)Vec_IntArray(p->vFlopClasses), 4*Gia_ManRegNum(p) );
     }
     // write gate classes
     if ( p->vGateClasses )
     {
-        fprintf( pFile, "g" );
-        Gia_FileWriteBufferSize( pFile, 4*Gia_ManObjNum(p) );
+        Abc_OstrPutC( pFile, 'g' );
+        Gia_AigerPutInt( pFile, 4*Gia_ManObjNum(p) );
         assert( Vec_IntSize(p->vGateClasses) == Gia_ManObjNum(p) );
-        fwrite( Vec_IntArray(p->vGateClasses), 1, 4*Gia_ManObjNum(p), pFile );
+        Abc_OstrPutBuf( pFile, (char *)Vec_IntArray(p->vGateClasses), 4*Gia_ManObjNum(p) );
     }
     // write hierarchy info
     if ( p->pManTime )
     {
-        fprintf( pFile, "h" );
+        Abc_OstrPutC( pFile, 'h' );
         vStrExt = Tim_ManSave( (Tim_Man_t *)p->pManTime, 1 );
-        Gia_FileWriteBufferSize( pFile, Vec_StrSize(vStrExt) );
-        fwrite( Vec_StrArray(vStrExt), 1, Vec_StrSize(vStrExt), pFile );
+        Gia_AigerPutInt( pFile, Vec_StrSize(vStrExt) );
+        Abc_OstrPutBuf( pFile, Vec_StrArray(vStrExt), Vec_StrSize(vStrExt) );
         Vec_StrFree( vStrExt );
         if ( fVerbose ) printf( "Finished writing extension \"h\".\n" );
     }
@@ -1261,10 +1413,10 @@ void Gia_AigerWrite( Gia_Man_t * pInit, char * pFileName, int fWriteSymbols, int
     if ( p->vPacking )
     {
         extern Vec_Str_t * Gia_WritePacking( Vec_Int_t * vPacking );
-        fprintf( pFile, "k" );
+        Abc_OstrPutC( pFile, 'k' );
         vStrExt = Gia_WritePacking( p->vPacking );
-        Gia_FileWriteBufferSize( pFile, Vec_StrSize(vStrExt) );
-        fwrite( Vec_StrArray(vStrExt), 1, Vec_StrSize(vStrExt), pFile );
+        Gia_AigerPutInt( pFile, Vec_StrSize(vStrExt) );
+        Abc_OstrPutBuf( pFile, Vec_StrArray(vStrExt), Vec_StrSize(vStrExt) );
         Vec_StrFree( vStrExt );
         if ( fVerbose ) printf( "Finished writing extension \"k\".\n" );
     }
@@ -1274,107 +1426,108 @@ void Gia_AigerWrite( Gia_Man_t * pInit, char * pFileName, int fWriteSymbols, int
         extern Vec_Str_t * Gia_AigerWriteMapping( Gia_Man_t * p );
         extern Vec_Str_t * Gia_AigerWriteMappingSimple( Gia_Man_t * p );
         extern Vec_Str_t * Gia_AigerWriteMappingDoc( Gia_Man_t * p );
-        fprintf( pFile, "m" );
+        Abc_OstrPutC( pFile, 'm' );
         vStrExt = Gia_AigerWriteMappingDoc( p );
-        Gia_FileWriteBufferSize( pFile, Vec_StrSize(vStrExt) );
-        fwrite( Vec_StrArray(vStrExt), 1, Vec_StrSize(vStrExt), pFile );
+        Gia_AigerPutInt( pFile, Vec_StrSize(vStrExt) );
+        Abc_OstrPutBuf( pFile, Vec_StrArray(vStrExt), Vec_StrSize(vStrExt) );
         Vec_StrFree( vStrExt );
         if ( fVerbose ) printf( "Finished writing extension \"m\".\n" );
     }
     // write placement
     if ( p->pPlacement )
     {
-        fprintf( pFile, "p" );
-        Gia_FileWriteBufferSize( pFile, 4*Gia_ManObjNum(p) );
-        fwrite( p->pPlacement, 1, 4*Gia_ManObjNum(p), pFile );
+        Abc_OstrPutC( pFile, 'p' );
+        Gia_AigerPutInt( pFile, 4*Gia_ManObjNum(p) );
+        Abc_OstrPutBuf( pFile, (char *)p->pPlacement, 4*Gia_ManObjNum(p) );
     }
     // write register classes
     if ( p->vRegClasses )
     {
         int i;
-        fprintf( pFile, "r" );
-        Gia_FileWriteBufferSize( pFile, 4*(Vec_IntSize(p->vRegClasses)+1) );
-        Gia_FileWriteBufferSize( pFile, Vec_IntSize(p->vRegClasses) );
+        Abc_OstrPutC( pFile, 'r' );
+        Gia_AigerPutInt( pFile, 4*(Vec_IntSize(p->vRegClasses)+1) );
+        Gia_AigerPutInt( pFile, Vec_IntSize(p->vRegClasses) );
         for ( i = 0; i < Vec_IntSize(p->vRegClasses); i++ )
-            Gia_FileWriteBufferSize( pFile, Vec_IntEntry(p->vRegClasses, i) );
+            Gia_AigerPutInt( pFile, Vec_IntEntry(p->vRegClasses, i) );
     }
     // write register inits
     if ( p->vRegInits )
     {
         int i;
-        fprintf( pFile, "s" );
-        Gia_FileWriteBufferSize( pFile, 4*(Vec_IntSize(p->vRegInits)+1) );
-        Gia_FileWriteBufferSize( pFile, Vec_IntSize(p->vRegInits) );
+        Abc_OstrPutC( pFile, 's' );
+        Gia_AigerPutInt( pFile, 4*(Vec_IntSize(p->vRegInits)+1) );
+        Gia_AigerPutInt( pFile, Vec_IntSize(p->vRegInits) );
         for ( i = 0; i < Vec_IntSize(p->vRegInits); i++ )
-            Gia_FileWriteBufferSize( pFile, Vec_IntEntry(p->vRegInits, i) );
+            Gia_AigerPutInt( pFile, Vec_IntEntry(p->vRegInits, i) );
     }
     // write configuration data
     if ( p->vConfigs )
     {
-        fprintf( pFile, "b" );
+        Abc_OstrPutC( pFile, 'b' );
         assert( p->pCellStr != NULL );
-        Gia_FileWriteBufferSize( pFile, 4*Vec_IntSize(p->vConfigs) + strlen(p->pCellStr) + 1 );
-        fwrite( p->pCellStr, 1, strlen(p->pCellStr) + 1, pFile );
+        Gia_AigerPutInt( pFile, 4*Vec_IntSize(p->vConfigs) + strlen(p->pCellStr) + 1 );
+        Abc_OstrPutBuf( pFile, p->pCellStr, strlen(p->pCellStr) + 1 );
 //        fwrite( Vec_IntArray(p->vConfigs), 1, 4*Vec_IntSize(p->vConfigs), pFile );
         for ( i = 0; i < Vec_IntSize(p->vConfigs); i++ )
-            Gia_FileWriteBufferSize( pFile, Vec_IntEntry(p->vConfigs, i) );
+            Gia_AigerPutInt( pFile, Vec_IntEntry(p->vConfigs, i) );
     }
     // write choices
     if ( Gia_ManHasChoices(p) )
     {
         int i, nPairs = 0;
-        fprintf( pFile, "q" );
+        Abc_OstrPutC( pFile, 'q' );
         for ( i = 0; i < Gia_ManObjNum(p); i++ )
             nPairs += (Gia_ObjSibl(p, i) > 0);
-        Gia_FileWriteBufferSize( pFile, 4*(nPairs * 2 + 1) );
-        Gia_FileWriteBufferSize( pFile, nPairs );
+        Gia_AigerPutInt( pFile, 4*(nPairs * 2 + 1) );
+        Gia_AigerPutInt( pFile, nPairs );
         for ( i = 0; i < Gia_ManObjNum(p); i++ )
             if ( Gia_ObjSibl(p, i) )
             {
                 assert( i > Gia_ObjSibl(p, i) );
-                Gia_FileWriteBufferSize( pFile, i );
-                Gia_FileWriteBufferSize( pFile, Gia_ObjSibl(p, i) );
+                Gia_AigerPutInt( pFile, i );
+                Gia_AigerPutInt( pFile, Gia_ObjSibl(p, i) );
             }
         if ( fVerbose ) printf( "Finished writing extension \"q\".\n" );
     }
     // write switching activity
     if ( p->pSwitching )
     {
-        fprintf( pFile, "u" );
-        Gia_FileWriteBufferSize( pFile, Gia_ManObjNum(p) );
-        fwrite( p->pSwitching, 1, Gia_ManObjNum(p), pFile );
+        Abc_OstrPutC( pFile, 'u' );
+        Gia_AigerPutInt( pFile, Gia_ManObjNum(p) );
+        Abc_OstrPutBuf( pFile, (char *)p->pSwitching, Gia_ManObjNum(p) );
     }
 /*
     // write timing information
     if ( p->pManTime )
     {
-        fprintf( pFile, "t" );
+        Abc_OstrPutC( pFile, 't' );
         vStrExt = Tim_ManSave( (Tim_Man_t *)p->pManTime, 0 );
-        Gia_FileWriteBufferSize( pFile, Vec_StrSize(vStrExt) );
-        fwrite( Vec_StrArray(vStrExt), 1, Vec_StrSize(vStrExt), pFile );
+        Gia_AigerPutInt( pFile, Vec_StrSize(vStrExt) );
+        Abc_OstrPutBuf( pFile, Vec_StrArray(vStrExt), Vec_StrSize(vStrExt) );
         Vec_StrFree( vStrExt );
     }
 */
     // write object classes
     if ( p->vObjClasses )
     {
-        fprintf( pFile, "v" );
-        Gia_FileWriteBufferSize( pFile, 4*Gia_ManObjNum(p) );
+        Abc_OstrPutC( pFile, 'v' );
+        Gia_AigerPutInt( pFile, 4*Gia_ManObjNum(p) );
         assert( Vec_IntSize(p->vObjClasses) == Gia_ManObjNum(p) );
-        fwrite( Vec_IntArray(p->vObjClasses), 1, 4*Gia_ManObjNum(p), pFile );
+        Abc_OstrPutBuf( pFile, (char *)Vec_IntArray(p->vObjClasses), 4*Gia_ManObjNum(p) );
     }
     // write name
     if ( p->pName )
     {
-        fprintf( pFile, "n" );
-        Gia_FileWriteBufferSize( pFile, strlen(p->pName)+1 );
-        fwrite( p->pName, 1, strlen(p->pName), pFile );
-        fprintf( pFile, "%c", '\0' );
+        Abc_OstrPutC( pFile, 'n' );
+        Gia_AigerPutInt( pFile, strlen(p->pName)+1 );
+        Abc_OstrPutBuf( pFile, p->pName, strlen(p->pName) );
+        Abc_OstrPutC( pFile, '\0' );
     }
     // write comments
-    fprintf( pFile, "\nThis file was produced by the GIA package in ABC on %s\n", Gia_TimeStamp() );
-    fprintf( pFile, "For information about AIGER format, refer to %s\n", "http://fmv.jku.at/aiger" );
-	fclose( pFile );
+    Abc_OstrPrintf( pFile, "\nThis file was produced by the GIA package in ABC on %s\n", Gia_TimeStamp() );
+    Abc_OstrPrintf( pFile, "For information about AIGER format, refer to %s\n", "http://fmv.jku.at/aiger" );
+    if ( !Abc_OstrStop( pFile ) )
+        fprintf( stdout, "Gia_AigerWrite(): Writing the output file \"%s\" has failed.\n", pFileName );
     if ( p != pInit )
     {
         pInit->pManTime  = p->pManTime;  p->pManTime = NULL;
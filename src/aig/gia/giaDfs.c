@@ -19,6 +19,7 @@
 ***********************************************************************/
 
 #include "gia.h"
+#include "misc/vec/vecWec.h"
 
 ABC_NAMESPACE_IMPL_START
 
@@ -392,6 +393,41 @@ Vec_Vec_t * Gia_ManLevelize( Gia_Man_t * p )
     return vLevels;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Levelizes the internal nodes for parallel processing.]
+
+  Description [Returns IDs of the internal nodes grouped by level. Unlike
+  the usual levels, the level of a node is larger than the levels of all
+  its fanins, including buffers, the control input of MUXes, and the choice
+  sibling, so the nodes of one level can be processed independently. The
+  nodes of each level are listed in the increasing order of their IDs.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Vec_Wec_t * Gia_ManLevelizeAnds( Gia_Man_t * p )
+{
+    Vec_Wec_t * vLevels = Vec_WecAlloc( 100 );
+    Vec_Int_t * vLevel = Vec_IntStart( Gia_ManObjNum(p) );
+    Gia_Obj_t * pObj;
+    int i, Level;
+    Gia_ManForEachAnd( p, pObj, i )
+    {
+        Level = Abc_MaxInt( Vec_IntEntry(vLevel, Gia_ObjFaninId0(pObj, i)), Vec_IntEntry(vLevel, Gia_ObjFaninId1(pObj, i)) );
+        if ( Gia_ObjIsMuxId(p, i) )
+            Level = Abc_MaxInt( Level, Vec_IntEntry(vLevel, Gia_ObjFaninId2(p, i)) );
+        if ( Gia_ObjSibl(p, i) )
+            Level = Abc_MaxInt( Level, Vec_IntEntry(vLevel, Gia_ObjSibl(p, i)) );
+        Vec_IntWriteEntry( vLevel, i, Level + 1 );
+        Vec_WecPush( vLevels, Level, i );
+    }
+    Vec_IntFree( vLevel );
+    return vLevels;
+}
+
 /**Function*************************************************************
 
   Synopsis    [Computes reverse topological order.]
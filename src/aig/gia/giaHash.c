@@ -27,6 +27,25 @@ ABC_NAMESPACE_IMPL_START
 ///                        DECLARATIONS                              ///
 ////////////////////////////////////////////////////////////////////////
 
+// The structural hash table is an array of entries with linear probing;
+// the number of entries is a power of 2. The entry keeps the 32-bit hash 
+// key of the fanin literals next to the node literal, so that probing does 
+// not touch the objects unless the keys match, and resizing does not touch
+// the objects at all. The entry is empty if the node literal is 0.
+typedef struct Gia_HashEnt_t_ Gia_HashEnt_t;
+struct Gia_HashEnt_t_
+{
+    unsigned       Key;           // the hash key of the fanin literals
+    int            iLit;          // the node literal
+};
+
+// the largest table size is the largest power of 2 representable as int
+#define GIA_HASH_LOG_MAX 30
+
+static inline Gia_HashEnt_t * Gia_ManHashEnts( Gia_Man_t * p )  { return (Gia_HashEnt_t *)p->pHTable;               }
+// the table is resized when it is more than three-quarters full (unless it is the largest)
+static inline int Gia_ManHashIsFull( Gia_Man_t * p )           { return p->nHTable < (1 << GIA_HASH_LOG_MAX) && 4 * (word)Gia_ManAndNum(p) > 3 * (word)p->nHTable; }
+
 ////////////////////////////////////////////////////////////////////////
 ///                     FUNCTION DEFINITIONS                         ///
 ////////////////////////////////////////////////////////////////////////
@@ -42,28 +61,34 @@ ABC_NAMESPACE_IMPL_START
   SeeAlso     []
 
 ***********************************************************************/
-static inline int Gia_ManHashOne( int iLit0, int iLit1, int iLitC, int TableSize ) 
+static inline unsigned Gia_ManHashOne( int iLit0, int iLit1, int iLitC ) 
 {
-    unsigned Key = iLitC * 2011;
-    Key += Abc_Lit2Var(iLit0) * 7937;
-    Key += Abc_Lit2Var(iLit1) * 2971;
-    Key += Abc_LitIsCompl(iLit0) * 911;
-    Key += Abc_LitIsCompl(iLit1) * 353;
-    return (int)(Key % TableSize);
+    word Key = ((word)(unsigned)iLit1 << 32) | (word)(unsigned)iLit0;
+    Key += (word)(unsigned)iLitC * ABC_CONST(0xC2B2AE3D27D4EB4F);
+    Key *= ABC_CONST(0x9E3779B97F4A7C15);
+    return (unsigned)(Key >> 32);
 }
-static inline int * Gia_ManHashFind( Gia_Man_t * p, int iLit0, int iLit1, int iLitC )
-{
-    Gia_Obj_t * pThis;
-    int * pPlace = p->pHTable + Gia_ManHashOne( iLit0, iLit1, iLitC, p->nHTable );
+static inline int * Gia_ManHashFind( Gia_Man_t * p, int iLit0, int iLit1, int iLitC )
+{
+    Gia_HashEnt_t * pEnts = Gia_ManHashEnts( p ), * pEnt;
+    Gia_Obj_t * pThis;
+    unsigned Key = Gia_ManHashOne( iLit0, iLit1, iLitC ), Mask = (unsigned)p->nHTable - 1, i;
     assert( p->pMuxes || iLit0 < iLit1 );
     assert( iLit0 < iLit1 || (!Abc_LitIsCompl(iLit0) && !Abc_LitIsCompl(iLit1)) );
     assert( iLitC == -1 || !Abc_LitIsCompl(iLit1) );
-    for ( pThis = (*pPlace)? Gia_ManObj(p, Abc_Lit2Var(*pPlace)) : NULL; pThis; 
-          pPlace = (int *)&pThis->Value, pThis = (*pPlace)? Gia_ManObj(p, Abc_Lit2Var(*pPlace)) : NULL )
-              if ( Gia_ObjFaninLit0p(p, pThis) == iLit0 && Gia_ObjFaninLit1p(p, pThis) == iLit1 && (p->pMuxes == NULL || Gia_ObjFaninLit2p(p, pThis) == iLitC) )
-                  break;
-    return pPlace;
-}
+    for ( i = Key & Mask, pEnt = pEnts + i; pEnt->iLit; i = (i + 1) & Mask, pEnt = pEnts + i )
+    {
+        if ( pEnt->Key != Key )
+            continue;
+        pThis = Gia_ManObj( p, Abc_Lit2Var(pEnt->iLit) );
+        if ( Gia_ObjFaninLit0p(p, pThis) == iLit0 && Gia_ObjFaninLit1p(p, pThis) == iLit1 && (p->pMuxes == NULL || Gia_ObjFaninLit2p(p, pThis) == iLitC) )
+            return &pEnt->iLit;
+    }
+    // the node is not found; record the key in the empty entry,
+    // so that the caller can add the node by assigning the literal
+    pEnt->Key = Key;
+    return &pEnt->iLit;
+}
 
 /**Function*************************************************************
 
@@ -102,9 +127,11 @@ int Gia_ManHashLookup( Gia_Man_t * p, Gia_Obj_t * p0, Gia_Obj_t * p1 )
 ***********************************************************************/
 void Gia_ManHashAlloc( Gia_Man_t * p )  
 {
+    word nEntries = Gia_ManAndNum(p) ? (word)Gia_ManAndNum(p) + 1000 : (word)p->nObjsAlloc;
+    int nLog = Abc_Base2Log( (unsigned)Abc_MinWord( 4 * nEntries / 3, (word)1 << GIA_HASH_LOG_MAX ) );
     assert( p->pHTable == NULL );
-    p->nHTable = Abc_PrimeCudd( Gia_ManAndNum(p) ? Gia_ManAndNum(p) + 1000 : p->nObjsAlloc );
-    p->pHTable = ABC_CALLOC( int, p->nHTable );
+    p->nHTable = 1 << Abc_MaxInt( 12, nLog );
+    p->pHTable = (int *)ABC_CALLOC( Gia_HashEnt_t, p->nHTable );
 }
 
 /**Function*************************************************************
@@ -153,7 +180,8 @@ void Gia_ManHashStop( Gia_Man_t * p )
 
   Synopsis    [Resizes the hash table.]
 
-  Description []
+  Description [The table is doubled. The entries are moved in one pass 
+  over the old table using the stored keys, without visiting the objects.]
                
   SideEffects []
 
@@ -162,33 +190,31 @@ void Gia_ManHashStop( Gia_Man_t * p )
 ***********************************************************************/
 void Gia_ManHashResize( Gia_Man_t * p )
 {
-    Gia_Obj_t * pThis;
-    int * pHTableOld, * pPlace;
-    int nHTableOld, iNext, Counter, Counter2, i;
+    Gia_HashEnt_t * pEntsOld, * pEnts, * pEnt;
+    unsigned Mask, k;
+    int nHTableOld, Counter, Counter2, i;
     assert( p->pHTable != NULL );
     // replace the table
-    pHTableOld = p->pHTable;
+    pEntsOld   = Gia_ManHashEnts( p );
     nHTableOld = p->nHTable;
-    p->nHTable = Abc_PrimeCudd( 2 * Gia_ManAndNum(p) ); 
-    p->pHTable = ABC_CALLOC( int, p->nHTable );
+    assert( nHTableOld < (1 << GIA_HASH_LOG_MAX) );
+    p->nHTable = 2 * nHTableOld;
+    p->pHTable = (int *)ABC_CALLOC( Gia_HashEnt_t, p->nHTable );
+    pEnts      = Gia_ManHashEnts( p );
+    Mask       = (unsigned)p->nHTable - 1;
     // rehash the entries from the old table
     Counter = 0;
-    for ( i = 0; i < nHTableOld; i++ )
-    for ( pThis = (pHTableOld[i]? Gia_ManObj(p, Abc_Lit2Var(pHTableOld[i])) : NULL),
-          iNext = (pThis? pThis->Value : 0);  
-          pThis;  pThis = (iNext? Gia_ManObj(p, Abc_Lit2Var(iNext)) : NULL),   
-          iNext = (pThis? pThis->Value : 0)  )
+    for ( i = 0, pEnt = pEntsOld; i < nHTableOld; i++, pEnt++ )
     {
-        pThis->Value = 0;
-        pPlace = Gia_ManHashFind( p, Gia_ObjFaninLit0p(p, pThis), Gia_ObjFaninLit1p(p, pThis), Gia_ObjFaninLit2p(p, pThis) );
-        assert( *pPlace == 0 ); // should not be there
-        *pPlace = Abc_Var2Lit( Gia_ObjId(p, pThis), 0 );
-        assert( *pPlace != 0 );
+        if ( pEnt->iLit == 0 )
+            continue;
+        for ( k = pEnt->Key & Mask; pEnts[k].iLit; k = (k + 1) & Mask );
+        pEnts[k] = *pEnt;
         Counter++;
     }
     Counter2 = Gia_ManAndNum(p) - Gia_ManBufNum(p);
     assert( Counter == Counter2 );
-    ABC_FREE( pHTableOld );
+    ABC_FREE( pEntsOld );
 //    if ( p->fVerbose )
 //        printf( "Resizing GIA hash table: %d -> %d.\n", nHTableOld, p->nHTable );
 }
@@ -206,22 +232,24 @@ void Gia_ManHashResize( Gia_Man_t * p )
 ******************************************************************************/
 void Gia_ManHashProfile( Gia_Man_t * p )
 {
-    Gia_Obj_t * pEntry;
-    int i, Counter, Limit;
+    Gia_HashEnt_t * pEnts = Gia_ManHashEnts( p ), * pEnt;
+    unsigned Dist, DistMax = 0, Mask = (unsigned)p->nHTable - 1;
+    int i, nUsed = 0;
+    double DistSum = 0;
     printf( "Table size = %d. Entries = %d. ", p->nHTable, Gia_ManAndNum(p) );
     printf( "Hits = %d. Misses = %d.\n", (int)p->nHashHit, (int)p->nHashMiss );
-    Limit = Abc_MinInt( 1000, p->nHTable );
-    for ( i = 0; i < Limit; i++ )
+    // the probe length of an entry is its distance from the home position
+    for ( i = 0, pEnt = pEnts; i < p->nHTable; i++, pEnt++ )
     {
-        Counter = 0;
-        for ( pEntry = (p->pHTable[i]? Gia_ManObj(p, Abc_Lit2Var(p->pHTable[i])) : NULL); 
-              pEntry; 
-              pEntry = (pEntry->Value? Gia_ManObj(p, Abc_Lit2Var(pEntry->Value)) : NULL) )
-            Counter++;
-        if ( Counter ) 
-            printf( "%d ", Counter );
+        if ( pEnt->iLit == 0 )
+            continue;
+        Dist = ((unsigned)i - pEnt->Key) & Mask;
+        DistMax  = Abc_MaxInt( DistMax, Dist );
+        DistSum += Dist;
+        nUsed++;
     }
-    printf( "\n" );
+    printf( "Used = %d (%.1f %%). Probe length: Ave = %.2f. Max = %d.\n", 
+        nUsed, 100.0 * nUsed / p->nHTable, nUsed ? 1.0 + DistSum / nUsed : 0.0, 1 + (int)DistMax );
 }
 
 /**Function*************************************************************
@@ -478,7 +506,7 @@ int Gia_ManHashXorReal( Gia_Man_t * p, int iLit0, int iLit1 )
         return 0;
     if ( iLit0 == Abc_LitNot(iLit1) )
         return 1;
-    if ( (p->nObjs & 0xFF) == 0 && 2 * p->nHTable < Gia_ManAndNum(p) )
+    if ( Gia_ManHashIsFull(p) )
         Gia_ManHashResize( p );
     if ( iLit0 < iLit1 )
         iLit0 ^= iLit1, iLit1 ^= iLit0, iLit0 ^= iLit1;
@@ -494,15 +522,8 @@ int Gia_ManHashXorReal( Gia_Man_t * p, int iLit0, int iLit1 )
             return Abc_LitNotCond( *pPlace, fCompl );
         }
         p->nHashMiss++;
-        if ( p->nObjs < p->nObjsAlloc )
-            *pPlace = Gia_ManAppendXorReal( p, iLit0, iLit1 );
-        else
-        {
-            int iNode = Gia_ManAppendXorReal( p, iLit0, iLit1 );
-            pPlace = Gia_ManHashFind( p, iLit0, iLit1, -1 );
-            assert( *pPlace == 0 );
-            *pPlace = iNode;
-        }
+        // the table does not move when the objects are reallocated
+        *pPlace = Gia_ManAppendXorReal( p, iLit0, iLit1 );
         return Abc_LitNotCond( *pPlace, fCompl );
     }
 }
@@ -541,6 +562,8 @@ int Gia_ManHashMuxReal( Gia_Man_t * p, int iLitC, int iLit1, int iLit0 )
         iLit0 ^= iLit1, iLit1 ^= iLit0, iLit0 ^= iLit1, iLitC = Abc_LitNot(iLitC);
     if ( Abc_LitIsCompl(iLit1) )
         iLit0 = Abc_LitNot(iLit0), iLit1 = Abc_LitNot(iLit1), fCompl = 1;
+    if ( Gia_ManHashIsFull(p) )
+        Gia_ManHashResize( p );
     {
         int *pPlace = Gia_ManHashFind( p, iLit0, iLit1, iLitC );
         if ( *pPlace )
@@ -549,15 +572,7 @@ int Gia_ManHashMuxReal( Gia_Man_t * p, int iLitC, int iLit1, int iLit0 )
             return Abc_LitNotCond( *pPlace, fCompl );
         }
         p->nHashMiss++;
-        if ( p->nObjs < p->nObjsAlloc )
-            *pPlace = Gia_ManAppendMuxReal( p, iLitC, iLit1, iLit0 );
-        else
-        {
-            int iNode = Gia_ManAppendMuxReal( p, iLitC, iLit1, iLit0 );
-            pPlace = Gia_ManHashFind( p, iLit0, iLit1, iLitC );
-            assert( *pPlace == 0 );
-            *pPlace = iNode;
-        }
+        *pPlace = Gia_ManAppendMuxReal( p, iLitC, iLit1, iLit0 );
         return Abc_LitNotCond( *pPlace, fCompl );
     }
 }
@@ -583,7 +598,7 @@ int Gia_ManHashAnd( Gia_Man_t * p, int iLit0, int iLit1 )
         return iLit1;
     if ( iLit0 == Abc_LitNot(iLit1) )
         return 0;
-    if ( (p->nObjs & 0xFF) == 0 && 2 * p->nHTable < Gia_ManAndNum(p) )
+    if ( Gia_ManHashIsFull(p) )
         Gia_ManHashResize( p );
     if ( p->fAddStrash )
     {
@@ -601,15 +616,7 @@ int Gia_ManHashAnd( Gia_Man_t * p, int iLit0, int iLit1 )
             return *pPlace;
         }
         p->nHashMiss++;
-        if ( p->nObjs < p->nObjsAlloc )
-            return *pPlace = Gia_ManAppendAnd( p, iLit0, iLit1 );
-        else
-        {
-            int iNode = Gia_ManAppendAnd( p, iLit0, iLit1 );
-            pPlace = Gia_ManHashFind( p, iLit0, iLit1, -1 );
-            assert( *pPlace == 0 );
-            return *pPlace = iNode;
-        }
+        return *pPlace = Gia_ManAppendAnd( p, iLit0, iLit1 );
     }
 }
 int Gia_ManHashOr( Gia_Man_t * p, int iLit0, int iLit1 )  
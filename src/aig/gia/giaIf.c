@@ -81,6 +81,7 @@ void Gia_ManSetIfParsDefault( void * pp )
     p->fEdge       =  1;
     p->fPower      =  0;
     p->fCutMin     =  0;
+    p->nThreads    =  1;
     p->fVerbose    =  0;
     p->pLutStruct  =  NULL;
     // internal parameters
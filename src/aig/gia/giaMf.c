@@ -24,6 +24,8 @@
 #include "misc/extra/extra.h"
 #include "sat/cnf/cnf.h"
 #include "opt/dau/dau.h"
+#include "misc/vec/vecWec.h"
+#include "misc/util/utilPool.h"
 
 ABC_NAMESPACE_IMPL_START
 
@@ -38,6 +40,11 @@ ABC_NAMESPACE_IMPL_START
 #define MF_TT_WORDS  ((MF_LEAF_MAX > 6) ? 1 << (MF_LEAF_MAX-6) : 1)
 #define MF_NO_FUNC    134217727     // (1<<27)-1
 
+// the smallest number of nodes of one level given to a thread
+#define MF_PAR_CHUNK_MIN    64
+// the largest number of nodes whose cuts are kept before saving
+#define MF_PAR_BATCH     16384
+
 typedef struct Mf_Cut_t_ Mf_Cut_t; 
 struct Mf_Cut_t_
 {
@@ -70,6 +77,7 @@ struct Mf_Man_t_
     Vec_Mem_t *     vTtMem;         // truth tables
     Vec_Int_t       vCnfSizes;      // handles to CNF
     Vec_Int_t       vCnfMem;        // memory for CNF
+    Vec_Wec_t *     vLevels;        // nodes by level (multi-threaded mode)
     int             iCur;           // current position
     int             Iter;           // mapping iterations
     int             fUseEla;        // use exact area
@@ -79,6 +87,18 @@ struct Mf_Man_t_
     int             nCutCounts[MF_LEAF_MAX+1];
 };
 
+// the state of one thread processing the nodes of a level
+typedef struct Mf_ParThData_t_ Mf_ParThData_t;
+struct Mf_ParThData_t_
+{
+    Mf_Man_t        Man;            // private copy of the manager (statistics)
+    int *           pNodes;         // the nodes
+    int             nNodes;         // the number of nodes
+    Mf_Cut_t *      pCuts;          // the resulting cuts (nCutNum entries per node)
+    int *           pnCuts;         // the number of resulting cuts of each node
+    int             fCuts;          // computing cuts vs. selecting the best cut
+};
+
 static inline Mf_Obj_t * Mf_ManObj( Mf_Man_t * p, int i )            { return p->pLfObjs + i;                                          }
 static inline int *      Mf_ManCutSet( Mf_Man_t * p, int i )         { return (int *)Vec_PtrEntry(&p->vPages, i >> 16) + (i & 0xFFFF); }
 static inline int *      Mf_ObjCutSet( Mf_Man_t * p, int i )         { return Mf_ManCutSet(p, Mf_ManObj(p, i)->iCutSet);               }
@@ -98,6 +118,9 @@ static inline int        Mf_CutIsTriv( int * pCut, int i )           { return Mf
 
 extern int Kit_TruthToGia( Gia_Man_t * pMan, unsigned * pTruth, int nVars, Vec_Int_t * vMemory, Vec_Int_t * vLeaves, int fHash );
 
+extern Vec_Wec_t * Gia_ManLevelizeAnds( Gia_Man_t * p );
+static void        Mf_ManComputeLevels( Mf_Man_t * p, int fCuts );
+
 ////////////////////////////////////////////////////////////////////////
 ///                     FUNCTION DEFINITIONS                         ///
 ////////////////////////////////////////////////////////////////////////
@@ -963,9 +986,9 @@ static inline void Mf_CutParams( Mf_Man_t * p, Mf_Cut_t * pCut, float FlowRefs )
     pCut->Delay += (int)(nLeaves > 1);
     pCut->Flow = (pCut->Flow + Mf_CutArea(p, nLeaves, pCut->iFunc)) / FlowRefs;
 }
-void Mf_ObjMergeOrder( Mf_Man_t * p, int iObj )
+static inline int Mf_ObjComputeCuts( Mf_Man_t * p, int iObj, Mf_Cut_t * pCuts, Mf_Cut_t ** pCutsR )
 {
-    Mf_Cut_t pCuts0[MF_CUT_MAX], pCuts1[MF_CUT_MAX], pCuts[MF_CUT_MAX], * pCutsR[MF_CUT_MAX];
+    Mf_Cut_t pCuts0[MF_CUT_MAX], pCuts1[MF_CUT_MAX];
     Gia_Obj_t * pObj = Gia_ManObj(p->pGia, iObj);
     Mf_Obj_t * pBest = Mf_ManObj(p, iObj);
     int nLutSize = p->pPars->nLutSize;
@@ -1051,15 +1074,21 @@ void Mf_ObjMergeOrder( Mf_Man_t * p, int iObj )
             Mf_CutPrint( p, pCutsR[i] );
         printf( "\n" );
     } 
-    // store the cutset
+    // store the best cut
     pBest->Flow = pCutsR[0]->Flow;
     pBest->Delay = pCutsR[0]->Delay;
-    pBest->iCutSet = Mf_ManSaveCuts( p, pCutsR, nCutsR );
     // verify
     assert( nCutsR > 0 && nCutsR < nCutNum );
 //    assert( Mf_SetCheckArray(pCutsR, nCutsR) );
     p->nCutCounts[pCutsR[0]->nLeaves]++;
     p->CutCount[3] += nCutsR;
+    return nCutsR;
+}
+void Mf_ObjMergeOrder( Mf_Man_t * p, int iObj )
+{
+    Mf_Cut_t pCuts[MF_CUT_MAX], * pCutsR[MF_CUT_MAX];
+    int nCutsR = Mf_ObjComputeCuts( p, iObj, pCuts, pCutsR );
+    Mf_ManObj(p, iObj)->iCutSet = Mf_ManSaveCuts( p, pCutsR, nCutsR );
 }
  
 
@@ -1335,6 +1364,7 @@ Mf_Man_t * Mf_ManAlloc( Gia_Man_t * pGia, Jf_Par_t * pPars )
     p->pPars     = pPars;
     p->vTtMem    = pPars->fCutMin ? Vec_MemAllocForTT( pPars->nLutSize, 0 ) : NULL;
     p->pLfObjs   = ABC_CALLOC( Mf_Obj_t, Gia_ManObjNum(pGia) );
+    p->vLevels   = pPars->nProcNum > 1 ? Gia_ManLevelizeAnds( pGia ) : NULL;
     p->iCur      = 2;
     Vec_PtrGrow( &p->vPages, 256 );
     if ( pPars->fGenCnf )
@@ -1359,6 +1389,7 @@ void Mf_ManFree( Mf_Man_t * p )
     if ( p->pPars->fCutMin )
         Vec_MemFree( p->vTtMem );
     Vec_PtrFreeData( &p->vPages );
+    Vec_WecFreeP( &p->vLevels );
     ABC_FREE( p->vCnfSizes.pArray );
     ABC_FREE( p->vCnfMem.pArray );
     ABC_FREE( p->vPages.pArray );
@@ -1425,6 +1456,8 @@ void Mf_ManPrintInit( Mf_Man_t * p )
     printf( "CutMin = %d  ",  p->pPars->fCutMin );
     printf( "Coarse = %d  ",  p->pPars->fCoarsen );
     printf( "CNF = %d  ",     p->pPars->fGenCnf );
+    if ( p->vLevels )
+    printf( "Threads = %d  ", p->pPars->nProcNum );
     printf( "\n" );
     printf( "Computing cuts...\r" );
     fflush( stdout );
@@ -1466,8 +1499,11 @@ void Mf_ManPrintQuit( Mf_Man_t * p, Gia_Man_t * pNew )
 void Mf_ManComputeCuts( Mf_Man_t * p )
 {
     int i;
-    Gia_ManForEachAndId( p->pGia, i )
-        Mf_ObjMergeOrder( p, i );
+    if ( p->vLevels && !p->pPars->fCutMin )
+        Mf_ManComputeLevels( p, 1 );
+    else
+        Gia_ManForEachAndId( p->pGia, i )
+            Mf_ObjMergeOrder( p, i );
     Mf_ManSetMapRefs( p );
     Mf_ManPrintStats( p, (char *)(p->fUseEla ? "Ela  " : (p->Iter ? "Area " : "Delay")) );
 }
@@ -1553,6 +1589,119 @@ static inline void Mf_ObjComputeBestCut( Mf_Man_t * p, int iObj )
 }
 
 
+/**Function*************************************************************
+
+  Synopsis    [Processes a range of nodes of one level.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void * Mf_ManLevelTask( void * pArg, Abc_Task_t * pTask )
+{
+    Mf_ParThData_t * pThData = (Mf_ParThData_t *)pArg;
+    Mf_Cut_t pCuts[MF_CUT_MAX], * pCutsR[MF_CUT_MAX];
+    int i, k, nCutNum = pThData->Man.pPars->nCutNum;
+    for ( i = 0; i < pThData->nNodes; i++ )
+    {
+        if ( !pThData->fCuts )
+        {
+            Mf_ObjComputeBestCut( &pThData->Man, pThData->pNodes[i] );
+            continue;
+        }
+        pThData->pnCuts[i] = Mf_ObjComputeCuts( &pThData->Man, pThData->pNodes[i], pCuts, pCutsR );
+        for ( k = 0; k < pThData->pnCuts[i]; k++ )
+            pThData->pCuts[i * nCutNum + k] = *pCutsR[k];
+    }
+    return NULL;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Computes cuts or area flow of the nodes level by level.]
+
+  Description [The nodes of one level depend only on the nodes of the
+  previous levels, so they are processed in parallel. Each thread works
+  with a private copy of the manager, which differs only in the statistics.
+  The cuts computed by the threads are stored in the cut memory by the
+  calling thread in the order of nodes, because the memory is shared.
+  The cuts and the selected cuts do not depend on the number of threads
+  and are the same as in the single-threaded mode. The exact area
+  recovery is always sequential because it references and dereferences
+  the cuts of the transitive fanin of the node.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Mf_ManComputeLevels( Mf_Man_t * p, int fCuts )
+{
+    Mf_ParThData_t * pThData;
+    Abc_Task_t ** ppTasks;
+    Vec_Int_t * vLevel;
+    Mf_Cut_t * pStore = NULL, * pCutsR[MF_CUT_MAX];
+    int * pnCuts = NULL, nThreads = p->pPars->nProcNum, nCutNum = p->pPars->nCutNum;
+    int i, k, c, iStart, iBeg, nNodes, nTasks;
+    assert( p->vLevels != NULL && !p->fUseEla );
+    assert( !fCuts || !p->pPars->fCutMin );
+    if ( fCuts )
+    {
+        pStore = ABC_ALLOC( Mf_Cut_t, MF_PAR_BATCH * nCutNum );
+        pnCuts = ABC_ALLOC( int, MF_PAR_BATCH );
+    }
+    pThData = ABC_ALLOC( Mf_ParThData_t, nThreads );
+    ppTasks = ABC_ALLOC( Abc_Task_t *, nThreads );
+    Vec_WecForEachLevel( p->vLevels, vLevel, i )
+    for ( iBeg = 0; iBeg < Vec_IntSize(vLevel); iBeg += MF_PAR_BATCH )
+    {
+        nNodes = Abc_MinInt( MF_PAR_BATCH, Vec_IntSize(vLevel) - iBeg );
+        nTasks = Abc_MinInt( nThreads, Abc_MaxInt(1, nNodes / MF_PAR_CHUNK_MIN) );
+        for ( k = 0; k < nTasks; k++ )
+        {
+            // the copy is refreshed because the page array may have been reallocated
+            pThData[k].Man = *p;
+            memset( pThData[k].Man.CutCount, 0, sizeof(p->CutCount) );
+            memset( pThData[k].Man.nCutCounts, 0, sizeof(p->nCutCounts) );
+            iStart = (int)((ABC_INT64_T)nNodes * k / nTasks);
+            pThData[k].pNodes = Vec_IntArray(vLevel) + iBeg + iStart;
+            pThData[k].nNodes = (int)((ABC_INT64_T)nNodes * (k + 1) / nTasks) - iStart;
+            pThData[k].pCuts  = fCuts ? pStore + iStart * nCutNum : NULL;
+            pThData[k].pnCuts = fCuts ? pnCuts + iStart : NULL;
+            pThData[k].fCuts  = fCuts;
+        }
+        for ( k = 1; k < nTasks; k++ )
+            ppTasks[k] = Abc_TaskSubmit( Mf_ManLevelTask, pThData + k );
+        Mf_ManLevelTask( pThData, NULL );
+        for ( k = 1; k < nTasks; k++ )
+            Abc_TaskWait( ppTasks[k] );
+        if ( !fCuts )
+            continue;
+        // collect statistics
+        for ( k = 0; k < nTasks; k++ )
+        {
+            for ( c = 0; c < 4; c++ )
+                p->CutCount[c] += pThData[k].Man.CutCount[c];
+            for ( c = 0; c <= MF_LEAF_MAX; c++ )
+                p->nCutCounts[c] += pThData[k].Man.nCutCounts[c];
+        }
+        // save the cuts
+        for ( k = 0; k < nNodes; k++ )
+        {
+            for ( c = 0; c < pnCuts[k]; c++ )
+                pCutsR[c] = pStore + k * nCutNum + c;
+            Mf_ManObj(p, Vec_IntEntry(vLevel, iBeg + k))->iCutSet = Mf_ManSaveCuts( p, pCutsR, pnCuts[k] );
+        }
+    }
+    ABC_FREE( pStore );
+    ABC_FREE( pnCuts );
+    ABC_FREE( pThData );
+    ABC_FREE( ppTasks );
+}
+
 /**Function*************************************************************
 
   Synopsis    [Technology mappping.]
@@ -1567,8 +1716,11 @@ static inline void Mf_ObjComputeBestCut( Mf_Man_t * p, int iObj )
 void Mf_ManComputeMapping( Mf_Man_t * p )
 {
     int i;
-    Gia_ManForEachAndId( p->pGia, i )
-        Mf_ObjComputeBestCut( p, i );
+    if ( p->vLevels && !p->fUseEla )
+        Mf_ManComputeLevels( p, 0 );
+    else
+        Gia_ManForEachAndId( p->pGia, i )
+            Mf_ObjComputeBestCut( p, i );
     Mf_ManSetMapRefs( p );
     Mf_ManPrintStats( p, (char *)(p->fUseEla ? "Ela  " : (p->Iter ? "Area " : "Delay")) );
 }
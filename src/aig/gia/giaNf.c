@@ -30,6 +30,7 @@
 #include "opt/dau/dau.h"
 #include "misc/util/utilNam.h"
 #include "map/scl/sclCon.h"
+#include "misc/util/utilPool.h"
 
 ABC_NAMESPACE_IMPL_START
 
@@ -42,11 +43,18 @@ ABC_NAMESPACE_IMPL_START
 #define NF_NO_LEAF  31
 #define NF_NO_FUNC  0x3FFFFFF
 #define NF_INFINITY (~(word)0)
+#define NF_PEND_FUNC 0x1FFFFFF      // function computed by a thread and not hashed yet
+
+// the smallest number of nodes of one level given to a thread
+#define NF_PAR_CHUNK_MIN    64
+// the largest number of nodes whose cuts are kept before saving
+#define NF_PAR_BATCH      8192
 
 typedef struct Nf_Cut_t_ Nf_Cut_t; 
 struct Nf_Cut_t_
 {
     word            Sign;           // signature
+    word            Truth;          // truth table (NF_PEND_FUNC)
     int             Delay;          // delay
     float           Flow;           // flow
     unsigned        iFunc   : 26;   // function (NF_NO_FUNC)
@@ -98,6 +106,8 @@ struct Nf_Man_t_
     Vec_Flt_t       vCutFlows;      // temporary cut area
     Vec_Int_t       vCutDelays;     // temporary cut delay
     Vec_Int_t       vBackup;        // backup literals
+    Vec_Wec_t *     vLevels;        // nodes by level (multi-threaded mode)
+    int             fPending;       // do not add new functions to the table
     int             iCur;           // current position
     int             Iter;           // mapping iterations
     int             fUseEla;        // use exact area
@@ -110,6 +120,18 @@ struct Nf_Man_t_
     int             nCutUseAll;     // objects with useful cuts
 };
 
+// the state of one thread processing the nodes of a level
+typedef struct Nf_ParThData_t_ Nf_ParThData_t;
+struct Nf_ParThData_t_
+{
+    Nf_Man_t        Man;            // private copy of the manager (statistics)
+    int *           pNodes;         // the nodes
+    int             nNodes;         // the number of nodes
+    Nf_Cut_t *      pCuts;          // the resulting cuts (nCutNum entries per node)
+    int *           pnCuts;         // the number of resulting cuts of each node (-1 for buffers)
+    int             fCuts;          // computing cuts vs. matching
+};
+
 static inline int          Nf_Cfg2Int( Nf_Cfg_t Mat )                                { union { int x; Nf_Cfg_t y; } v; v.y = Mat; return v.x;           }
 static inline Nf_Cfg_t     Nf_Int2Cfg( int Int )                                     { union { int x; Nf_Cfg_t y; } v; v.x = Int; return v.y;           }
 
@@ -155,6 +177,9 @@ static inline int          Nf_CfgCompl( Nf_Cfg_t Cfg, int i )
 #define Nf_SetForEachCut( pList, pCut, i )                   for ( i = 0, pCut = pList + 1; i < pList[0]; i++, pCut += Nf_CutSize(pCut) + 1 )
 #define Nf_CutForEachVarCompl( pCut, Cfg, iVar, fCompl, i )  for ( i = 0; i < Nf_CutSize(pCut) && (iVar = Nf_CutLeaves(pCut)[Nf_CfgVar(Cfg, i)]) && ((fCompl = Nf_CfgCompl(Cfg, i)), 1); i++ )
 #define Nf_CfgForEachVarCompl( Cfg, Size, iVar, fCompl, i )  for ( i = 0; i < Size && ((iVar = Nf_CfgVar(Cfg, i)), 1) && ((fCompl = Nf_CfgCompl(Cfg, i)), 1); i++ )
+
+extern Vec_Wec_t * Gia_ManLevelizeAnds( Gia_Man_t * p );
+static void        Nf_ManComputeLevels( Nf_Man_t * p, int fCuts );
 
 ////////////////////////////////////////////////////////////////////////
 ///                     FUNCTION DEFINITIONS                         ///
@@ -391,6 +416,7 @@ Nf_Man_t * Nf_StoCreate( Gia_Man_t * pGia, Jf_Par_t * pPars )
     Vec_FltFill( &p->vCutFlows, Gia_ManObjNum(pGia), 0 );              // cut area
     Vec_IntFill( &p->vCutDelays,Gia_ManObjNum(pGia), 0 );              // cut delay
     Vec_IntGrow( &p->vBackup, 1000 );
+    p->vLevels = pPars->nProcNum > 1 ? Gia_ManLevelizeAnds( pGia ) : NULL;
     // references
     vFlowRefs = Vec_IntAlloc(0);
     Mf_ManSetFlowRefs( pGia, vFlowRefs );
@@ -426,6 +452,7 @@ void Nf_StoDelete( Nf_Man_t * p )
     ABC_FREE( p->vCutDelays.pArray );
     ABC_FREE( p->vBackup.pArray );
     ABC_FREE( p->pNfObjs );
+    Vec_WecFreeP( &p->vLevels );
     // matching
     Vec_WecFree( p->vTt2Match );
     Vec_MemHashFree( p->vTtMem );
@@ -437,6 +464,42 @@ void Nf_StoDelete( Nf_Man_t * p )
 
 
 
+/**Function*************************************************************
+
+  Synopsis    [Finds the ID of the cut function.]
+
+  Description [In the multi-threaded mode, the table of functions is only
+  looked up. A function that is not in the table cannot be matched, because
+  the functions of the library gates are added before computing cuts, so
+  its cut is useless, and the function is added to the table later by
+  the calling thread (Nf_ManHashPending).]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline int Nf_CutHashTruth( Nf_Man_t * p, word t, Nf_Cut_t * pCutR )
+{
+    int truthId;
+    if ( !p->fPending )
+        return Vec_MemHashInsert( p->vTtMem, &t );
+    truthId = *Vec_MemHashLookup( p->vTtMem, &t );
+    if ( truthId >= 0 )
+        return truthId;
+    pCutR->Truth = t;
+    return NF_PEND_FUNC;
+}
+static inline void Nf_ManHashPending( Nf_Man_t * p, Nf_Cut_t * pCut )
+{
+    int truthId;
+    if ( Abc_Lit2Var(pCut->iFunc) != NF_PEND_FUNC )
+        return;
+    truthId = Vec_MemHashInsert( p->vTtMem, &pCut->Truth );
+    assert( pCut->Useless && Nf_ObjCutUseless(p, truthId) );
+    pCut->iFunc = Abc_Var2Lit( truthId, Abc_LitIsCompl(pCut->iFunc) );
+}
+
 /**Function*************************************************************
 
   Synopsis    []
@@ -462,7 +525,7 @@ static inline int Nf_CutComputeTruth6( Nf_Man_t * p, Nf_Cut_t * pCut0, Nf_Cut_t
     if ( (fCompl = (int)(t & 1)) ) t = ~t;
     pCutR->nLeaves = Abc_Tt6MinBase( &t, pCutR->pLeaves, pCutR->nLeaves );
     assert( (int)(t & 1) == 0 );
-    truthId        = Vec_MemHashInsert(p->vTtMem, &t);
+    truthId        = Nf_CutHashTruth(p, t, pCutR);
     pCutR->iFunc   = Abc_Var2Lit( truthId, fCompl );
     pCutR->Useless = Nf_ObjCutUseless( p, truthId );
     assert( (int)pCutR->nLeaves <= nOldSupp );
@@ -484,7 +547,7 @@ static inline int Nf_CutComputeTruthMux6( Nf_Man_t * p, Nf_Cut_t * pCut0, Nf_Cut
     if ( (fCompl = (int)(t & 1)) ) t = ~t;
     pCutR->nLeaves = Abc_Tt6MinBase( &t, pCutR->pLeaves, pCutR->nLeaves );
     assert( (int)(t & 1) == 0 );
-    truthId        = Vec_MemHashInsert(p->vTtMem, &t);
+    truthId        = Nf_CutHashTruth(p, t, pCutR);
     pCutR->iFunc   = Abc_Var2Lit( truthId, fCompl );
     pCutR->Useless = Nf_ObjCutUseless( p, truthId );
     assert( (int)pCutR->nLeaves <= nOldSupp );
@@ -859,9 +922,9 @@ static inline void Nf_CutParams( Nf_Man_t * p, Nf_Cut_t * pCut, float FlowRefs )
     pCut->Delay += (int)(nLeaves > 1);
     pCut->Flow = (pCut->Flow + Nf_CutArea(p, nLeaves)) / FlowRefs;
 }
-void Nf_ObjMergeOrder( Nf_Man_t * p, int iObj )
+static inline int Nf_ObjComputeCuts( Nf_Man_t * p, int iObj, Nf_Cut_t * pCuts, Nf_Cut_t ** pCutsR )
 {
-    Nf_Cut_t pCuts0[NF_CUT_MAX], pCuts1[NF_CUT_MAX], pCuts[NF_CUT_MAX], * pCutsR[NF_CUT_MAX];
+    Nf_Cut_t pCuts0[NF_CUT_MAX], pCuts1[NF_CUT_MAX];
     Gia_Obj_t * pObj = Gia_ManObj(p->pGia, iObj);
     //Nf_Obj_t * pBest = Nf_ManObj(p, iObj);
     float dFlowRefs  = Nf_ObjFlowRefs(p, iObj, 0) + Nf_ObjFlowRefs(p, iObj, 1);
@@ -951,19 +1014,30 @@ void Nf_ObjMergeOrder( Nf_Man_t * p, int iObj )
     // verify
     assert( nCutsR > 0 && nCutsR < nCutNum );
 //    assert( Nf_SetCheckArray(pCutsR, nCutsR) );
-    // store the cutset
+    // store the best cut
     Nf_ObjSetCutFlow( p, iObj, pCutsR[0]->Flow );
     Nf_ObjSetCutDelay( p, iObj, pCutsR[0]->Delay );
-    *Vec_IntEntryP(&p->vCutSets, iObj) = Nf_ManSaveCuts(p, pCutsR, nCutsR, 0);
     p->CutCount[3] += nCutsR;
     nCutsUse = Nf_ManCountUseful(pCutsR, nCutsR);
     p->CutCount[4] += nCutsUse;
     p->nCutUseAll  += nCutsUse == nCutsR;
     p->CutCount[5] += Nf_ManCountMatches(p, pCutsR, nCutsR);
+    return nCutsR;
+}
+void Nf_ObjMergeOrder( Nf_Man_t * p, int iObj )
+{
+    Nf_Cut_t pCuts[NF_CUT_MAX], * pCutsR[NF_CUT_MAX];
+    int nCutsR = Nf_ObjComputeCuts( p, iObj, pCuts, pCutsR );
+    *Vec_IntEntryP(&p->vCutSets, iObj) = Nf_ManSaveCuts(p, pCutsR, nCutsR, 0);
 }
 void Nf_ManComputeCuts( Nf_Man_t * p )
 {
     Gia_Obj_t * pObj; int i, iFanin;
+    if ( p->vLevels )
+    {
+        Nf_ManComputeLevels( p, 1 );
+        return;
+    }
     Gia_ManForEachAnd( p->pGia, pObj, i )
         if ( Gia_ObjIsBuf(pObj) )
         {
@@ -1018,6 +1092,8 @@ void Nf_ManPrintInit( Nf_Man_t * p )
     nChoices = Gia_ManChoiceNum( p->pGia );
     if ( nChoices )
     printf( "Choices = %d  ", nChoices );
+    if ( p->vLevels )
+    printf( "Threads = %d  ", p->pPars->nProcNum );
     printf( "\n" );
     printf( "Computing cuts...\r" );
     fflush( stdout );
@@ -1385,9 +1461,146 @@ void Nf_ManCutMatch( Nf_Man_t * p, int iObj )
     }
 */
 }
+
+/**Function*************************************************************
+
+  Synopsis    [Processes a range of nodes of one level.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void * Nf_ManLevelTask( void * pArg, Abc_Task_t * pTask )
+{
+    Nf_ParThData_t * pThData = (Nf_ParThData_t *)pArg;
+    Nf_Man_t * p = &pThData->Man;
+    Nf_Cut_t pCuts[NF_CUT_MAX], * pCutsR[NF_CUT_MAX];
+    Gia_Obj_t * pObj;
+    int i, k, iObj, iFanin, nCutNum = p->pPars->nCutNum;
+    for ( i = 0; i < pThData->nNodes; i++ )
+    {
+        iObj = pThData->pNodes[i];
+        pObj = Gia_ManObj( p->pGia, iObj );
+        if ( !pThData->fCuts )
+        {
+            if ( Gia_ObjIsBuf(pObj) )
+                Nf_ObjPrepareBuf( p, pObj );
+            else
+                Nf_ManCutMatch( p, iObj );
+            continue;
+        }
+        if ( Gia_ObjIsBuf(pObj) )
+        {
+            iFanin = Gia_ObjFaninId0(pObj, iObj);
+            Nf_ObjSetCutFlow( p, iObj,  Nf_ObjCutFlow(p, iFanin) );
+            Nf_ObjSetCutDelay( p, iObj, Nf_ObjCutDelay(p, iFanin) );
+            pThData->pnCuts[i] = -1;
+            continue;
+        }
+        pThData->pnCuts[i] = Nf_ObjComputeCuts( p, iObj, pCuts, pCutsR );
+        for ( k = 0; k < pThData->pnCuts[i]; k++ )
+            pThData->pCuts[i * nCutNum + k] = *pCutsR[k];
+    }
+    return NULL;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Computes cuts or matches of the nodes level by level.]
+
+  Description [The nodes of one level depend only on the nodes of the
+  previous levels, so they are processed in parallel. Each thread works
+  with a private copy of the manager, which differs only in the statistics
+  and in that the new cut functions are not added to the shared table.
+  The calling thread adds these functions and stores the cuts in the order
+  of nodes. The IDs of the functions that cannot be matched may differ from
+  those in the single-threaded mode, but the cuts and the matches do not
+  depend on the number of threads. Exact area recovery is sequential
+  because it references and dereferences the matches of the fanins.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Nf_ManComputeLevels( Nf_Man_t * p, int fCuts )
+{
+    Nf_ParThData_t * pThData;
+    Abc_Task_t ** ppTasks;
+    Vec_Int_t * vLevel;
+    Nf_Cut_t * pStore = NULL, * pCutsR[NF_CUT_MAX];
+    int * pnCuts = NULL, nThreads = p->pPars->nProcNum, nCutNum = p->pPars->nCutNum;
+    int i, k, c, iStart, iBeg, nNodes, nTasks;
+    assert( p->vLevels != NULL && !p->fUseEla );
+    if ( fCuts )
+    {
+        pStore = ABC_ALLOC( Nf_Cut_t, NF_PAR_BATCH * nCutNum );
+        pnCuts = ABC_ALLOC( int, NF_PAR_BATCH );
+    }
+    pThData = ABC_ALLOC( Nf_ParThData_t, nThreads );
+    ppTasks = ABC_ALLOC( Abc_Task_t *, nThreads );
+    Vec_WecForEachLevel( p->vLevels, vLevel, i )
+    for ( iBeg = 0; iBeg < Vec_IntSize(vLevel); iBeg += NF_PAR_BATCH )
+    {
+        nNodes = Abc_MinInt( NF_PAR_BATCH, Vec_IntSize(vLevel) - iBeg );
+        nTasks = Abc_MinInt( nThreads, Abc_MaxInt(1, nNodes / NF_PAR_CHUNK_MIN) );
+        for ( k = 0; k < nTasks; k++ )
+        {
+            // the copy is refreshed because the page array may have been reallocated
+            pThData[k].Man = *p;
+            pThData[k].Man.fPending   = 1;
+            pThData[k].Man.nCutUseAll = 0;
+            memset( pThData[k].Man.CutCount, 0, sizeof(p->CutCount) );
+            iStart = (int)((ABC_INT64_T)nNodes * k / nTasks);
+            pThData[k].pNodes = Vec_IntArray(vLevel) + iBeg + iStart;
+            pThData[k].nNodes = (int)((ABC_INT64_T)nNodes * (k + 1) / nTasks) - iStart;
+            pThData[k].pCuts  = fCuts ? pStore + iStart * nCutNum : NULL;
+            pThData[k].pnCuts = fCuts ? pnCuts + iStart : NULL;
+            pThData[k].fCuts  = fCuts;
+        }
+        for ( k = 1; k < nTasks; k++ )
+            ppTasks[k] = Abc_TaskSubmit( Nf_ManLevelTask, pThData + k );
+        Nf_ManLevelTask( pThData, NULL );
+        for ( k = 1; k < nTasks; k++ )
+            Abc_TaskWait( ppTasks[k] );
+        if ( !fCuts )
+            continue;
+        // collect statistics
+        for ( k = 0; k < nTasks; k++ )
+        {
+            for ( c = 0; c < 6; c++ )
+                p->CutCount[c] += pThData[k].Man.CutCount[c];
+            p->nCutUseAll += pThData[k].Man.nCutUseAll;
+        }
+        // hash the new functions and save the cuts
+        for ( k = 0; k < nNodes; k++ )
+        {
+            if ( pnCuts[k] == -1 )
+                continue;
+            for ( c = 0; c < pnCuts[k]; c++ )
+            {
+                pCutsR[c] = pStore + k * nCutNum + c;
+                Nf_ManHashPending( p, pCutsR[c] );
+            }
+            *Vec_IntEntryP(&p->vCutSets, Vec_IntEntry(vLevel, iBeg + k)) = Nf_ManSaveCuts( p, pCutsR, pnCuts[k], 0 );
+        }
+    }
+    ABC_FREE( pStore );
+    ABC_FREE( pnCuts );
+    ABC_FREE( pThData );
+    ABC_FREE( ppTasks );
+}
 void Nf_ManComputeMapping( Nf_Man_t * p )
 {
     Gia_Obj_t * pObj; int i;
+    if ( p->vLevels )
+    {
+        Nf_ManComputeLevels( p, 0 );
+        return;
+    }
     Gia_ManForEachAnd( p->pGia, pObj, i )
         if ( Gia_ObjIsBuf(pObj) )
             Nf_ObjPrepareBuf( p, pObj );
@@ -19,6 +19,7 @@
 ***********************************************************************/
 
 #include "gia.h"
+#include "misc/util/utilPool.h"
 
 ABC_NAMESPACE_IMPL_START
 
@@ -35,6 +36,34 @@ unsigned * Gia_SimDataExt( Gia_ManSim_t * p, int i )    { return Gia_SimData(p,
 unsigned * Gia_SimDataCiExt( Gia_ManSim_t * p, int i )  { return Gia_SimDataCi(p, i);  }
 unsigned * Gia_SimDataCoExt( Gia_ManSim_t * p, int i )  { return Gia_SimDataCo(p, i);  }
 
+// simulation kernel computing pOut[w] = (p0[w] ^ m0) & (p1[w] ^ m1) for 0 <= w < nWords
+typedef void (*Gia_ManSimAnd_f)( unsigned * pOut, unsigned * p0, unsigned * p1, unsigned m0, unsigned m1, int nWords );
+
+// the SIMD kernels need GCC/Clang target attributes and are selected at runtime
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && (__GNUC__ >= 5 || defined(__clang__))
+#define GIA_SIM_USE_SIMD
+#include <immintrin.h>
+#endif
+
+// the simulation info of one traversal is kept within this many bytes
+#define GIA_SIM_BLOCK_BYTES  (1 << 18)
+
+// the max number of simulation threads
+#define GIA_SIM_THREAD_MAX   64
+
+// the data of one simulation thread
+typedef struct Gia_SimThData_t_ Gia_SimThData_t;
+struct Gia_SimThData_t_
+{
+    Gia_ManSimRange_f pFunc;
+    void *            pMan;
+    int               w0;
+    int               w1;
+};
+
+static Gia_ManSimAnd_f s_SimAndFunc = NULL;
+static const char *    s_SimAndName = NULL;
+
 ////////////////////////////////////////////////////////////////////////
 ///                     FUNCTION DEFINITIONS                         ///
 ////////////////////////////////////////////////////////////////////////
@@ -170,6 +199,7 @@ void Gia_ManSimSetDefaultParams( Gia_ParSim_t * p )
     p->RandSeed     =   0;    // the seed to generate random numbers
     p->TimeLimit    =  60;    // time limit in seconds
     p->fCheckMiter  =   0;    // check if miter outputs are non-zero 
+    p->nThreads     =   1;    // the number of simulation threads
     p->fVerbose     =   0;    // enables verbose output
     p->iOutFail     =  -1;    // index of the failed output
 }
@@ -336,51 +366,151 @@ static inline void Gia_ManSimInfoCopy( Gia_ManSim_t * p, unsigned * pInfo, unsig
 
 /**Function*************************************************************
 
-  Synopsis    []
+  Synopsis    [Simulation kernels.]
 
-  Description []
+  Description [The portable kernel works on 64-bit words when the data
+  is 64-bit aligned. The AVX2 and AVX-512 kernels process 256 and 512
+  bits at a time and fall back to the portable code for the tail.]
                
   SideEffects []
 
   SeeAlso     []
 
 ***********************************************************************/
-static inline void Gia_ManSimulateCi( Gia_ManSim_t * p, Gia_Obj_t * pObj, int iCi )
+static void Gia_ManSimAndWord( unsigned * pOut, unsigned * p0, unsigned * p1, unsigned m0, unsigned m1, int nWords )
 {
-    unsigned * pInfo  = Gia_SimData( p, Gia_ObjValue(pObj) );
-    unsigned * pInfo0 = Gia_SimDataCi( p, iCi );
+    int w = 0;
+    if ( ((((ABC_PTRUINT_T)pOut) | ((ABC_PTRUINT_T)p0) | ((ABC_PTRUINT_T)p1)) & 7) == 0 )
+    {
+        word * pOut64 = (word *)pOut, * p064 = (word *)p0, * p164 = (word *)p1;
+        word   m064 = ((word)m0 << 32) | m0, m164 = ((word)m1 << 32) | m1;
+        for ( ; 2*w + 1 < nWords; w++ )
+            pOut64[w] = (p064[w] ^ m064) & (p164[w] ^ m164);
+        w *= 2;
+    }
+    for ( ; w < nWords; w++ )
+        pOut[w] = (p0[w] ^ m0) & (p1[w] ^ m1);
+}
+#ifdef GIA_SIM_USE_SIMD
+__attribute__((target("avx2")))
+static void Gia_ManSimAndAvx2( unsigned * pOut, unsigned * p0, unsigned * p1, unsigned m0, unsigned m1, int nWords )
+{
+    __m256i M0 = _mm256_set1_epi32( (int)m0 );
+    __m256i M1 = _mm256_set1_epi32( (int)m1 );
     int w;
-    for ( w = p->nWords-1; w >= 0; w-- )
-        pInfo[w] = pInfo0[w];
+    for ( w = 0; w + 8 <= nWords; w += 8 )
+    {
+        __m256i A = _mm256_xor_si256( _mm256_loadu_si256((__m256i *)(p0 + w)), M0 );
+        __m256i B = _mm256_xor_si256( _mm256_loadu_si256((__m256i *)(p1 + w)), M1 );
+        _mm256_storeu_si256( (__m256i *)(pOut + w), _mm256_and_si256(A, B) );
+    }
+    if ( w < nWords )
+        Gia_ManSimAndWord( pOut + w, p0 + w, p1 + w, m0, m1, nWords - w );
 }
+__attribute__((target("avx512f")))
+static void Gia_ManSimAndAvx512( unsigned * pOut, unsigned * p0, unsigned * p1, unsigned m0, unsigned m1, int nWords )
+{
+    __m512i M0 = _mm512_set1_epi32( (int)m0 );
+    __m512i M1 = _mm512_set1_epi32( (int)m1 );
+    int w;
+    for ( w = 0; w + 16 <= nWords; w += 16 )
+    {
+        __m512i A = _mm512_xor_si512( _mm512_loadu_si512((void *)(p0 + w)), M0 );
+        __m512i B = _mm512_xor_si512( _mm512_loadu_si512((void *)(p1 + w)), M1 );
+        _mm512_storeu_si512( (void *)(pOut + w), _mm512_and_si512(A, B) );
+    }
+    if ( w < nWords )
+        Gia_ManSimAndWord( pOut + w, p0 + w, p1 + w, m0, m1, nWords - w );
+}
+#endif
 
 /**Function*************************************************************
 
-  Synopsis    []
+  Synopsis    [Selects the simulation kernel supported by the CPU.]
 
-  Description []
+  Description [Returns the name of the kernel.]
                
   SideEffects []
 
   SeeAlso     []
 
 ***********************************************************************/
-static inline void Gia_ManSimulateCo( Gia_ManSim_t * p, int iCo, Gia_Obj_t * pObj )
+const char * Gia_ManSimSelectKernel()
 {
-    unsigned * pInfo  = Gia_SimDataCo( p, iCo );
-    unsigned * pInfo0 = Gia_SimData( p, Gia_ObjDiff0(pObj) );
-    int w;
-    if ( Gia_ObjFaninC0(pObj) )
-        for ( w = p->nWords-1; w >= 0; w-- )
-            pInfo[w] = ~pInfo0[w];
-    else 
-        for ( w = p->nWords-1; w >= 0; w-- )
-            pInfo[w] = pInfo0[w];
+    if ( s_SimAndFunc )
+        return s_SimAndName;
+    s_SimAndFunc = Gia_ManSimAndWord;
+    s_SimAndName = "64-bit";
+#ifdef GIA_SIM_USE_SIMD
+    __builtin_cpu_init();
+    if ( __builtin_cpu_supports("avx512f") )
+    {
+        s_SimAndFunc = Gia_ManSimAndAvx512;
+        s_SimAndName = "AVX-512";
+    }
+    else if ( __builtin_cpu_supports("avx2") )
+    {
+        s_SimAndFunc = Gia_ManSimAndAvx2;
+        s_SimAndName = "AVX2";
+    }
+#endif
+    return s_SimAndName;
 }
 
 /**Function*************************************************************
 
-  Synopsis    []
+  Synopsis    [Calls pFunc for the word ranges of nThreads threads.]
+
+  Description [Splits words 0 <= w < nWords into contiguous ranges whose
+  boundaries are multiples of nAlign and calls pFunc( pMan, w0, w1 ) for
+  each range in a separate pool task; the first range is processed by the 
+  calling thread. Since the simulation of one pattern word does not depend
+  on other words, the tasks write disjoint parts of the simulation info,
+  including the CO signatures, and need no locking. Returns after all 
+  ranges are done. Without pthreads, the ranges are processed in order.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void * Gia_ManSimWorkerTask( void * pArg, Abc_Task_t * pTask )
+{
+    Gia_SimThData_t * pTh = (Gia_SimThData_t *)pArg;
+    pTh->pFunc( pTh->pMan, pTh->w0, pTh->w1 );
+    return NULL;
+}
+void Gia_ManSimRunRanges( Gia_ManSimRange_f pFunc, void * pMan, int nWords, int nThreads, int nAlign )
+{
+    Gia_SimThData_t ThData[GIA_SIM_THREAD_MAX];
+    Abc_Task_t * pTasks[GIA_SIM_THREAD_MAX];
+    int i, nRange;
+    assert( nAlign > 0 );
+    nThreads = Abc_MaxInt( 1, Abc_MinInt(nThreads, GIA_SIM_THREAD_MAX) );
+    nThreads = Abc_MinInt( nThreads, (nWords + nAlign - 1) / nAlign );
+    if ( nThreads <= 1 )
+    {
+        pFunc( pMan, 0, nWords );
+        return;
+    }
+    nRange = ((nWords + nThreads - 1) / nThreads + nAlign - 1) / nAlign * nAlign;
+    for ( i = 0; i < nThreads; i++ )
+    {
+        ThData[i].pFunc = pFunc;
+        ThData[i].pMan  = pMan;
+        ThData[i].w0    = Abc_MinInt( i * nRange, nWords );
+        ThData[i].w1    = Abc_MinInt( (i + 1) * nRange, nWords );
+    }
+    for ( i = 1; i < nThreads; i++ )
+        pTasks[i] = Abc_TaskSubmit( Gia_ManSimWorkerTask, ThData + i );
+    pFunc( pMan, ThData[0].w0, ThData[0].w1 );
+    for ( i = 1; i < nThreads; i++ )
+        Abc_TaskWait( pTasks[i] );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Simulates one object for words w0 <= w < w1.]
 
   Description []
                
@@ -389,30 +519,36 @@ static inline void Gia_ManSimulateCo( Gia_ManSim_t * p, int iCo, Gia_Obj_t * pOb
   SeeAlso     []
 
 ***********************************************************************/
-static inline void Gia_ManSimulateNode( Gia_ManSim_t * p, Gia_Obj_t * pObj )
+static inline void Gia_ManSimulateCi( Gia_ManSim_t * p, Gia_Obj_t * pObj, int iCi, int w0, int w1 )
 {
     unsigned * pInfo  = Gia_SimData( p, Gia_ObjValue(pObj) );
+    unsigned * pInfo0 = Gia_SimDataCi( p, iCi );
+    memcpy( pInfo + w0, pInfo0 + w0, sizeof(unsigned) * (w1 - w0) );
+}
+static inline void Gia_ManSimulateCo( Gia_ManSim_t * p, int iCo, Gia_Obj_t * pObj, int w0, int w1 )
+{
+    unsigned * pInfo  = Gia_SimDataCo( p, iCo );
     unsigned * pInfo0 = Gia_SimData( p, Gia_ObjDiff0(pObj) );
-    unsigned * pInfo1 = Gia_SimData( p, Gia_ObjDiff1(pObj) );
     int w;
     if ( Gia_ObjFaninC0(pObj) )
-    {
-        if (  Gia_ObjFaninC1(pObj) )
-            for ( w = p->nWords-1; w >= 0; w-- )
-                pInfo[w] = ~(pInfo0[w] | pInfo1[w]);
-        else 
-            for ( w = p->nWords-1; w >= 0; w-- )
-                pInfo[w] = ~pInfo0[w] & pInfo1[w];
-    }
+        for ( w = w0; w < w1; w++ )
+            pInfo[w] = ~pInfo0[w];
     else 
-    {
-        if (  Gia_ObjFaninC1(pObj) )
-            for ( w = p->nWords-1; w >= 0; w-- )
-                pInfo[w] = pInfo0[w] & ~pInfo1[w];
-        else 
-            for ( w = p->nWords-1; w >= 0; w-- )
-                pInfo[w] = pInfo0[w] & pInfo1[w];
-    }
+        memcpy( pInfo + w0, pInfo0 + w0, sizeof(unsigned) * (w1 - w0) );
+}
+static inline void Gia_ManSimulateNode( Gia_ManSim_t * p, Gia_Obj_t * pObj, int w0, int w1 )
+{
+    unsigned * pInfo  = Gia_SimData( p, Gia_ObjValue(pObj) );
+    unsigned * pInfo0 = Gia_SimData( p, Gia_ObjDiff0(pObj) );
+    unsigned * pInfo1 = Gia_SimData( p, Gia_ObjDiff1(pObj) );
+    unsigned   m0 = Gia_ObjFaninC0(pObj) ? ~0 : 0;
+    unsigned   m1 = Gia_ObjFaninC1(pObj) ? ~0 : 0;
+    int w;
+    if ( w1 - w0 >= 16 )
+        s_SimAndFunc( pInfo + w0, pInfo0 + w0, pInfo1 + w0, m0, m1, w1 - w0 );
+    else // short ranges are not worth the call
+        for ( w = w0; w < w1; w++ )
+            pInfo[w] = (pInfo0[w] ^ m0) & (pInfo1[w] ^ m1);
 }
 
 /**Function*************************************************************
@@ -463,42 +599,57 @@ void Gia_ManSimInfoTransfer( Gia_ManSim_t * p )
 
 /**Function*************************************************************
 
-  Synopsis    []
+  Synopsis    [Simulates one round.]
 
-  Description []
+  Description [Gia_ManSimulateRange() simulates words wStart <= w < wStop
+  of all objects.]
                
   SideEffects []
 
   SeeAlso     []
 
 ***********************************************************************/
-void Gia_ManSimulateRound( Gia_ManSim_t * p )
+static void Gia_ManSimulateRange( void * pMan, int wStart, int wStop )
 {
+    Gia_ManSim_t * p = (Gia_ManSim_t *)pMan;
     Gia_Obj_t * pObj;
-    int i, iCis = 0, iCos = 0;
-    assert( p->pAig->nFront > 0 );
-    assert( Gia_ManConst0(p->pAig)->Value == 0 );
-    Gia_ManSimInfoZero( p, Gia_SimData(p, 0) );
-    Gia_ManForEachObj1( p->pAig, pObj, i )
+    int i, iCis, iCos, w0, w1, nBlock;
+    // simulate the words in blocks, so that the frontier of one block stays in cache
+    nBlock = Abc_MaxInt( 16, (GIA_SIM_BLOCK_BYTES / (int)sizeof(unsigned) / p->pAig->nFront) & ~15 );
+    for ( w0 = wStart; w0 < wStop; w0 = w1 )
     {
-        if ( Gia_ObjIsAndOrConst0(pObj) )
-        {
-            assert( Gia_ObjValue(pObj) < p->pAig->nFront );
-            Gia_ManSimulateNode( p, pObj );
-        }
-        else if ( Gia_ObjIsCo(pObj) )
-        {
-            assert( Gia_ObjValue(pObj) == GIA_NONE );
-            Gia_ManSimulateCo( p, iCos++, pObj );
-        }
-        else // if ( Gia_ObjIsCi(pObj) )
+        w1 = Abc_MinInt( w0 + nBlock, wStop );
+        iCis = iCos = 0;
+        Gia_ManForEachObj1( p->pAig, pObj, i )
         {
-            assert( Gia_ObjValue(pObj) < p->pAig->nFront );
-            Gia_ManSimulateCi( p, pObj, iCis++ );
+            if ( Gia_ObjIsAndOrConst0(pObj) )
+            {
+                assert( Gia_ObjValue(pObj) < p->pAig->nFront );
+                Gia_ManSimulateNode( p, pObj, w0, w1 );
+            }
+            else if ( Gia_ObjIsCo(pObj) )
+            {
+                assert( Gia_ObjValue(pObj) == GIA_NONE );
+                Gia_ManSimulateCo( p, iCos++, pObj, w0, w1 );
+            }
+            else // if ( Gia_ObjIsCi(pObj) )
+            {
+                assert( Gia_ObjValue(pObj) < p->pAig->nFront );
+                Gia_ManSimulateCi( p, pObj, iCis++, w0, w1 );
+            }
         }
+        assert( Gia_ManCiNum(p->pAig) == iCis );
+        assert( Gia_ManCoNum(p->pAig) == iCos );
     }
-    assert( Gia_ManCiNum(p->pAig) == iCis );
-    assert( Gia_ManCoNum(p->pAig) == iCos );
+}
+void Gia_ManSimulateRound( Gia_ManSim_t * p )
+{
+    assert( p->pAig->nFront > 0 );
+    assert( Gia_ManConst0(p->pAig)->Value == 0 );
+    if ( s_SimAndFunc == NULL )
+        Gia_ManSimSelectKernel();
+    Gia_ManSimInfoZero( p, Gia_SimData(p, 0) );
+    Gia_ManSimRunRanges( Gia_ManSimulateRange, p, p->nWords, p->pPars->nThreads, 16 );
 }
 
 /**Function*************************************************************
@@ -600,6 +751,7 @@ int Gia_ManSimSimulate( Gia_Man_t * pAig, Gia_ParSim_t * pPars )
     extern int Gia_ManSimSimulateEquiv( Gia_Man_t * pAig, Gia_ParSim_t * pPars );
     Gia_ManSim_t * p;
     abctime clkTotal = Abc_Clock();
+    abctime clkWall = Abc_ThreadClock(); // the rates include the work of the other threads
     int i, iOut, iPat, RetValue = 0;
     abctime nTimeToStop = pPars->TimeLimit ? pPars->TimeLimit * CLOCKS_PER_SEC + Abc_Clock(): 0;
     if ( pAig->pReprs && pAig->pNexts )
@@ -646,6 +798,13 @@ int Gia_ManSimSimulate( Gia_Man_t * pAig, Gia_ParSim_t * pPars )
         if ( i < pPars->nIters - 1 )
             Gia_ManSimInfoTransfer( p );
     }
+    if ( pPars->fVerbose )
+    {
+        double Time = 1.0*(Abc_ThreadClock() - clkWall)/CLOCKS_PER_SEC;
+        double nPats = 32.0 * p->nWords * (pAig->pCexSeq ? i + 1 : i);
+        Abc_Print( 1, "Simulated %.0f patterns using %s kernel and %d thread(s): %.2f M patterns/sec, %.2f G node-patterns/sec.\n", 
+            nPats, Gia_ManSimSelectKernel(), Abc_MaxInt(1, pPars->nThreads), Time > 0 ? nPats / Time / 1e6 : 0.0, Time > 0 ? nPats * Gia_ManAndNum(pAig) / Time / 1e9 : 0.0 );
+    }
     Gia_ManSimDelete( p );
     if ( pAig->pCexSeq == NULL )
         Abc_Print( 1, "No bug detected after simulating %d frames with %d words.  ", i, pPars->nWords );
@@ -188,16 +188,16 @@ static inline void Gia_Sim2InfoCopy( Gia_Sim2_t * p, unsigned * pInfo, unsigned
   SeeAlso     []
 
 ***********************************************************************/
-static inline void Gia_Sim2SimulateCo( Gia_Sim2_t * p, Gia_Obj_t * pObj )
+static inline void Gia_Sim2SimulateCo( Gia_Sim2_t * p, Gia_Obj_t * pObj, int w0, int w1 )
 {
     unsigned * pInfo  = Gia_Sim2Data( p, Gia_ObjValue(pObj) );
     unsigned * pInfo0 = Gia_Sim2Data( p, Gia_ObjFaninId0(pObj, Gia_ObjValue(pObj)) );
     int w;
     if ( Gia_ObjFaninC0(pObj) )
-        for ( w = p->nWords-1; w >= 0; w-- )
+        for ( w = w0; w < w1; w++ )
             pInfo[w] = ~pInfo0[w];
     else 
-        for ( w = p->nWords-1; w >= 0; w-- )
+        for ( w = w0; w < w1; w++ )
             pInfo[w] = pInfo0[w];
 }
 
@@ -212,7 +212,7 @@ static inline void Gia_Sim2SimulateCo( Gia_Sim2_t * p, Gia_Obj_t * pObj )
   SeeAlso     []
 
 ***********************************************************************/
-static inline void Gia_Sim2SimulateNode( Gia_Sim2_t * p, Gia_Obj_t * pObj )
+static inline void Gia_Sim2SimulateNode( Gia_Sim2_t * p, Gia_Obj_t * pObj, int w0, int w1 )
 {
     unsigned * pInfo  = Gia_Sim2Data( p, Gia_ObjValue(pObj) );
     unsigned * pInfo0 = Gia_Sim2Data( p, Gia_ObjFaninId0(pObj, Gia_ObjValue(pObj)) );
@@ -221,19 +221,19 @@ static inline void Gia_Sim2SimulateNode( Gia_Sim2_t * p, Gia_Obj_t * pObj )
     if ( Gia_ObjFaninC0(pObj) )
     {
         if (  Gia_ObjFaninC1(pObj) )
-            for ( w = p->nWords-1; w >= 0; w-- )
+            for ( w = w0; w < w1; w++ )
                 pInfo[w] = ~(pInfo0[w] | pInfo1[w]);
         else 
-            for ( w = p->nWords-1; w >= 0; w-- )
+            for ( w = w0; w < w1; w++ )
                 pInfo[w] = ~pInfo0[w] & pInfo1[w];
     }
     else 
     {
         if (  Gia_ObjFaninC1(pObj) )
-            for ( w = p->nWords-1; w >= 0; w-- )
+            for ( w = w0; w < w1; w++ )
                 pInfo[w] = pInfo0[w] & ~pInfo1[w];
         else 
-            for ( w = p->nWords-1; w >= 0; w-- )
+            for ( w = w0; w < w1; w++ )
                 pInfo[w] = pInfo0[w] & pInfo1[w];
     }
 }
@@ -273,6 +273,19 @@ static inline void Gia_Sim2InfoTransfer( Gia_Sim2_t * p )
   SeeAlso     []
 
 ***********************************************************************/
+static void Gia_Sim2SimulateRange( void * pMan, int w0, int w1 )
+{
+    Gia_Sim2_t * p = (Gia_Sim2_t *)pMan;
+    Gia_Obj_t * pObj;
+    int i;
+    Gia_ManForEachAnd( p->pAig, pObj, i )
+    {
+        assert( Gia_ObjValue(pObj) == i );
+        Gia_Sim2SimulateNode( p, pObj, w0, w1 );
+    }
+    Gia_ManForEachCo( p->pAig, pObj, i )
+        Gia_Sim2SimulateCo( p, pObj, w0, w1 );
+}
 static inline void Gia_Sim2SimulateRound( Gia_Sim2_t * p )
 {
     Gia_Obj_t * pObj;
@@ -280,15 +293,10 @@ static inline void Gia_Sim2SimulateRound( Gia_Sim2_t * p )
     pObj = Gia_ManConst0(p->pAig);
     assert( Gia_ObjValue(pObj) == 0 );
     Gia_Sim2InfoZero( p, Gia_Sim2Data(p, Gia_ObjValue(pObj)) );
+    // random patterns are generated by one thread to keep them reproducible
     Gia_ManForEachPi( p->pAig, pObj, i )
         Gia_Sim2InfoRandom( p, Gia_Sim2Data(p, Gia_ObjValue(pObj)) );
-    Gia_ManForEachAnd( p->pAig, pObj, i )
-    {
-        assert( Gia_ObjValue(pObj) == i );
-        Gia_Sim2SimulateNode( p, pObj );
-    }
-    Gia_ManForEachCo( p->pAig, pObj, i )
-        Gia_Sim2SimulateCo( p, pObj );
+    Gia_ManSimRunRanges( Gia_Sim2SimulateRange, p, p->nWords, p->pPars->nThreads, 16 );
 }
 
 
@@ -1821,6 +1821,54 @@ int Abc_NtkDSat( Abc_Ntk_t * pNtk, ABC_INT64_T nConfLimit, ABC_INT64_T nInsLimit
     return RetValue;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Solves combinational miter using a portfolio of SAT solvers.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Abc_NtkDSatPortfolio( Abc_Ntk_t * pNtk, Sat_PortPars_t * pPars )
+{
+    Aig_Man_t * pMan;
+    int RetValue;
+    assert( Abc_NtkIsStrash(pNtk) );
+    assert( Abc_NtkLatchNum(pNtk) == 0 );
+    pMan = Abc_NtkToDar( pNtk, 0, 0 );
+    RetValue = Fra_FraigSatPortfolio( pMan, pPars ); 
+    pNtk->pModel = (int *)pMan->pData, pMan->pData = NULL;
+    Aig_ManStop( pMan );
+    return RetValue;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Solves combinational miter after CNF preprocessing.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Abc_NtkDSatElim( Abc_Ntk_t * pNtk, ABC_INT64_T nConfLimit, ABC_INT64_T nInsLimit, int fVerbose )
+{
+    Aig_Man_t * pMan;
+    int RetValue;
+    assert( Abc_NtkIsStrash(pNtk) );
+    assert( Abc_NtkLatchNum(pNtk) == 0 );
+    pMan = Abc_NtkToDar( pNtk, 0, 0 );
+    RetValue = Fra_FraigSatElim( pMan, nConfLimit, nInsLimit, fVerbose ); 
+    pNtk->pModel = (int *)pMan->pData, pMan->pData = NULL;
+    Aig_ManStop( pMan );
+    return RetValue;
+}
+
 /**Function*************************************************************
 
   Synopsis    [Solves combinational miter using a SAT solver.]
@@ -28,6 +28,7 @@
 #include "base/main/mainInt.h"
 #include "cmdInt.h"
 #include "misc/util/utilSignal.h"
+#include "misc/util/utilPool.h"
 
 ABC_NAMESPACE_IMPL_START
 
@@ -49,6 +50,7 @@ static int CmdCommandUnsetVariable ( Abc_Frame_t * pAbc, int argc, char ** argv
 static int CmdCommandUndo          ( Abc_Frame_t * pAbc, int argc, char ** argv );
 static int CmdCommandRecall        ( Abc_Frame_t * pAbc, int argc, char ** argv );
 static int CmdCommandEmpty         ( Abc_Frame_t * pAbc, int argc, char ** argv );
+static int CmdCommandThreads       ( Abc_Frame_t * pAbc, int argc, char ** argv );
 #if defined(WIN32) && !defined(__cplusplus)
 static int CmdCommandScanDir       ( Abc_Frame_t * pAbc, int argc, char ** argv );
 static int CmdCommandRenameFiles   ( Abc_Frame_t * pAbc, int argc, char ** argv );
@@ -98,6 +100,7 @@ void Cmd_Init( Abc_Frame_t * pAbc )
     Cmd_CommandAdd( pAbc, "Basic", "undo",          CmdCommandUndo,            0 );
     Cmd_CommandAdd( pAbc, "Basic", "recall",        CmdCommandRecall,          0 );
     Cmd_CommandAdd( pAbc, "Basic", "empty",         CmdCommandEmpty,           0 );
+    Cmd_CommandAdd( pAbc, "Basic", "threads",       CmdCommandThreads,         0 );
 #if defined(WIN32) && !defined(__cplusplus)
     Cmd_CommandAdd( pAbc, "Basic", "scandir",       CmdCommandScanDir,         0 );
     Cmd_CommandAdd( pAbc, "Basic", "renamefiles",   CmdCommandRenameFiles,     0 );
@@ -219,6 +222,59 @@ int CmdCommandTime( Abc_Frame_t * pAbc, int argc, char **argv )
     return 1;
 }
 
+/**Function********************************************************************
+
+  Synopsis    [Sets the number of threads of the shared thread pool.]
+
+  Description [The pool is used by all multi-threaded commands; their own
+  thread-count options limit the number of tasks they run at a time.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+******************************************************************************/
+int CmdCommandThreads( Abc_Frame_t * pAbc, int argc, char **argv )
+{
+    int c, nThreads = -1;
+    Extra_UtilGetoptReset();
+    while ( ( c = Extra_UtilGetopt( argc, argv, "Nh" ) ) != EOF )
+    {
+        switch ( c )
+        {
+        case 'N':
+            if ( globalUtilOptind >= argc )
+            {
+                fprintf( pAbc->Err, "Command line switch \"-N\" should be followed by an integer.\n" );
+                goto usage;
+            }
+            nThreads = atoi(argv[globalUtilOptind]);
+            globalUtilOptind++;
+            if ( nThreads < 0 )
+                goto usage;
+            break;
+        case 'h':
+            goto usage;
+        default:
+            goto usage;
+        }
+    }
+    if ( argc != globalUtilOptind )
+        goto usage;
+    if ( nThreads >= 0 )
+        Abc_PoolSetThreadNum( nThreads );
+    else
+        fprintf( pAbc->Out, "The thread pool has %d worker threads.\n", Abc_PoolThreadNum() );
+    return 0;
+
+  usage:
+    fprintf( pAbc->Err, "usage: threads [-N num] [-h]\n" );
+    fprintf( pAbc->Err, "      \t\tsets the number of threads shared by multi-threaded commands\n" );
+    fprintf( pAbc->Err, "   -N num\tthe number of threads (0 = one per processor) [default = %d]\n", Abc_PoolThreadNum() );
+    fprintf( pAbc->Err, "   -h \t\tprint the command usage\n" );
+    return 1;
+}
+
 /**Function********************************************************************
 
   Synopsis    []
@@ -24,17 +24,7 @@
 #include <assert.h>
 #include "misc/util/abc_global.h"
 #include "misc/extra/extra.h"
-
-#ifdef ABC_USE_PTHREADS
-
-#ifdef _WIN32
-#include "../lib/pthread.h"
-#else
-#include <pthread.h>
-#include <unistd.h>
-#endif
-
-#endif
+#include "misc/util/utilPool.h"
 
 ABC_NAMESPACE_IMPL_START
  
@@ -48,12 +38,6 @@ void Cmd_RunStarter( char * pFileName, char * pBinary, char * pCommand, int nCor
 
 #else // pthreads are used
 
-// the number of concurrently running threads
-static volatile int nThreadsRunning = 0;
-
-// mutex to control access to the number of threads
-pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
-
 ////////////////////////////////////////////////////////////////////////
 ///                     FUNCTION DEFINITIONS                         ///
 ////////////////////////////////////////////////////////////////////////
@@ -69,9 +53,8 @@ pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
   SeeAlso     []
 
 ***********************************************************************/
-void * Abc_RunThread( void * pCommand )
+void * Abc_RunTask( void * pCommand, Abc_Task_t * pTask )
 {
-    int status;
     // perform the call
     if ( system( (char *)pCommand ) )
     {
@@ -80,16 +63,7 @@ void * Abc_RunThread( void * pCommand )
         fflush( stdout );
     }
     free( pCommand );
-
-    // decrement the number of threads runining 
-    status = pthread_mutex_lock(&mutex);   assert(status == 0);
-    nThreadsRunning--;
-    status = pthread_mutex_unlock(&mutex); assert(status == 0);
-
-    // quit this thread
 	//printf("...Finishing %s\n", (char *)Command);
-	pthread_exit( NULL );
-	assert(0);
 	return NULL;
 }
 
@@ -107,10 +81,10 @@ void * Abc_RunThread( void * pCommand )
 void Cmd_RunStarter( char * pFileName, char * pBinary, char * pCommand, int nCores )
 {
     FILE * pFile, * pFileTemp;
-	pthread_t * pThreadIds;
+	Abc_Task_t ** pTasks;
     char * BufferCopy, * Buffer;
     int nLines, LineMax, Line, Len;
-	int i, c, status, Counter;
+	int i, c, iSlot;
     abctime clk = Abc_Clock();
 
     // check the number of cores
@@ -146,7 +120,7 @@ void Cmd_RunStarter( char * pFileName, char * pBinary, char * pCommand, int nCor
 
     // allocate storage
     Buffer = ABC_ALLOC( char, LineMax );
-    pThreadIds = ABC_ALLOC( pthread_t, nLines );
+    pTasks = ABC_CALLOC( Abc_Task_t *, nCores - 1 );
 
     // check if all files can be opened
     if ( pCommand != NULL )
@@ -172,7 +146,7 @@ void Cmd_RunStarter( char * pFileName, char * pBinary, char * pCommand, int nCor
             {
                 fprintf( stdout, "Starter cannot open file \"%s\".\n", Buffer );
                 fflush( stdout );
-                ABC_FREE( pThreadIds );
+                ABC_FREE( pTasks );
                 ABC_FREE( Buffer );
                 fclose( pFile );
                 return;
@@ -206,43 +180,29 @@ void Cmd_RunStarter( char * pFileName, char * pBinary, char * pCommand, int nCor
         fprintf( stdout, "Calling:  %s\n", (char *)BufferCopy );  
         fflush( stdout );
 
-        // wait till there is an empty thread
-        while ( 1 )
-        {
-            status = pthread_mutex_lock(&mutex);   assert(status == 0);
-            Counter = nThreadsRunning;
-            status = pthread_mutex_unlock(&mutex); assert(status == 0);
-            if ( Counter < nCores - 1 )
+        // wait till there is an empty slot
+        for ( iSlot = 0; iSlot < nCores - 1; iSlot++ )
+            if ( pTasks[iSlot] == NULL )
                 break;
-//            Sleep( 100 );
+        if ( iSlot == nCores - 1 )
+        {
+            iSlot = Abc_TaskWaitAny( pTasks, nCores - 1 );
+            Abc_TaskWait( pTasks[iSlot] );
         }
 
-        // increament the number of threads running
-        status = pthread_mutex_lock(&mutex);   assert(status == 0);
-        nThreadsRunning++;
-        status = pthread_mutex_unlock(&mutex); assert(status == 0);
-
-        // create thread to execute this command
-        status = pthread_create( &pThreadIds[i], NULL, Abc_RunThread, (void *)BufferCopy );  assert(status == 0);
+        // submit the task to execute this command
+        pTasks[iSlot] = Abc_TaskSubmit( Abc_RunTask, (void *)BufferCopy );
         assert( i < nLines );
     }
-    ABC_FREE( pThreadIds );
     ABC_FREE( Buffer );
     fclose( pFile );
 
-    // wait for all the threads to finish
-    while ( 1 )
-    {
-        status = pthread_mutex_lock(&mutex);   assert(status == 0);
-        Counter = nThreadsRunning;
-        status = pthread_mutex_unlock(&mutex); assert(status == 0);
-        if ( Counter == 0 )
-            break;
-    }
+    // wait for all the tasks to finish
+    for ( iSlot = 0; iSlot < nCores - 1; iSlot++ )
+        if ( pTasks[iSlot] )
+            Abc_TaskWait( pTasks[iSlot] );
+    ABC_FREE( pTasks );
 
-    // cleanup
-//    status = pthread_mutex_destroy(&mutex);   assert(status == 0);
-//    mutex = PTHREAD_MUTEX_INITIALIZER;
     fprintf( stdout, "Finished processing commands in file \"%s\".  ", pFileName );
     Abc_PrintTime( 1, "Total wall time", Abc_Clock() - clk );
     fflush( stdout );
@@ -52,6 +52,8 @@ struct Amap_Par_t_
     int    fFreeInvs;   // assume inverters are free (area = 0)
     float  fEpsilon;    // used to compare floating point numbers
     float  fADratio;    // ratio of area/delay improvement
+    int    nProcNum;    // the number of threads
+    int    nMemLimit;   // the limit on the cut memory in MB (0 = no limit)
     int    fVerbose;    // verbosity flag
 };
 
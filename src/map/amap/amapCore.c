@@ -53,6 +53,8 @@ void Amap_ManSetDefaultParams( Amap_Par_t * p )
     p->fUseXors  = 1;            // enables the use of XORs
     p->fFreeInvs = 0;            // assume inverters are free (area = 0)
     p->fEpsilon  = (float)0.001; // used to compare floating point numbers
+    p->nProcNum  = 1;            // the number of threads
+    p->nMemLimit = 0;            // the limit on the cut memory in MB (0 = no limit)
     p->fVerbose  = 0;            // verbosity flag
 }
 
@@ -28,6 +28,7 @@
 
 #include "misc/extra/extra.h"
 #include "aig/aig/aig.h"
+#include "misc/vec/vecWec.h"
 #include "amap.h"
 
 ////////////////////////////////////////////////////////////////////////
@@ -46,6 +47,11 @@ ABC_NAMESPACE_HEADER_START
 #define AMAP_STRING_CONST0     "CONST0"
 #define AMAP_STRING_CONST1     "CONST1"
 
+// the largest number of nodes processed in parallel
+// and the smallest number of nodes given to a thread
+#define AMAP_PAR_BATCH      4096
+#define AMAP_PAR_CHUNK_MIN    64
+
 // object types
 typedef enum { 
     AMAP_OBJ_NONE,    // 0: non-existent object
@@ -103,6 +109,9 @@ struct Amap_Man_t_
     Vec_Ptr_t *        vCuts0;
     Vec_Ptr_t *        vCuts1;
     Vec_Ptr_t *        vCuts2;
+    Vec_Wec_t *        vLevels;
+    Vec_Ptr_t *        vMemCuts;
+    int                nWordsMax;
     // statistics
     int                nCutsUsed;
     int                nCutsTried;
@@ -342,6 +351,7 @@ extern void          Amap_ManStop( Amap_Man_t * p );
 /*=== amapMatch.c ==========================================================*/
 extern void          Amap_ManMap( Amap_Man_t * p );
 /*=== amapMerge.c ==========================================================*/
+extern Vec_Wec_t *   Amap_ManLevelize( Amap_Man_t * p );
 extern void          Amap_ManMerge( Amap_Man_t * p );
 /*=== amapOutput.c ==========================================================*/
 extern Vec_Ptr_t *   Amap_ManProduceMapped( Amap_Man_t * p );
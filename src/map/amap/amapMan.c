@@ -78,6 +78,8 @@ Amap_Man_t * Amap_ManStart( int nNodes )
 ***********************************************************************/
 void Amap_ManStop( Amap_Man_t * p )
 {
+    Aig_MmFlex_t * pMem;
+    int i;
     Vec_PtrFree( p->vPis );
     Vec_PtrFree( p->vPos );
     Vec_PtrFree( p->vObjs );
@@ -87,6 +89,14 @@ void Amap_ManStop( Amap_Man_t * p )
     Vec_IntFree( p->vTemp );
     Aig_MmFixedStop( p->pMemObj, 0 );
     Aig_MmFlexStop( p->pMemCuts, 0 );
+    if ( p->vMemCuts )
+    {
+        Vec_PtrForEachEntry( Aig_MmFlex_t *, p->vMemCuts, pMem, i )
+            Aig_MmFlexStop( pMem, 0 );
+        Vec_PtrFree( p->vMemCuts );
+    }
+    if ( p->vLevels )
+        Vec_WecFree( p->vLevels );
     Aig_MmFlexStop( p->pMemCutBest, 0 );
     Aig_MmFlexStop( p->pMemTemp, 0 );
     ABC_FREE( p->pMatsTemp );
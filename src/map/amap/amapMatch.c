@@ -19,6 +19,7 @@
 ***********************************************************************/
 
 #include "amapInt.h"
+#include "misc/util/utilPool.h"
 
 ABC_NAMESPACE_IMPL_START
 
@@ -27,6 +28,14 @@ ABC_NAMESPACE_IMPL_START
 ///                        DECLARATIONS                              ///
 ////////////////////////////////////////////////////////////////////////
 
+typedef struct Amap_ThMatch_t_ Amap_ThMatch_t;
+struct Amap_ThMatch_t_
+{
+    Amap_Man_t *     p;                        // the manager
+    int *            pNodes;                   // the nodes to be processed
+    int              nNodes;                   // the number of nodes
+};
+
 ////////////////////////////////////////////////////////////////////////
 ///                     FUNCTION DEFINITIONS                         ///
 ////////////////////////////////////////////////////////////////////////
@@ -445,14 +454,14 @@ static inline void Amap_ManMatchGetExacts( Amap_Man_t * p, Amap_Obj_t * pNode, A
 
   Synopsis    [Computes the best match at each node.]
 
-  Description []
+  Description [The cut of the best match points to the cuts of the node.]
                
   SideEffects []
 
   SeeAlso     []
 
 ***********************************************************************/
-void Amap_ManMatchNode( Amap_Man_t * p, Amap_Obj_t * pNode, int fFlow, int fRefs )
+static void Amap_ManMatchNodeBest( Amap_Man_t * p, Amap_Obj_t * pNode, int fFlow, int fRefs )
 {
     int fVerbose = 0; //(pNode->Level == 2 || pNode->Level == 4);
     int fVeryVerbose = fVerbose;
@@ -535,11 +544,106 @@ void Amap_ManMatchNode( Amap_Man_t * p, Amap_Obj_t * pNode, int fFlow, int fRefs
 
     pNode->fPolar = pMBest->pCut->fInv ^ pMBest->pSet->fInv;
     pNode->Best = *pMBest;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Computes the best match at each node.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Amap_ManMatchNode( Amap_Man_t * p, Amap_Obj_t * pNode, int fFlow, int fRefs )
+{
+    Amap_ManMatchNodeBest( p, pNode, fFlow, fRefs );
     pNode->Best.pCut = Amap_ManDupCut( p, pNode->Best.pCut );
     if ( fRefs && Amap_ObjRefsTotal(pNode) > 0 )
         Amap_CutAreaRef( p, &pNode->Best );
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Computes the best matches of a chunk of nodes in one thread.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void * Amap_ManMatchTask( void * pArg, Abc_Task_t * pTask )
+{
+    Amap_ThMatch_t * pThData = (Amap_ThMatch_t *)pArg;
+    Amap_Obj_t * pObj;
+    int i;
+    for ( i = 0; i < pThData->nNodes; i++ )
+    {
+        pObj = Amap_ManObj( pThData->p, pThData->pNodes[i] );
+        if ( pObj->pData )
+            Amap_ManMatchNodeBest( pThData->p, pObj, 1, 0 );
+    }
+    return NULL;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Computes the area flow matches level by level.]
+
+  Description [In the first round of area flow, the match of a node
+  depends only on the matches of the cut leaves, which belong to the 
+  previous levels, so the nodes of one level are matched in parallel. 
+  The cuts of the best matches are saved by the calling thread.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Amap_ManMatchLevels( Amap_Man_t * p )
+{
+    Amap_ThMatch_t * pThData;
+    Abc_Task_t ** ppTasks;
+    Vec_Int_t * vLevel;
+    Amap_Obj_t * pObj;
+    int nThreads = p->pPars->nProcNum;
+    int i, k, iStart, iBeg, nNodes, nTasks;
+    assert( p->vLevels != NULL );
+    pThData = ABC_ALLOC( Amap_ThMatch_t, nThreads );
+    ppTasks = ABC_ALLOC( Abc_Task_t *, nThreads );
+    Vec_WecForEachLevel( p->vLevels, vLevel, i )
+    for ( iBeg = 0; iBeg < Vec_IntSize(vLevel); iBeg += AMAP_PAR_BATCH )
+    {
+        nNodes = Abc_MinInt( AMAP_PAR_BATCH, Vec_IntSize(vLevel) - iBeg );
+        nTasks = Abc_MinInt( nThreads, Abc_MaxInt(1, nNodes / AMAP_PAR_CHUNK_MIN) );
+        for ( k = 0; k < nTasks; k++ )
+        {
+            iStart = (int)((ABC_INT64_T)nNodes * k / nTasks);
+            pThData[k].p      = p;
+            pThData[k].pNodes = Vec_IntArray(vLevel) + iBeg + iStart;
+            pThData[k].nNodes = (int)((ABC_INT64_T)nNodes * (k + 1) / nTasks) - iStart;
+        }
+        for ( k = 1; k < nTasks; k++ )
+            ppTasks[k] = Abc_TaskSubmit( Amap_ManMatchTask, pThData + k );
+        Amap_ManMatchTask( pThData, NULL );
+        for ( k = 1; k < nTasks; k++ )
+            Abc_TaskWait( ppTasks[k] );
+        // save the cuts of the best matches
+        for ( k = iBeg; k < iBeg + nNodes; k++ )
+        {
+            pObj = Amap_ManObj( p, Vec_IntEntry(vLevel, k) );
+            if ( pObj->pData )
+                pObj->Best.pCut = Amap_ManDupCut( p, pObj->Best.pCut );
+        }
+    }
+    ABC_FREE( pThData );
+    ABC_FREE( ppTasks );
+}
+
 /**Function*************************************************************
 
   Synopsis    [Performs one round of mapping.]
@@ -560,9 +664,14 @@ void Amap_ManMatch( Amap_Man_t * p, int fFlow, int fRefs )
     abctime clk = Abc_Clock();
     pMemOld = p->pMemCutBest;
     p->pMemCutBest = Aig_MmFlexStart();
-    Amap_ManForEachNode( p, pObj, i )
-        if ( pObj->pData )
-            Amap_ManMatchNode( p, pObj, fFlow, fRefs );
+    if ( p->vLevels && fFlow && !fRefs )
+        Amap_ManMatchLevels( p );
+    else
+    {
+        Amap_ManForEachNode( p, pObj, i )
+            if ( pObj->pData )
+                Amap_ManMatchNode( p, pObj, fFlow, fRefs );
+    }
     Aig_MmFlexStop( pMemOld, 0 );
     Area = Amap_ManComputeMapping( p );
     nInvs = Amap_ManCountInverters( p );
@@ -19,6 +19,7 @@
 ***********************************************************************/
 
 #include "amapInt.h"
+#include "misc/util/utilPool.h"
 
 ABC_NAMESPACE_IMPL_START
 
@@ -27,6 +28,16 @@ ABC_NAMESPACE_IMPL_START
 ///                        DECLARATIONS                              ///
 ////////////////////////////////////////////////////////////////////////
 
+#define AMAP_WORDS_MIN      (AMAP_MAXINS + 3)  // the trivial cut and the cut of the largest gate
+
+typedef struct Amap_ThData_t_ Amap_ThData_t;
+struct Amap_ThData_t_
+{
+    Amap_Man_t       Man;                      // the copy of the manager
+    int *            pNodes;                   // the nodes to be processed
+    int              nNodes;                   // the number of nodes
+};
+
 ////////////////////////////////////////////////////////////////////////
 ///                     FUNCTION DEFINITIONS                         ///
 ////////////////////////////////////////////////////////////////////////
@@ -62,6 +73,26 @@ Amap_Cut_t * Amap_ManSetupPis( Amap_Man_t * p )
     return (Amap_Cut_t *)pBuffer;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Returns 1 if the list contains the same cut.]
+
+  Description [Such cut is dominated because it leads to the same matches.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline int Amap_ManCutIsDominated( Amap_Cut_t * pList, Amap_Cut_t * pCut )
+{
+    for ( ; pList; pList = *Amap_ManCutNextP(pList) )
+        if ( pList->fInv == pCut->fInv && pList->nFans == pCut->nFans && 
+            !memcmp(pList->Fans, pCut->Fans, sizeof(int) * pCut->nFans) )
+            return 1;
+    return 0;
+}
+
 /**Function*************************************************************
 
   Synopsis    [Creates new cut and adds it to storage.]
@@ -84,6 +115,8 @@ Amap_Cut_t * Amap_ManCutStore( Amap_Man_t * p, Amap_Cut_t * pCut, int fCompl )
     memcpy( pNew->Fans, pCut->Fans, sizeof(int) * pCut->nFans );
     // add it to storage
     iFan = Abc_Var2Lit( pNew->iMat, pNew->fInv );
+    if ( p->nWordsMax && Amap_ManCutIsDominated(p->ppCutsTemp[ iFan ], pNew) )
+        return pNew;
     if ( p->ppCutsTemp[ iFan ] == NULL )
         Vec_IntPushOrder( p->vTemp, iFan );
     *Amap_ManCutNextP( pNew ) = p->ppCutsTemp[ iFan ];
@@ -103,7 +136,7 @@ Amap_Cut_t * Amap_ManCutStore( Amap_Man_t * p, Amap_Cut_t * pCut, int fCompl )
 
 ***********************************************************************/
 Amap_Cut_t * Amap_ManCutCreate( Amap_Man_t * p, 
-    Amap_Cut_t * pCut0, Amap_Cut_t * pCut1, int iMat )
+    Amap_Cut_t * pCut0, int fCompl0, Amap_Cut_t * pCut1, int fCompl1, int iMat )
 {
     Amap_Cut_t * pCut;
     int i, nSize  = pCut0->nFans + pCut1->nFans;
@@ -117,7 +150,14 @@ Amap_Cut_t * Amap_ManCutCreate( Amap_Man_t * p,
         pCut->Fans[i] = pCut0->Fans[i];
     for ( i = 0; i < (int)pCut1->nFans; i++ )
         pCut->Fans[pCut0->nFans+i] = pCut1->Fans[i];
+    // complement literals
+    if ( fCompl0 )
+        pCut->Fans[0] = Abc_LitNot(pCut->Fans[0]);
+    if ( fCompl1 )
+        pCut->Fans[pCut0->nFans] = Abc_LitNot(pCut->Fans[pCut0->nFans]);
     // add it to storage
+    if ( p->nWordsMax && Amap_ManCutIsDominated(p->ppCutsTemp[ pCut->iMat ], pCut) )
+        return pCut;
     if ( p->ppCutsTemp[ pCut->iMat ] == NULL )
         Vec_IntPushOrder( p->vTemp, pCut->iMat );
     *Amap_ManCutNextP( pCut ) = p->ppCutsTemp[ pCut->iMat ];
@@ -137,7 +177,7 @@ Amap_Cut_t * Amap_ManCutCreate( Amap_Man_t * p,
 
 ***********************************************************************/
 Amap_Cut_t * Amap_ManCutCreate3( Amap_Man_t * p, 
-    Amap_Cut_t * pCut0, Amap_Cut_t * pCut1, Amap_Cut_t * pCut2, int iMat )
+    Amap_Cut_t * pCut0, int fCompl0, Amap_Cut_t * pCut1, int fCompl1, Amap_Cut_t * pCut2, int fCompl2, int iMat )
 {
     Amap_Cut_t * pCut;
     int i, nSize  = pCut0->nFans + pCut1->nFans + pCut2->nFans;
@@ -152,7 +192,16 @@ Amap_Cut_t * Amap_ManCutCreate3( Amap_Man_t * p,
         pCut->Fans[pCut0->nFans+i] = pCut1->Fans[i];
     for ( i = 0; i < (int)pCut2->nFans; i++ )
         pCut->Fans[pCut0->nFans+pCut1->nFans+i] = pCut2->Fans[i];
+    // complement literals
+    if ( fCompl0 )
+        pCut->Fans[0] = Abc_LitNot(pCut->Fans[0]);
+    if ( fCompl1 )
+        pCut->Fans[pCut0->nFans] = Abc_LitNot(pCut->Fans[pCut0->nFans]);
+    if ( fCompl2 )
+        pCut->Fans[pCut0->nFans+pCut1->nFans] = Abc_LitNot(pCut->Fans[pCut0->nFans+pCut1->nFans]);
     // add it to storage
+    if ( p->nWordsMax && Amap_ManCutIsDominated(p->ppCutsTemp[ pCut->iMat ], pCut) )
+        return pCut;
     if ( p->ppCutsTemp[ pCut->iMat ] == NULL )
         Vec_IntPushOrder( p->vTemp, pCut->iMat );
     *Amap_ManCutNextP( pCut ) = p->ppCutsTemp[ pCut->iMat ];
@@ -164,7 +213,8 @@ Amap_Cut_t * Amap_ManCutCreate3( Amap_Man_t * p,
 
   Synopsis    [Removes cuts from the temporary storage.]
 
-  Description [] 
+  Description [When the cut memory is limited, the cuts are saved while
+  they fit into the memory given to one node.] 
                
   SideEffects []
 
@@ -186,6 +236,8 @@ void Amap_ManCutSaveStored( Amap_Man_t * p, Amap_Obj_t * pNode )
         for ( pCut = p->ppCutsTemp[Entry]; pCut; pCut = *Amap_ManCutNextP(pCut) )
         {
             nCuts++;
+            if ( nCuts < nMaxCuts && p->nWordsMax && nWords + (int)pCut->nFans + 1 > p->nWordsMax )
+                nMaxCuts = nCuts;
             if ( nCuts < nMaxCuts )
                 nWords += pCut->nFans + 1;
         }
@@ -330,7 +382,9 @@ void Amap_ManMergeNodeChoice( Amap_Man_t * p, Amap_Obj_t * pNode )
             if ( pCut->iMat )
                 Amap_ManCutStore( p, pCut, pNode->fPhase ^ pTemp->fPhase );
         }
-        pTemp->pData = NULL;
+        // the choice nodes may be still used by other threads
+        if ( pTemp == pNode || p->vLevels == NULL )
+            pTemp->pData = NULL;
     }
     Amap_ManCutSaveStored( p, pNode );
 
@@ -404,22 +458,11 @@ void Amap_ManMergeNodeCutsMux( Amap_Man_t * p, Amap_Obj_t * pNode )
             Amap_Nod_t * pNod = Amap_LibNod( p->pLib, Vec_IntEntry(vRules, x+3) );
             if ( pNod->pSets == NULL )
                 continue;
-            // complement literals
-            if ( pCut0->nFans == 1 && (pCut0->fInv ^ fComplFanin0) )
-                pCut0->Fans[0] = Abc_LitNot(pCut0->Fans[0]);
-            if ( pCut1->nFans == 1 && (pCut1->fInv ^ fComplFanin1) )
-                pCut1->Fans[0] = Abc_LitNot(pCut1->Fans[0]);
-            if ( pCut2->nFans == 1 && (pCut2->fInv ^ fComplFanin2) )
-                pCut2->Fans[0] = Abc_LitNot(pCut2->Fans[0]);
-            // create new cut
-            Amap_ManCutCreate3( p, pCut0, pCut1, pCut2, Vec_IntEntry(vRules, x+3) );
-            // uncomplement literals
-            if ( pCut0->nFans == 1 && (pCut0->fInv ^ fComplFanin0) )
-                pCut0->Fans[0] = Abc_LitNot(pCut0->Fans[0]);
-            if ( pCut1->nFans == 1 && (pCut1->fInv ^ fComplFanin1) )
-                pCut1->Fans[0] = Abc_LitNot(pCut1->Fans[0]);
-            if ( pCut2->nFans == 1 && (pCut2->fInv ^ fComplFanin2) )
-                pCut2->Fans[0] = Abc_LitNot(pCut2->Fans[0]);
+            // create new cut with complemented literals
+            Amap_ManCutCreate3( p, 
+                pCut0, pCut0->nFans == 1 && (pCut0->fInv ^ fComplFanin0), 
+                pCut1, pCut1->nFans == 1 && (pCut1->fInv ^ fComplFanin1), 
+                pCut2, pCut2->nFans == 1 && (pCut2->fInv ^ fComplFanin2), Vec_IntEntry(vRules, x+3) );
         }
     }
     Amap_ManCutSaveStored( p, pNode );
@@ -445,7 +488,7 @@ void Amap_ManMergeNodeCuts( Amap_Man_t * p, Amap_Obj_t * pNode )
     Amap_Obj_t * pFanin0 = Amap_ObjFanin0( p, pNode );
     Amap_Obj_t * pFanin1 = Amap_ObjFanin1( p, pNode );
     Amap_Cut_t * pCut0, * pCut1;
-    int ** pRules, Entry, i, k, c, iCompl0, iCompl1, iFan0, iFan1;
+    int ** pRules, Entry, i, k, c, iCompl0, iCompl1, iFan0, iFan1, fCompl0, fCompl1;
     assert( pNode->pData == NULL );
     if ( pNode->Type == AMAP_OBJ_MUX )
     {
@@ -458,9 +501,6 @@ void Amap_ManMergeNodeCuts( Amap_Man_t * p, Amap_Obj_t * pNode )
     {
         iCompl0 = pCut0->fInv ^ Amap_ObjFaninC0(pNode);
         iFan0   = !pCut0->iMat? 0: Abc_Var2Lit( pCut0->iMat, iCompl0 );
-        // complement literals
-        if ( pCut0->nFans == 1 && iCompl0 )
-            pCut0->Fans[0] = Abc_LitNot(pCut0->Fans[0]);
         // label resulting sets
         for ( i = 0; (Entry = pRules[iFan0][i]); i++ )
             p->pMatsTemp[Entry & 0xffff] = (Entry >> 16);
@@ -471,21 +511,14 @@ void Amap_ManMergeNodeCuts( Amap_Man_t * p, Amap_Obj_t * pNode )
             iFan1   = !pCut1->iMat? 0: Abc_Var2Lit( pCut1->iMat, iCompl1 );
             if ( p->pMatsTemp[iFan1] == 0 )
                 continue;
-            // complement literals
-            if ( pCut1->nFans == 1 && iCompl1 )
-                pCut1->Fans[0] = Abc_LitNot(pCut1->Fans[0]);
-            // create new cut
+            // create new cut with complemented literals
+            fCompl0 = pCut0->nFans == 1 && iCompl0;
+            fCompl1 = pCut1->nFans == 1 && iCompl1;
             if ( iFan0 >= iFan1 )
-                Amap_ManCutCreate( p, pCut0, pCut1, p->pMatsTemp[iFan1] );
+                Amap_ManCutCreate( p, pCut0, fCompl0, pCut1, fCompl1, p->pMatsTemp[iFan1] );
             else
-                Amap_ManCutCreate( p, pCut1, pCut0, p->pMatsTemp[iFan1] );
-            // uncomplement literals
-            if ( pCut1->nFans == 1 && iCompl1 )
-                pCut1->Fans[0] = Abc_LitNot(pCut1->Fans[0]);
+                Amap_ManCutCreate( p, pCut1, fCompl1, pCut0, fCompl0, p->pMatsTemp[iFan1] );
         }
-        // uncomplement literals
-        if ( pCut0->nFans == 1 && iCompl0 )
-            pCut0->Fans[0] = Abc_LitNot(pCut0->Fans[0]);
         // label resulting sets
         for ( i = 0; (Entry = pRules[iFan0][i]); i++ )
             p->pMatsTemp[Entry & 0xffff] = 0;
@@ -502,7 +535,99 @@ void Amap_ManMergeNodeCuts( Amap_Man_t * p, Amap_Obj_t * pNode )
 
 /**Function*************************************************************
 
-  Synopsis    [Derives cuts for all nodes.]
+  Synopsis    [Collects the nodes by level.]
+
+  Description [The level of the representative of a choice class is larger
+  than the levels of the preceding choice nodes, whose cuts are merged into
+  the cuts of the representative. The level of a choice node following its
+  representative is larger than the level of the representative, so that
+  the cuts of this node are not seen by the representative, as it happens
+  in the single-threaded mode.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Vec_Wec_t * Amap_ManLevelize( Amap_Man_t * p )
+{
+    Vec_Wec_t * vLevels;
+    Vec_Int_t * vLevel = Vec_IntStart( Amap_ManObjNum(p) );
+    Vec_Int_t * vRepr  = Vec_IntStart( Amap_ManObjNum(p) );
+    Amap_Obj_t * pObj, * pTemp;
+    int i, iRepr, Level, LevelMax = 0;
+    Amap_ManForEachNode( p, pObj, i )
+        if ( pObj->fRepr )
+            for ( pTemp = Amap_ObjChoice(p, pObj); pTemp; pTemp = Amap_ObjChoice(p, pTemp) )
+                Vec_IntWriteEntry( vRepr, pTemp->Id, pObj->Id );
+    Amap_ManForEachNode( p, pObj, i )
+    {
+        Level = Abc_MaxInt( Vec_IntEntry(vLevel, Abc_Lit2Var(pObj->Fan[0])), Vec_IntEntry(vLevel, Abc_Lit2Var(pObj->Fan[1])) );
+        if ( Amap_ObjIsMux(pObj) )
+            Level = Abc_MaxInt( Level, Vec_IntEntry(vLevel, Abc_Lit2Var(pObj->Fan[2])) );
+        if ( pObj->fRepr )
+            for ( pTemp = Amap_ObjChoice(p, pObj); pTemp; pTemp = Amap_ObjChoice(p, pTemp) )
+                if ( pTemp->Id < pObj->Id )
+                    Level = Abc_MaxInt( Level, Vec_IntEntry(vLevel, pTemp->Id) );
+        iRepr = Vec_IntEntry( vRepr, pObj->Id );
+        if ( iRepr && iRepr < (int)pObj->Id )
+            Level = Abc_MaxInt( Level, Vec_IntEntry(vLevel, iRepr) );
+        Vec_IntWriteEntry( vLevel, pObj->Id, ++Level );
+        LevelMax = Abc_MaxInt( LevelMax, Level );
+    }
+    vLevels = Vec_WecStart( LevelMax + 1 );
+    Amap_ManForEachNode( p, pObj, i )
+        Vec_WecPush( vLevels, Vec_IntEntry(vLevel, pObj->Id), pObj->Id );
+    Vec_IntFree( vLevel );
+    Vec_IntFree( vRepr );
+    return vLevels;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Prepares the copy of the manager used by one thread.]
+
+  Description [The copy has its own temporary storage and the memory for
+  the cuts of its nodes, which is kept until the end of mapping.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Amap_ManThDataStart( Amap_Man_t * p, Amap_ThData_t * pThData )
+{
+    Amap_Man_t * pMan = &pThData->Man;
+    *pMan = *p;
+    pMan->vTemp       = Vec_IntAlloc( 100 );
+    pMan->vCuts0      = Vec_PtrAlloc( 100 );
+    pMan->vCuts1      = Vec_PtrAlloc( 100 );
+    pMan->vCuts2      = Vec_PtrAlloc( 100 );
+    pMan->pMemCuts    = Aig_MmFlexStart();
+    pMan->pMemTemp    = Aig_MmFlexStart();
+    pMan->ppCutsTemp  = ABC_CALLOC( Amap_Cut_t *, 2 * p->pLib->nNodes );
+    pMan->pMatsTemp   = ABC_CALLOC( int, 2 * p->pLib->nNodes );
+    pMan->nCutsUsed   = 0;
+    pMan->nCutsTried  = 0;
+    pMan->nCutsTried3 = 0;
+    pMan->nBytesUsed  = 0;
+    Vec_PtrPush( p->vMemCuts, pMan->pMemCuts );
+}
+static void Amap_ManThDataStop( Amap_ThData_t * pThData )
+{
+    Amap_Man_t * pMan = &pThData->Man;
+    Vec_IntFree( pMan->vTemp );
+    Vec_PtrFree( pMan->vCuts0 );
+    Vec_PtrFree( pMan->vCuts1 );
+    Vec_PtrFree( pMan->vCuts2 );
+    Aig_MmFlexStop( pMan->pMemTemp, 0 );
+    ABC_FREE( pMan->ppCutsTemp );
+    ABC_FREE( pMan->pMatsTemp );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Derives the cuts of a chunk of nodes in one thread.]
 
   Description []
                
@@ -510,6 +635,94 @@ void Amap_ManMergeNodeCuts( Amap_Man_t * p, Amap_Obj_t * pNode )
 
   SeeAlso     []
 
+***********************************************************************/
+static void * Amap_ManMergeTask( void * pArg, Abc_Task_t * pTask )
+{
+    Amap_ThData_t * pThData = (Amap_ThData_t *)pArg;
+    Amap_Man_t * p = &pThData->Man;
+    int i;
+    for ( i = 0; i < pThData->nNodes; i++ )
+        Amap_ManMergeNodeCuts( p, Amap_ManObj(p, pThData->pNodes[i]) );
+    return NULL;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Derives the cuts of the nodes level by level.]
+
+  Description [The nodes of one level depend only on the nodes of the
+  previous levels, so their cuts are merged in parallel. Each thread
+  has its own copy of the manager with the temporary storage and saves
+  the cuts in its own memory. The fanin cuts are not modified while
+  merging, so they are shared by all threads. The cuts of the choice
+  nodes are removed when all cuts are computed.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Amap_ManMergeLevels( Amap_Man_t * p )
+{
+    Amap_ThData_t * pThData;
+    Abc_Task_t ** ppTasks;
+    Vec_Int_t * vLevel;
+    Amap_Obj_t * pObj, * pTemp;
+    int nThreads = p->pPars->nProcNum;
+    int i, k, iStart, iBeg, nNodes, nTasks;
+    assert( p->vLevels != NULL );
+    p->vMemCuts = Vec_PtrAlloc( nThreads );
+    pThData = ABC_ALLOC( Amap_ThData_t, nThreads );
+    ppTasks = ABC_ALLOC( Abc_Task_t *, nThreads );
+    for ( k = 0; k < nThreads; k++ )
+        Amap_ManThDataStart( p, pThData + k );
+    Vec_WecForEachLevel( p->vLevels, vLevel, i )
+    for ( iBeg = 0; iBeg < Vec_IntSize(vLevel); iBeg += AMAP_PAR_BATCH )
+    {
+        nNodes = Abc_MinInt( AMAP_PAR_BATCH, Vec_IntSize(vLevel) - iBeg );
+        nTasks = Abc_MinInt( nThreads, Abc_MaxInt(1, nNodes / AMAP_PAR_CHUNK_MIN) );
+        for ( k = 0; k < nTasks; k++ )
+        {
+            iStart = (int)((ABC_INT64_T)nNodes * k / nTasks);
+            pThData[k].pNodes = Vec_IntArray(vLevel) + iBeg + iStart;
+            pThData[k].nNodes = (int)((ABC_INT64_T)nNodes * (k + 1) / nTasks) - iStart;
+        }
+        for ( k = 1; k < nTasks; k++ )
+            ppTasks[k] = Abc_TaskSubmit( Amap_ManMergeTask, pThData + k );
+        Amap_ManMergeTask( pThData, NULL );
+        for ( k = 1; k < nTasks; k++ )
+            Abc_TaskWait( ppTasks[k] );
+    }
+    // collect statistics
+    for ( k = 0; k < nThreads; k++ )
+    {
+        p->nCutsUsed   += pThData[k].Man.nCutsUsed;
+        p->nCutsTried  += pThData[k].Man.nCutsTried;
+        p->nCutsTried3 += pThData[k].Man.nCutsTried3;
+        p->nBytesUsed  += pThData[k].Man.nBytesUsed;
+        Amap_ManThDataStop( pThData + k );
+    }
+    // remove the cuts of the choice nodes merged into their representatives
+    Amap_ManForEachNode( p, pObj, i )
+        if ( pObj->fRepr )
+            for ( pTemp = Amap_ObjChoice(p, pObj); pTemp; pTemp = Amap_ObjChoice(p, pTemp) )
+                if ( pTemp->Id < pObj->Id )
+                    pTemp->pData = NULL;
+    ABC_FREE( pThData );
+    ABC_FREE( ppTasks );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Derives cuts for all nodes.]
+
+  Description [If the cut memory is limited, the memory is divided among
+  the nodes and the dominated cuts are not saved.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
 ***********************************************************************/
 void Amap_ManMerge( Amap_Man_t * p )
 {
@@ -517,8 +730,21 @@ void Amap_ManMerge( Amap_Man_t * p )
     int i;
     abctime clk = Abc_Clock();
     p->pCutsPi = Amap_ManSetupPis( p );
-    Amap_ManForEachNode( p, pObj, i )
-        Amap_ManMergeNodeCuts( p, pObj );
+    if ( p->pPars->nMemLimit )
+    {
+        word nWords = ((word)p->pPars->nMemLimit << 18) / Abc_MaxInt( 1, Amap_ManNodeNum(p) );
+        p->nWordsMax = Abc_MaxInt( (int)Abc_MinWord(nWords, ABC_INFINITY), AMAP_WORDS_MIN );
+    }
+    if ( p->pPars->nProcNum > 1 )
+    {
+        p->vLevels = Amap_ManLevelize( p );
+        Amap_ManMergeLevels( p );
+    }
+    else
+    {
+        Amap_ManForEachNode( p, pObj, i )
+            Amap_ManMergeNodeCuts( p, pObj );
+    }
     if ( p->pPars->fVerbose )
     {
         printf( "AIG object is %d bytes.  ", (int)sizeof(Amap_Obj_t) );
@@ -81,6 +81,7 @@ typedef struct If_Set_t_     If_Set_t;
 typedef struct If_LibLut_t_  If_LibLut_t;
 typedef struct If_LibBox_t_  If_LibBox_t;
 typedef struct If_DsdMan_t_  If_DsdMan_t;
+typedef struct If_TtCache_t_ If_TtCache_t;
 typedef struct Ifn_Ntk_t_    Ifn_Ntk_t;
 
 typedef struct Ifif_Par_t_   Ifif_Par_t;
@@ -140,8 +141,11 @@ struct If_Par_t_
     int                fUseTtPerm;    // compute truth tables of the cut functions
     int                fDeriveLuts;   // enables deriving LUT structures
     int                fDoAverage;    // optimize average rather than maximum level
+    int                nThreads;      // the number of threads for delay-oriented cut enumeration
+    int                fUseSimd;      // use the AVX2 kernels for cut merging and filtering
     int                fVerbose;      // the verbosity flag
     char *             pLutStruct;    // LUT structure
+    char *             pCacheFile;    // the file with the results of the cut function checks
     float              WireDelay;     // wire delay
     // internal parameters
     int                fSkipCutFilter;// skip cut filter
@@ -192,11 +196,13 @@ struct If_Man_t_
     Vec_Ptr_t *        vCos;          // the primary outputs
     Vec_Ptr_t *        vObjs;         // all objects
     Vec_Ptr_t *        vObjsRev;      // reverse topological order of objects
+    Vec_Wec_t *        vLevels;       // AND nodes by level (multi-threaded mapping)
     Vec_Ptr_t *        vTemp;         // temporary array
     int                nObjs[IF_VOID];// the number of objects by type
     // various data
     int                nLevelMax;     // the max number of AIG levels
     float              fEpsilon;      // epsilon used for comparison
+    int                fUseAvx2;      // the AVX2 kernels are used (set once by If_ManStart)
     float              RequiredGlo;   // global required times
     float              RequiredGlo2;  // global required times
     float              AreaGlo;       // global area
@@ -262,6 +268,7 @@ struct If_Man_t_
     int                nBestCutSmall[2];
     int                nCountNonDec[2];
     Vec_Int_t *        vCutData;      // cut data storage
+    If_TtCache_t *     pTtCache;      // persistent cache of the cut function checks
 
     // timing manager
     Tim_Man_t *        pManTim;
@@ -284,7 +291,7 @@ struct If_Cut_t_
     float              Delay;         // delay of the cut
     int                iCutFunc;      // TT ID of the cut
     int                uMaskFunc;     // polarity bitmask
-    unsigned           uSign;         // cut signature
+    word               uSign;         // cut signature
     unsigned           Cost    : 12;  // the user's cost of the cut (related to IF_COST_MAX)
     unsigned           fCompl  :  1;  // the complemented attribute 
     unsigned           fUser   :  1;  // using the user's area and delay
@@ -404,8 +411,8 @@ static inline void       If_CutCopy( If_Man_t * p, If_Cut_t * pDst, If_Cut_t * p
 static inline void       If_CutSetup( If_Man_t * p, If_Cut_t * pCut        ) { memset(pCut, 0, p->nCutBytes); pCut->nLimit = p->pPars->nLutSize; }
 
 static inline If_Cut_t * If_ObjCutBest( If_Obj_t * pObj )                    { return &pObj->CutBest;                }
-static inline unsigned   If_ObjCutSign( unsigned ObjId )                     { return (1 << (ObjId % 31));           }
-static inline unsigned   If_ObjCutSignCompute( If_Cut_t * p )                { unsigned s = 0; int i; for ( i = 0; i < If_CutLeaveNum(p); i++ ) s |= If_ObjCutSign(p->pLeaves[i]); return s; }
+static inline word       If_ObjCutSign( unsigned ObjId )                     { return ((word)1 << (ObjId % 63));     }
+static inline word       If_ObjCutSignCompute( If_Cut_t * p )                { word s = 0; int i; for ( i = 0; i < If_CutLeaveNum(p); i++ ) s |= If_ObjCutSign(p->pLeaves[i]); return s; }
 
 static inline float      If_ObjArrTime( If_Obj_t * pObj )                    { return If_ObjCutBest(pObj)->Delay;    }
 static inline void       If_ObjSetArrTime( If_Obj_t * pObj, float ArrTime )  { If_ObjCutBest(pObj)->Delay = ArrTime; }
@@ -495,13 +502,19 @@ extern void            If_ManSetDefaultPars( If_Par_t * pPars );
 extern int             If_ManPerformMapping( If_Man_t * p );
 extern int             If_ManPerformMappingComb( If_Man_t * p );
 extern void            If_ManComputeSwitching( If_Man_t * p );
+/*=== ifCache.c ==========================================================*/
+extern If_TtCache_t *  If_TtCacheStart( If_Man_t * pMan, char * pFileName );
+extern void            If_TtCacheStop( If_TtCache_t * p, int fVerbose );
+extern int             If_TtCacheCheckCut( If_Man_t * pMan, If_Cut_t * pCut );
 /*=== ifCut.c ============================================================*/
 extern int             If_CutVerifyCuts( If_Set_t * pCutSet, int fOrdered );
-extern int             If_CutFilter( If_Set_t * pCutSet, If_Cut_t * pCut, int fSaveCut0 );
+extern int             If_CutFilter( If_Man_t * p, If_Set_t * pCutSet, If_Cut_t * pCut, int fSaveCut0 );
 extern void            If_CutSort( If_Man_t * p, If_Set_t * pCutSet, If_Cut_t * pCut );
 extern void            If_CutOrder( If_Cut_t * pCut );
 extern int             If_CutMergeOrdered( If_Man_t * p, If_Cut_t * pCut0, If_Cut_t * pCut1, If_Cut_t * pCut );
 extern int             If_CutMerge( If_Man_t * p, If_Cut_t * pCut0, If_Cut_t * pCut1, If_Cut_t * pCut );
+extern int             If_CutHasAvx2();
+extern void            If_CutMergeBenchmark( int nLutSize, int nCuts, int nRounds, int fVerbose );
 extern int             If_CutCheck( If_Cut_t * pCut );
 extern void            If_CutPrint( If_Cut_t * pCut );
 extern void            If_CutPrintTiming( If_Man_t * p, If_Cut_t * pCut );
@@ -618,6 +631,7 @@ extern void            If_ManSetupSetAll( If_Man_t * p, int nCrossCut );
 extern void            If_ObjPerformMappingAnd( If_Man_t * p, If_Obj_t * pObj, int Mode, int fPreprocess, int fFirst );
 extern void            If_ObjPerformMappingChoice( If_Man_t * p, If_Obj_t * pObj, int Mode, int fPreprocess );
 extern int             If_ManPerformMappingRound( If_Man_t * p, int nCutsUsed, int Mode, int fPreprocess, int fFirst, char * pLabel );
+extern void            If_ManPerformMappingLevels( If_Man_t * p, int Mode, int fPreprocess, int fFirst );
 /*=== ifReduce.c ==========================================================*/
 extern void            If_ManImproveMapping( If_Man_t * p );
 /*=== ifSat.c ==========================================================*/
@@ -657,6 +671,9 @@ extern float           If_ManScanMappingDirect( If_Man_t * p );
 extern float           If_ManScanMappingSeq( If_Man_t * p );
 extern void            If_ManResetOriginalRefs( If_Man_t * p );
 extern int             If_ManCrossCut( If_Man_t * p );
+extern int             If_ManCanMapParallel( If_Man_t * p );
+extern Vec_Wec_t *     If_ManCollectLevels( If_Man_t * p );
+extern int             If_ManCrossCutLevels( If_Man_t * p, Vec_Wec_t * vLevels );
 
 extern Vec_Ptr_t *     If_ManReverseOrder( If_Man_t * p );
 extern void            If_ManMarkMapping( If_Man_t * p );
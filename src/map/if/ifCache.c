@@ -21,11 +21,38 @@
 #include "if.h"
 #include "misc/vec/vecHsh.h"
 
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 ABC_NAMESPACE_IMPL_START
 
 ////////////////////////////////////////////////////////////////////////
 ///                        DECLARATIONS                              ///
 ////////////////////////////////////////////////////////////////////////
+
+#define IF_TT_CACHE_MAGIC "ABCIFTT1"  // the first 8 bytes of the cache file
+#define IF_TT_CACHE_KEY   64          // the length of the key in the cache file
+
+struct If_TtCache_t_
+{
+    char *         pFileName;          // the cache file
+    char           pKey[IF_TT_CACHE_KEY]; // the parameters of the checks
+    int            nVars;              // the number of sections (the LUT size plus 1)
+    char *         pFile;              // the contents of the cache file
+    int            nFileSize;          // the size of the contents
+    int            fMapped;            // the contents are mapped into memory
+    int *          pSects;             // the sections of the file (or NULL)
+    int            nSects;             // the number of sections of the file
+    Vec_Mem_t *    vTtNew[IF_MAX_FUNC_LUTSIZE+1];  // the functions checked in this run
+    Vec_Str_t *    vResNew[IF_MAX_FUNC_LUTSIZE+1]; // the results for these functions
+    Vec_Str_t *    vLitRes[IF_MAX_FUNC_LUTSIZE+1]; // the results for the truth table literals (-1 if unknown)
+    int            nHitsRun;           // the checks found by the truth table literal
+    int            nHitsFile;          // the checks found in the file
+};
 
 ////////////////////////////////////////////////////////////////////////
 ///                     FUNCTION DEFINITIONS                         ///
@@ -91,6 +118,443 @@ void If_ManCacheAnalize( If_Man_t * p )
     Vec_IntFree( vRes );
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Derives the key of the cut function cache.]
+
+  Description [The key lists the parameters, which the results of the
+  structural checks depend on. Returns 0 if the checks are not cached.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static int If_TtCacheKey( If_Man_t * p, char * pKey )
+{
+    If_Par_t * pPars = p->pPars;
+    char * pCheck = NULL;
+    if ( !pPars->fTruth || pPars->fUseDsd || pPars->fUseTtPerm )
+        return 0;
+    if ( pPars->pFuncCell == If_CutPerformCheck16 )
+        pCheck = pPars->pLutStruct;
+    else if ( pPars->pFuncCell == If_CutPerformCheck07 )
+        pCheck = "07";
+    else if ( pPars->pFuncCell == If_CutPerformCheck75 )
+        pCheck = pPars->fEnableCheck75u ? "75u" : "75";
+    if ( pCheck == NULL )
+        return 0;
+    memset( pKey, 0, IF_TT_CACHE_KEY );
+    snprintf( pKey, IF_TT_CACHE_KEY, "K=%d check=%s cutmin=%d", pPars->nLutSize, pCheck, pPars->fCutMin );
+    return 1;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Hashes the truth table.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline unsigned If_TtCacheHash( word * pTruth, int nWords )
+{
+    word uHash = 0;
+    int i;
+    for ( i = 0; i < nWords; i++ )
+        uHash = (uHash ^ pTruth[i]) * ABC_CONST(0x9E3779B97F4A7C15);
+    return (unsigned)(uHash >> 32);
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Reads the cache file.]
+
+  Description [The file is mapped into memory, if possible. Otherwise,
+  it is read into a buffer.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static char * If_TtCacheFileRead( char * pFileName, int * pnFileSize, int * pfMapped )
+{
+    FILE * pFile;
+    char * pContents;
+    int nFileSize;
+    *pnFileSize = *pfMapped = 0;
+#if !defined(_WIN32)
+    {
+        struct stat Stat;
+        void * pMap;
+        int fd = open( pFileName, O_RDONLY );
+        if ( fd < 0 )
+            return NULL;
+        if ( fstat( fd, &Stat ) == 0 && Stat.st_size > 0 && Stat.st_size <= 0x7FFFFFFF )
+        {
+            pMap = mmap( NULL, (size_t)Stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+            if ( pMap != MAP_FAILED )
+            {
+                close( fd );
+                *pnFileSize = (int)Stat.st_size;
+                *pfMapped = 1;
+                return (char *)pMap;
+            }
+        }
+        close( fd );
+    }
+#endif
+    pFile = fopen( pFileName, "rb" );
+    if ( pFile == NULL )
+        return NULL;
+    fseek( pFile, 0, SEEK_END );
+    nFileSize = ftell( pFile );
+    rewind( pFile );
+    if ( nFileSize <= 0 )
+    {
+        fclose( pFile );
+        return NULL;
+    }
+    pContents = ABC_ALLOC( char, nFileSize );
+    if ( (int)fread( pContents, 1, nFileSize, pFile ) != nFileSize )
+    {
+        ABC_FREE( pContents );
+        fclose( pFile );
+        return NULL;
+    }
+    fclose( pFile );
+    *pnFileSize = nFileSize;
+    return pContents;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Checks the header of the cache file.]
+
+  Description [Returns the section table or NULL if the file was written 
+  with a different key or is corrupted. Section v describes the functions
+  of v variables by five numbers: the number of functions, the number of
+  hash table bins (a power of 2), the offsets of the hash table, of the
+  truth tables, and of the check results.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static int * If_TtCacheFileCheck( char * pFile, int nFileSize, char * pKey, int * pnSects )
+{
+    int nHead = 8 + IF_TT_CACHE_KEY + 4;
+    int v, nSects, * pSects;
+    if ( nFileSize < nHead || memcmp( pFile, IF_TT_CACHE_MAGIC, 8 ) )
+        return NULL;
+    if ( memcmp( pFile + 8, pKey, IF_TT_CACHE_KEY ) )
+        return NULL;
+    nSects = *(int *)(pFile + 8 + IF_TT_CACHE_KEY);
+    if ( nSects < 1 || nSects > IF_MAX_FUNC_LUTSIZE + 1 || nFileSize < nHead + 5 * 4 * nSects )
+        return NULL;
+    pSects = (int *)(pFile + nHead);
+    for ( v = 0; v < nSects; v++ )
+    {
+        int * pSect = pSects + 5 * v;
+        int nWords = Abc_Truth6WordNum( v );
+        if ( pSect[0] < 0 || pSect[1] < 0 || (pSect[1] & (pSect[1] - 1)) || pSect[0] >= Abc_MaxInt(pSect[1], 1) )
+            return NULL;
+        if ( (pSect[2] & 3) || (pSect[3] & 7) || pSect[2] < 0 || pSect[3] < 0 || pSect[4] < 0 )
+            return NULL;
+        if ( (word)pSect[2] + 4 * (word)pSect[1] > (word)nFileSize ||
+             (word)pSect[3] + 8 * (word)nWords * pSect[0] > (word)nFileSize ||
+             (word)pSect[4] + (word)pSect[0] > (word)nFileSize )
+            return NULL;
+    }
+    *pnSects = nSects;
+    return pSects;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Looks up the truth table in the cache file.]
+
+  Description [Returns the result of the check or -1 if the function 
+  is not in the file.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static int If_TtCacheFileLookup( If_TtCache_t * p, word * pTruth, int nVars )
+{
+    int * pSect, * pBins, i, k, Mask, nWords = Abc_Truth6WordNum( nVars );
+    word * pTruths;
+    if ( p->pSects == NULL || nVars >= p->nSects )
+        return -1;
+    pSect = p->pSects + 5 * nVars;
+    if ( pSect[1] == 0 )
+        return -1;
+    pBins   = (int *)(p->pFile + pSect[2]);
+    pTruths = (word *)(p->pFile + pSect[3]);
+    Mask    = pSect[1] - 1;
+    // at most one pass over the bins, in case the file has no empty bin
+    i = If_TtCacheHash(pTruth, nWords) & Mask;
+    for ( k = 0; k < pSect[1] && pBins[i] != -1; k++, i = (i + 1) & Mask )
+        if ( pBins[i] >= 0 && pBins[i] < pSect[0] && !memcmp(pTruths + nWords * pBins[i], pTruth, sizeof(word) * nWords) )
+            return (int)(p->pFile + pSect[4])[pBins[i]];
+    return -1;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Writes the functions of the file and of this run.]
+
+  Description [The file is written under a temporary name and renamed, 
+  so that other runs reading the cache at the same time see either the 
+  old or the new file.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static int If_TtCacheFileWrite( If_TtCache_t * p )
+{
+    FILE * pFile;
+    char * pTemp, * pRes;
+    word * pTruths, * pTruth;
+    int pSects[5 * (IF_MAX_FUNC_LUTSIZE + 1)];
+    int v, i, k, nOld, nNew, nWords, nBins, Mask, Offset, * pBins;
+    int nHead = 8 + IF_TT_CACHE_KEY + 4 + 5 * 4 * p->nVars, Zero[2] = {0};
+    // compute the layout
+    Offset = nHead;
+    for ( v = 0; v < p->nVars; v++ )
+    {
+        nOld   = (p->pSects && v < p->nSects) ? p->pSects[5 * v] : 0;
+        nNew   = Vec_MemEntryNum( p->vTtNew[v] );
+        nWords = Abc_Truth6WordNum( v );
+        for ( nBins = (nOld + nNew) ? 4 : 0; nBins && nBins < 2 * (nOld + nNew); nBins *= 2 );
+        pSects[5*v+0] = nOld + nNew;
+        pSects[5*v+1] = nBins;
+        pSects[5*v+2] = Offset = 4 * ((Offset + 3) / 4);
+        Offset += 4 * nBins;
+        pSects[5*v+3] = Offset = 8 * ((Offset + 7) / 8);
+        Offset += 8 * nWords * (nOld + nNew);
+        pSects[5*v+4] = Offset;
+        Offset += nOld + nNew;
+    }
+    pTemp = ABC_ALLOC( char, strlen(p->pFileName) + 20 );
+#if !defined(_WIN32)
+    sprintf( pTemp, "%s.tmp%d", p->pFileName, (int)getpid() );
+#else
+    sprintf( pTemp, "%s.tmp", p->pFileName );
+#endif
+    pFile = fopen( pTemp, "wb" );
+    if ( pFile == NULL )
+    {
+        printf( "Cannot open file \"%s\" for writing the cut function cache.\n", pTemp );
+        ABC_FREE( pTemp );
+        return 0;
+    }
+    fwrite( IF_TT_CACHE_MAGIC, 1, 8, pFile );
+    fwrite( p->pKey, 1, IF_TT_CACHE_KEY, pFile );
+    fwrite( &p->nVars, 4, 1, pFile );
+    fwrite( pSects, 4, 5 * p->nVars, pFile );
+    Offset = nHead;
+    for ( v = 0; v < p->nVars; v++ )
+    {
+        nOld    = (p->pSects && v < p->nSects) ? p->pSects[5 * v] : 0;
+        nWords  = Abc_Truth6WordNum( v );
+        nBins   = pSects[5*v+1];
+        Mask    = nBins - 1;
+        // collect the functions
+        pTruths = ABC_ALLOC( word, nWords * Abc_MaxInt(pSects[5*v], 1) );
+        pRes    = ABC_ALLOC( char, Abc_MaxInt(pSects[5*v], 1) );
+        if ( nOld )
+        {
+            memcpy( pTruths, p->pFile + p->pSects[5*v+3], sizeof(word) * nWords * nOld );
+            memcpy( pRes, p->pFile + p->pSects[5*v+4], nOld );
+        }
+        Vec_MemForEachEntry( p->vTtNew[v], pTruth, i )
+            memcpy( pTruths + nWords * (nOld + i), pTruth, sizeof(word) * nWords );
+        if ( Vec_StrSize(p->vResNew[v]) )
+            memcpy( pRes + nOld, Vec_StrArray(p->vResNew[v]), Vec_StrSize(p->vResNew[v]) );
+        // build the hash table
+        pBins = ABC_FALLOC( int, Abc_MaxInt(nBins, 1) );
+        for ( i = 0; i < pSects[5*v]; i++ )
+        {
+            for ( k = If_TtCacheHash(pTruths + nWords * i, nWords) & Mask; pBins[k] != -1; k = (k + 1) & Mask );
+            pBins[k] = i;
+        }
+        // write the section
+        fwrite( Zero, 1, pSects[5*v+2] - Offset, pFile );
+        fwrite( pBins, 4, nBins, pFile );
+        Offset = pSects[5*v+2] + 4 * nBins;
+        fwrite( Zero, 1, pSects[5*v+3] - Offset, pFile );
+        fwrite( pTruths, 8, nWords * pSects[5*v], pFile );
+        fwrite( pRes, 1, pSects[5*v], pFile );
+        Offset = pSects[5*v+4] + pSects[5*v];
+        ABC_FREE( pTruths );
+        ABC_FREE( pRes );
+        ABC_FREE( pBins );
+    }
+    if ( fclose( pFile ) != 0 )
+    {
+        printf( "Writing the cut function cache into file \"%s\" has failed.\n", pTemp );
+        remove( pTemp );
+        ABC_FREE( pTemp );
+        return 0;
+    }
+#if defined(_WIN32)
+    remove( p->pFileName );
+#endif
+    if ( rename( pTemp, p->pFileName ) != 0 )
+    {
+        printf( "Cannot rename file \"%s\" into \"%s\".\n", pTemp, p->pFileName );
+        remove( pTemp );
+        ABC_FREE( pTemp );
+        return 0;
+    }
+    ABC_FREE( pTemp );
+    return 1;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Starts the persistent cache of the cut function checks.]
+
+  Description [The cache file keeps the truth tables of the cut functions
+  together with the results of the structural checks (LUT structures 
+  given by -S and the 07/75 checks), so that they are not repeated when 
+  closely related designs are mapped. The file is mapped into memory and
+  searched in place. Returns NULL if the checks are not cached for the
+  current parameters.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+If_TtCache_t * If_TtCacheStart( If_Man_t * pMan, char * pFileName )
+{
+    If_TtCache_t * p;
+    char pKey[IF_TT_CACHE_KEY];
+    int v, nFuncs = 0;
+    if ( !If_TtCacheKey( pMan, pKey ) )
+    {
+        printf( "The cut function cache is used only with the structural checks of cut functions.\n" );
+        return NULL;
+    }
+    p = ABC_CALLOC( If_TtCache_t, 1 );
+    p->pFileName = Abc_UtilStrsav( pFileName );
+    memcpy( p->pKey, pKey, IF_TT_CACHE_KEY );
+    p->nVars = pMan->pPars->nLutSize + 1;
+    for ( v = 0; v < p->nVars; v++ )
+    {
+        p->vTtNew[v] = Vec_MemAlloc( Abc_Truth6WordNum(v), 12 );
+        Vec_MemHashAlloc( p->vTtNew[v], 1000 );
+        p->vResNew[v] = Vec_StrAlloc( 1000 );
+        p->vLitRes[v] = Vec_StrAlloc( 1000 );
+    }
+    p->pFile = If_TtCacheFileRead( pFileName, &p->nFileSize, &p->fMapped );
+    if ( p->pFile )
+    {
+        p->pSects = If_TtCacheFileCheck( p->pFile, p->nFileSize, p->pKey, &p->nSects );
+        if ( p->pSects == NULL )
+            printf( "Cut function cache \"%s\" was written with different parameters or is corrupted and will be overwritten.\n", pFileName );
+        for ( v = 0; p->pSects && v < p->nSects; v++ )
+            nFuncs += p->pSects[5 * v];
+    }
+    if ( pMan->pPars->fVerbose )
+        printf( "Cut function cache \"%s\" (%s) contains %d functions.\n", pFileName, p->pKey, nFuncs );
+    return p;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Stops the cache and saves the new functions.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void If_TtCacheStop( If_TtCache_t * p, int fVerbose )
+{
+    int v, nNew = 0;
+    for ( v = 0; v < p->nVars; v++ )
+        nNew += Vec_MemEntryNum( p->vTtNew[v] );
+    if ( fVerbose )
+        printf( "Cut function cache: Repeated = %d.  Found in file = %d.  Checked = %d.\n", p->nHitsRun, p->nHitsFile, nNew );
+    if ( nNew > 0 )
+        If_TtCacheFileWrite( p );
+#if !defined(_WIN32)
+    if ( p->fMapped )
+        munmap( p->pFile, (size_t)p->nFileSize );
+    else
+#endif
+        ABC_FREE( p->pFile );
+    for ( v = 0; v < p->nVars; v++ )
+    {
+        Vec_MemHashFree( p->vTtNew[v] );
+        Vec_MemFree( p->vTtNew[v] );
+        Vec_StrFree( p->vResNew[v] );
+        Vec_StrFree( p->vLitRes[v] );
+    }
+    ABC_FREE( p->pFileName );
+    ABC_FREE( p );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Performs the structural check of the cut function.]
+
+  Description [The result is looked up by the truth table literal of
+  the cut, then in the cache file. If both fail, the check is performed 
+  and its result is recorded. Returns 1 if the cut is feasible.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int If_TtCacheCheckCut( If_Man_t * pMan, If_Cut_t * pCut )
+{
+    If_TtCache_t * p = pMan->pTtCache;
+    Vec_Str_t * vLitRes = p->vLitRes[pCut->nLeaves];
+    word * pTruth;
+    int Res, iEntry, nEntries;
+    Vec_StrFillExtra( vLitRes, pCut->iCutFunc + 1, -1 );
+    Res = Vec_StrEntry( vLitRes, pCut->iCutFunc );
+    if ( Res >= 0 )
+    {
+        p->nHitsRun++;
+        return Res;
+    }
+    pTruth = If_CutTruthW( pMan, pCut );
+    Res = If_TtCacheFileLookup( p, pTruth, pCut->nLeaves );
+    if ( Res >= 0 )
+        p->nHitsFile++;
+    else
+    {
+        nEntries = Vec_MemEntryNum( p->vTtNew[pCut->nLeaves] );
+        iEntry = Vec_MemHashInsert( p->vTtNew[pCut->nLeaves], pTruth );
+        if ( iEntry == nEntries )
+        {
+            Res = pMan->pPars->pFuncCell( pMan, If_CutTruth(pMan, pCut), Abc_MaxInt(6, pCut->nLeaves), pCut->nLeaves, pMan->pPars->pLutStruct ) != 0;
+            Vec_StrPush( p->vResNew[pCut->nLeaves], (char)Res );
+        }
+        else
+            Res = Vec_StrEntry( p->vResNew[pCut->nLeaves], iEntry );
+    }
+    Vec_StrWriteEntry( vLitRes, pCut->iCutFunc, (char)Res );
+    return Res;
+}
+
 ////////////////////////////////////////////////////////////////////////
 ///                       END OF FILE                                ///
 ////////////////////////////////////////////////////////////////////////
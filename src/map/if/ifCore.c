@@ -62,6 +62,8 @@ void If_ManSetDefaultPars( If_Par_t * pPars )
     pPars->fPower      =  0;
     pPars->fCutMin     =  0;
     pPars->fBidec      =  0;
+    pPars->nThreads    =  1;
+    pPars->fUseSimd    =  0;
     pPars->fVerbose    =  0;
 }
 
@@ -79,11 +81,19 @@ void If_ManSetDefaultPars( If_Par_t * pPars )
 ***********************************************************************/
 int If_ManPerformMapping( If_Man_t * p )
 {
+    int nCrossCut;
     p->pPars->fAreaOnly = p->pPars->fArea; // temporary
     // create the CI cutsets
     If_ManSetupCiCutSets( p );
     // allocate memory for other cutsets
-    If_ManSetupSetAll( p, If_ManCrossCut(p) );
+    nCrossCut = If_ManCrossCut( p );
+    if ( p->pPars->nThreads > 1 && If_ManCanMapParallel(p) )
+    {
+        // the level-by-level schedule keeps more cutsets alive
+        p->vLevels = If_ManCollectLevels( p );
+        nCrossCut = Abc_MaxInt( nCrossCut, If_ManCrossCutLevels(p, p->vLevels) );
+    }
+    If_ManSetupSetAll( p, nCrossCut );
     // derive reverse top order
     p->vObjsRev = If_ManReverseOrder( p );
     return If_ManPerformMappingComb( p );
@@ -20,6 +20,12 @@
 
 #include "if.h"
 
+// the SIMD kernels need GCC/Clang target attributes and are selected at runtime
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && (__GNUC__ >= 5 || defined(__clang__))
+#define IF_CUT_USE_SIMD
+#include <immintrin.h>
+#endif
+
 ABC_NAMESPACE_IMPL_START
 
 
@@ -27,6 +33,15 @@ ABC_NAMESPACE_IMPL_START
 ///                        DECLARATIONS                              ///
 ////////////////////////////////////////////////////////////////////////
 
+// the largest cut handled by the SIMD kernels (one 256-bit register)
+#define IF_CUT_SIMD_MAX  8
+
+#ifdef IF_CUT_USE_SIMD
+// the lane masks for loading 0 <= n <= 8 leaves
+static const int s_IfCutLoadMask[16] = { -1, -1, -1, -1, -1, -1, -1, -1, 0, 0, 0, 0, 0, 0, 0, 0 };
+static const int s_IfCutRotate[16]   = {  0,  1,  2,  3,  4,  5,  6,  7, 0, 1, 2, 3, 4, 5, 6, 7 };
+#endif
+
 ////////////////////////////////////////////////////////////////////////
 ///                     FUNCTION DEFINITIONS                         ///
 ////////////////////////////////////////////////////////////////////////
@@ -118,7 +133,7 @@ int If_CutVerifyCuts( If_Set_t * pCutSet, int fOrdered )
 ***********************************************************************/
 static inline int If_CutCheckDominance( If_Cut_t * pDom, If_Cut_t * pCut )
 {
-    int i, k;
+    int i, k;
     assert( pDom->nLeaves <= pCut->nLeaves );
     for ( i = 0; i < (int)pDom->nLeaves; i++ )
     {
@@ -132,6 +147,61 @@ static inline int If_CutCheckDominance( If_Cut_t * pDom, If_Cut_t * pCut )
     return 1;
 }
 
+#ifdef IF_CUT_USE_SIMD
+
+/**Function*************************************************************
+
+  Synopsis    [Loads the leaves of a cut into a 256-bit register.]
+
+  Description [The cut has at most 8 leaves. The masked load does not
+  touch the memory after the last leaf. The unused lanes are set to 
+  Pad, which should be larger than any leaf.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+__attribute__((target("avx2")))
+static inline __m256i If_CutLoadAvx2( If_Cut_t * pCut, int Pad )
+{
+    __m256i vMask = _mm256_loadu_si256( (__m256i *)(s_IfCutLoadMask + IF_CUT_SIMD_MAX - pCut->nLeaves) );
+    __m256i vLeaves = _mm256_maskload_epi32( pCut->pLeaves, vMask );
+    return _mm256_blendv_epi8( _mm256_set1_epi32(Pad), vLeaves, vMask );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Returns 1 if pDom is contained in pCut.]
+
+  Description [All leaves of pDom are compared with all leaves of pCut
+  by rotating the second register eight times. The two cuts are padded
+  with different values, so that the unused lanes never match. Requires 
+  pCut to have at most 8 leaves.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+__attribute__((target("avx2")))
+static inline int If_CutCheckDominanceAvx2( If_Cut_t * pDom, If_Cut_t * pCut )
+{
+    __m256i vDom = If_CutLoadAvx2( pDom, 0x7FFFFFFE );
+    __m256i vCut = If_CutLoadAvx2( pCut, 0x7FFFFFFF );
+    __m256i vEqu = _mm256_cmpeq_epi32( vDom, vCut ), vRot;
+    int r, uMask = (1 << pDom->nLeaves) - 1;
+    assert( pDom->nLeaves <= pCut->nLeaves );
+    for ( r = 1; r < IF_CUT_SIMD_MAX; r++ )
+    {
+        vRot = _mm256_permutevar8x32_epi32( vCut, _mm256_loadu_si256((__m256i *)(s_IfCutRotate + r)) );
+        vEqu = _mm256_or_si256( vEqu, _mm256_cmpeq_epi32(vDom, vRot) );
+    }
+    return (_mm256_movemask_ps(_mm256_castsi256_ps(vEqu)) & uMask) == uMask;
+}
+
+#endif
+
 /**Function*************************************************************
 
   Synopsis    [Returns 1 if the cut is contained.]
@@ -143,7 +213,7 @@ static inline int If_CutCheckDominance( If_Cut_t * pDom, If_Cut_t * pCut )
   SeeAlso     []
 
 ***********************************************************************/
-int If_CutFilter( If_Set_t * pCutSet, If_Cut_t * pCut, int fSaveCut0 )
+static inline int If_CutFilter_int( If_Set_t * pCutSet, If_Cut_t * pCut, int fSaveCut0, int fAvx2 )
 { 
     If_Cut_t * pTemp;
     int i, k;
@@ -160,7 +230,11 @@ int If_CutFilter( If_Set_t * pCutSet, If_Cut_t * pCut, int fSaveCut0 )
             if ( (pTemp->uSign & pCut->uSign) != pCut->uSign )
                 continue;
             // check containment seriously
+#ifdef IF_CUT_USE_SIMD
+            if ( fAvx2 ? If_CutCheckDominanceAvx2( pCut, pTemp ) : If_CutCheckDominance( pCut, pTemp ) )
+#else
             if ( If_CutCheckDominance( pCut, pTemp ) )
+#endif
             {
 //                p->ppCuts[i] = p->ppCuts[p->nCuts-1];
 //                p->ppCuts[p->nCuts-1] = pTemp;
@@ -180,12 +254,31 @@ int If_CutFilter( If_Set_t * pCutSet, If_Cut_t * pCut, int fSaveCut0 )
             if ( (pTemp->uSign & pCut->uSign) != pTemp->uSign )
                 continue;
             // check containment seriously
+#ifdef IF_CUT_USE_SIMD
+            if ( fAvx2 ? If_CutCheckDominanceAvx2( pTemp, pCut ) : If_CutCheckDominance( pTemp, pCut ) )
+#else
             if ( If_CutCheckDominance( pTemp, pCut ) )
+#endif
                 return 1;
         }
     }
     return 0;
 }
+#ifdef IF_CUT_USE_SIMD
+__attribute__((target("avx2")))
+static int If_CutFilterAvx2( If_Set_t * pCutSet, If_Cut_t * pCut, int fSaveCut0 )
+{
+    return If_CutFilter_int( pCutSet, pCut, fSaveCut0, 1 );
+}
+#endif
+int If_CutFilter( If_Man_t * p, If_Set_t * pCutSet, If_Cut_t * pCut, int fSaveCut0 )
+{
+#ifdef IF_CUT_USE_SIMD
+    if ( p->fUseAvx2 && pCut->nLimit <= IF_CUT_SIMD_MAX )
+        return If_CutFilterAvx2( pCutSet, pCut, fSaveCut0 );
+#endif
+    return If_CutFilter_int( pCutSet, pCut, fSaveCut0, 0 );
+}
 
 /**Function*************************************************************
 
@@ -287,7 +380,7 @@ FlushCut1:
   SeeAlso     []
 
 ***********************************************************************/
-int If_CutMergeOrdered( If_Man_t * p, If_Cut_t * pC0, If_Cut_t * pC1, If_Cut_t * pC )
+static int If_CutMergeOrderedScalar( If_Cut_t * pC0, If_Cut_t * pC1, If_Cut_t * pC )
 { 
     int nSizeC0 = pC0->nLeaves;
     int nSizeC1 = pC1->nLeaves;
@@ -350,6 +443,95 @@ FlushCut1:
     return 1;
 }
 
+#ifdef IF_CUT_USE_SIMD
+
+/**Function*************************************************************
+
+  Synopsis    [Merges two ordered cuts with at most 8 leaves.]
+
+  Description [All leaves of one cut are compared with all leaves of the 
+  other cut by rotating the registers eight times. The first pass finds
+  the shared leaves, which are used to reject the pair. The second pass
+  replaces the shared leaves of the second cut by a padding value and 
+  counts, for each leaf, the smaller leaves of the merged cut, which is
+  the position of the leaf in the merged cut. The padding lanes land
+  after the last leaf and are not stored.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+__attribute__((target("avx2,popcnt")))
+static int If_CutMergeOrderedAvx2( If_Cut_t * pC0, If_Cut_t * pC1, If_Cut_t * pC )
+{ 
+    __m256i vPad  = _mm256_set1_epi32( 0x7FFFFFFE );
+    __m256i vCut0 = If_CutLoadAvx2( pC0, 0x7FFFFFFF );
+    __m256i vCut1 = If_CutLoadAvx2( pC1, 0x7FFFFFFE );
+    __m256i vRot, vRot0, vRot1, vPos0, vPos1;
+    __m256i vEqu0 = _mm256_setzero_si256(), vEqu1 = _mm256_setzero_si256();
+    int pLeaves[2*IF_CUT_SIMD_MAX], pPos[2*IF_CUT_SIMD_MAX], pTemp[2*IF_CUT_SIMD_MAX];
+    int i, r, nSize;
+    // find the shared leaves
+    for ( r = 0; r < IF_CUT_SIMD_MAX; r++ )
+    {
+        vRot  = _mm256_loadu_si256( (__m256i *)(s_IfCutRotate + r) );
+        vRot0 = _mm256_permutevar8x32_epi32( vCut0, vRot );
+        vRot1 = _mm256_permutevar8x32_epi32( vCut1, vRot );
+        vEqu0 = _mm256_or_si256( vEqu0, _mm256_cmpeq_epi32(vCut0, vRot1) );
+        vEqu1 = _mm256_or_si256( vEqu1, _mm256_cmpeq_epi32(vCut1, vRot0) );
+    }
+    nSize = pC0->nLeaves + pC1->nLeaves - _mm_popcnt_u32( _mm256_movemask_ps(_mm256_castsi256_ps(vEqu0)) & ((1 << pC0->nLeaves) - 1) );
+    if ( nSize > (int)pC0->nLimit )
+        return 0;
+    // count the smaller leaves of the merged cut; the comparison results are -1
+    vCut1 = _mm256_blendv_epi8( vCut1, vPad, vEqu1 );
+    vPos0 = _mm256_setr_epi32( 0, 1, 2, 3, 4, 5, 6, 7 );
+    vPos1 = _mm256_setzero_si256();
+    for ( r = 0; r < IF_CUT_SIMD_MAX; r++ )
+    {
+        vRot  = _mm256_loadu_si256( (__m256i *)(s_IfCutRotate + r) );
+        vRot0 = _mm256_permutevar8x32_epi32( vCut0, vRot );
+        vRot1 = _mm256_permutevar8x32_epi32( vCut1, vRot );
+        vPos0 = _mm256_sub_epi32( vPos0, _mm256_cmpgt_epi32(vCut0, vRot1) );
+        vPos1 = _mm256_sub_epi32( vPos1, _mm256_cmpgt_epi32(vCut1, vRot0) );
+        vPos1 = _mm256_sub_epi32( vPos1, _mm256_cmpgt_epi32(vCut1, vRot1) );
+    }
+    // scatter the leaves and store the first nSize of them
+    _mm256_storeu_si256( (__m256i *)pLeaves, vCut0 );
+    _mm256_storeu_si256( (__m256i *)(pLeaves + IF_CUT_SIMD_MAX), vCut1 );
+    _mm256_storeu_si256( (__m256i *)pPos, vPos0 );
+    _mm256_storeu_si256( (__m256i *)(pPos + IF_CUT_SIMD_MAX), vPos1 );
+    for ( i = 0; i < 2*IF_CUT_SIMD_MAX; i++ )
+        pTemp[pPos[i]] = pLeaves[i];
+    _mm256_maskstore_epi32( pC->pLeaves, _mm256_loadu_si256((__m256i *)(s_IfCutLoadMask + IF_CUT_SIMD_MAX - nSize)), _mm256_loadu_si256((__m256i *)pTemp) );
+    pC->nLeaves = nSize;
+    pC->uSign = pC0->uSign | pC1->uSign;
+    return 1;
+}
+
+#endif
+
+/**Function*************************************************************
+
+  Synopsis    [Merges two ordered cuts.]
+
+  Description [Returns 0 if the merged cut has more than nLimit leaves.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int If_CutMergeOrdered( If_Man_t * p, If_Cut_t * pC0, If_Cut_t * pC1, If_Cut_t * pC )
+{ 
+#ifdef IF_CUT_USE_SIMD
+    if ( p->fUseAvx2 && pC0->nLimit <= IF_CUT_SIMD_MAX )
+        return If_CutMergeOrderedAvx2( pC0, pC1, pC );
+#endif
+    return If_CutMergeOrderedScalar( pC0, pC1, pC );
+}
+
 /**Function*************************************************************
 
   Synopsis    [Prepares the object for FPGA mapping.]
@@ -1466,6 +1648,159 @@ int If_CutCountTotalFanins( If_Man_t * p )
     return 1;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Returns 1 if the AVX2 kernels can be used.]
+
+  Description [The kernels are used by the mapper only if requested
+  (If_Par_t::fUseSimd) because they were not measured to be faster 
+  than the scalar code on all machines; see If_CutMergeBenchmark().
+  They are applied to the cuts with at most 8 leaves.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int If_CutHasAvx2()
+{
+#ifdef IF_CUT_USE_SIMD
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt");
+#else
+    return 0;
+#endif
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Counts the pairs of cuts, in which one contains the other.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static int If_CutCountContained( If_Cut_t ** ppCuts, int nCuts )
+{
+    int i, k, Counter = 0;
+    for ( i = 0; i < nCuts; i++ )
+    for ( k = 0; k < nCuts; k++ )
+        if ( ppCuts[i]->nLeaves <= ppCuts[k]->nLeaves && (ppCuts[i]->uSign & ppCuts[k]->uSign) == ppCuts[i]->uSign )
+            Counter += If_CutCheckDominance( ppCuts[i], ppCuts[k] );
+    return Counter;
+}
+#ifdef IF_CUT_USE_SIMD
+__attribute__((target("avx2")))
+static int If_CutCountContainedAvx2( If_Cut_t ** ppCuts, int nCuts )
+{
+    int i, k, Counter = 0;
+    for ( i = 0; i < nCuts; i++ )
+    for ( k = 0; k < nCuts; k++ )
+        if ( ppCuts[i]->nLeaves <= ppCuts[k]->nLeaves && (ppCuts[i]->uSign & ppCuts[k]->uSign) == ppCuts[i]->uSign )
+            Counter += If_CutCheckDominanceAvx2( ppCuts[i], ppCuts[k] );
+    return Counter;
+}
+#endif
+static int If_CutMergeOrderedKernel( If_Cut_t * pC0, If_Cut_t * pC1, If_Cut_t * pC, int fAvx2 )
+{
+#ifdef IF_CUT_USE_SIMD
+    if ( fAvx2 )
+        return If_CutMergeOrderedAvx2( pC0, pC1, pC );
+#endif
+    return If_CutMergeOrderedScalar( pC0, pC1, pC );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Measures the throughput of cut merging and containment.]
+
+  Description [Generates nCuts random ordered cuts with up to nLutSize 
+  leaves taken from 4*nLutSize nodes, so that many pairs share leaves.
+  All pairs are merged and checked for containment nRounds times with 
+  each available kernel. The results of the kernels are compared.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void If_CutMergeBenchmark( int nLutSize, int nCuts, int nRounds, int fVerbose )
+{
+    extern unsigned Gia_ManRandom( int fReset );
+    If_Cut_t ** ppCuts, * pRes;
+    char * pMemory;
+    int nCutBytes = 8 * ((sizeof(If_Cut_t) + sizeof(int) * nLutSize + 7) / 8);
+    int i, k, r, v, m, Leaf, fDup, nMerged, nContained, Checksum, Kernel;
+    int nMerged0 = -1, nContained0 = -1, Checksum0 = -1;
+    double Pairs = (double)nRounds * nCuts * nCuts;
+    abctime clk, clkMerge, clkContain;
+    assert( nLutSize > 0 && nLutSize <= IF_MAX_LUTSIZE && nCuts > 0 );
+    // generate random cuts
+    pMemory = ABC_CALLOC( char, (nCuts + 1) * nCutBytes );
+    ppCuts  = ABC_ALLOC( If_Cut_t *, nCuts + 1 );
+    for ( i = 0; i <= nCuts; i++ )
+        ppCuts[i] = (If_Cut_t *)(pMemory + i * nCutBytes);
+    Gia_ManRandom( 1 );
+    for ( i = 0; i < nCuts; i++ )
+    {
+        If_Cut_t * pCut = ppCuts[i];
+        pCut->nLimit  = nLutSize;
+        pCut->nLeaves = 1 + Gia_ManRandom(0) % nLutSize;
+        for ( v = 0; v < (int)pCut->nLeaves; )
+        {
+            Leaf = Gia_ManRandom(0) % (4 * nLutSize);
+            for ( fDup = m = 0; m < v; m++ )
+                fDup |= (pCut->pLeaves[m] == Leaf);
+            if ( !fDup )
+                pCut->pLeaves[v++] = Leaf;
+        }
+        If_CutOrder( pCut );
+        pCut->uSign = If_ObjCutSignCompute( pCut );
+    }
+    pRes = ppCuts[nCuts];
+    pRes->nLimit = nLutSize;
+    // run the kernels
+    for ( Kernel = 0; Kernel < 1 + (If_CutHasAvx2() && nLutSize <= IF_CUT_SIMD_MAX); Kernel++ )
+    {
+        const char * pName = Kernel ? "AVX2" : "scalar";
+        nMerged = Checksum = 0;
+        clk = Abc_Clock();
+        for ( r = 0; r < nRounds; r++ )
+        for ( i = 0; i < nCuts; i++ )
+        for ( k = 0; k < nCuts; k++ )
+            if ( If_CutMergeOrderedKernel( ppCuts[i], ppCuts[k], pRes, Kernel ) && r == 0 )
+            {
+                nMerged++;
+                for ( v = 0; v < (int)pRes->nLeaves; v++ )
+                    Checksum = 31 * Checksum + pRes->pLeaves[v];
+            }
+        clkMerge = Abc_Clock() - clk;
+        nContained = 0;
+        clk = Abc_Clock();
+        for ( r = 0; r < nRounds; r++ )
+#ifdef IF_CUT_USE_SIMD
+            nContained += Kernel ? If_CutCountContainedAvx2( ppCuts, nCuts ) : If_CutCountContained( ppCuts, nCuts );
+#else
+            nContained += If_CutCountContained( ppCuts, nCuts );
+#endif
+        clkContain = Abc_Clock() - clk;
+        printf( "Kernel %-6s :  Merge = %7.2f Mpairs/sec.  Containment = %7.2f Mpairs/sec.", pName,
+            1e-6 * Pairs / Abc_MaxDouble(1e-9, 1.0 * clkMerge / CLOCKS_PER_SEC), 
+            1e-6 * Pairs / Abc_MaxDouble(1e-9, 1.0 * clkContain / CLOCKS_PER_SEC) );
+        if ( fVerbose )
+            printf( "  Merged = %d.  Contained = %d.  Checksum = %08x.", nMerged, nContained, Checksum );
+        printf( "\n" );
+        if ( Kernel == 0 )
+            nMerged0 = nMerged, nContained0 = nContained, Checksum0 = Checksum;
+        else if ( nMerged != nMerged0 || nContained != nContained0 || Checksum != Checksum0 )
+            printf( "Kernel %s produced different results.\n", pName );
+    }
+    ABC_FREE( ppCuts );
+    ABC_FREE( pMemory );
+}
+
 ////////////////////////////////////////////////////////////////////////
 ///                       END OF FILE                                ///
 ////////////////////////////////////////////////////////////////////////
@@ -30,16 +30,7 @@
 #include "bdd/extrab/extraBdd.h"
 #endif
 
-#ifdef ABC_USE_PTHREADS
-
-#ifdef _WIN32
-#include "../lib/pthread.h"
-#else
-#include <pthread.h>
-#include <unistd.h>
-#endif
-
-#endif
+#include "misc/util/utilPool.h"
 
 ABC_NAMESPACE_IMPL_START
 
@@ -2572,33 +2563,17 @@ typedef struct Ifn_ThData_t_
     int         Id;      // object
     int         nConfls; // conflicts
     int         Result;  // result
-    int         Status;  // state
     abctime     clkUsed; // total runtime
 } Ifn_ThData_t;
-void * Ifn_WorkerThread( void * pArg )
+void * Ifn_WorkerTask( void * pArg, Abc_Task_t * pTask )
 {
     Ifn_ThData_t * pThData = (Ifn_ThData_t *)pArg;
-    volatile int * pPlace = &pThData->Status;
-    abctime clk;
-    while ( 1 )
-    {
-        while ( *pPlace == 0 );
-        assert( pThData->Status == 1 );
-        if ( pThData->Id == -1 )
-        {
-	        pthread_exit( NULL );
-            assert( 0 );
-            return NULL;
-        }
-        clk = Abc_Clock();
-        memset( pThData->pConfig, 0, sizeof(word) * pThData->nConfigWords );
-        pThData->Result = Ifn_NtkMatch( pThData->pNtk, pThData->pTruth, pThData->nVars, pThData->nConfls, 0, 0, pThData->pConfig );
-        pThData->clkUsed += Abc_Clock() - clk;
-        pThData->Status = 0;
-//        printf( "Finished object %d\n", pThData->Id );
-    }
-	assert( 0 );
-	return NULL;
+    abctime clk = Abc_Clock();
+    memset( pThData->pConfig, 0, sizeof(word) * pThData->nConfigWords );
+    pThData->Result = Ifn_NtkMatch( pThData->pNtk, pThData->pTruth, pThData->nVars, pThData->nConfls, 0, 0, pThData->pConfig );
+    pThData->clkUsed += Abc_Clock() - clk;
+//    printf( "Finished object %d\n", pThData->Id );
+    return NULL;
 }
 void Id_DsdManTuneStr( If_DsdMan_t * p, char * pStruct, int nConfls, int nProcs, int fVerbose )
 {
@@ -2658,11 +2633,11 @@ void Id_DsdManTuneStr( If_DsdMan_t * p, char * pStruct, int nConfls, int nProcs,
 
     // perform concurrent solving
     {
-	    pthread_t WorkerThread[PAR_THR_MAX];
+        Abc_Task_t * pTasks[PAR_THR_MAX];
         Ifn_ThData_t ThData[PAR_THR_MAX];
         abctime clk, clkUsed = 0;
-        int status, fRunning = 1, iCurrentObj = p->nObjsPrev;
-        // start the threads
+        int fRunning = 1, iCurrentObj = p->nObjsPrev;
+        // start the task slots
         for ( i = 0; i < nProcs; i++ )
         {
             ThData[i].pNtk     = Ifn_NtkParse( pStruct );
@@ -2670,21 +2645,21 @@ void Id_DsdManTuneStr( If_DsdMan_t * p, char * pStruct, int nConfls, int nProcs,
             ThData[i].Id       = -1;      // object
             ThData[i].nConfls  = nConfls; // conflicts
             ThData[i].Result   = -1;      // result
-            ThData[i].Status   =  0;      // state
             ThData[i].clkUsed  =  0;      // total runtime
             ThData[i].nConfigWords = p->nConfigWords;
-            status = pthread_create( WorkerThread + i, NULL, Ifn_WorkerThread, (void *)(ThData + i) );  assert( status == 0 );
+            pTasks[i] = NULL;
         }
-        // run the threads
+        // run the tasks
         while ( fRunning || iCurrentObj < Vec_PtrSize(&p->vObjs) )
         {
             for ( i = 0; i < nProcs; i++ )
             {
-                if ( ThData[i].Status )
+                if ( pTasks[i] && !Abc_TaskIsDone(pTasks[i]) )
                     continue;
-                assert( ThData[i].Status == 0 );
-                if ( ThData[i].Id >= 0 )
+                if ( pTasks[i] )
                 {
+                    Abc_TaskWait( pTasks[i] );
+                    pTasks[i] = NULL;
                     //printf( "Closing obj %d with Thread %d:\n", ThData[i].Id, i );
                     assert( ThData[i].Result == 0 || ThData[i].Result == 1 );
                     if ( ThData[i].Result == 0 )
@@ -2711,7 +2686,7 @@ void Id_DsdManTuneStr( If_DsdMan_t * p, char * pStruct, int nConfls, int nProcs,
                     ThData[i].nVars  = nVars;
                     ThData[i].Id     =  k;
                     ThData[i].Result = -1;
-                    ThData[i].Status =  1;
+                    pTasks[i] = Abc_TaskSubmit( Ifn_WorkerTask, ThData + i );
                     //printf( "Scheduling %d for Thread %d\n", ThData[i].Id, i );
                     iCurrentObj = k+1;
                     break;
@@ -2719,18 +2694,16 @@ void Id_DsdManTuneStr( If_DsdMan_t * p, char * pStruct, int nConfls, int nProcs,
             }
             fRunning = 0;
             for ( i = 0; i < nProcs; i++ )
-                if ( ThData[i].Status == 1 || (ThData[i].Status == 0 && ThData[i].Id >= 0) )
+                if ( pTasks[i] )
                     fRunning = 1;
             //printf( "fRunning %d\n", fRunning );
+            // sleep until one of the tasks is finished
+            if ( fRunning )
+                Abc_TaskWaitAny( pTasks, nProcs );
         }
-        // stop the threads
+        // free the task data
         for ( i = 0; i < nProcs; i++ )
-        {
-            assert( ThData[i].Status == 0 );
-            ThData[i].Id = -1;
-            ThData[i].Status = 1;
             ABC_FREE( ThData[i].pNtk );
-        }
         if ( fVerbose )
         {
             printf( "Main     : " );
@@ -56,6 +56,7 @@ If_Man_t * If_ManStart( If_Par_t * pPars )
     memset( p, 0, sizeof(If_Man_t) );
     p->pPars    = pPars;
     p->fEpsilon = pPars->Epsilon;
+    p->fUseAvx2 = pPars->fUseSimd && If_CutHasAvx2();
     // allocate arrays for nodes
     p->vCis     = Vec_PtrAlloc( 100 );
     p->vCos     = Vec_PtrAlloc( 100 );
@@ -88,6 +89,9 @@ If_Man_t * If_ManStart( If_Par_t * pPars )
     p->nPermWords  = p->pPars->fUsePerm? If_CutPermWords( p->pPars->nLutSize ) : 0;
     p->nObjBytes   = sizeof(If_Obj_t) + sizeof(int) * (p->pPars->nLutSize + p->nPermWords);
     p->nCutBytes   = sizeof(If_Cut_t) + sizeof(int) * (p->pPars->nLutSize + p->nPermWords);
+    // keep the 64-bit cut signatures aligned
+    p->nObjBytes   = 8 * ((p->nObjBytes + 7) / 8);
+    p->nCutBytes   = 8 * ((p->nCutBytes + 7) / 8);
     p->nSetBytes   = sizeof(If_Set_t) + (sizeof(If_Cut_t *) + p->nCutBytes) * (p->pPars->nCutsMax + 1);
     p->pMemObj     = Mem_FixedStart( p->nObjBytes );
     // report expected memory usage
@@ -156,6 +160,8 @@ If_Man_t * If_ManStart( If_Par_t * pPars )
         Bat_ManFuncSetupTable();
 //        Abc_PrintTime( 1, "Setup time", Abc_Clock() - clk );
     }
+    if ( pPars->pCacheFile )
+        p->pTtCache = If_TtCacheStart( p, pPars->pCacheFile );
     // create the constant node
     p->pConst1   = If_ManSetupObj( p );
     p->pConst1->Type   = IF_CONST1;
@@ -251,6 +257,7 @@ void If_ManStop( If_Man_t * p )
     Vec_WrdFreeP( &p->vAndGate );
     Vec_WrdFreeP( &p->vOrGate );
     Vec_PtrFreeP( &p->vObjsRev );
+    Vec_WecFreeP( &p->vLevels );
     Vec_PtrFreeP( &p->vLatchOrder );
     Vec_IntFreeP( &p->vLags );
     for ( i = 6; i <= Abc_MaxInt(6,p->pPars->nLutSize); i++ )
@@ -262,6 +269,8 @@ void If_ManStop( If_Man_t * p )
     for ( i = 6; i <= Abc_MaxInt(6,p->pPars->nLutSize); i++ )
         Vec_IntFreeP( &p->vTtDecs[i] );
     Vec_IntFreeP( &p->vCutData );
+    if ( p->pTtCache )
+        If_TtCacheStop( p->pTtCache, p->pPars->fVerbose );
     Vec_IntFreeP( &p->vPairRes );
     Vec_StrFreeP( &p->vPairPerms );
     if ( p->vPairHash )
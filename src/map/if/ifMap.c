@@ -19,6 +19,7 @@
 ***********************************************************************/
 
 #include "if.h"
+#include "misc/util/utilPool.h"
 
 
 ABC_NAMESPACE_IMPL_START
@@ -29,6 +30,22 @@ ABC_NAMESPACE_IMPL_START
 
 extern char * Dau_DsdMerge( char * pDsd0i, int * pPerm0, char * pDsd1i, int * pPerm1, int fCompl0, int fCompl1, int nVars );
 extern int    If_CutDelayRecCost3(If_Man_t* p, If_Cut_t* pCut, If_Obj_t * pObj);
+
+// the smallest number of nodes of one level given to a thread
+#define IF_PAR_CHUNK_MIN  64
+
+// the state of one thread computing cuts of a level
+typedef struct If_ParThData_t_ If_ParThData_t;
+struct If_ParThData_t_
+{
+    If_Man_t        Man;          // private copy of the manager (statistics)
+    Vec_Int_t *     vLevel;       // the nodes of the current level
+    int             iStart;       // the first node
+    int             iStop;        // the last node
+    int             Mode;         // the mapping mode
+    int             fPreprocess;  // preprocessing
+    int             fFirst;       // the first round
+};
 
 ////////////////////////////////////////////////////////////////////////
 ///                     FUNCTION DEFINITIONS                         ///
@@ -45,13 +62,12 @@ extern int    If_CutDelayRecCost3(If_Man_t* p, If_Cut_t* pCut, If_Obj_t * pObj);
   SeeAlso     []
 
 ***********************************************************************/
-static inline int If_WordCountOnes( unsigned uWord )
+static inline int If_WordCountOnes( word uWord )
 {
-    uWord = (uWord & 0x55555555) + ((uWord>>1) & 0x55555555);
-    uWord = (uWord & 0x33333333) + ((uWord>>2) & 0x33333333);
-    uWord = (uWord & 0x0F0F0F0F) + ((uWord>>4) & 0x0F0F0F0F);
-    uWord = (uWord & 0x00FF00FF) + ((uWord>>8) & 0x00FF00FF);
-    return  (uWord & 0x0000FFFF) + (uWord>>16);
+    uWord = (uWord & ABC_CONST(0x5555555555555555)) + ((uWord>>1) & ABC_CONST(0x5555555555555555));
+    uWord = (uWord & ABC_CONST(0x3333333333333333)) + ((uWord>>2) & ABC_CONST(0x3333333333333333));
+    uWord = (uWord & ABC_CONST(0x0F0F0F0F0F0F0F0F)) + ((uWord>>4) & ABC_CONST(0x0F0F0F0F0F0F0F0F));
+    return (int)((uWord * ABC_CONST(0x0101010101010101)) >> 56);
 }
 
 /**Function*************************************************************
@@ -92,7 +108,7 @@ float If_CutDelaySpecial( If_Man_t * p, If_Cut_t * pCut, int fCarry )
   SeeAlso     []
 
 ***********************************************************************/
-void If_ObjPerformMappingAnd( If_Man_t * p, If_Obj_t * pObj, int Mode, int fPreprocess, int fFirst )
+static void If_ObjPerformMappingAndCuts( If_Man_t * p, If_Obj_t * pObj, int Mode, int fPreprocess, int fFirst )
 {
     If_Set_t * pCutSet;
     If_Cut_t * pCut0, * pCut1, * pCut;
@@ -113,8 +129,8 @@ void If_ObjPerformMappingAnd( If_Man_t * p, If_Obj_t * pObj, int Mode, int fPrep
     if ( Mode && pObj->nRefs > 0 )
         If_CutAreaDeref( p, If_ObjCutBest(pObj) );
 
-    // prepare the cutset
-    pCutSet = If_ManSetupNodeCutSet( p, pObj );
+    // the cutset is prepared by the caller
+    pCutSet = pObj->pCutSet;
 
     // get the current assigned best cut
     pCut = If_ObjCutBest(pObj);
@@ -188,7 +204,7 @@ void If_ObjPerformMappingAnd( If_Man_t * p, If_Obj_t * pObj, int Mode, int fPrep
         p->nCutsMerged++;
         p->nCutsTotal++;
         // check if this cut is contained in any of the available cuts
-        if ( !p->pPars->fSkipCutFilter && If_CutFilter( pCutSet, pCut, fSave0 ) )
+        if ( !p->pPars->fSkipCutFilter && If_CutFilter( p, pCutSet, pCut, fSave0 ) )
             continue;
         // check if the cut is a special AND-gate cut
         pCut->fAndCut = fUseAndCut && pCut->nLeaves == 2 && pCut->pLeaves[0] == pObj->pFanin0->Id && pCut->pLeaves[1] == pObj->pFanin1->Id;
@@ -209,7 +225,7 @@ void If_ObjPerformMappingAnd( If_Man_t * p, If_Obj_t * pObj, int Mode, int fPrep
                 fChange = If_CutComputeTruth( p, pCut, pCut0, pCut1, pObj->fCompl0, pObj->fCompl1 );
             if ( p->pPars->fVerbose )
                 p->timeCache[4] += Abc_Clock() - clk;
-            if ( !p->pPars->fSkipCutFilter && fChange && If_CutFilter( pCutSet, pCut, fSave0 ) )
+            if ( !p->pPars->fSkipCutFilter && fChange && If_CutFilter( p, pCutSet, pCut, fSave0 ) )
                 continue;
             if ( p->pPars->fUseDsd )
             {
@@ -237,6 +253,8 @@ void If_ObjPerformMappingAnd( If_Man_t * p, If_Obj_t * pObj, int Mode, int fPrep
                 assert( pCut->nLimit >= 4 && pCut->nLimit <= 16 );
                 if ( p->pPars->fUseDsd )
                     pCut->fUseless = If_DsdManCheckDec( p->pIfDsdMan, If_CutDsdLit(p, pCut) );
+                else if ( p->pTtCache )
+                    pCut->fUseless = !If_TtCacheCheckCut( p, pCut );
                 else
                     pCut->fUseless = !p->pPars->pFuncCell( p, If_CutTruth(p, pCut), Abc_MaxInt(6, pCut->nLeaves), pCut->nLeaves, p->pPars->pLutStruct );
                 p->nCutsUselessAll += pCut->fUseless;
@@ -401,6 +419,13 @@ void If_ObjPerformMappingAnd( If_Man_t * p, If_Obj_t * pObj, int Mode, int fPrep
     if ( p->pPars->pFuncUser )
         If_ObjForEachCut( pObj, pCut, i )
             p->pPars->pFuncUser( p, pObj, pCut );
+}
+void If_ObjPerformMappingAnd( If_Man_t * p, If_Obj_t * pObj, int Mode, int fPreprocess, int fFirst )
+{
+    // prepare the cutset
+    If_ManSetupNodeCutSet( p, pObj );
+    // compute the cuts
+    If_ObjPerformMappingAndCuts( p, pObj, Mode, fPreprocess, fFirst );
     // free the cuts
     If_ManDerefNodeCutSet( p, pObj );
 }
@@ -451,7 +476,7 @@ void If_ObjPerformMappingChoice( If_Man_t * p, If_Obj_t * pObj, int Mode, int fP
             // copy the cut into storage
             If_CutCopy( p, pCut, pCutTemp );
             // check if this cut is contained in any of the available cuts
-            if ( If_CutFilter( pCutSet, pCut, fSave0 ) )
+            if ( If_CutFilter( p, pCutSet, pCut, fSave0 ) )
                 continue;
             // check if the cut satisfies the required times
 //            assert( pCut->Delay == If_CutDelay( p, pTemp, pCut ) );
@@ -489,6 +514,95 @@ void If_ObjPerformMappingChoice( If_Man_t * p, If_Obj_t * pObj, int Mode, int fP
     If_ManDerefChoiceCutSet( p, pObj );
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Computes the cuts of a range of nodes of one level.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void * If_ManPerformMappingLevelTask( void * pArg, Abc_Task_t * pTask )
+{
+    If_ParThData_t * pThData = (If_ParThData_t *)pArg;
+    int i;
+    for ( i = pThData->iStart; i < pThData->iStop; i++ )
+        If_ObjPerformMappingAndCuts( &pThData->Man, If_ManObj(&pThData->Man, Vec_IntEntry(pThData->vLevel, i)), 
+            pThData->Mode, pThData->fPreprocess, pThData->fFirst );
+    return NULL;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Performs delay-oriented mapping of the nodes level by level.]
+
+  Description [The nodes of one level do not depend on each other, so
+  their cuts are computed in parallel. The cutsets of the level are taken
+  from the free list and the cutsets of the fanins are released by the
+  calling thread in the order of node IDs, before and after the level is
+  processed. Each thread works with a private copy of the manager, which
+  differs only in the statistics. Since the cuts of a node depend only on
+  the cuts of its fanins, the result is the same for any number of threads.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void If_ManPerformMappingLevels( If_Man_t * p, int Mode, int fPreprocess, int fFirst )
+{
+    If_ParThData_t * pThData;
+    Abc_Task_t ** ppTasks;
+    Vec_Int_t * vLevel;
+    int i, k, Id, nTasks, nThreads = p->pPars->nThreads;
+    assert( Mode == 0 && p->vLevels != NULL );
+    pThData = ABC_ALLOC( If_ParThData_t, nThreads );
+    ppTasks = ABC_ALLOC( Abc_Task_t *, nThreads );
+    for ( i = 0; i < nThreads; i++ )
+    {
+        pThData[i].Man             = *p;
+        pThData[i].Man.nCutsMerged = 0;
+        pThData[i].Man.nCutsTotal  = 0;
+        pThData[i].Mode            = Mode;
+        pThData[i].fPreprocess     = fPreprocess;
+        pThData[i].fFirst          = fFirst;
+    }
+    Vec_WecForEachLevel( p->vLevels, vLevel, i )
+    {
+        if ( Vec_IntSize(vLevel) == 0 )
+            continue;
+        // prepare the cutsets
+        Vec_IntForEachEntry( vLevel, Id, k )
+            If_ManSetupNodeCutSet( p, If_ManObj(p, Id) );
+        // compute the cuts
+        nTasks = Abc_MinInt( nThreads, Abc_MaxInt(1, Vec_IntSize(vLevel) / IF_PAR_CHUNK_MIN) );
+        for ( k = 0; k < nTasks; k++ )
+        {
+            pThData[k].vLevel = vLevel;
+            pThData[k].iStart = (int)((ABC_INT64_T)Vec_IntSize(vLevel) * k / nTasks);
+            pThData[k].iStop  = (int)((ABC_INT64_T)Vec_IntSize(vLevel) * (k + 1) / nTasks);
+        }
+        for ( k = 1; k < nTasks; k++ )
+            ppTasks[k] = Abc_TaskSubmit( If_ManPerformMappingLevelTask, pThData + k );
+        If_ManPerformMappingLevelTask( pThData, NULL );
+        for ( k = 1; k < nTasks; k++ )
+            Abc_TaskWait( ppTasks[k] );
+        // free the cutsets
+        Vec_IntForEachEntry( vLevel, Id, k )
+            If_ManDerefNodeCutSet( p, If_ManObj(p, Id) );
+    }
+    for ( i = 0; i < nThreads; i++ )
+    {
+        p->nCutsMerged += pThData[i].Man.nCutsMerged;
+        p->nCutsTotal  += pThData[i].Man.nCutsTotal;
+    }
+    ABC_FREE( pThData );
+    ABC_FREE( ppTasks );
+}
+
 /**Function*************************************************************
 
   Synopsis    [Performs one mapping pass over all nodes.]
@@ -553,6 +667,8 @@ int If_ManPerformMappingRound( If_Man_t * p, int nCutsUsed, int Mode, int fPrepr
         }
 //        Tim_ManPrint( p->pManTim );
     }
+    else if ( p->vLevels && Mode == 0 )
+        If_ManPerformMappingLevels( p, Mode, fPreprocess, fFirst );
     else
     {
     //    pProgress = Extra_ProgressBarStart( stdout, If_ManObjNum(p) );
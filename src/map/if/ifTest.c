@@ -20,17 +20,7 @@
 
 #include "if.h"
 #include "aig/gia/gia.h"
-
-#ifdef ABC_USE_PTHREADS
-
-#ifdef _WIN32
-#include "../lib/pthread.h"
-#else
-#include <pthread.h>
-#include <unistd.h>
-#endif
-
-#endif
+#include "misc/util/utilPool.h"
 
 ABC_NAMESPACE_IMPL_START
 
@@ -210,35 +200,20 @@ typedef struct Par_ThData_t_
 {
     Gia_Man_t * p;
     int         Id;
-    int         Status;
 } Par_ThData_t;
-void * Gia_ParWorkerThread( void * pArg )
+void * Gia_ParWorkerTask( void * pArg, Abc_Task_t * pTask )
 {
     Par_ThData_t * pThData = (Par_ThData_t *)pArg;
-    volatile int * pPlace = &pThData->Status;
-    while ( 1 )
-    {
-        while ( *pPlace == 0 );
-        assert( pThData->Status == 1 );
-        if ( pThData->Id == -1 )
-        {
-	        pthread_exit( NULL );
-            assert( 0 );
-            return NULL;
-        }
-        assert( pThData->Id >= 0 );
-        Gia_ParTestSimulateObj( pThData->p, pThData->Id );
-        pThData->Status = 0;
-    }
-	assert( 0 );
-	return NULL;
+    assert( pThData->Id >= 0 );
+    Gia_ParTestSimulateObj( pThData->p, pThData->Id );
+    return NULL;
 }
 void Gia_ParTestSimulate2( Gia_Man_t * p, int nWords, int nProcs )
 {
-	pthread_t WorkerThread[PAR_THR_MAX];
+    Abc_Task_t * pTasks[PAR_THR_MAX];
     Par_ThData_t ThData[PAR_THR_MAX];
     Vec_Int_t * vStack, * vFanins;
-    int i, k, iFan, status, nCountFanins;
+    int i, k, iFan, nCountFanins;
     assert( nProcs <= PAR_THR_MAX );
     Gia_ManRandom( 1 );
     Gia_ParTestAlloc( p, nWords );
@@ -251,23 +226,23 @@ void Gia_ParTestSimulate2( Gia_Man_t * p, int nWords, int nProcs )
     Gia_ManStaticFanoutStart( p );
     vFanins = Gia_ManCreateFaninCounts( p );
     nCountFanins = Vec_IntSum(vFanins);
-    // start the threads
+    // start the task slots
     for ( i = 0; i < nProcs; i++ )
     {
         ThData[i].p = p;
         ThData[i].Id = -1;
-        ThData[i].Status = 0;
-        status = pthread_create( WorkerThread + i, NULL, Gia_ParWorkerThread, (void *)(ThData + i) );  assert( status == 0 );
+        pTasks[i] = NULL;
     }
     while ( nCountFanins > 0 || Vec_IntSize(vStack) > 0 )
     {
         for ( i = 0; i < nProcs; i++ )
         {
-            if ( ThData[i].Status )
+            if ( pTasks[i] && !Abc_TaskIsDone(pTasks[i]) )
                 continue;
-            assert( ThData[i].Status == 0 );
-            if ( ThData[i].Id >= 0 )
+            if ( pTasks[i] )
             {
+                Abc_TaskWait( pTasks[i] );
+                pTasks[i] = NULL;
                 Gia_ObjForEachFanoutStaticId( p, ThData[i].Id, iFan, k )
                 {
                     assert( Vec_IntEntry(vFanins, iFan) > 0 );
@@ -281,9 +256,11 @@ void Gia_ParTestSimulate2( Gia_Man_t * p, int nWords, int nProcs )
             if ( Vec_IntSize(vStack) > 0 )
             {
                 ThData[i].Id = Vec_IntPop( vStack );
-                ThData[i].Status = 1;
+                pTasks[i] = Abc_TaskSubmit( Gia_ParWorkerTask, ThData + i );
             }
         }
+        // the slots are busy or there is nothing to schedule
+        Abc_TaskWaitAny( pTasks, nProcs );
     }
     Vec_IntForEachEntry( vFanins, iFan, k )
         if ( iFan != 0 )
@@ -292,21 +269,10 @@ void Gia_ParTestSimulate2( Gia_Man_t * p, int nWords, int nProcs )
             Gia_ObjPrint( p, Gia_ManObj(p, k) );
         }
 //    assert( Vec_IntSum(vFanins) == 0 );
-    // stop the threads
-    while ( 1 )
-    {
-        for ( i = 0; i < nProcs; i++ )
-            if ( ThData[i].Status )
-                break;
-        if ( i == nProcs )
-            break;
-    }
+    // wait for the remaining tasks
     for ( i = 0; i < nProcs; i++ )
-    {
-        assert( ThData[i].Status == 0 );
-        ThData[i].Id = -1;
-        ThData[i].Status = 1;
-    }
+        if ( pTasks[i] )
+            Abc_TaskWait( pTasks[i] );
     Gia_ManStaticFanoutStop( p );
     Vec_IntFree( vStack );
     Vec_IntFree( vFanins );
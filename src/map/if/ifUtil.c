@@ -349,6 +349,96 @@ int If_ManCrossCut( If_Man_t * p )
     return nCutSizeMax;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Returns 1 if the cuts of one level can be computed in parallel.]
+
+  Description [Delay-oriented cut computation of a node depends only on
+  the cuts of its fanins, unless the cut functions are computed (they are
+  hashed in the shared tables) or the cost is evaluated by the procedures
+  using scratch memory of the manager.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int If_ManCanMapParallel( If_Man_t * p )
+{
+    If_Par_t * pPars = p->pPars;
+    if ( p->pManTim || p->nChoices || pPars->fTruth || pPars->fLiftLeaves )
+        return 0;
+    if ( pPars->fDelayOpt || pPars->fDelayOptLut || pPars->fDsdBalance || pPars->fUserRecLib || pPars->nGateSize > 0 )
+        return 0;
+    if ( pPars->pFuncCost || pPars->pFuncUser )
+        return 0;
+    return 1;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Collects AND nodes by level.]
+
+  Description [The nodes of each level are listed in the increasing
+  order of their IDs.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Vec_Wec_t * If_ManCollectLevels( If_Man_t * p )
+{
+    Vec_Wec_t * vLevels;
+    If_Obj_t * pObj;
+    int i;
+    vLevels = Vec_WecStart( p->nLevelMax + 1 );
+    If_ManForEachNode( p, pObj, i )
+        Vec_WecPush( vLevels, If_ObjLevel(pObj), pObj->Id );
+    return vLevels;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Computes cross-cut of the level-by-level schedule.]
+
+  Description [The cutsets of all nodes of a level are allocated before
+  the cutsets of their fanins are released.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int If_ManCrossCutLevels( If_Man_t * p, Vec_Wec_t * vLevels )
+{
+    If_Obj_t * pObj, * pFanin;
+    Vec_Int_t * vLevel;
+    int i, k, Id, nCutSize = 0, nCutSizeMax = 0;
+    Vec_WecForEachLevel( vLevels, vLevel, i )
+    {
+        nCutSize += Vec_IntSize(vLevel);
+        nCutSizeMax = Abc_MaxInt( nCutSizeMax, nCutSize );
+        Vec_IntForEachEntry( vLevel, Id, k )
+        {
+            pObj = If_ManObj( p, Id );
+            assert( !pObj->fRepr );
+            if ( pObj->nVisits == 0 )
+                nCutSize--;
+            pFanin = If_ObjFanin0(pObj);
+            if ( !If_ObjIsCi(pFanin) && --pFanin->nVisits == 0 )
+                nCutSize--;
+            pFanin = If_ObjFanin1(pObj);
+            if ( !If_ObjIsCi(pFanin) && --pFanin->nVisits == 0 )
+                nCutSize--;
+        }
+    }
+    If_ManForEachObj( p, pObj, i )
+        pObj->nVisits = pObj->nVisitsCopy;
+    assert( nCutSize == 0 );
+    return nCutSizeMax;
+}
+
 /**Function*************************************************************
 
   Synopsis    [Computes the reverse topological order of nodes.]
@@ -70,6 +70,11 @@ int Map_Mapping( Map_Man_t * p )
     clk = Abc_Clock();
     Map_MappingTruths( p );
     p->timeTruth = Abc_Clock() - clk;
+if ( p->fVerbose )
+{
+printf( "Functions: Canonical forms = %9d.  Reused matches = %9d.                ", p->nCanons, p->nCanonHits );
+ABC_PRT( "Time", p->timeTruth );
+}
     //////////////////////////////////////////////////////////////////////
 //ABC_PRT( "Truths", Abc_Clock() - clk );
 
@@ -145,6 +145,7 @@ struct Map_ManStruct_t_
     int                 nChoiceNodes;  // the number of choice nodes
     int                 nChoices;      // the number of all choices
     int                 nCanons;       // the number of times N-canonical form was computed
+    int                 nCanonHits;    // the number of times the matches of a cut function were reused
     int                 nMatches;      // the number of times supergate matching was performed
     int                 nPhases;       // the number of phases considered during matching
     int                 nFanoutViolations;  // the number of nodes in mapped circuit violating fanout
@@ -181,6 +182,7 @@ struct Map_SuperLibStruct_t_
     Map_Super_t **      ppSupers;      // the array of supergates
     Map_HashTable_t *   tTableC;       // the table mapping N-canonical forms into supergates
     Map_HashTable_t *   tTable;        // the table mapping truth tables into supergates
+    Map_HashTable_t *   tTableM[7];    // the tables mapping cut truth tables into matches (by cut size)
 
     // data structures for N-canonical form computation
     unsigned            uTruths[6][2]; // the elementary truth tables
@@ -408,6 +410,7 @@ extern void              Map_SuperTableFree( Map_HashTable_t * p );
 extern int               Map_SuperTableInsertC( Map_HashTable_t * pLib, unsigned uTruthC[], Map_Super_t * pGate );
 extern int               Map_SuperTableInsert( Map_HashTable_t * pLib, unsigned uTruth[], Map_Super_t * pGate, unsigned uPhase );
 extern Map_Super_t *     Map_SuperTableLookup( Map_HashTable_t * p, unsigned uTruth[], unsigned * puPhase );
+extern int               Map_SuperTableLookupM( Map_HashTable_t * p, unsigned uTruth[], Map_Super_t ** ppGates, unsigned * puPhase );
 extern void              Map_SuperTableSortSupergates( Map_HashTable_t * p, int nSupersMax );
 extern void              Map_SuperTableSortSupergatesByDelay( Map_HashTable_t * p, int nSupersMax );
 /*=== mapperTime.c =============================================================*/
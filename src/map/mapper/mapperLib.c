@@ -166,6 +166,7 @@ clk = Abc_Clock();
 ***********************************************************************/
 void Map_SuperLibFree( Map_SuperLib_t * p )
 {
+    int i;
     if ( p == NULL ) return;
     if ( p->pGenlib )
     {
@@ -177,6 +178,9 @@ void Map_SuperLibFree( Map_SuperLib_t * p )
         Map_SuperTableFree( p->tTableC );
     if ( p->tTable )
         Map_SuperTableFree( p->tTable );
+    for ( i = 0; i < 7; i++ )
+        if ( p->tTableM[i] )
+            Map_SuperTableFree( p->tTableM[i] );
     Extra_MmFixedStop( p->mmSupers );
     Extra_MmFixedStop( p->mmEntries );
     Extra_MmFlexStop( p->mmForms );
@@ -189,14 +193,15 @@ void Map_SuperLibFree( Map_SuperLib_t * p )
 
   Synopsis    [Derives the library from the genlib library.]
 
-  Description []
+  Description [If fUseCache is set, the supergates are read from (or saved 
+  in) the cache file "<genlib>.super.cache" next to the genlib file.]
                
   SideEffects []
 
   SeeAlso     []
 
 ***********************************************************************/
-int Map_SuperLibDeriveFromGenlib( Mio_Library_t * pLib, int fVerbose )
+int Map_SuperLibDeriveFromGenlib( Mio_Library_t * pLib, int fUseCache, int fVerbose )
 {
     Map_SuperLib_t * pLibSuper;
     Vec_Str_t * vStr;
@@ -205,7 +210,10 @@ int Map_SuperLibDeriveFromGenlib( Mio_Library_t * pLib, int fVerbose )
         return 0;
 
     // compute supergates
-    vStr = Super_PrecomputeStr( pLib, 5, 1, 100000000, 10000000, 10000000, 100, 1, 0 );
+    if ( fUseCache )
+        vStr = Super_PrecomputeStrCached( pLib, 5, 1, 100000000, 10000000, 10000000, 100, 1, 1, 0 );
+    else
+        vStr = Super_PrecomputeStr( pLib, 5, 1, 100000000, 10000000, 10000000, 100, 1, 1, 0 );
     if ( vStr == NULL )
         return 0;
 
@@ -239,7 +247,7 @@ int Map_SuperLibDeriveFromGenlib2( Mio_Library_t * pLib, int fVerbose )
         return 0;
     // compute supergates
     pFileName = Extra_FileNameGenericAppend(Mio_LibraryReadName(pLib), ".super");
-    Super_Precompute( pLib, 5, 1, 100000000, 10000000, 10000000, 100, 1, 0, pFileName );
+    Super_Precompute( pLib, 5, 1, 100000000, 10000000, 10000000, 100, 1, 1, 1, 0, pFileName );
     // assuming that it terminated successfully
     if ( Cmd_CommandExecute( pAbc, pFileName ) )
     {
@@ -219,6 +219,34 @@ Map_Super_t * Map_SuperTableLookup( Map_HashTable_t * p, unsigned uTruth[], unsi
     return NULL;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Looks up the matches of a cut function.]
+
+  Description [Similar to Map_SuperTableLookup() but returns 0 if the 
+  function is not in the table. This way, the functions without matching
+  supergates can be stored in the table as well.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Map_SuperTableLookupM( Map_HashTable_t * p, unsigned uTruth[], Map_Super_t ** ppGates, unsigned * puPhase )
+{
+    Map_HashEntry_t * pEnt;
+    unsigned Key;
+    Key = MAP_TABLE_HASH( uTruth[0], uTruth[1], p->nBins );
+    for ( pEnt = p->pBins[Key]; pEnt; pEnt = pEnt->pNext )
+        if ( pEnt->uTruth[0] == uTruth[0] && pEnt->uTruth[1] == uTruth[1] )
+        {
+            *ppGates = pEnt->pGates;
+            *puPhase = pEnt->uPhase;
+            return 1;
+        }
+    return 0;
+}
+
 /**Function*************************************************************
 
   Synopsis    [Resizes the table.]
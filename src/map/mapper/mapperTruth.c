@@ -28,6 +28,7 @@ ABC_NAMESPACE_IMPL_START
 static void Map_TruthsCut( Map_Man_t * pMan, Map_Cut_t * pCut );
 extern void Map_TruthsCutOne( Map_Man_t * p, Map_Cut_t * pCut, unsigned uTruth[] );
 static void Map_CutsCollect_rec( Map_Cut_t * pCut, Map_NodeVec_t * vVisited );
+static Map_Super_t * Map_TruthsCutMatch( Map_Man_t * p, int nLeaves, unsigned uTruth[], unsigned * puPhase );
 
 ////////////////////////////////////////////////////////////////////////
 ///                     FUNCTION DEFINITIONS                         ///
@@ -82,56 +83,54 @@ void Map_MappingTruths( Map_Man_t * pMan )
 
 /**Function*************************************************************
 
-  Synopsis    [Derives the truth table for one cut.]
+  Synopsis    [Finds the matching supergates for one cut function.]
 
-  Description []
+  Description [The matches (the list of supergates of the N-class and the
+  phase transforming the function into its canonical form) are stored in
+  the supergate library, in the table indexed by the number of cut leaves.
+  The canonical form is computed only for the functions not found there.
+  Because the library is kept between the runs of the mapper, the table 
+  is reused by the following runs with the same library.]
                
   SideEffects []
 
   SeeAlso     []
 
 ***********************************************************************/
-void Map_TruthsCut( Map_Man_t * p, Map_Cut_t * pCut )
-{ 
-//    unsigned uCanon1, uCanon2;
-    unsigned uTruth[2], uCanon[2];
+Map_Super_t * Map_TruthsCutMatch( Map_Man_t * p, int nLeaves, unsigned uTruth[], unsigned * puPhase )
+{
+    Map_HashTable_t * pTable;
+    Map_Super_t * pSupers;
+    unsigned uCanon[2];
     unsigned char uPhases[16];
     unsigned * uCanon2;
     char * pPhases2;
     int fUseFast = 1;
     int fUseSlow = 0;
     int fUseRec = 0; // this does not work for Solaris
-
-    extern int Map_CanonCompute( int nVarsMax, int nVarsReal, unsigned * pt, unsigned ** pptRes, char ** ppfRes );
- 
-    // generally speaking, 1-input cut can be matched into a wire!
-    if ( pCut->nLeaves == 1 )
-        return;
-/*
-    if ( p->nVarsMax == 5 )
+    // look up the function among those matched before
+    if ( p->pSuperLib->tTableM[nLeaves] == NULL )
+        p->pSuperLib->tTableM[nLeaves] = Map_SuperTableCreate( p->pSuperLib );
+    pTable = p->pSuperLib->tTableM[nLeaves];
+    if ( Map_SuperTableLookupM( pTable, uTruth, &pSupers, puPhase ) )
     {
-        uTruth[0] = pCut->uTruth;
-        uTruth[1] = pCut->uTruth;
+        p->nCanonHits++;
+        return pSupers;
     }
-    else
-*/
-    Map_TruthsCutOne( p, pCut, uTruth );
-
-
-    // compute the canonical form for the positive phase
+    // compute the canonical form
     if ( fUseFast )
-        Map_CanonComputeFast( p, p->nVarsMax, pCut->nLeaves, uTruth, uPhases, uCanon );
+        Map_CanonComputeFast( p, p->nVarsMax, nLeaves, uTruth, uPhases, uCanon );
     else if ( fUseSlow )
-        Map_CanonComputeSlow( p->uTruths, p->nVarsMax, pCut->nLeaves, uTruth, uPhases, uCanon );
+        Map_CanonComputeSlow( p->uTruths, p->nVarsMax, nLeaves, uTruth, uPhases, uCanon );
     else if ( fUseRec )
     {
-//        Map_CanonComputeSlow( p->uTruths, p->nVarsMax, pCut->nLeaves, uTruth, uPhases, uCanon );
-        Extra_TruthCanonFastN( p->nVarsMax, pCut->nLeaves, uTruth, &uCanon2, &pPhases2 );
+//        Map_CanonComputeSlow( p->uTruths, p->nVarsMax, nLeaves, uTruth, uPhases, uCanon );
+        Extra_TruthCanonFastN( p->nVarsMax, nLeaves, uTruth, &uCanon2, &pPhases2 );
 /*
         if ( uCanon[0] != uCanon2[0] || uPhases[0] != pPhases2[0] )
         {
             int k = 0;
-            Map_CanonCompute( p->nVarsMax, pCut->nLeaves, uTruth, &uCanon2, &pPhases2 );
+            Map_CanonCompute( p->nVarsMax, nLeaves, uTruth, &uCanon2, &pPhases2 );
         }
 */
         uCanon[0] = uCanon2[0];
@@ -139,45 +138,52 @@ void Map_TruthsCut( Map_Man_t * p, Map_Cut_t * pCut )
         uPhases[0] = pPhases2[0];
     }
     else
-        Map_CanonComputeSlow( p->uTruths, p->nVarsMax, pCut->nLeaves, uTruth, uPhases, uCanon );
-    pCut->M[1].pSupers = Map_SuperTableLookupC( p->pSuperLib, uCanon );
-    pCut->M[1].uPhase  = uPhases[0];
+        Map_CanonComputeSlow( p->uTruths, p->nVarsMax, nLeaves, uTruth, uPhases, uCanon );
+    pSupers  = Map_SuperTableLookupC( p->pSuperLib, uCanon );
+    *puPhase = uPhases[0];
     p->nCanons++;
+    // save the matches
+    Map_SuperTableInsert( pTable, uTruth, pSupers, *puPhase );
+    return pSupers;
+}
 
-//uCanon1 = uCanon[0] & 0xFFFF;
+/**Function*************************************************************
 
-    // compute the canonical form for the negative phase
-    uTruth[0] = ~uTruth[0];
-    uTruth[1] = ~uTruth[1];
-    if ( fUseFast )
-        Map_CanonComputeFast( p, p->nVarsMax, pCut->nLeaves, uTruth, uPhases, uCanon );
-    else if ( fUseSlow )
-        Map_CanonComputeSlow( p->uTruths, p->nVarsMax, pCut->nLeaves, uTruth, uPhases, uCanon );
-    else if ( fUseRec )
-    {
-//        Map_CanonComputeSlow( p->uTruths, p->nVarsMax, pCut->nLeaves, uTruth, uPhases, uCanon );
-        Extra_TruthCanonFastN( p->nVarsMax, pCut->nLeaves, uTruth, &uCanon2, &pPhases2 );
+  Synopsis    [Derives the truth table for one cut.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Map_TruthsCut( Map_Man_t * p, Map_Cut_t * pCut )
+{ 
+//    unsigned uCanon1, uCanon2;
+    unsigned uTruth[2];
+    // generally speaking, 1-input cut can be matched into a wire!
+    if ( pCut->nLeaves == 1 )
+        return;
 /*
-        if ( uCanon[0] != uCanon2[0] || uPhases[0] != pPhases2[0] )
-        {
-            int k = 0;
-            Map_CanonCompute( p->nVarsMax, pCut->nLeaves, uTruth, &uCanon2, &pPhases2 );
-        }
-*/
-        uCanon[0] = uCanon2[0];
-        uCanon[1] = (p->nVarsMax == 6)? uCanon2[1] : uCanon2[0];
-        uPhases[0] = pPhases2[0];
+    if ( p->nVarsMax == 5 )
+    {
+        uTruth[0] = pCut->uTruth;
+        uTruth[1] = pCut->uTruth;
     }
     else
-        Map_CanonComputeSlow( p->uTruths, p->nVarsMax, pCut->nLeaves, uTruth, uPhases, uCanon );
-    pCut->M[0].pSupers = Map_SuperTableLookupC( p->pSuperLib, uCanon );
-    pCut->M[0].uPhase  = uPhases[0];
-    p->nCanons++;
-
+*/
+    Map_TruthsCutOne( p, pCut, uTruth );
+    // find the matches for the positive phase
+    pCut->M[1].pSupers = Map_TruthsCutMatch( p, pCut->nLeaves, uTruth, &pCut->M[1].uPhase );
+//uCanon1 = uCanon[0] & 0xFFFF;
+    // find the matches for the negative phase
+    uTruth[0] = ~uTruth[0];
+    uTruth[1] = ~uTruth[1];
+    pCut->M[0].pSupers = Map_TruthsCutMatch( p, pCut->nLeaves, uTruth, &pCut->M[0].uPhase );
 //uCanon2 = uCanon[0] & 0xFFFF;
 //assert( p->nVarsMax == 4 );
 //Rwt_Man4ExploreCount( uCanon1 < uCanon2 ? uCanon1 : uCanon2 );
-
     // restore the truth table
     uTruth[0] = ~uTruth[0];
     uTruth[1] = ~uTruth[1];
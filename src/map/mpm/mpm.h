@@ -60,6 +60,7 @@ struct Mpm_Par_t_
     void *           pScl;
     int              nNumCuts;
     int              DelayTarget;
+    int              nProcNum;
     int              fUseGates;
     int              fUseTruth;
     int              fUseDsd;
@@ -53,6 +53,7 @@ void Mpm_ManSetParsDefault( Mpm_Par_t * p )
     p->fCutMin        =      0;  // enables cut minimization
     p->fOneRound      =      0;  // enabled one round
     p->DelayTarget    =     -1;  // delay target
+    p->nProcNum       =      1;  // the number of threads
     p->fDeriveLuts    =      0;  // use truth tables to derive AIG structure
     p->fMap4Cnf       =      0;  // mapping for CNF
     p->fMap4Aig       =      0;  // mapping for AIG
@@ -138,6 +138,9 @@ struct Mpm_Man_t_
     unsigned         uPermMask[3];
     unsigned         uComplMask[3];
     Vec_Wec_t *      vNpnConfigs;
+    Vec_Wec_t *      vLevels;                  // nodes by level (multi-threaded mode)
+    Vec_Wec_t *      vFanouts;                 // node fanouts in the order of IDs (multi-threaded mode)
+    int              iObjCur;                  // the node whose cuts are derived (multi-threaded mode)
     // mapping attributes
     Vec_Int_t        vCutBests;                // cut best
     Vec_Int_t        vCutLists;                // cut list
@@ -250,6 +253,8 @@ extern void                  Mpm_LibLutFree( Mpm_LibLut_t * pLib );
 extern void                  Mpm_CutPrint( Mpm_Cut_t * pCut );
 extern void                  Mpm_ManPrepare( Mpm_Man_t * p );
 extern void                  Mpm_ManPerform( Mpm_Man_t * p );
+extern Vec_Wec_t *           Mpm_ManLevelize( Mig_Man_t * pMig );
+extern Vec_Wec_t *           Mpm_ManCollectFanouts( Mig_Man_t * pMig );
 /*=== mpmTruth.c ===========================================================*/
 extern int                   Mpm_CutComputeTruth( Mpm_Man_t * p, Mpm_Cut_t * pCut, Mpm_Cut_t * pCut0, Mpm_Cut_t * pCut1, Mpm_Cut_t * pCutC, int fCompl0, int fCompl1, int fComplC, int Type );
 
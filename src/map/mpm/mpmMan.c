@@ -91,6 +91,12 @@ Mpm_Man_t * Mpm_ManStart( Mig_Man_t * pMig, Mpm_Par_t * pPars )
         Mpm_ManPrecomputePerms( p );
         p->funcVar0 = 1;
     }
+    // levelize the nodes for multi-threaded cut computation
+    if ( p->pPars->nProcNum > 1 && !p->pPars->fUseTruth )
+    {
+        p->vLevels  = Mpm_ManLevelize( pMig );
+        p->vFanouts = Mpm_ManCollectFanouts( pMig );
+    }
     // finish
     p->timeTotal = Abc_Clock();
     pMig->pMan = p;
@@ -136,6 +142,8 @@ void Mpm_ManStop( Mpm_Man_t * p )
         Hsh_IntManStop( p->pHash );
     }
     Vec_WecFreeP( &p->vNpnConfigs );
+    Vec_WecFreeP( &p->vLevels );
+    Vec_WecFreeP( &p->vFanouts );
     Vec_PtrFree( p->vTemp );
     Mmr_StepStop( p->pManCuts );
     ABC_FREE( p->vFreeUnits.pArray );
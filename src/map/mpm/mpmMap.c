@@ -19,6 +19,7 @@
 ***********************************************************************/
 
 #include "mpmInt.h"
+#include "misc/util/utilPool.h"
 
 ABC_NAMESPACE_IMPL_START
 
@@ -28,6 +29,20 @@ ABC_NAMESPACE_IMPL_START
 
 //#define MIG_RUNTIME
 
+#define MPM_PAR_BATCH     4096    // the largest number of nodes processed in parallel
+#define MPM_PAR_CHUNK_MIN   64    // the smallest number of nodes given to a thread
+
+typedef struct Mpm_ThData_t_ Mpm_ThData_t;
+struct Mpm_ThData_t_
+{
+    Mpm_Man_t        Man;                      // the copy of the manager
+    void *           pFreeUnits[MPM_CUT_MAX+1];// free cut units of the copy
+    int *            pNodes;                   // the nodes to be processed
+    int              nNodes;                   // the number of nodes
+    Mpm_Uni_t *      pCuts;                    // the cuts derived for the nodes
+    int *            pnCuts;                   // the number of cuts of each node
+};
+
 ////////////////////////////////////////////////////////////////////////
 ///                     FUNCTION DEFINITIONS                         ///
 ////////////////////////////////////////////////////////////////////////
@@ -172,6 +187,21 @@ static inline int Mpm_CutGetArrTime( Mpm_Man_t * p, Mpm_Cut_t * pCut )
         ArrTime = Abc_MaxInt( ArrTime, pmTimes[iLeaf] + pDelays[i] );
     return ArrTime;
 }
+// the number of references of the leaf when the current node is reached in the order of IDs
+static inline int Mpm_ObjMigRefNumCur( Mpm_Man_t * p, int iLeaf )
+{
+    Vec_Int_t * vFanouts = Vec_WecEntry( p->vFanouts, iLeaf );
+    int iBeg = 0, iEnd = Vec_IntSize(vFanouts), iMid;
+    while ( iBeg < iEnd )
+    {
+        iMid = (iBeg + iEnd) / 2;
+        if ( Vec_IntEntry(vFanouts, iMid) < p->iObjCur )
+            iBeg = iMid + 1;
+        else
+            iEnd = iMid;
+    }
+    return Vec_IntEntry( &p->vMigRefs, iLeaf ) - iBeg;
+}
 static inline Mpm_Uni_t * Mpm_CutSetupInfo( Mpm_Man_t * p, Mpm_Cut_t * pCut, int ArrTime )  
 {
     int * pMigRefs = Vec_IntArray( &p->vMigRefs );
@@ -200,7 +230,7 @@ static inline Mpm_Uni_t * Mpm_CutSetupInfo( Mpm_Man_t * p, Mpm_Cut_t * pCut, int
             assert( pEstRefs[iLeaf] > 0 );
             pUnit->mArea += MPM_UNIT_REFS * pmArea[iLeaf] / pEstRefs[iLeaf];
             pUnit->mEdge += MPM_UNIT_REFS * pmEdge[iLeaf] / pEstRefs[iLeaf];
-            pUnit->mAveRefs += p->fMainRun ? pMapRefs[iLeaf] : pMigRefs[iLeaf];
+            pUnit->mAveRefs += p->fMainRun ? pMapRefs[iLeaf] : (p->iObjCur ? Mpm_ObjMigRefNumCur(p, iLeaf) : pMigRefs[iLeaf]);
         }
         pUnit->uSign |= ((word)1 << (iLeaf & 0x3F));
     }
@@ -544,23 +574,19 @@ void Mpm_ObjAddChoiceCutsToStore( Mpm_Man_t * p, Mig_Obj_t * pRoot, Mig_Obj_t *
     }
 }
 // create cuts at the node from storage
-void Mpm_ObjTranslateCutsFromStore( Mpm_Man_t * p, Mig_Obj_t * pObj )
+void Mpm_ObjTranslateCutsFromStore( Mpm_Man_t * p, Mig_Obj_t * pObj, Mpm_Uni_t ** ppStore, int nStore )
 {
     Mpm_Cut_t * pCut = NULL;
-    Mpm_Uni_t * pUnit;
     int i, *pList = Mpm_ObjCutListP( p, pObj );
-    assert( p->nCutStore > 0 && p->nCutStore <= p->nNumCuts );
+    assert( nStore > 0 && nStore <= p->nNumCuts );
     assert( *pList == 0 );
     // translate cuts
-    for ( i = 0; i < p->nCutStore; i++ )
+    for ( i = 0; i < nStore; i++ )
     {
-        pUnit  = p->pCutStore[i];
-        *pList = Mpm_CutCreate( p, &pUnit->pCut, &pCut );
+        *pList = Mpm_CutCreate( p, &ppStore[i]->pCut, &pCut );
         pList  = &pCut->hNext;
-        Vec_PtrPush( &p->vFreeUnits, pUnit );
     }
-    assert( Vec_PtrSize(&p->vFreeUnits) == p->nNumCuts + 1 );
-    if ( p->nCutStore == 1 && pCut->nLeaves < 2 )
+    if ( nStore == 1 && pCut->nLeaves < 2 )
         *pList = 0;
     else
         *pList = Mpm_CutCreateUnit( p, Mig_ObjId(pObj) );
@@ -577,7 +603,7 @@ void Mpm_ObjTranslateCutsFromStore( Mpm_Man_t * p, Mig_Obj_t * pObj )
   SeeAlso     []
 
 ***********************************************************************/
-int Mpm_ManDeriveCuts( Mpm_Man_t * p, Mig_Obj_t * pObj )
+static void Mpm_ObjDeriveCutStore( Mpm_Man_t * p, Mig_Obj_t * pObj )
 {
     Mpm_Cut_t * pCut0, * pCut1, * pCut2;
     int Required = Mpm_ObjRequired( p, pObj );
@@ -617,7 +643,7 @@ clk = Abc_Clock();
         for ( c1 = 0; c1 < p->nCuts[1] && (pCut1 = p->pCuts[1][c1]); c1++ )
             if ( Abc_TtCountOnes(p->pSigns[0][c0] | p->pSigns[1][c1]) <= p->nLutSize )
                 if ( !Mpm_ManExploreNewCut( p, pObj, pCut0, pCut1, NULL, Required ) )
-                    goto finish;
+                    return;
     }
     else if ( Mig_ObjIsNode3(pObj) )
     {
@@ -627,36 +653,258 @@ clk = Abc_Clock();
         for ( c2 = 0; c2 < p->nCuts[2] && (pCut2 = p->pCuts[2][c2]); c2++ )
             if ( Abc_TtCountOnes(p->pSigns[0][c0] | p->pSigns[1][c1] | p->pSigns[2][c2]) <= p->nLutSize )
                 if ( !Mpm_ManExploreNewCut( p, pObj, pCut0, pCut1, pCut2, Required ) )
-                    goto finish;
+                    return;
     }
     else assert( 0 );
 #ifdef MIG_RUNTIME
 p->timeDerive += Abc_Clock() - clk;
 #endif
-
-finish:
+}
+static void Mpm_ObjSaveCutStore( Mpm_Man_t * p, Mig_Obj_t * pObj, Mpm_Uni_t ** ppStore, int nStore )
+{
+    int Required = Mpm_ObjRequired( p, pObj );
+    int hCutBest = Mpm_ObjCutBest( p, pObj );
     // save best cut
-    assert( p->nCutStore > 0 );
-    if ( p->pCutStore[0]->mTime <= Required )
+    assert( nStore > 0 );
+    if ( ppStore[0]->mTime <= Required )
     {
         Mpm_Cut_t * pCut;
         if ( hCutBest )
             Mmr_StepRecycle( p->pManCuts, hCutBest );
-        hCutBest = Mpm_CutCreate( p, &p->pCutStore[0]->pCut, &pCut );
+        hCutBest = Mpm_CutCreate( p, &ppStore[0]->pCut, &pCut );
         Mpm_ObjSetCutBest( p, pObj, hCutBest );
-        Mpm_ObjSetTime( p, pObj, p->pCutStore[0]->mTime );
-        Mpm_ObjSetArea( p, pObj, p->pCutStore[0]->mArea );
-        Mpm_ObjSetEdge( p, pObj, p->pCutStore[0]->mEdge );
+        Mpm_ObjSetTime( p, pObj, ppStore[0]->mTime );
+        Mpm_ObjSetArea( p, pObj, ppStore[0]->mArea );
+        Mpm_ObjSetEdge( p, pObj, ppStore[0]->mEdge );
     }
     else assert( !p->fMainRun );
     assert( hCutBest > 0 );
     // transform internal storage into regular cuts
-    Mpm_ObjTranslateCutsFromStore( p, pObj );
+    Mpm_ObjTranslateCutsFromStore( p, pObj, ppStore, nStore );
     // dereference fanin cuts and reference node
     Mpm_ObjDerefFaninCuts( p, pObj );
+}
+int Mpm_ManDeriveCuts( Mpm_Man_t * p, Mig_Obj_t * pObj )
+{
+    int i;
+    Mpm_ObjDeriveCutStore( p, pObj );
+    Mpm_ObjSaveCutStore( p, pObj, p->pCutStore, p->nCutStore );
+    for ( i = 0; i < p->nCutStore; i++ )
+        Vec_PtrPush( &p->vFreeUnits, p->pCutStore[i] );
+    assert( Vec_PtrSize(&p->vFreeUnits) == p->nNumCuts + 1 );
     return 1;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Collects the fanouts whose cuts dereference the node.]
+
+  Description [The fanouts are listed in the order of IDs. They are used
+  to find the number of references of the cut leaves, which would be seen
+  by the node in the single-threaded mode.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Vec_Wec_t * Mpm_ManCollectFanouts( Mig_Man_t * pMig )
+{
+    Vec_Wec_t * vFanouts = Vec_WecStart( Mig_ManObjNum(pMig) );
+    Mig_Obj_t * pObj, * pFanin;
+    int i;
+    Mig_ManForEachNode( pMig, pObj )
+    {
+        Mig_ObjForEachFanin( pObj, pFanin, i )
+            if ( Mig_ObjIsNode(pFanin) )
+                Vec_WecPush( vFanouts, Mig_ObjId(pFanin), Mig_ObjId(pObj) );
+        if ( Mig_ObjSiblId(pObj) )
+            Vec_WecPush( vFanouts, Mig_ObjSiblId(pObj), Mig_ObjId(pObj) );
+    }
+    return vFanouts;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Collects the nodes by level.]
+
+  Description [The level of a node with a choice is larger than the level
+  of its sibling, because the cuts of the sibling are used at the node.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Vec_Wec_t * Mpm_ManLevelize( Mig_Man_t * pMig )
+{
+    Vec_Wec_t * vLevels;
+    Vec_Int_t * vLevel = Vec_IntStart( Mig_ManObjNum(pMig) );
+    Mig_Obj_t * pObj;
+    int i, iFanin, Level, LevelMax = 0;
+    Mig_ManForEachObj( pMig, pObj )
+    {
+        Level = 0;
+        Mig_ObjForEachFaninId( pObj, iFanin, i )
+            Level = Abc_MaxInt( Level, Vec_IntEntry(vLevel, iFanin) );
+        if ( Mig_ObjSiblId(pObj) )
+        {
+            assert( Mig_ObjSiblId(pObj) < Mig_ObjId(pObj) );
+            Level = Abc_MaxInt( Level, Vec_IntEntry(vLevel, Mig_ObjSiblId(pObj)) );
+        }
+        Level += Mig_ObjIsNode(pObj);
+        Vec_IntWriteEntry( vLevel, Mig_ObjId(pObj), Level );
+        LevelMax = Abc_MaxInt( LevelMax, Level );
+    }
+    vLevels = Vec_WecStart( LevelMax + 1 );
+    Mig_ManForEachNode( pMig, pObj )
+        Vec_WecPush( vLevels, Vec_IntEntry(vLevel, Mig_ObjId(pObj)), Mig_ObjId(pObj) );
+    Vec_IntFree( vLevel );
+    return vLevels;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Prepares the copy of the manager used by one thread.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Mpm_ManThDataStart( Mpm_Man_t * p, Mpm_ThData_t * pThData, Vec_Int_t * vMigRefs )
+{
+    Mpm_Man_t * pMan = &pThData->Man;
+    int i;
+    *pMan = *p;
+    pMan->vMigRefs   = *vMigRefs;
+    pMan->nCutStore  = 0;
+    pMan->vFreeUnits.nCap   = p->nNumCuts + 1;
+    pMan->vFreeUnits.nSize  = 0;
+    pMan->vFreeUnits.pArray = pThData->pFreeUnits;
+    for ( i = p->nNumCuts; i >= 0; i-- )
+        Vec_PtrPush( &pMan->vFreeUnits, pMan->pCutUnits + i );
+    pMan->nCutsMerged    = 0;
+    pMan->nCutsMergedAll = 0;
+    pMan->nSmallSupp     = 0;
+    pMan->nNonDsd        = 0;
+    pMan->nNoMatch       = 0;
+    memset( pMan->nCountDsd, 0, sizeof(p->nCountDsd) );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Derives the cuts of a chunk of nodes in one thread.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void * Mpm_ManLevelTask( void * pArg, Abc_Task_t * pTask )
+{
+    Mpm_ThData_t * pThData = (Mpm_ThData_t *)pArg;
+    Mpm_Man_t * p = &pThData->Man;
+    int i, k;
+    for ( i = 0; i < pThData->nNodes; i++ )
+    {
+        p->iObjCur = pThData->pNodes[i];
+        Mpm_ObjDeriveCutStore( p, Mig_ManObj(p->pMig, p->iObjCur) );
+        pThData->pnCuts[i] = p->nCutStore;
+        for ( k = 0; k < p->nCutStore; k++ )
+        {
+            pThData->pCuts[i * p->nNumCuts + k] = *p->pCutStore[k];
+            Vec_PtrPush( &p->vFreeUnits, p->pCutStore[k] );
+        }
+    }
+    return NULL;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Derives the cuts of the nodes level by level.]
+
+  Description [The nodes of one level depend only on the nodes of the
+  previous levels, so their cuts are derived in parallel. Each thread
+  merges the fanin cuts and evaluates them in its own copy of the manager
+  with private cut units, while the DSD class tables, which serve as the
+  NPN cache, are shared by all threads without locking because they are
+  not modified during mapping. The cut memory is shared, so the cuts are
+  saved and the fanin cuts are recycled by the calling thread in the order
+  of nodes. The cut leaves are evaluated using the references at the
+  beginning of the round, from which the fanouts preceding the node are
+  subtracted, as it happens in the single-threaded mode. As a result, the
+  mapping is the same as in the single-threaded mode.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Mpm_ManDeriveCutsLevels( Mpm_Man_t * p )
+{
+    Mpm_ThData_t * pThData;
+    Abc_Task_t ** ppTasks;
+    Vec_Int_t * vLevel, * vMigRefs;
+    Mpm_Uni_t * pStore, * ppStore[MPM_CUT_MAX+1];
+    int * pnCuts, nThreads = p->pPars->nProcNum, nNumCuts = p->nNumCuts;
+    int i, k, c, iStart, iBeg, nNodes, nTasks;
+    assert( p->vLevels != NULL && !p->pPars->fUseTruth );
+    vMigRefs = Vec_IntDup( &p->vMigRefs );
+    pStore  = ABC_ALLOC( Mpm_Uni_t, MPM_PAR_BATCH * nNumCuts );
+    pnCuts  = ABC_ALLOC( int, MPM_PAR_BATCH );
+    pThData = ABC_ALLOC( Mpm_ThData_t, nThreads );
+    ppTasks = ABC_ALLOC( Abc_Task_t *, nThreads );
+    Vec_WecForEachLevel( p->vLevels, vLevel, i )
+    for ( iBeg = 0; iBeg < Vec_IntSize(vLevel); iBeg += MPM_PAR_BATCH )
+    {
+        nNodes = Abc_MinInt( MPM_PAR_BATCH, Vec_IntSize(vLevel) - iBeg );
+        nTasks = Abc_MinInt( nThreads, Abc_MaxInt(1, nNodes / MPM_PAR_CHUNK_MIN) );
+        for ( k = 0; k < nTasks; k++ )
+        {
+            // the copy is refreshed to reset the statistics
+            Mpm_ManThDataStart( p, pThData + k, vMigRefs );
+            iStart = (int)((ABC_INT64_T)nNodes * k / nTasks);
+            pThData[k].pNodes = Vec_IntArray(vLevel) + iBeg + iStart;
+            pThData[k].nNodes = (int)((ABC_INT64_T)nNodes * (k + 1) / nTasks) - iStart;
+            pThData[k].pCuts  = pStore + iStart * nNumCuts;
+            pThData[k].pnCuts = pnCuts + iStart;
+        }
+        for ( k = 1; k < nTasks; k++ )
+            ppTasks[k] = Abc_TaskSubmit( Mpm_ManLevelTask, pThData + k );
+        Mpm_ManLevelTask( pThData, NULL );
+        for ( k = 1; k < nTasks; k++ )
+            Abc_TaskWait( ppTasks[k] );
+        // collect statistics
+        for ( k = 0; k < nTasks; k++ )
+        {
+            p->nCutsMerged    += pThData[k].Man.nCutsMerged;
+            p->nCutsMergedAll += pThData[k].Man.nCutsMergedAll;
+            p->nSmallSupp     += pThData[k].Man.nSmallSupp;
+            p->nNonDsd        += pThData[k].Man.nNonDsd;
+            p->nNoMatch       += pThData[k].Man.nNoMatch;
+            for ( c = 0; c < 600; c++ )
+                p->nCountDsd[c] += pThData[k].Man.nCountDsd[c];
+        }
+        // save the cuts
+        for ( k = 0; k < nNodes; k++ )
+        {
+            for ( c = 0; c < pnCuts[k]; c++ )
+                ppStore[c] = pStore + k * nNumCuts + c;
+            Mpm_ObjSaveCutStore( p, Mig_ManObj(p->pMig, Vec_IntEntry(vLevel, iBeg + k)), ppStore, pnCuts[k] );
+        }
+    }
+    Vec_IntFree( vMigRefs );
+    ABC_FREE( pStore );
+    ABC_FREE( pnCuts );
+    ABC_FREE( pThData );
+    ABC_FREE( ppTasks );
+}
+
 
 /**Function*************************************************************
 
@@ -816,8 +1064,13 @@ void Mpm_ManPerformRound( Mpm_Man_t * p )
         Mig_ObjMigRefDec( p, Mig_ObjFanin0(pObj) );
     // derive cuts
     p->nCutsMerged = 0;
-    Mig_ManForEachNode( p->pMig, pObj )
-        Mpm_ManDeriveCuts( p, pObj );
+    if ( p->vLevels )
+        Mpm_ManDeriveCutsLevels( p );
+    else
+    {
+        Mig_ManForEachNode( p->pMig, pObj )
+            Mpm_ManDeriveCuts( p, pObj );
+    }
     assert( Mig_ManCandNum(p->pMig) == p->pManCuts->nEntries );
     Mpm_ManFinalizeRound( p );
     // report results
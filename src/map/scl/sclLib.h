@@ -79,6 +79,7 @@ struct SC_SizePars_
     int        TimeOut;
     int        BuffTreeEst;      // ratio for buffer tree estimation
     int        BypassFreq;       // frequency to try bypassing
+    int        nProcNum;         // the number of threads
     int        fUseDept;
     int        fDumpStats;
     int        fUseWireLoads;
@@ -583,10 +584,12 @@ static inline void Scl_LibHandleInputDriver( SC_Cell * pCell, SC_Pair * pLoadIn,
 }
 
 /*=== sclLiberty.c ===============================================================*/
+extern Vec_Str_t *   Abc_SclReadLibertyStr( char * pFileName, int fVerbose, int fVeryVerbose );
 extern SC_Lib *      Abc_SclReadLiberty( char * pFileName, int fVerbose, int fVeryVerbose );
 /*=== sclLibScl.c ===============================================================*/
 extern SC_Lib *      Abc_SclReadFromStr( Vec_Str_t * vOut );
 extern SC_Lib *      Abc_SclReadFromFile( char * pFileName );
+extern SC_Lib *      Abc_SclReadLibertyCached( char * pFileName, int fVerbose, int fVeryVerbose );
 extern void          Abc_SclWriteScl( char * pFileName, SC_Lib * p );
 extern void          Abc_SclWriteLiberty( char * pFileName, SC_Lib * p );
 /*=== sclLibUtil.c ===============================================================*/
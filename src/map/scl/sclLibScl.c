@@ -24,6 +24,13 @@
 #include "bool/kit/kit.h"
 #include "misc/extra/extra.h"
 
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 ABC_NAMESPACE_IMPL_START
 
 
@@ -31,6 +38,9 @@ ABC_NAMESPACE_IMPL_START
 ///                        DECLARATIONS                              ///
 ////////////////////////////////////////////////////////////////////////
 
+#define SCL_CACHE_MAGIC  "ABCSCLC1"   // the first 8 bytes of the library cache
+#define SCL_CACHE_HEAD   24           // magic, source hash, image size, padding
+
 ////////////////////////////////////////////////////////////////////////
 ///                     FUNCTION DEFINITIONS                         ///
 ////////////////////////////////////////////////////////////////////////
@@ -249,36 +259,230 @@ SC_Lib * Abc_SclReadFromStr( Vec_Str_t * vOut )
     Abc_SclLinkCells( p );
     return p;
 }
-SC_Lib * Abc_SclReadFromFile( char * pFileName )
+
+/**Function*************************************************************
+
+  Synopsis    [Reads the contents of a file.]
+
+  Description [The file is mapped into memory, if possible. Otherwise,
+  it is read into a buffer.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static char * Abc_SclFileRead( char * pFileName, int * pnFileSize, int * pfMapped )
 {
-    SC_Lib * p;
     FILE * pFile;
-    Vec_Str_t * vOut;
+    char * pContents;
     int nFileSize;
+    *pnFileSize = *pfMapped = 0;
+#if !defined(_WIN32)
+    {
+        struct stat Stat;
+        void * pMap;
+        int fd = open( pFileName, O_RDONLY );
+        if ( fd < 0 )
+            return NULL;
+        if ( fstat( fd, &Stat ) == 0 && Stat.st_size > 0 && Stat.st_size <= 0x7FFFFFFF )
+        {
+            pMap = mmap( NULL, (size_t)Stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+            if ( pMap != MAP_FAILED )
+            {
+                close( fd );
+                *pnFileSize = (int)Stat.st_size;
+                *pfMapped = 1;
+                return (char *)pMap;
+            }
+        }
+        close( fd );
+    }
+#endif
     pFile = fopen( pFileName, "rb" );
     if ( pFile == NULL )
+        return NULL;
+    fseek( pFile, 0, SEEK_END );
+    nFileSize = ftell( pFile );
+    rewind( pFile );
+    if ( nFileSize <= 0 )
     {
-        printf( "Cannot open file \"%s\" for reading.\n", pFileName );
+        fclose( pFile );
+        return NULL;
+    }
+    pContents = ABC_ALLOC( char, nFileSize );
+    if ( (int)fread( pContents, 1, nFileSize, pFile ) != nFileSize )
+    {
+        ABC_FREE( pContents );
+        fclose( pFile );
         return NULL;
     }
-    // get the file size, in bytes
-    fseek( pFile, 0, SEEK_END );  
-    nFileSize = ftell( pFile );  
-    rewind( pFile ); 
-    // load the contents
-    vOut = Vec_StrAlloc( nFileSize );
-    vOut->nSize = vOut->nCap;
-    assert( nFileSize == Vec_StrSize(vOut) );
-    nFileSize = fread( Vec_StrArray(vOut), 1, Vec_StrSize(vOut), pFile );
-    assert( nFileSize == Vec_StrSize(vOut) );
     fclose( pFile );
+    *pnFileSize = nFileSize;
+    return pContents;
+}
+static void Abc_SclFileFree( char * pContents, int nFileSize, int fMapped )
+{
+#if !defined(_WIN32)
+    if ( fMapped )
+        munmap( pContents, (size_t)nFileSize );
+    else
+#endif
+        ABC_FREE( pContents );
+}
+SC_Lib * Abc_SclReadFromFile( char * pFileName )
+{
+    SC_Lib * p;
+    Vec_Str_t vOut;
+    char * pContents;
+    int nFileSize, fMapped;
+    pContents = Abc_SclFileRead( pFileName, &nFileSize, &fMapped );
+    if ( pContents == NULL )
+    {
+        printf( "Cannot open file \"%s\" for reading.\n", pFileName );
+        return NULL;
+    }
     // read the library
-    p = Abc_SclReadFromStr( vOut );
+    vOut.nCap   = vOut.nSize = nFileSize;
+    vOut.pArray = pContents;
+    p = Abc_SclReadFromStr( &vOut );
+    if ( p != NULL )
+        p->pFileName = Abc_UtilStrsav( pFileName );
+    if ( p != NULL )
+        Abc_SclLibNormalize( p );
+    Abc_SclFileFree( pContents, nFileSize, fMapped );
+    return p;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Reads Liberty library using the binary cache.]
+
+  Description [The cache file "<file>.cache" is written next to the 
+  Liberty file. It contains the hash of the Liberty file followed by the
+  library in the binary SCL format. When the hash matches, the cache is
+  mapped into memory and the library is read from it, skipping Liberty
+  parsing. Otherwise, the Liberty file is parsed and the cache is saved.
+  The file is written under a temporary name and renamed, so that other
+  runs see either the old or the new cache.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static word Abc_SclFileHash( char * pContents, int nFileSize )
+{
+    word uHash = (word)nFileSize, uWord;
+    int i;
+    for ( i = 0; i + 8 <= nFileSize; i += 8 )
+    {
+        memcpy( &uWord, pContents + i, 8 );
+        uHash = (uHash ^ uWord) * ABC_CONST(0x9E3779B97F4A7C15);
+        uHash ^= uHash >> 31;
+    }
+    for ( ; i < nFileSize; i++ )
+        uHash = (uHash ^ (unsigned char)pContents[i]) * ABC_CONST(0x9E3779B97F4A7C15);
+    return uHash;
+}
+static int Abc_SclCacheWrite( char * pCacheName, word uHash, Vec_Str_t * vStr )
+{
+    FILE * pFile;
+    char * pTemp;
+    int nSize = Vec_StrSize(vStr), Zero = 0;
+    pTemp = ABC_ALLOC( char, strlen(pCacheName) + 20 );
+#if !defined(_WIN32)
+    sprintf( pTemp, "%s.tmp%d", pCacheName, (int)getpid() );
+#else
+    sprintf( pTemp, "%s.tmp", pCacheName );
+#endif
+    pFile = fopen( pTemp, "wb" );
+    if ( pFile == NULL )
+    {
+        ABC_FREE( pTemp );
+        return 0;
+    }
+    fwrite( SCL_CACHE_MAGIC, 1, 8, pFile );
+    fwrite( &uHash, 8, 1, pFile );
+    fwrite( &nSize, 4, 1, pFile );
+    fwrite( &Zero, 4, 1, pFile );
+    fwrite( Vec_StrArray(vStr), 1, nSize, pFile );
+    if ( fclose( pFile ) != 0 )
+    {
+        remove( pTemp );
+        ABC_FREE( pTemp );
+        return 0;
+    }
+#if defined(_WIN32)
+    remove( pCacheName );
+#endif
+    if ( rename( pTemp, pCacheName ) != 0 )
+    {
+        remove( pTemp );
+        ABC_FREE( pTemp );
+        return 0;
+    }
+    ABC_FREE( pTemp );
+    return 1;
+}
+SC_Lib * Abc_SclReadLibertyCached( char * pFileName, int fVerbose, int fVeryVerbose )
+{
+    SC_Lib * p = NULL;
+    Vec_Str_t vOut, * vStr;
+    char * pCacheName, * pContents;
+    int nFileSize, fMapped;
+    abctime clk = Abc_Clock();
+    word uHash;
+    // hash the Liberty file
+    pContents = Abc_SclFileRead( pFileName, &nFileSize, &fMapped );
+    if ( pContents == NULL )
+        return Abc_SclReadLiberty( pFileName, fVerbose, fVeryVerbose );
+    uHash = Abc_SclFileHash( pContents, nFileSize );
+    Abc_SclFileFree( pContents, nFileSize, fMapped );
+    // read the library from the cache
+    pCacheName = ABC_ALLOC( char, strlen(pFileName) + 10 );
+    sprintf( pCacheName, "%s.cache", pFileName );
+    pContents = Abc_SclFileRead( pCacheName, &nFileSize, &fMapped );
+    if ( pContents != NULL )
+    {
+        if ( nFileSize > SCL_CACHE_HEAD && !memcmp(pContents, SCL_CACHE_MAGIC, 8) && !memcmp(pContents + 8, &uHash, 8) && 
+             *(int *)(pContents + 16) == nFileSize - SCL_CACHE_HEAD )
+        {
+            vOut.nCap   = vOut.nSize = nFileSize - SCL_CACHE_HEAD;
+            vOut.pArray = pContents + SCL_CACHE_HEAD;
+            p = Abc_SclReadFromStr( &vOut );
+        }
+        Abc_SclFileFree( pContents, nFileSize, fMapped );
+    }
     if ( p != NULL )
+    {
         p->pFileName = Abc_UtilStrsav( pFileName );
+        Abc_SclLibNormalize( p );
+        if ( fVerbose )
+        {
+            printf( "Library \"%s\" from \"%s\" has %d cells (read from \"%s\").  ", p->pName, pFileName, SC_LibCellNum(p), pCacheName );
+            Abc_PrintTime( 1, "Time", Abc_Clock() - clk );
+        }
+        ABC_FREE( pCacheName );
+        return p;
+    }
+    // parse the Liberty file and update the cache
+    vStr = Abc_SclReadLibertyStr( pFileName, fVerbose, fVeryVerbose );
+    if ( vStr == NULL )
+    {
+        ABC_FREE( pCacheName );
+        return NULL;
+    }
+    if ( !Abc_SclCacheWrite( pCacheName, uHash, vStr ) && fVerbose )
+        printf( "Cannot write the library cache into file \"%s\".\n", pCacheName );
+    p = Abc_SclReadFromStr( vStr );
     if ( p != NULL )
+    {
+        p->pFileName = Abc_UtilStrsav( pFileName );
         Abc_SclLibNormalize( p );
-    Vec_StrFree( vOut );
+    }
+    Vec_StrFree( vStr );
+    ABC_FREE( pCacheName );
     return p;
 }
 
@@ -22,6 +22,7 @@
 #include "map/mio/mio.h"
 #include "misc/vec/vecWec.h"
 #include "base/main/main.h"
+#include "misc/util/utilPool.h"
 
 #ifdef WIN32
 #include <windows.h>
@@ -33,6 +34,18 @@ ABC_NAMESPACE_IMPL_START
 ////////////////////////////////////////////////////////////////////////
 ///                        DECLARATIONS                              ///
 ////////////////////////////////////////////////////////////////////////
+
+// the smallest number of nodes given to one thread
+#define SCL_PAR_CHUNK_MIN  64
+
+typedef struct Abc_SclParThData_t_ Abc_SclParThData_t;
+struct Abc_SclParThData_t_
+{
+    SC_Man         Man;           // private copy of the manager
+    int *          pNodes;        // nodes processed by this thread
+    int            nNodes;        // the number of nodes
+    int            fDept;         // computing departure times
+};
 
 ////////////////////////////////////////////////////////////////////////
 ///                     FUNCTION DEFINITIONS                         ///
@@ -397,6 +410,148 @@ void Abc_SclTimeCone( SC_Man * p, Vec_Int_t * vCone )
         printf( "after (%6.1f ps  %6.1f ps)\n", Abc_SclObjTimeOne(p, pObj, 1), Abc_SclObjTimeOne(p, pObj, 0) );
     }
 }
+
+/**Function*************************************************************
+
+  Synopsis    [Computes the departure time of the object from its fanouts.]
+
+  Description [Abc_SclTimeNode() called with fDept = 1 updates the
+  departure times of the fanins of the node. This procedure computes the
+  departure time of the object by looking at its fanouts instead, so that
+  only the object itself is modified. The load and the departure time of
+  a fanout, adjusted by the buffer tree estimation, are kept in local
+  variables. The result is the maximum over the same timing arcs and does
+  not depend on the order in which they are visited.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline void Abc_SclDeptNodeFanouts( SC_Man * p, Abc_Obj_t * pObj )
+{
+    SC_Pair Load, Dept;
+    Abc_Obj_t * pFanout, * pFanin;
+    float Value;
+    int i, k;
+    Abc_ObjForEachFanout( pObj, pFanout, i )
+    {
+        if ( !Abc_ObjIsNode(pFanout) )
+            continue;
+        Load  = *Abc_SclObjLoad( p, pFanout );
+        Dept  = *Abc_SclObjDept( p, pFanout );
+        Value = p->EstLoadMax ? Abc_SclObjLoadValue( p, pFanout ) : 0;
+        if ( p->EstLoadMax && Value > 1 )
+        {
+            float EstDelta = p->EstLinear * log( Value );
+            Load.rise = p->EstLoadAve * p->EstLoadMax;
+            Load.fall = p->EstLoadAve * p->EstLoadMax;
+            Dept.rise += EstDelta;
+            Dept.fall += EstDelta;
+        }
+        Abc_ObjForEachFanin( pFanout, pFanin, k )
+            if ( pFanin == pObj )
+                Scl_LibPinDeparture( Scl_CellPinTime(Abc_SclObjCell(pFanout), k), Abc_SclObjDept(p, pObj), Abc_SclObjSlew(p, pObj), &Load, &Dept );
+    }
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Computes timing of the internal nodes level by level.]
+
+  Description [The arrival times of the nodes of one level depend only on
+  the nodes of the lower levels, and their departure times depend only on
+  the nodes of the higher levels, so the nodes of one level are processed
+  in parallel. Each thread works with a private copy of the manager, which
+  differs only in the number of estimated nodes. The departure times are
+  computed from the fanouts (see Abc_SclDeptNodeFanouts), so the timing
+  does not depend on the number of threads.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static Vec_Wec_t * Abc_SclLevelizeNodes( SC_Man * p )
+{
+    Vec_Wec_t * vLevels = Vec_WecAlloc( 100 );
+    Vec_Int_t * vObjLevels = Vec_IntStart( Abc_NtkObjNumMax(p->pNtk) );
+    Abc_Obj_t * pObj, * pFanin;
+    int i, k, Level;
+    Abc_NtkForEachNode1( p->pNtk, pObj, i )
+    {
+        Level = 0;
+        Abc_ObjForEachFanin( pObj, pFanin, k )
+            Level = Abc_MaxInt( Level, Vec_IntEntry(vObjLevels, Abc_ObjId(pFanin)) );
+        Vec_IntWriteEntry( vObjLevels, i, Level + 1 );
+        Vec_WecPush( vLevels, Level, i );
+    }
+    Vec_IntFree( vObjLevels );
+    return vLevels;
+}
+static void * Abc_SclTimeLevelTask( void * pArg, Abc_Task_t * pTask )
+{
+    Abc_SclParThData_t * pThData = (Abc_SclParThData_t *)pArg;
+    SC_Man * p = &pThData->Man;
+    Abc_Obj_t * pObj;
+    int i;
+    for ( i = 0; i < pThData->nNodes; i++ )
+    {
+        pObj = Abc_NtkObj( p->pNtk, pThData->pNodes[i] );
+        if ( !pThData->fDept )
+        {
+            Abc_SclTimeNode( p, pObj, 0 );
+            continue;
+        }
+        Abc_SclDeptNodeFanouts( p, pObj );
+        if ( p->EstLoadMax && Abc_SclObjLoadValue(p, pObj) > 1 )
+            p->nEstNodes++;
+    }
+    return NULL;
+}
+static void Abc_SclTimeNtkLevels( SC_Man * p, int fDept )
+{
+    Abc_SclParThData_t * pThData;
+    Abc_Task_t ** ppTasks;
+    Vec_Wec_t * vLevels = Abc_SclLevelizeNodes( p );
+    Vec_Int_t * vLevel;
+    Abc_Obj_t * pObj;
+    int i, k, iStart, nNodes, nTasks, nThreads = p->nProcNum;
+    pThData = ABC_ALLOC( Abc_SclParThData_t, nThreads );
+    ppTasks = ABC_ALLOC( Abc_Task_t *, nThreads );
+    for ( i = 0; i < Vec_WecSize(vLevels); i++ )
+    {
+        vLevel = Vec_WecEntry( vLevels, fDept ? Vec_WecSize(vLevels) - 1 - i : i );
+        nNodes = Vec_IntSize(vLevel);
+        nTasks = Abc_MinInt( nThreads, Abc_MaxInt(1, nNodes / SCL_PAR_CHUNK_MIN) );
+        for ( k = 0; k < nTasks; k++ )
+        {
+            pThData[k].Man = *p;
+            pThData[k].Man.nEstNodes = 0;
+            iStart = (int)((ABC_INT64_T)nNodes * k / nTasks);
+            pThData[k].pNodes = Vec_IntArray(vLevel) + iStart;
+            pThData[k].nNodes = (int)((ABC_INT64_T)nNodes * (k + 1) / nTasks) - iStart;
+            pThData[k].fDept  = fDept;
+        }
+        for ( k = 1; k < nTasks; k++ )
+            ppTasks[k] = Abc_TaskSubmit( Abc_SclTimeLevelTask, pThData + k );
+        Abc_SclTimeLevelTask( pThData, NULL );
+        for ( k = 1; k < nTasks; k++ )
+            Abc_TaskWait( ppTasks[k] );
+        for ( k = 0; k < nTasks; k++ )
+            p->nEstNodes += pThData[k].Man.nEstNodes;
+    }
+    // the departure times of the CIs and the constant nodes
+    if ( fDept )
+    {
+        Abc_NtkForEachObj( p->pNtk, pObj, i )
+            if ( Abc_ObjIsCi(pObj) || (Abc_ObjIsNode(pObj) && Abc_ObjFaninNum(pObj) == 0) )
+                Abc_SclDeptNodeFanouts( p, pObj );
+    }
+    ABC_FREE( pThData );
+    ABC_FREE( ppTasks );
+    Vec_WecFree( vLevels );
+}
 void Abc_SclTimeNtkRecompute( SC_Man * p, float * pArea, float * pDelay, int fReverse, float DUser )
 {
     Abc_Obj_t * pObj;
@@ -407,6 +562,9 @@ void Abc_SclTimeNtkRecompute( SC_Man * p, float * pArea, float * pDelay, int fRe
     p->nEstNodes = 0;
     Abc_NtkForEachCi( p->pNtk, pObj, i )
         Abc_SclTimeNode( p, pObj, 0 );
+    if ( p->nProcNum > 1 )
+        Abc_SclTimeNtkLevels( p, 0 );
+    else
     Abc_NtkForEachNode1( p->pNtk, pObj, i )
         Abc_SclTimeNode( p, pObj, 0 );
     Abc_NtkForEachCo( p->pNtk, pObj, i )
@@ -421,6 +579,9 @@ void Abc_SclTimeNtkRecompute( SC_Man * p, float * pArea, float * pDelay, int fRe
     if ( fReverse )
     {
         p->nEstNodes = 0;
+        if ( p->nProcNum > 1 )
+            Abc_SclTimeNtkLevels( p, 1 );
+        else
         Abc_NtkForEachNodeReverse1( p->pNtk, pObj, i )
             Abc_SclTimeNode( p, pObj, 1 );
     }
@@ -630,9 +791,10 @@ void Abc_SclManReadSlewAndLoad( SC_Man * p, Abc_Ntk_t * pNtk )
   SeeAlso     []
 
 ***********************************************************************/
-SC_Man * Abc_SclManStart( SC_Lib * pLib, Abc_Ntk_t * pNtk, int fUseWireLoads, int fDept, float DUser, int nTreeCRatio )
+SC_Man * Abc_SclManStart( SC_Lib * pLib, Abc_Ntk_t * pNtk, int fUseWireLoads, int fDept, float DUser, int nTreeCRatio, int nProcNum )
 {
     SC_Man * p = Abc_SclManAlloc( pLib, pNtk );
+    p->nProcNum = Abc_MaxInt( nProcNum, 1 );
     if ( nTreeCRatio )
     {
         p->EstLoadMax = 0.01 * nTreeCRatio;  // max ratio of Cout/Cave when the estimation is used
@@ -668,10 +830,10 @@ SC_Man * Abc_SclManStart( SC_Lib * pLib, Abc_Ntk_t * pNtk, int fUseWireLoads, in
   SeeAlso     []
 
 ***********************************************************************/
-void Abc_SclTimePerformInt( SC_Lib * pLib, Abc_Ntk_t * pNtk, int nTreeCRatio, int fUseWireLoads, int fShowAll, int fPrintPath, int fDumpStats )
+void Abc_SclTimePerformInt( SC_Lib * pLib, Abc_Ntk_t * pNtk, int nTreeCRatio, int fUseWireLoads, int fShowAll, int fPrintPath, int fDumpStats, int nProcNum )
 {
     SC_Man * p;
-    p = Abc_SclManStart( pLib, pNtk, fUseWireLoads, 1, 0, nTreeCRatio );
+    p = Abc_SclManStart( pLib, pNtk, fUseWireLoads, 1, 0, nTreeCRatio, nProcNum );
     Abc_SclTimeNtkPrint( p, fShowAll, fPrintPath );
     if ( fDumpStats )
         Abc_SclDumpStats( p, "stats.txt", 0 );
@@ -689,12 +851,12 @@ void Abc_SclTimePerformInt( SC_Lib * pLib, Abc_Ntk_t * pNtk, int nTreeCRatio, in
   SeeAlso     []
 
 ***********************************************************************/
-void Abc_SclTimePerform( SC_Lib * pLib, Abc_Ntk_t * pNtk, int nTreeCRatio, int fUseWireLoads, int fShowAll, int fPrintPath, int fDumpStats )
+void Abc_SclTimePerform( SC_Lib * pLib, Abc_Ntk_t * pNtk, int nTreeCRatio, int fUseWireLoads, int fShowAll, int fPrintPath, int fDumpStats, int nProcNum )
 {
     Abc_Ntk_t * pNtkNew = pNtk;
     if ( pNtk->nBarBufs2 > 0 )
         pNtkNew = Abc_NtkDupDfsNoBarBufs( pNtk );
-    Abc_SclTimePerformInt( pLib, pNtkNew, nTreeCRatio, fUseWireLoads, fShowAll, fPrintPath, fDumpStats );
+    Abc_SclTimePerformInt( pLib, pNtkNew, nTreeCRatio, fUseWireLoads, fShowAll, fPrintPath, fDumpStats, nProcNum );
     if ( pNtk->nBarBufs2 > 0 )
         Abc_NtkDelete( pNtkNew );
 }
@@ -899,7 +1061,7 @@ void Abc_SclPrintBuffers( SC_Lib * pLib, Abc_Ntk_t * pNtk, int fVerbose )
     int fUseWireLoads = 0;
     SC_Man * p;
     assert( Abc_NtkIsMappedLogic(pNtk) );
-    p = Abc_SclManStart( pLib, pNtk, fUseWireLoads, 1, 0, 10000 ); 
+    p = Abc_SclManStart( pLib, pNtk, fUseWireLoads, 1, 0, 10000, 1 ); 
     Abc_SclPrintBufferTrees( p, pNtk ); 
 //    Abc_SclPrintFaninPairs( p, pNtk );
     Abc_SclManFree( p );
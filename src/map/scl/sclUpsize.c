@@ -19,6 +19,7 @@
 ***********************************************************************/
 
 #include "sclSize.h"
+#include "misc/util/utilPool.h"
 
 ABC_NAMESPACE_IMPL_START
 
@@ -27,6 +28,24 @@ ABC_NAMESPACE_IMPL_START
 ///                        DECLARATIONS                              ///
 ////////////////////////////////////////////////////////////////////////
 
+// the smallest number of candidates given to one thread
+#define SCL_UPS_CHUNK_MIN  4
+
+typedef struct Abc_SclUpsThData_t_ Abc_SclUpsThData_t;
+struct Abc_SclUpsThData_t_
+{
+    SC_Man         Man;           // private copy of the manager
+    Vec_Int_t *    vCands;        // candidate nodes
+    Vec_Wec_t *    vRecalcs;      // nodes to recompute for each candidate
+    Vec_Wec_t *    vEvals;        // nodes to evaluate for each candidate
+    int *          pBatch;        // candidates evaluated by this thread
+    int            nBatch;        // the number of candidates
+    int            Notches;       // limit on upsizing steps
+    int            DelayGap;      // delay gap
+    int *          pGates;        // the best gate of each candidate
+    float *        pGains;        // the best gain of each candidate
+};
+
 ////////////////////////////////////////////////////////////////////////
 ///                     FUNCTION DEFINITIONS                         ///
 ////////////////////////////////////////////////////////////////////////
@@ -322,6 +341,185 @@ int Abc_SclFindBestCell( SC_Man * p, Abc_Obj_t * pObj, Vec_Int_t * vRecalcs, Vec
     return gateBest;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Evaluates upsizing of the critical nodes in parallel.]
+
+  Description [Abc_SclFindBestCell() tries the gates of the node while
+  temporarily changing the loads of its fanins and the timing of the
+  window, and restores them afterwards. Two candidates are evaluated at
+  the same time only if neither of them changes an object whose timing
+  or load is used by the other one. The candidates are grouped into such
+  conflict-free batches in the order of the critical nodes; a candidate
+  conflicting with the current batch goes to one of the next batches.
+  Each thread has a private copy of the manager with its own backup
+  storage. Since every evaluation starts and ends with the same timing,
+  the gains do not depend on the number of threads.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline int Abc_SclUpsizeWindowConflicts( SC_Man * p, Abc_Obj_t * pPivot, Vec_Int_t * vRecalcs, Vec_Int_t * vWrite, Vec_Int_t * vRead, int Stamp )
+{
+    Abc_Obj_t * pObj, * pFanin;
+    int i, k;
+    // objects whose load or timing is changed
+    Abc_ObjForEachFanin( pPivot, pFanin, k )
+        if ( Vec_IntEntry(vRead, Abc_ObjId(pFanin)) == Stamp )
+            return 1;
+    Abc_NtkForEachObjVec( vRecalcs, p->pNtk, pObj, i )
+    {
+        if ( Vec_IntEntry(vRead, Abc_ObjId(pObj)) == Stamp )
+            return 1;
+        // objects whose timing is used
+        Abc_ObjForEachFanin( pObj, pFanin, k )
+            if ( Vec_IntEntry(vWrite, Abc_ObjId(pFanin)) == Stamp )
+                return 1;
+    }
+    return 0;
+}
+static inline void Abc_SclUpsizeWindowMark( SC_Man * p, Abc_Obj_t * pPivot, Vec_Int_t * vRecalcs, Vec_Int_t * vWrite, Vec_Int_t * vRead, int Stamp )
+{
+    Abc_Obj_t * pObj, * pFanin;
+    int i, k;
+    Abc_ObjForEachFanin( pPivot, pFanin, k )
+    {
+        Vec_IntWriteEntry( vWrite, Abc_ObjId(pFanin), Stamp );
+        Vec_IntWriteEntry( vRead,  Abc_ObjId(pFanin), Stamp );
+    }
+    Abc_NtkForEachObjVec( vRecalcs, p->pNtk, pObj, i )
+    {
+        Vec_IntWriteEntry( vWrite, Abc_ObjId(pObj), Stamp );
+        Vec_IntWriteEntry( vRead,  Abc_ObjId(pObj), Stamp );
+        Abc_ObjForEachFanin( pObj, pFanin, k )
+            Vec_IntWriteEntry( vRead, Abc_ObjId(pFanin), Stamp );
+    }
+}
+static void * Abc_SclUpsizeEvalTask( void * pArg, Abc_Task_t * pTask )
+{
+    Abc_SclUpsThData_t * pThData = (Abc_SclUpsThData_t *)pArg;
+    SC_Man * p = &pThData->Man;
+    Abc_Obj_t * pObj;
+    int i, c;
+    for ( i = 0; i < pThData->nBatch; i++ )
+    {
+        c = pThData->pBatch[i];
+        pObj = Abc_NtkObj( p->pNtk, Vec_IntEntry(pThData->vCands, c) );
+        pThData->pGates[c] = Abc_SclFindBestCell( p, pObj, Vec_WecEntry(pThData->vRecalcs, c), Vec_WecEntry(pThData->vEvals, c), pThData->Notches, pThData->DelayGap, pThData->pGains + c );
+    }
+    return NULL;
+}
+static void Abc_SclFindUpsizesPar( SC_Man * p, Vec_Int_t * vPathNodes, int Notches, int iIter, int DelayGap )
+{
+    Abc_SclUpsThData_t * pThData;
+    Abc_Task_t ** ppTasks;
+    Vec_Int_t * vCands, * vBatch, * vWrite, * vRead, * vTemp, * vTemp2;
+    Vec_Wec_t * vRecalcs, * vEvals;
+    Abc_Obj_t * pObj;
+    int * pGates, * pDone;
+    float * pGains;
+    int i, k, c, iIterLast, iStart, nTasks, nDone = 0, Stamp = 0, nThreads = p->nProcNum;
+    // collect the candidates and their windows
+    vCands   = Vec_IntAlloc( Vec_IntSize(vPathNodes) );
+    vRecalcs = Vec_WecAlloc( Vec_IntSize(vPathNodes) );
+    vEvals   = Vec_WecAlloc( Vec_IntSize(vPathNodes) );
+    Abc_NtkForEachObjVec( vPathNodes, p->pNtk, pObj, i )
+    {
+        assert( pObj->fMarkB == 0 );
+        iIterLast = Vec_IntEntry(p->vNodeIter, Abc_ObjId(pObj));
+        if ( iIterLast >= 0 && iIterLast + 5 > iIter )
+            continue;
+        Vec_IntPush( vCands, Abc_ObjId(pObj) );
+        vTemp  = Vec_WecPushLevel( vRecalcs );
+        vTemp2 = Vec_WecPushLevel( vEvals );
+        Abc_SclFindNodesToUpdate( pObj, &vTemp, &vTemp2, NULL );
+        assert( Vec_IntSize(vTemp2) > 0 );
+    }
+    pGates  = ABC_FALLOC( int, Vec_IntSize(vCands) );
+    pGains  = ABC_CALLOC( float, Vec_IntSize(vCands) );
+    pDone   = ABC_CALLOC( int, Vec_IntSize(vCands) );
+    vBatch  = Vec_IntAlloc( Vec_IntSize(vCands) );
+    vWrite  = Vec_IntStart( Abc_NtkObjNumMax(p->pNtk) );
+    vRead   = Vec_IntStart( Abc_NtkObjNumMax(p->pNtk) );
+    pThData = ABC_CALLOC( Abc_SclUpsThData_t, nThreads );
+    ppTasks = ABC_ALLOC( Abc_Task_t *, nThreads );
+    for ( k = 0; k < nThreads; k++ )
+    {
+        pThData[k].Man = *p;
+        pThData[k].Man.vLoads2 = Vec_FltAlloc( 100 );
+        pThData[k].Man.vTimes2 = Vec_FltAlloc( 100 );
+        pThData[k].Man.vTimes3 = Vec_FltAlloc( 100 );
+        pThData[k].Man.nEstNodes = 0;
+        pThData[k].vCands   = vCands;
+        pThData[k].vRecalcs = vRecalcs;
+        pThData[k].vEvals   = vEvals;
+        pThData[k].Notches  = Notches;
+        pThData[k].DelayGap = DelayGap;
+        pThData[k].pGates   = pGates;
+        pThData[k].pGains   = pGains;
+    }
+    // evaluate the candidates in conflict-free batches
+    while ( nDone < Vec_IntSize(vCands) )
+    {
+        Stamp++;
+        Vec_IntClear( vBatch );
+        Vec_IntForEachEntry( vCands, i, c )
+        {
+            if ( pDone[c] )
+                continue;
+            pObj = Abc_NtkObj( p->pNtk, i );
+            if ( Abc_SclUpsizeWindowConflicts( p, pObj, Vec_WecEntry(vRecalcs, c), vWrite, vRead, Stamp ) )
+                continue;
+            Abc_SclUpsizeWindowMark( p, pObj, Vec_WecEntry(vRecalcs, c), vWrite, vRead, Stamp );
+            Vec_IntPush( vBatch, c );
+            pDone[c] = 1;
+            nDone++;
+        }
+        nTasks = Abc_MinInt( nThreads, Abc_MaxInt(1, Vec_IntSize(vBatch) / SCL_UPS_CHUNK_MIN) );
+        for ( k = 0; k < nTasks; k++ )
+        {
+            iStart = (int)((ABC_INT64_T)Vec_IntSize(vBatch) * k / nTasks);
+            pThData[k].pBatch = Vec_IntArray(vBatch) + iStart;
+            pThData[k].nBatch = (int)((ABC_INT64_T)Vec_IntSize(vBatch) * (k + 1) / nTasks) - iStart;
+        }
+        for ( k = 1; k < nTasks; k++ )
+            ppTasks[k] = Abc_TaskSubmit( Abc_SclUpsizeEvalTask, pThData + k );
+        Abc_SclUpsizeEvalTask( pThData, NULL );
+        for ( k = 1; k < nTasks; k++ )
+            Abc_TaskWait( ppTasks[k] );
+    }
+    // remember savings in the order of the critical nodes
+    Vec_IntForEachEntry( vCands, i, c )
+    {
+        if ( pGates[c] < 0 )
+            continue;
+        assert( pGains[c] > 0.0 );
+        Vec_FltWriteEntry( p->vNode2Gain, i, pGains[c] );
+        Vec_IntWriteEntry( p->vNode2Gate, i, pGates[c] );
+        Vec_QuePush( p->vNodeByGain, i );
+    }
+    for ( k = 0; k < nThreads; k++ )
+    {
+        p->nEstNodes += pThData[k].Man.nEstNodes;
+        Vec_FltFree( pThData[k].Man.vLoads2 );
+        Vec_FltFree( pThData[k].Man.vTimes2 );
+        Vec_FltFree( pThData[k].Man.vTimes3 );
+    }
+    ABC_FREE( pThData );
+    ABC_FREE( ppTasks );
+    ABC_FREE( pGates );
+    ABC_FREE( pGains );
+    ABC_FREE( pDone );
+    Vec_IntFree( vCands );
+    Vec_IntFree( vBatch );
+    Vec_IntFree( vWrite );
+    Vec_IntFree( vRead );
+    Vec_WecFree( vRecalcs );
+    Vec_WecFree( vEvals );
+}
+
 /**Function*************************************************************
 
   Synopsis    [Computes the set of gates to upsize.]
@@ -606,6 +804,9 @@ int Abc_SclFindUpsizes( SC_Man * p, Vec_Int_t * vPathNodes, int Ratio, int Notch
     vRecalcs = Vec_IntAlloc( 100 );
     vEvals = Vec_IntAlloc( 100 );
     Vec_QueClear( p->vNodeByGain );
+    if ( p->nProcNum > 1 )
+        Abc_SclFindUpsizesPar( p, vPathNodes, Notches, iIter, DelayGap );
+    else
     Abc_NtkForEachObjVec( vPathNodes, p->pNtk, pObj, i )
     {
         assert( pObj->fMarkB == 0 );
@@ -883,14 +1084,15 @@ void Abc_SclUpsizePerformInt( SC_Lib * pLib, Abc_Ntk_t * pNtk, SC_SizePars * pPa
         printf( "UseWL =%2d. ",           pPars->fUseWireLoads );
         printf( "Target =%5d ps. ",       pPars->DelayUser );
         printf( "DelayGap =%3d ps. ",     pPars->DelayGap );
-        printf( "Timeout =%4d sec",       pPars->TimeOut  );
+        printf( "Timeout =%4d sec. ",     pPars->TimeOut  );
+        printf( "Threads =%3d",           pPars->nProcNum );
         printf( "\n" );
     }
     // increase window for larger networks
     if ( pPars->Window == 1 )
         pPars->Window += (Abc_NtkNodeNum(pNtk) > 40000);
     // prepare the manager; collect init stats
-    p = Abc_SclManStart( pLib, pNtk, pPars->fUseWireLoads, pPars->fUseDept, 0, pPars->BuffTreeEst );
+    p = Abc_SclManStart( pLib, pNtk, pPars->fUseWireLoads, pPars->fUseDept, 0, pPars->BuffTreeEst, pPars->nProcNum );
     p->timeTotal  = Abc_Clock();
     assert( p->vGatesBest == NULL );
     p->vGatesBest = Vec_IntDup( p->pNtk->vGates );
@@ -18,6 +18,11 @@
 
 #include <math.h>
 #include "superInt.h"
+#include "misc/util/utilPool.h"
+
+#if !defined(_WIN32)
+#include <unistd.h>
+#endif
 
 ABC_NAMESPACE_IMPL_START
 
@@ -32,6 +37,9 @@ ABC_NAMESPACE_IMPL_START
 #define SUPER_NO_VAR         (-9999.0)
 #define SUPER_EPSILON        (0.001)
 
+#define SUPER_PAR_BINS       (1<<14)      // the number of bins in the thread-local table
+#define SUPER_CACHE_MAGIC    "ABCSUPC1"   // the first 8 bytes of the supergate cache
+
 // data structure for supergate precomputation
 typedef struct Super_ManStruct_t_     Super_Man_t;   // manager
 typedef struct Super_GateStruct_t_    Super_Gate_t;  // supergate
@@ -48,6 +56,7 @@ struct Super_ManStruct_t_
     float               tAreaMax;     // the max area of the supergates in the library
     int                 fSkipInv;     // the flag says about skipping inverters
     int                 fWriteOldFormat; // in addition, writes the file in the old format
+    int                 nProcNum;     // the number of threads
     int                 fVerbose;
 
     // supergates
@@ -93,6 +102,47 @@ struct Super_GateStruct_t_
 };
 
 
+// candidate supergate derived by a thread
+typedef struct Super_Cand_t_          Super_Cand_t;
+struct Super_Cand_t_
+{
+    unsigned            uTruth[2];    // the truth table
+    float               Area;         // the area
+    float               tDelayMax;    // the maximum delay
+    float               ptDelays[6];  // the pin-to-pin delays for all inputs
+    int                 pFanins[6];   // the fanins (indexes in the array of considered gates)
+    int                 iNext;        // the next candidate in the thread-local table
+    int                 fDead;        // the candidate is dominated by another one
+};
+
+// thread data for enumerating supergates with the given root gate
+typedef struct Super_ThData_t_        Super_ThData_t;
+struct Super_ThData_t_
+{
+    Super_Man_t *       pMan;         // the manager (read-only)
+    Mio_Gate_t *        pRoot;        // the root gate
+    Super_Gate_t **     ppGatesLimit; // the gates to be used as fanins
+    int                 nGatesLimit;  // the number of these gates
+    int                 nFanins;      // the number of root gate fanins
+    float               AreaMio;      // the area of the root gate
+    int                 iTask;        // the first fanin choice of this task
+    int                 nTasks;       // the step between the first fanin choices
+    // current fanins
+    int                 pIndex[6];
+    unsigned            uTruths[6][2];
+    float *             ptPinDelays[6];
+    // candidates
+    Super_Cand_t *      pCands;       // the surviving candidates
+    int                 nCands;       // the number of candidates
+    int                 nCandsAlloc;  // the number of allocated candidates
+    Vec_Int_t *         vStarts;      // the first candidate for each first fanin choice
+    Vec_Int_t *         vBins;        // the thread-local table
+    Vec_Int_t *         vUsed;        // the non-empty bins
+    // statistics
+    int                 nTried;       // the number of tried combinations
+    int                 fTimeOut;     // the timeout was reached
+};
+
 // iterating through the gates in the library
 #define Super_ManForEachGate( GateArray, Limit, Index, Gate )    \
     for ( Index = 0;                                             \
@@ -111,6 +161,7 @@ static int            Super_CompareGates( Super_Man_t * pMan, unsigned uTruth[],
 static int            Super_DelayCompare( Super_Gate_t ** ppG1, Super_Gate_t ** ppG2 );
 static int            Super_AreaCompare( Super_Gate_t ** ppG1, Super_Gate_t ** ppG2 );
 static void           Super_TranferGatesToArray( Super_Man_t * pMan );
+static int            Super_ComputeRootPar( Super_Man_t * pMan, Super_ThData_t * pThData, Abc_Task_t ** ppTasks, Mio_Gate_t * pRoot, Super_Gate_t ** ppGatesLimit, int nGatesLimit, int nGatesMax, int * pfTimeOut );
 static int            Super_CheckTimeout( ProgressBar * pPro, Super_Man_t * pMan );
  
 static Vec_Str_t *    Super_Write( Super_Man_t * pMan );
@@ -137,7 +188,7 @@ static Vec_Str_t *    Super_WriteLibraryTreeStr( Super_Man_t * pMan );
   SeeAlso     []
 
 ***********************************************************************/
-void Super_Precompute( Mio_Library_t * pLibGen, int nVarsMax, int nLevels, int nGatesMax, float tDelayMax, float tAreaMax, int TimeLimit, int fSkipInv, int fVerbose, char * pFileName )
+void Super_Precompute( Mio_Library_t * pLibGen, int nVarsMax, int nLevels, int nGatesMax, float tDelayMax, float tAreaMax, int TimeLimit, int fSkipInv, int nProcNum, int fUseCache, int fVerbose, char * pFileName )
 {
     Vec_Str_t * vStr;
     FILE * pFile = fopen( pFileName, "wb" );
@@ -146,7 +197,10 @@ void Super_Precompute( Mio_Library_t * pLibGen, int nVarsMax, int nLevels, int n
         printf( "Cannot open output file \"%s\".\n", pFileName );
         return;
     }
-    vStr = Super_PrecomputeStr( pLibGen, nVarsMax, nLevels, nGatesMax, tDelayMax, tAreaMax, TimeLimit, fSkipInv, fVerbose );
+    if ( fUseCache )
+        vStr = Super_PrecomputeStrCached( pLibGen, nVarsMax, nLevels, nGatesMax, tDelayMax, tAreaMax, TimeLimit, fSkipInv, nProcNum, fVerbose );
+    else
+        vStr = Super_PrecomputeStr( pLibGen, nVarsMax, nLevels, nGatesMax, tDelayMax, tAreaMax, TimeLimit, fSkipInv, nProcNum, fVerbose );
     fwrite( Vec_StrArray(vStr), 1, Vec_StrSize(vStr), pFile );
     fclose( pFile );
     Vec_StrFree( vStr );
@@ -162,14 +216,16 @@ void Super_Precompute( Mio_Library_t * pLibGen, int nVarsMax, int nLevels, int n
 
   Synopsis    [Precomputes the library of supergates.]
 
-  Description []
+  Description [When nProcNum > 1, the supergates with each root gate are 
+  enumerated by several threads. If the runtime limit was reached, sets
+  *pfTimeOut (if given), because the library may be incomplete.]
                
   SideEffects []
 
   SeeAlso     []
 
 ***********************************************************************/
-Vec_Str_t * Super_PrecomputeStr( Mio_Library_t * pLibGen, int nVarsMax, int nLevels, int nGatesMax, float tDelayMax, float tAreaMax, int TimeLimit, int fSkipInv, int fVerbose )
+static Vec_Str_t * Super_PrecomputeStrInt( Mio_Library_t * pLibGen, int nVarsMax, int nLevels, int nGatesMax, float tDelayMax, float tAreaMax, int TimeLimit, int fSkipInv, int nProcNum, int fVerbose, int * pfTimeOut )
 {
     Vec_Str_t * vStr;
     Super_Man_t * pMan;
@@ -201,7 +257,8 @@ Vec_Str_t * Super_PrecomputeStr( Mio_Library_t * pLibGen, int nVarsMax, int nLev
     pMan->tDelayMax = tDelayMax;
     pMan->tAreaMax  = tAreaMax;
     pMan->TimeLimit = TimeLimit; // in seconds
-    pMan->TimeStop  = TimeLimit ? TimeLimit * CLOCKS_PER_SEC + Abc_Clock() : 0; // in CPU ticks
+    pMan->TimeStop  = TimeLimit ? TimeLimit * CLOCKS_PER_SEC + Abc_ThreadClock() : 0; // in wall-clock ticks, checked by all threads
+    pMan->nProcNum  = nProcNum;
     pMan->fVerbose  = fVerbose;
 
     if ( nGates == 0 )
@@ -228,11 +285,13 @@ if ( fVerbose )
         pMan->nVarsMax, nLevels, nGatesMax );
     printf( "Limits: max delay =  %.2f, max area =  %.2f, time limit = %d sec.\n", 
         pMan->tDelayMax, pMan->tAreaMax, pMan->TimeLimit );
+    if ( pMan->nProcNum > 1 )
+        printf( "Using %d threads.\n", pMan->nProcNum );
 }
 
     for ( Level = 1; Level <= nLevels; Level++ )
     {
-        if ( pMan->TimeStop && Abc_Clock() > pMan->TimeStop )
+        if ( pMan->TimeStop && Abc_ThreadClock() > pMan->TimeStop )
             break;
 clk = Abc_Clock();
         Super_Compute( pMan, ppGates, nGates, nGatesMax, fSkipInv );
@@ -246,6 +305,8 @@ fflush( stdout );
 }
     }
     pMan->Time = Abc_Clock() - clockStart;
+    if ( pfTimeOut )
+        *pfTimeOut = pMan->TimeStop && Abc_ThreadClock() > pMan->TimeStop;
 
 if ( fVerbose )
 {
@@ -260,6 +321,152 @@ fflush( stdout );
     ABC_FREE( ppGates );
     return vStr;
 }
+Vec_Str_t * Super_PrecomputeStr( Mio_Library_t * pLibGen, int nVarsMax, int nLevels, int nGatesMax, float tDelayMax, float tAreaMax, int TimeLimit, int fSkipInv, int nProcNum, int fVerbose )
+{
+    return Super_PrecomputeStrInt( pLibGen, nVarsMax, nLevels, nGatesMax, tDelayMax, tAreaMax, TimeLimit, fSkipInv, nProcNum, fVerbose, NULL );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Precomputes the library of supergates using the cache.]
+
+  Description [The cache file "<genlib>.super.cache" is written next to 
+  the genlib file. It contains the hash of the root gates (names, truth 
+  tables, areas, and pin delays) and of the parameters, including whether 
+  threads are used, followed by the supergate library. When the hash 
+  matches, the library is read from the cache. Otherwise, it is computed and saved, unless the runtime 
+  limit was reached. The file is written under a temporary name and 
+  renamed, so that other runs see either the old or the new cache.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static word Super_CacheHash( Mio_Library_t * pLibGen, int nVarsMax, int nLevels, int nGatesMax, float tDelayMax, float tAreaMax, int TimeLimit, int fSkipInv, int nProcNum )
+{
+    Vec_Str_t * vKey = Vec_StrAlloc( 1000 );
+    Mio_Gate_t ** ppGates;
+    Mio_Pin_t * pPin;
+    word uHash, uTruth;
+    int i, k, nGates;
+    // the threaded enumeration gives the same result for any number of threads
+    Vec_StrPrintF( vKey, "%s %d %d %d %.9g %.9g %d %d %d\n", Mio_LibraryReadName(pLibGen), 
+        nVarsMax, nLevels, nGatesMax, tDelayMax, tAreaMax, TimeLimit, fSkipInv, nProcNum > 1 );
+    ppGates = Mio_CollectRoots( pLibGen, nVarsMax, tDelayMax, 0, &nGates, 0 );
+    for ( i = 0; i < nGates; i++ )
+    {
+        uTruth = Mio_GateReadTruth( ppGates[i] );
+        Vec_StrPrintF( vKey, "%s %08x%08x %.9g", Mio_GateReadName(ppGates[i]), 
+            (unsigned)(uTruth >> 32), (unsigned)uTruth, Mio_GateReadArea(ppGates[i]) );
+        for ( pPin = Mio_GateReadPins(ppGates[i]); pPin; pPin = Mio_PinReadNext(pPin) )
+            Vec_StrPrintF( vKey, " %.9g", Mio_PinReadDelayBlockMax(pPin) );
+        Vec_StrPush( vKey, '\n' );
+    }
+    ABC_FREE( ppGates );
+    uHash = (word)Vec_StrSize(vKey);
+    for ( k = 0; k < Vec_StrSize(vKey); k++ )
+    {
+        uHash = (uHash ^ (unsigned char)Vec_StrEntry(vKey, k)) * ABC_CONST(0x9E3779B97F4A7C15);
+        uHash ^= uHash >> 31;
+    }
+    Vec_StrFree( vKey );
+    return uHash;
+}
+static Vec_Str_t * Super_CacheRead( char * pCacheName, word uHash )
+{
+    Vec_Str_t * vStr;
+    FILE * pFile;
+    char pMagic[8];
+    word uHashFile;
+    int nSize, Zero;
+    pFile = fopen( pCacheName, "rb" );
+    if ( pFile == NULL )
+        return NULL;
+    if ( fread( pMagic, 1, 8, pFile ) != 8 || memcmp( pMagic, SUPER_CACHE_MAGIC, 8 ) ||
+         fread( &uHashFile, 8, 1, pFile ) != 1 || uHashFile != uHash ||
+         fread( &nSize, 4, 1, pFile ) != 1 || nSize <= 0 ||
+         fread( &Zero, 4, 1, pFile ) != 1 )
+    {
+        fclose( pFile );
+        return NULL;
+    }
+    vStr = Vec_StrAlloc( nSize );
+    if ( (int)fread( Vec_StrArray(vStr), 1, nSize, pFile ) != nSize || Vec_StrArray(vStr)[nSize-1] != 0 )
+    {
+        Vec_StrFree( vStr );
+        fclose( pFile );
+        return NULL;
+    }
+    vStr->nSize = nSize;
+    fclose( pFile );
+    return vStr;
+}
+static int Super_CacheWrite( char * pCacheName, word uHash, Vec_Str_t * vStr )
+{
+    FILE * pFile;
+    char * pTemp;
+    int nSize = Vec_StrSize(vStr), Zero = 0;
+    pTemp = ABC_ALLOC( char, strlen(pCacheName) + 20 );
+#if !defined(_WIN32)
+    sprintf( pTemp, "%s.tmp%d", pCacheName, (int)getpid() );
+#else
+    sprintf( pTemp, "%s.tmp", pCacheName );
+#endif
+    pFile = fopen( pTemp, "wb" );
+    if ( pFile == NULL )
+    {
+        ABC_FREE( pTemp );
+        return 0;
+    }
+    fwrite( SUPER_CACHE_MAGIC, 1, 8, pFile );
+    fwrite( &uHash, 8, 1, pFile );
+    fwrite( &nSize, 4, 1, pFile );
+    fwrite( &Zero, 4, 1, pFile );
+    fwrite( Vec_StrArray(vStr), 1, nSize, pFile );
+    if ( fclose( pFile ) != 0 )
+    {
+        remove( pTemp );
+        ABC_FREE( pTemp );
+        return 0;
+    }
+#if defined(_WIN32)
+    remove( pCacheName );
+#endif
+    if ( rename( pTemp, pCacheName ) != 0 )
+    {
+        remove( pTemp );
+        ABC_FREE( pTemp );
+        return 0;
+    }
+    ABC_FREE( pTemp );
+    return 1;
+}
+Vec_Str_t * Super_PrecomputeStrCached( Mio_Library_t * pLibGen, int nVarsMax, int nLevels, int nGatesMax, float tDelayMax, float tAreaMax, int TimeLimit, int fSkipInv, int nProcNum, int fVerbose )
+{
+    Vec_Str_t * vStr;
+    char * pCacheName, * pNameGeneric;
+    word uHash;
+    int fTimeOut = 0;
+    uHash = Super_CacheHash( pLibGen, nVarsMax, nLevels, nGatesMax, tDelayMax, tAreaMax, TimeLimit, fSkipInv, nProcNum );
+    pNameGeneric = Extra_FileNameGeneric( Mio_LibraryReadName(pLibGen) );
+    pCacheName = ABC_ALLOC( char, strlen(pNameGeneric) + 20 );
+    sprintf( pCacheName, "%s.super.cache", pNameGeneric );
+    ABC_FREE( pNameGeneric );
+    vStr = Super_CacheRead( pCacheName, uHash );
+    if ( vStr != NULL )
+    {
+        if ( fVerbose )
+            printf( "Read the supergate library from cache \"%s\".\n", pCacheName );
+        ABC_FREE( pCacheName );
+        return vStr;
+    }
+    vStr = Super_PrecomputeStrInt( pLibGen, nVarsMax, nLevels, nGatesMax, tDelayMax, tAreaMax, TimeLimit, fSkipInv, nProcNum, fVerbose, &fTimeOut );
+    if ( vStr != NULL && !fTimeOut && Super_CacheWrite( pCacheName, uHash, vStr ) && fVerbose )
+        printf( "Saved the supergate library in cache \"%s\".\n", pCacheName );
+    ABC_FREE( pCacheName );
+    return vStr;
+}
 
 
 /**Function*************************************************************
@@ -349,6 +556,8 @@ Super_Man_t * Super_Compute( Super_Man_t * pMan, Mio_Gate_t ** ppGates, int nGat
     unsigned uTruth[2], uTruths[6][2];
     int i0, i1, i2, i3, i4, i5; 
     Super_Gate_t ** ppGatesLimit;
+    Super_ThData_t * pThData = NULL;
+    Abc_Task_t ** ppTasks = NULL;
     int nFanins, nGatesLimit, k, s, t;
     ProgressBar * pProgress;
     int fTimeOut;
@@ -379,6 +588,17 @@ Super_Man_t * Super_Compute( Super_Man_t * pMan, Mio_Gate_t ** ppGates, int nGat
     pProgress = Extra_ProgressBarStart( stdout, pMan->TimeLimit );
     pMan->TimePrint = Abc_Clock() + CLOCKS_PER_SEC;
     ppGatesLimit = ABC_ALLOC( Super_Gate_t *, pMan->nGates );
+    if ( pMan->nProcNum > 1 )
+    {
+        pThData = ABC_CALLOC( Super_ThData_t, pMan->nProcNum );
+        ppTasks = ABC_ALLOC( Abc_Task_t *, pMan->nProcNum );
+        for ( t = 0; t < pMan->nProcNum; t++ )
+        {
+            pThData[t].vStarts = Vec_IntAlloc( 100 );
+            pThData[t].vBins   = Vec_IntStartFull( SUPER_PAR_BINS );
+            pThData[t].vUsed   = Vec_IntAlloc( 100 );
+        }
+    }
     // go through the root gates
     // the root gates are sorted in the increasing gelay
     fTimeOut = 0;
@@ -430,6 +650,19 @@ Super_Man_t * Super_Compute( Super_Man_t * pMan, Mio_Gate_t ** ppGates, int nGat
         if ( nGatesLimit > 10000 )
             printf( "                                       \r" );
 
+        // enumerate the combinations using several threads
+        if ( pMan->nProcNum > 1 )
+        {
+            if ( Super_ComputeRootPar( pMan, pThData, ppTasks, ppGates[k], ppGatesLimit, nGatesLimit, nGatesMax, &fTimeOut ) )
+                goto done;
+            if ( Abc_Clock() > pMan->TimePrint )
+            {
+                Extra_ProgressBarUpdate( pProgress, ++pMan->TimeSec, NULL );
+                pMan->TimePrint = Abc_Clock() + CLOCKS_PER_SEC;
+            }
+            continue;
+        }
+
         // consider the combinations of gates with the root gate on top
         AreaMio = (float)Mio_GateReadArea(ppGates[k]);
         nFanins = Mio_GateReadPinNum(ppGates[k]);
@@ -720,6 +953,18 @@ Super_Man_t * Super_Compute( Super_Man_t * pMan, Mio_Gate_t ** ppGates, int nGat
 done: 
     Extra_ProgressBarStop( pProgress );
     ABC_FREE( ppGatesLimit );
+    if ( pThData )
+    {
+        for ( t = 0; t < pMan->nProcNum; t++ )
+        {
+            ABC_FREE( pThData[t].pCands );
+            Vec_IntFree( pThData[t].vStarts );
+            Vec_IntFree( pThData[t].vBins );
+            Vec_IntFree( pThData[t].vUsed );
+        }
+        ABC_FREE( pThData );
+        ABC_FREE( ppTasks );
+    }
     return pMan;
 }
 
@@ -742,7 +987,7 @@ int Super_CheckTimeout( ProgressBar * pPro, Super_Man_t * pMan )
         Extra_ProgressBarUpdate( pPro, ++pMan->TimeSec, NULL );
         pMan->TimePrint = Abc_Clock() + CLOCKS_PER_SEC;
     }
-    if ( pMan->TimeStop && TimeNow > pMan->TimeStop )
+    if ( pMan->TimeStop && Abc_ThreadClock() > pMan->TimeStop )
     {
         printf ("Timeout!\n");
         return 1;
@@ -752,6 +997,292 @@ int Super_CheckTimeout( ProgressBar * pPro, Super_Man_t * pMan )
 }
 
 
+/**Function*************************************************************
+
+  Synopsis    [Checks the thread-local table for comparable candidates.]
+
+  Description [Works as Super_CompareGates() on the candidates derived
+  by this thread for the current first fanin. Returns 0 if the candidate
+  is dominated. Otherwise, marks the candidates dominated by the new one.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline int Super_ThHash( unsigned uTruth[] )
+{
+    return (int)(((uTruth[0] * 0x9E3779B1) ^ (uTruth[1] * 0x85EBCA6B)) >> 18) & (SUPER_PAR_BINS - 1);
+}
+static int Super_ThCompare( Super_ThData_t * p, int * pPlace, unsigned uTruth[], float Area, float tPinDelaysRes[] )
+{
+    Super_Cand_t * pCand;
+    int i, fNewIsBetter, fCandIsBetter;
+    while ( *pPlace >= 0 )
+    {
+        pCand = p->pCands + *pPlace;
+        if ( pCand->uTruth[0] != uTruth[0] || pCand->uTruth[1] != uTruth[1] )
+        {
+            pPlace = &pCand->iNext;
+            continue;
+        }
+        fCandIsBetter = 0;
+        fNewIsBetter  = 0;
+        if ( pCand->Area + SUPER_EPSILON < Area )
+            fCandIsBetter = 1;
+        else if ( pCand->Area > Area + SUPER_EPSILON )
+            fNewIsBetter = 1;
+        for ( i = 0; i < p->pMan->nVarsMax; i++ )
+        {
+            if ( pCand->ptDelays[i] == SUPER_NO_VAR || tPinDelaysRes[i] == SUPER_NO_VAR )
+                continue;
+            if ( pCand->ptDelays[i] + SUPER_EPSILON < tPinDelaysRes[i] )
+                fCandIsBetter = 1;
+            else if ( pCand->ptDelays[i] > tPinDelaysRes[i] + SUPER_EPSILON )
+                fNewIsBetter = 1;
+            if ( fCandIsBetter && fNewIsBetter )
+                break;
+        }
+        if ( fCandIsBetter && fNewIsBetter ) // Pareto points; save both
+            pPlace = &pCand->iNext;
+        else if ( fNewIsBetter ) // candidate is worse; remove it
+        {
+            *pPlace = pCand->iNext;
+            pCand->fDead = 1;
+        }
+        else // new is worse or identical
+            return 0;
+    }
+    return 1;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Derives the candidate for the current fanins.]
+
+  Description []
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Super_ThAddCand( Super_ThData_t * p, float Area )
+{
+    Super_Man_t * pMan = p->pMan;
+    Super_Cand_t * pCand;
+    float tPinDelaysRes[6], tPinDelayMax;
+    unsigned uTruth[2];
+    int iBin;
+    Mio_DeriveGateDelays( p->pRoot, p->ptPinDelays, p->nFanins, pMan->nVarsMax, SUPER_NO_VAR, tPinDelaysRes, &tPinDelayMax );
+    Mio_DeriveTruthTable( p->pRoot, p->uTruths, p->nFanins, pMan->nVarsMax, uTruth );
+    // skip constant functions
+    if ( pMan->nVarsMax < 6 )
+    {
+        if ( uTruth[0] == 0 || ~uTruth[0] == 0 )
+            return;
+    }
+    else
+    {
+        if ( ( uTruth[0] == 0 && uTruth[1] == 0 ) || ( ~uTruth[0] == 0 && ~uTruth[1] == 0 ) )
+            return;
+    }
+    iBin = Super_ThHash( uTruth );
+    if ( !Super_ThCompare( p, Vec_IntEntryP(p->vBins, iBin), uTruth, Area, tPinDelaysRes ) )
+        return;
+    // add the new candidate
+    if ( p->nCands == p->nCandsAlloc )
+    {
+        p->nCandsAlloc = Abc_MaxInt( 1000, 2 * p->nCandsAlloc );
+        p->pCands = ABC_REALLOC( Super_Cand_t, p->pCands, p->nCandsAlloc );
+    }
+    pCand = p->pCands + p->nCands;
+    memset( pCand, 0, sizeof(Super_Cand_t) );
+    pCand->uTruth[0] = uTruth[0];
+    pCand->uTruth[1] = uTruth[1];
+    pCand->Area      = Area;
+    pCand->tDelayMax = tPinDelayMax;
+    memcpy( pCand->ptDelays, tPinDelaysRes, sizeof(float) * pMan->nVarsMax );
+    memcpy( pCand->pFanins, p->pIndex, sizeof(int) * p->nFanins );
+    if ( Vec_IntEntry(p->vBins, iBin) == -1 )
+        Vec_IntPush( p->vUsed, iBin );
+    pCand->iNext = Vec_IntEntry( p->vBins, iBin );
+    Vec_IntWriteEntry( p->vBins, iBin, p->nCands++ );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Enumerates the fanins of the root gate.]
+
+  Description [Follows the loops in Super_Compute(): the fanins are 
+  distinct, the gates are sorted by area, and the enumeration at each 
+  level stops when the area limit is exceeded. The first fanin is fixed
+  to p->pIndex[0].]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Super_ThEnum_rec( Super_ThData_t * p, int iPin, float Area )
+{
+    Super_Man_t * pMan = p->pMan;
+    Super_Gate_t * pGate;
+    float AreaNew;
+    int i, k, iBeg, iEnd;
+    assert( iPin < 6 && iPin < p->nFanins );
+    iBeg = iPin ? 0 : p->pIndex[0];
+    iEnd = iPin ? p->nGatesLimit : p->pIndex[0] + 1;
+    for ( i = iBeg; i < iEnd; i++ )
+    {
+        for ( k = 0; k < iPin; k++ )
+            if ( p->pIndex[k] == i )
+                break;
+        if ( k < iPin )
+            continue;
+        pGate = p->ppGatesLimit[i];
+        if ( iPin == p->nFanins - 1 )
+        {
+            if ( (++p->nTried & 0x3FF) == 0 && pMan->TimeStop && Abc_ThreadClock() > pMan->TimeStop )
+            {
+                p->fTimeOut = 1;
+                return;
+            }
+            // skip the inverter as the root gate before the elementary variable
+            if ( p->nFanins == 1 && pMan->fSkipInv && pGate->tDelayMax == 0 )
+                continue;
+        }
+        AreaNew = Area + pGate->Area;
+        if ( pMan->tAreaMax > 0.0 && AreaNew > pMan->tAreaMax )
+            break;
+        p->pIndex[iPin]      = i;
+        p->uTruths[iPin][0]  = pGate->uTruth[0];
+        p->uTruths[iPin][1]  = pGate->uTruth[1];
+        p->ptPinDelays[iPin] = pGate->ptDelays;
+        if ( iPin == p->nFanins - 1 )
+            Super_ThAddCand( p, AreaNew );
+        else
+            Super_ThEnum_rec( p, iPin + 1, AreaNew );
+        if ( p->fTimeOut )
+            return;
+    }
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Enumerates supergates for a subset of the first fanins.]
+
+  Description [The task takes every p->nTasks-th first fanin. For each
+  of them, the candidates are filtered by a thread-local table, which
+  is cleaned before the next first fanin. This way, the candidates do not
+  depend on how the first fanins are distributed among the threads.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void * Super_ThEnumTask( void * pArg, Abc_Task_t * pTask )
+{
+    Super_ThData_t * p = (Super_ThData_t *)pArg;
+    int i, iBin, iFirst, iStart;
+    p->nCands   = 0;
+    p->nTried   = 0;
+    p->fTimeOut = 0;
+    Vec_IntFill( p->vStarts, 1, 0 );
+    for ( iFirst = p->iTask; iFirst < p->nGatesLimit && !p->fTimeOut; iFirst += p->nTasks )
+    {
+        p->pIndex[0] = iFirst;
+        iStart = p->nCands;
+        Super_ThEnum_rec( p, 0, p->AreaMio );
+        // clean the table
+        Vec_IntForEachEntry( p->vUsed, iBin, i )
+            Vec_IntWriteEntry( p->vBins, iBin, -1 );
+        Vec_IntClear( p->vUsed );
+        // compact the surviving candidates
+        for ( i = iStart; i < p->nCands; i++ )
+            if ( !p->pCands[i].fDead )
+                p->pCands[iStart++] = p->pCands[i];
+        p->nCands = iStart;
+        if ( !p->fTimeOut )
+            Vec_IntPush( p->vStarts, p->nCands );
+    }
+    return NULL;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Computes supergates with the given root gate using threads.]
+
+  Description [The first fanins are distributed among the threads, which
+  derive the candidates independently. The candidates are then added to
+  the unique table in the same order as in Super_Compute(), so the result 
+  is the same for any number of threads. It may differ from the serial 
+  run, because the candidates of each first fanin are filtered before 
+  they are compared with the gates in the table. Returns 1 if the limit 
+  on the number of supergates is reached.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Super_ComputeRootPar( Super_Man_t * pMan, Super_ThData_t * pThData, Abc_Task_t ** ppTasks, Mio_Gate_t * pRoot, Super_Gate_t ** ppGatesLimit, int nGatesLimit, int nGatesMax, int * pfTimeOut )
+{
+    Super_ThData_t * p;
+    Super_Cand_t * pCand;
+    Super_Gate_t * pSupers[6], * pGateNew;
+    int i, k, c, nTasks, nFanins = Mio_GateReadPinNum(pRoot);
+    nTasks = Abc_MinInt( pMan->nProcNum, Abc_MaxInt(1, nGatesLimit) );
+    for ( k = 0; k < nTasks; k++ )
+    {
+        p = pThData + k;
+        p->pMan         = pMan;
+        p->pRoot        = pRoot;
+        p->ppGatesLimit = ppGatesLimit;
+        p->nGatesLimit  = nGatesLimit;
+        p->nFanins      = nFanins;
+        p->AreaMio      = (float)Mio_GateReadArea(pRoot);
+        p->iTask        = k;
+        p->nTasks       = nTasks;
+    }
+    for ( k = 1; k < nTasks; k++ )
+        ppTasks[k] = Abc_TaskSubmit( Super_ThEnumTask, pThData + k );
+    Super_ThEnumTask( pThData, NULL );
+    for ( k = 1; k < nTasks; k++ )
+        Abc_TaskWait( ppTasks[k] );
+    // add the candidates in the order of the first fanins
+    for ( k = 0; k < nTasks; k++ )
+    {
+        pMan->nTried += pThData[k].nTried;
+        if ( pThData[k].fTimeOut && !*pfTimeOut )
+        {
+            printf ("Timeout!\n");
+            *pfTimeOut = 1;
+        }
+    }
+    for ( i = 0; i < nGatesLimit; i++ )
+    {
+        p = pThData + i % nTasks;
+        if ( i / nTasks + 1 >= Vec_IntSize(p->vStarts) )
+            break;
+        for ( c = Vec_IntEntry(p->vStarts, i / nTasks); c < Vec_IntEntry(p->vStarts, i / nTasks + 1); c++ )
+        {
+            pCand = p->pCands + c;
+            if ( !Super_CompareGates( pMan, pCand->uTruth, pCand->Area, pCand->ptDelays, pMan->nVarsMax ) )
+                continue;
+            for ( k = 0; k < nFanins; k++ )
+                pSupers[k] = ppGatesLimit[pCand->pFanins[k]];
+            pGateNew = Super_CreateGateNew( pMan, pRoot, pSupers, nFanins, pCand->uTruth, pCand->Area, pCand->ptDelays, pCand->tDelayMax, pMan->nVarsMax );
+            Super_AddGateToTable( pMan, pGateNew );
+            if ( nGatesMax && pMan->nClasses > nGatesMax )
+                return 1;
+        }
+    }
+    return 0;
+}
+
+
 /**Function*************************************************************
 
   Synopsis    [Transfers gates from table into the array.]
@@ -881,7 +1412,9 @@ int Super_CompareGates( Super_Man_t * pMan, unsigned uTruth[], float Area, float
                 *ppList = pGate->pNext;
             else
                 pPrev->pNext = pGate->pNext;
-            Extra_MmFixedEntryRecycle( pMan->pMem, (char *)pGate );
+            // with several threads, the buffered candidates may still use this gate as a fanin
+            if ( pMan->nProcNum <= 1 )
+                Extra_MmFixedEntryRecycle( pMan->pMem, (char *)pGate );
             pMan->nRemoved++;
         }
         else if ( fGateIsBetter ) // new is worse, already dominated no need to see others
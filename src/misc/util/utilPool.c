@@ -0,0 +1,694 @@
+/**CFile****************************************************************
+
+  FileName    [utilPool.c]
+
+  SystemName  [ABC: Logic synthesis and verification system.]
+
+  PackageName [Process-wide thread pool.]
+
+  Synopsis    [Tasks, futures and parallel loops on a shared pool.]
+
+  Author      [Alan Mishchenko]
+
+  Affiliation [UC Berkeley]
+
+  Date        [Ver. 1.0. Started - June 20, 2005.]
+
+  Revision    [$Id: utilPool.c,v 1.00 2005/06/20 00:00:00 alanmi Exp $]
+
+***********************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "abc_global.h"
+#include "utilPool.h"
+
+#if !defined(_WIN32)
+#include <unistd.h>
+#endif
+
+#ifdef ABC_USE_PTHREADS
+
+#ifdef _WIN32
+#include "../lib/pthread.h"
+#else
+#include <pthread.h>
+#endif
+
+#endif
+
+ABC_NAMESPACE_IMPL_START
+
+////////////////////////////////////////////////////////////////////////
+///                        DECLARATIONS                              ///
+////////////////////////////////////////////////////////////////////////
+
+// task states
+enum { ABC_TASK_QUEUED = 0, ABC_TASK_RUNNING, ABC_TASK_DONE };
+
+typedef struct Abc_Pool_t_  Abc_Pool_t;
+typedef struct Abc_Deq_t_   Abc_Deq_t;
+typedef struct Abc_Range_t_ Abc_Range_t;
+
+struct Abc_Task_t_
+{
+    Abc_Pool_t *     pPool;      // the pool running the task
+    Abc_TaskFunc_f   pFunc;      // task procedure
+    void *           pArg;       // task argument
+    void *           pRes;       // task result
+    volatile int     State;      // task state
+    volatile int     fCancel;    // cancellation request
+    int              fDetached;  // the task is freed by the pool
+    int              iQueue;     // the queue holding the task
+};
+
+// range of the parallel loop
+struct Abc_Range_t_
+{
+    Abc_RangeFunc_f  pFunc;
+    void *           pArg;
+    int              iStart;
+    int              iStop;
+};
+
+// requested number of worker threads (0 = one per processor)
+static int s_nThreads = 0;
+
+////////////////////////////////////////////////////////////////////////
+///                     FUNCTION DEFINITIONS                         ///
+////////////////////////////////////////////////////////////////////////
+
+/**Function*************************************************************
+
+  Synopsis    [Setting the number of worker threads.]
+
+  Description [The new number takes effect when the next task is
+  submitted. Zero means one worker per online processor.]
+
+  SideEffects [Stops the current pool after its tasks are finished.]
+
+  SeeAlso     []
+
+***********************************************************************/
+static int Abc_PoolProcNum()
+{
+#if !defined(_WIN32) && defined(_SC_NPROCESSORS_ONLN)
+    long nProcs = sysconf( _SC_NPROCESSORS_ONLN );
+    return nProcs > 0 ? (int)nProcs : 1;
+#else
+    return 1;
+#endif
+}
+void Abc_PoolSetThreadNum( int nThreads )
+{
+    nThreads = Abc_MaxInt( nThreads, 0 );
+    nThreads = Abc_MinInt( nThreads, ABC_POOL_THREAD_MAX );
+    if ( nThreads == s_nThreads )
+        return;
+    Abc_PoolStop();
+    s_nThreads = nThreads;
+}
+int Abc_PoolThreadNum()
+{
+    return s_nThreads ? s_nThreads : Abc_MinInt( Abc_PoolProcNum(), ABC_POOL_THREAD_MAX );
+}
+
+#ifdef ABC_USE_PTHREADS
+
+// double-ended queue of tasks
+struct Abc_Deq_t_
+{
+    Abc_Task_t **    pArray;     // circular buffer
+    int              nCap;       // buffer size
+    int              iHead;      // the first task
+    int              nSize;      // the number of tasks
+};
+
+// argument of the worker thread
+typedef struct Abc_PoolArg_t_
+{
+    Abc_Pool_t *     pPool;
+    int              iWorker;
+} Abc_PoolArg_t;
+
+struct Abc_Pool_t_
+{
+    pthread_mutex_t  Mutex;      // protects everything below and the task states
+    pthread_cond_t   CondWork;   // a task is queued or the pool is stopped
+    pthread_cond_t   CondDone;   // a task is finished or a helper may find work
+    pthread_t *      pThreads;   // worker threads
+    Abc_PoolArg_t *  pArgs;      // worker arguments
+    Abc_Deq_t *      pQueues;    // worker deques, the shared queue, the detached queue
+    Abc_Task_t **    pBackRun;   // the background task run by each worker
+    int              nBackRun;   // the number of running background tasks
+    int              nThreads;   // the number of workers
+    int              nWaiting;   // the number of threads waiting for tasks
+    int              fStop;      // stop request
+};
+
+static Abc_Pool_t *    s_pPool     = NULL;
+static pthread_mutex_t s_PoolMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t  s_PoolOnce  = PTHREAD_ONCE_INIT;
+static pthread_key_t   s_PoolKey;  // Abc_PoolArg_t of the current worker
+
+static inline Abc_Deq_t * Abc_PoolShared( Abc_Pool_t * p )   { return p->pQueues + p->nThreads;     }
+static inline Abc_Deq_t * Abc_PoolDetached( Abc_Pool_t * p ) { return p->pQueues + p->nThreads + 1; }
+
+/**Function*************************************************************
+
+  Synopsis    [Double-ended queue.]
+
+  Description [The owner pushes and pops at the back; thieves and the
+  shared queue take tasks from the front.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Abc_DeqPushBack( Abc_Deq_t * p, Abc_Task_t * pTask )
+{
+    if ( p->nSize == p->nCap )
+    {
+        int i, nCapNew = Abc_MaxInt( 16, 2 * p->nCap );
+        Abc_Task_t ** pArray = ABC_ALLOC( Abc_Task_t *, nCapNew );
+        for ( i = 0; i < p->nSize; i++ )
+            pArray[i] = p->pArray[(p->iHead + i) % p->nCap];
+        ABC_FREE( p->pArray );
+        p->pArray = pArray;
+        p->nCap   = nCapNew;
+        p->iHead  = 0;
+    }
+    p->pArray[(p->iHead + p->nSize++) % p->nCap] = pTask;
+}
+static Abc_Task_t * Abc_DeqPopBack( Abc_Deq_t * p )
+{
+    if ( p->nSize == 0 )
+        return NULL;
+    return p->pArray[(p->iHead + --p->nSize) % p->nCap];
+}
+static Abc_Task_t * Abc_DeqPopFront( Abc_Deq_t * p )
+{
+    Abc_Task_t * pTask;
+    if ( p->nSize == 0 )
+        return NULL;
+    pTask = p->pArray[p->iHead];
+    p->iHead = (p->iHead + 1) % p->nCap;
+    p->nSize--;
+    return pTask;
+}
+static int Abc_DeqRemove( Abc_Deq_t * p, Abc_Task_t * pTask )
+{
+    int i, k;
+    for ( i = 0; i < p->nSize; i++ )
+        if ( p->pArray[(p->iHead + i) % p->nCap] == pTask )
+            break;
+    if ( i == p->nSize )
+        return 0;
+    for ( k = i; k < p->nSize - 1; k++ )
+        p->pArray[(p->iHead + k) % p->nCap] = p->pArray[(p->iHead + k + 1) % p->nCap];
+    p->nSize--;
+    return 1;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Selects and runs tasks.]
+
+  Description [Called with the pool mutex locked. A worker first takes
+  its own newest task, then the oldest task of the shared queue, then
+  steals the oldest task of another worker, and finally takes background
+  tasks. At most all but one worker run background tasks at the same
+  time, so that the foreground tasks are not delayed by them. Threads
+  waiting for results (fBackground = 0) never start background tasks
+  because those may run until cancelled.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static Abc_Task_t * Abc_PoolTake( Abc_Pool_t * p, int iWorker, int fBackground )
+{
+    Abc_Task_t * pTask = NULL;
+    int i, k;
+    if ( iWorker >= 0 )
+        pTask = Abc_DeqPopBack( p->pQueues + iWorker );
+    if ( pTask == NULL )
+        pTask = Abc_DeqPopFront( Abc_PoolShared(p) );
+    for ( k = 1; pTask == NULL && k <= p->nThreads; k++ )
+    {
+        i = (Abc_MaxInt(iWorker, 0) + k) % p->nThreads;
+        pTask = Abc_DeqPopFront( p->pQueues + i );
+    }
+    // cancelled background tasks are removed quickly when stopping
+    if ( pTask == NULL && fBackground && (p->fStop || p->nBackRun < Abc_MaxInt(1, p->nThreads - 1)) )
+        pTask = Abc_DeqPopFront( Abc_PoolDetached(p) );
+    if ( pTask )
+        pTask->State = ABC_TASK_RUNNING;
+    return pTask;
+}
+static void Abc_PoolRun( Abc_Pool_t * p, Abc_Task_t * pTask )
+{
+    void * pRes = NULL;
+    assert( pTask->State == ABC_TASK_RUNNING );
+    pthread_mutex_unlock( &p->Mutex );
+    if ( !pTask->fCancel )
+        pRes = pTask->pFunc( pTask->pArg, pTask );
+    pthread_mutex_lock( &p->Mutex );
+    pTask->pRes  = pRes;
+    pTask->State = ABC_TASK_DONE;
+    if ( pTask->fDetached )
+        ABC_FREE( pTask );
+    pthread_cond_broadcast( &p->CondDone );
+}
+static int Abc_PoolRunQueued( Abc_Pool_t * p, Abc_Task_t * pTask )
+{
+    if ( pTask->State != ABC_TASK_QUEUED || !Abc_DeqRemove(p->pQueues + pTask->iQueue, pTask) )
+        return 0;
+    pTask->State = ABC_TASK_RUNNING;
+    Abc_PoolRun( p, pTask );
+    return 1;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Worker thread.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void * Abc_PoolWorker( void * pArg )
+{
+    Abc_PoolArg_t * pThArg = (Abc_PoolArg_t *)pArg;
+    Abc_Pool_t * p = pThArg->pPool;
+    Abc_Task_t * pTask;
+    pthread_setspecific( s_PoolKey, pThArg );
+    pthread_mutex_lock( &p->Mutex );
+    while ( 1 )
+    {
+        if ( (pTask = Abc_PoolTake( p, pThArg->iWorker, 1 )) )
+        {
+            if ( !pTask->fDetached )
+            {
+                Abc_PoolRun( p, pTask );
+                continue;
+            }
+            // remember the background task to be cancelled by Abc_PoolStop()
+            p->pBackRun[pThArg->iWorker] = pTask;
+            p->nBackRun++;
+            Abc_PoolRun( p, pTask );
+            p->pBackRun[pThArg->iWorker] = NULL;
+            p->nBackRun--;
+            // another worker may start the next background task
+            if ( Abc_PoolDetached(p)->nSize )
+                pthread_cond_signal( &p->CondWork );
+            continue;
+        }
+        if ( p->fStop )
+            break;
+        pthread_cond_wait( &p->CondWork, &p->Mutex );
+    }
+    pthread_mutex_unlock( &p->Mutex );
+    return NULL;
+}
+static int Abc_PoolWorkerId( Abc_Pool_t * p )
+{
+    Abc_PoolArg_t * pThArg = (Abc_PoolArg_t *)pthread_getspecific( s_PoolKey );
+    return (pThArg && pThArg->pPool == p) ? pThArg->iWorker : -1;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Starting and stopping the pool.]
+
+  Description [The pool is started when the first task is submitted.
+  Stopping waits till the workers finish the queued tasks. Background
+  tasks are cancelled: those that did not start are not run, while the
+  running ones should return when Abc_TaskIsCancelled() is set. After
+  the pool is detached from s_pPool, it accepts only the tasks submitted
+  by its workers, which are finished before the workers exit.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Abc_PoolKeyStart()
+{
+    int status = pthread_key_create( &s_PoolKey, NULL );  assert( status == 0 );
+}
+static Abc_Pool_t * Abc_PoolStart( int nThreads )
+{
+    Abc_Pool_t * p = ABC_CALLOC( Abc_Pool_t, 1 );
+    int i, status;
+    pthread_once( &s_PoolOnce, Abc_PoolKeyStart );
+    pthread_mutex_init( &p->Mutex, NULL );
+    pthread_cond_init( &p->CondWork, NULL );
+    pthread_cond_init( &p->CondDone, NULL );
+    p->nThreads = nThreads;
+    p->pQueues  = ABC_CALLOC( Abc_Deq_t, nThreads + 2 );
+    p->pThreads = ABC_ALLOC( pthread_t, nThreads );
+    p->pArgs    = ABC_ALLOC( Abc_PoolArg_t, nThreads );
+    p->pBackRun = ABC_CALLOC( Abc_Task_t *, nThreads );
+    for ( i = 0; i < nThreads; i++ )
+    {
+        p->pArgs[i].pPool   = p;
+        p->pArgs[i].iWorker = i;
+        status = pthread_create( p->pThreads + i, NULL, Abc_PoolWorker, (void *)(p->pArgs + i) );  assert( status == 0 );
+    }
+    return p;
+}
+void Abc_PoolStop()
+{
+    Abc_Pool_t * p;
+    Abc_Deq_t * pDeq;
+    int i;
+    pthread_mutex_lock( &s_PoolMutex );
+    p = s_pPool;
+    s_pPool = NULL;
+    pthread_mutex_unlock( &s_PoolMutex );
+    if ( p == NULL )
+        return;
+    assert( Abc_PoolWorkerId(p) == -1 );
+    pthread_mutex_lock( &p->Mutex );
+    pDeq = Abc_PoolDetached( p );
+    for ( i = 0; i < pDeq->nSize; i++ )
+        pDeq->pArray[(pDeq->iHead + i) % pDeq->nCap]->fCancel = 1;
+    for ( i = 0; i < p->nThreads; i++ )
+        if ( p->pBackRun[i] )
+            p->pBackRun[i]->fCancel = 1;
+    p->fStop = 1;
+    pthread_cond_broadcast( &p->CondWork );
+    pthread_mutex_unlock( &p->Mutex );
+    for ( i = 0; i < p->nThreads; i++ )
+        pthread_join( p->pThreads[i], NULL );
+    for ( i = 0; i < p->nThreads + 2; i++ )
+        ABC_FREE( p->pQueues[i].pArray );
+    pthread_cond_destroy( &p->CondWork );
+    pthread_cond_destroy( &p->CondDone );
+    pthread_mutex_destroy( &p->Mutex );
+    ABC_FREE( p->pQueues );
+    ABC_FREE( p->pThreads );
+    ABC_FREE( p->pArgs );
+    ABC_FREE( p->pBackRun );
+    ABC_FREE( p );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Submits the task.]
+
+  Description [Returns the future to be passed to Abc_TaskWait(), which
+  frees it. Abc_TaskDetach() starts a background task without a future;
+  returns 0 if background tasks are not supported. A task submitted by a
+  worker goes to the pool of this worker, which is not freed while the
+  worker is running. Other threads queue the task while holding the lock
+  of s_pPool, so that the pool cannot be stopped at the same time.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static Abc_Task_t * Abc_TaskQueue( Abc_TaskFunc_f pFunc, void * pArg, int fDetached )
+{
+    Abc_Task_t * pTask = ABC_CALLOC( Abc_Task_t, 1 );
+    Abc_PoolArg_t * pThArg;
+    Abc_Pool_t * p;
+    int iWorker = -1;
+    pthread_once( &s_PoolOnce, Abc_PoolKeyStart );
+    pThArg = (Abc_PoolArg_t *)pthread_getspecific( s_PoolKey );
+    if ( pThArg )
+    {
+        p = pThArg->pPool;
+        iWorker = pThArg->iWorker;
+    }
+    else
+    {
+        pthread_mutex_lock( &s_PoolMutex );
+        if ( s_pPool == NULL )
+            s_pPool = Abc_PoolStart( Abc_PoolThreadNum() );
+        p = s_pPool;
+    }
+    pTask->pPool     = p;
+    pTask->pFunc     = pFunc;
+    pTask->pArg      = pArg;
+    pTask->fDetached = fDetached;
+    pthread_mutex_lock( &p->Mutex );
+    pTask->fCancel   = fDetached && p->fStop;
+    if ( fDetached )
+        pTask->iQueue = p->nThreads + 1;
+    else
+        pTask->iQueue = iWorker >= 0 ? iWorker : p->nThreads;
+    Abc_DeqPushBack( p->pQueues + pTask->iQueue, pTask );
+    pthread_cond_signal( &p->CondWork );
+    if ( p->nWaiting && !fDetached )
+        pthread_cond_broadcast( &p->CondDone );
+    pthread_mutex_unlock( &p->Mutex );
+    if ( pThArg == NULL )
+        pthread_mutex_unlock( &s_PoolMutex );
+    return pTask;
+}
+Abc_Task_t * Abc_TaskSubmit( Abc_TaskFunc_f pFunc, void * pArg )
+{
+    return Abc_TaskQueue( pFunc, pArg, 0 );
+}
+int Abc_TaskDetach( Abc_TaskFunc_f pFunc, void * pArg )
+{
+    Abc_TaskQueue( pFunc, pArg, 1 );
+    return 1;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Waits for the task.]
+
+  Description [Abc_TaskWait() returns the result of the task and frees
+  it. Abc_TaskWaitAny() returns the index of a finished task among the
+  non-NULL entries of the array, or -1 if there are none; the tasks are
+  not freed. While waiting, the thread runs the awaited tasks that did
+  not start yet and helps with other queued tasks.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Abc_TaskIsDone( Abc_Task_t * pTask )
+{
+    return pTask->State == ABC_TASK_DONE;
+}
+void * Abc_TaskWait( Abc_Task_t * pTask )
+{
+    Abc_Pool_t * p = pTask->pPool;
+    Abc_Task_t * pOther;
+    int iWorker = Abc_PoolWorkerId( p );
+    void * pRes;
+    assert( !pTask->fDetached );
+    pthread_mutex_lock( &p->Mutex );
+    while ( pTask->State != ABC_TASK_DONE )
+    {
+        if ( Abc_PoolRunQueued( p, pTask ) )
+            continue;
+        if ( (pOther = Abc_PoolTake( p, iWorker, 0 )) )
+        {
+            Abc_PoolRun( p, pOther );
+            continue;
+        }
+        p->nWaiting++;
+        pthread_cond_wait( &p->CondDone, &p->Mutex );
+        p->nWaiting--;
+    }
+    pRes = pTask->pRes;
+    pthread_mutex_unlock( &p->Mutex );
+    ABC_FREE( pTask );
+    return pRes;
+}
+int Abc_TaskWaitAny( Abc_Task_t ** ppTasks, int nTasks )
+{
+    Abc_Pool_t * p = NULL;
+    Abc_Task_t * pOther;
+    int i, iWorker;
+    for ( i = 0; i < nTasks; i++ )
+        if ( ppTasks[i] )
+            p = ppTasks[i]->pPool;
+    if ( p == NULL )
+        return -1;
+    iWorker = Abc_PoolWorkerId( p );
+    pthread_mutex_lock( &p->Mutex );
+    while ( 1 )
+    {
+        for ( i = 0; i < nTasks; i++ )
+            if ( ppTasks[i] && ppTasks[i]->State == ABC_TASK_DONE )
+                break;
+        if ( i < nTasks )
+            break;
+        for ( i = 0; i < nTasks; i++ )
+            if ( ppTasks[i] && Abc_PoolRunQueued( p, ppTasks[i] ) )
+                break;
+        if ( i < nTasks )
+            continue;
+        if ( (pOther = Abc_PoolTake( p, iWorker, 0 )) )
+        {
+            Abc_PoolRun( p, pOther );
+            continue;
+        }
+        p->nWaiting++;
+        pthread_cond_wait( &p->CondDone, &p->Mutex );
+        p->nWaiting--;
+    }
+    pthread_mutex_unlock( &p->Mutex );
+    return i;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Cancels the task.]
+
+  Description [The task that did not start is not run; its result is
+  NULL. The running task sees the request through Abc_TaskIsCancelled().
+  The task should still be waited for.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Abc_TaskCancel( Abc_Task_t * pTask )
+{
+    Abc_Pool_t * p = pTask->pPool;
+    pthread_mutex_lock( &p->Mutex );
+    pTask->fCancel = 1;
+    if ( pTask->State == ABC_TASK_QUEUED && Abc_DeqRemove(p->pQueues + pTask->iQueue, pTask) )
+    {
+        pTask->pRes  = NULL;
+        pTask->State = ABC_TASK_DONE;
+        pthread_cond_broadcast( &p->CondDone );
+    }
+    pthread_mutex_unlock( &p->Mutex );
+}
+
+#else // pthreads are not used
+
+void Abc_PoolStop()
+{
+}
+Abc_Task_t * Abc_TaskSubmit( Abc_TaskFunc_f pFunc, void * pArg )
+{
+    Abc_Task_t * pTask = ABC_CALLOC( Abc_Task_t, 1 );
+    pTask->pFunc = pFunc;
+    pTask->pArg  = pArg;
+    pTask->pRes  = pFunc( pArg, pTask );
+    pTask->State = ABC_TASK_DONE;
+    return pTask;
+}
+int Abc_TaskDetach( Abc_TaskFunc_f pFunc, void * pArg )
+{
+    return 0;
+}
+int Abc_TaskIsDone( Abc_Task_t * pTask )
+{
+    return 1;
+}
+void * Abc_TaskWait( Abc_Task_t * pTask )
+{
+    void * pRes = pTask->pRes;
+    ABC_FREE( pTask );
+    return pRes;
+}
+int Abc_TaskWaitAny( Abc_Task_t ** ppTasks, int nTasks )
+{
+    int i;
+    for ( i = 0; i < nTasks; i++ )
+        if ( ppTasks[i] )
+            return i;
+    return -1;
+}
+void Abc_TaskCancel( Abc_Task_t * pTask )
+{
+    pTask->fCancel = 1;
+}
+
+#endif // pthreads are used
+
+/**Function*************************************************************
+
+  Synopsis    [Returns 1 if the task has been cancelled.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Abc_TaskIsCancelled( Abc_Task_t * pTask )
+{
+    return pTask != NULL && pTask->fCancel;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Parallel loop.]
+
+  Description [Splits items [0, nItems) into nTasks contiguous ranges
+  (by default, one more than the number of workers) and calls pFunc on
+  each of them. The first range is processed by the caller.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void * Abc_PoolRangeTask( void * pArg, Abc_Task_t * pTask )
+{
+    Abc_Range_t * pRange = (Abc_Range_t *)pArg;
+    pRange->pFunc( pRange->pArg, pRange->iStart, pRange->iStop );
+    return NULL;
+}
+void Abc_PoolParFor( int nItems, int nTasks, Abc_RangeFunc_f pFunc, void * pArg )
+{
+    Abc_Range_t * pRanges;
+    Abc_Task_t ** ppTasks;
+    int i;
+    if ( nItems <= 0 )
+        return;
+    if ( nTasks <= 0 )
+        nTasks = Abc_PoolThreadNum() + 1;
+    nTasks = Abc_MinInt( nTasks, nItems );
+    if ( nTasks == 1 )
+    {
+        pFunc( pArg, 0, nItems );
+        return;
+    }
+    pRanges = ABC_ALLOC( Abc_Range_t, nTasks );
+    ppTasks = ABC_ALLOC( Abc_Task_t *, nTasks );
+    for ( i = 1; i < nTasks; i++ )
+    {
+        pRanges[i].pFunc  = pFunc;
+        pRanges[i].pArg   = pArg;
+        pRanges[i].iStart = (int)((ABC_INT64_T)nItems * i / nTasks);
+        pRanges[i].iStop  = (int)((ABC_INT64_T)nItems * (i + 1) / nTasks);
+        ppTasks[i] = Abc_TaskSubmit( Abc_PoolRangeTask, pRanges + i );
+    }
+    // the first range is processed by the caller
+    pFunc( pArg, 0, (int)((ABC_INT64_T)nItems / nTasks) );
+    for ( i = 1; i < nTasks; i++ )
+        Abc_TaskWait( ppTasks[i] );
+    ABC_FREE( pRanges );
+    ABC_FREE( ppTasks );
+}
+
+////////////////////////////////////////////////////////////////////////
+///                       END OF FILE                                ///
+////////////////////////////////////////////////////////////////////////
+
+ABC_NAMESPACE_IMPL_END
@@ -0,0 +1,96 @@
+/**CFile****************************************************************
+
+  FileName    [utilPool.h]
+
+  SystemName  [ABC: Logic synthesis and verification system.]
+
+  PackageName [Process-wide thread pool.]
+
+  Synopsis    [Tasks, futures and parallel loops on a shared pool.]
+
+  Author      [Alan Mishchenko]
+
+  Affiliation [UC Berkeley]
+
+  Date        [Ver. 1.0. Started - June 20, 2005.]
+
+  Revision    [$Id: utilPool.h,v 1.00 2005/06/20 00:00:00 alanmi Exp $]
+
+***********************************************************************/
+
+#ifndef ABC__misc__util__utilPool_h
+#define ABC__misc__util__utilPool_h
+
+/*
+    The pool is started on the first submission with the number of worker
+    threads set by Abc_PoolSetThreadNum() (command "threads"); by default,
+    one worker per online processor. Each worker owns a deque: tasks
+    submitted from a worker are pushed there and popped LIFO by the owner,
+    while idle workers steal from the other end. Tasks submitted from other
+    threads go to a shared queue.
+
+    A thread waiting for a task does not block while there is work to do:
+    it runs the awaited task itself if it has not started yet, or helps with
+    other queued tasks. Because of this, engines that submit tasks from
+    inside tasks (nested commands) reuse the same workers instead of
+    creating new threads.
+
+    Detached tasks are long-running background jobs. They are executed only
+    by the workers, at most by all but one of them, after the other queued
+    tasks, and are freed when finished. Abc_PoolStop() cancels them; a
+    detached task procedure should poll Abc_TaskIsCancelled() and return
+    when it is set, otherwise stopping the pool waits till it finishes.
+
+    Without ABC_USE_PTHREADS, submitted tasks are executed by the caller at
+    the time of submission and detached tasks are not supported.
+*/
+
+////////////////////////////////////////////////////////////////////////
+///                          INCLUDES                                ///
+////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////
+///                         PARAMETERS                               ///
+////////////////////////////////////////////////////////////////////////
+
+ABC_NAMESPACE_HEADER_START
+
+// the largest number of worker threads
+#define ABC_POOL_THREAD_MAX  256
+
+////////////////////////////////////////////////////////////////////////
+///                         BASIC TYPES                              ///
+////////////////////////////////////////////////////////////////////////
+
+typedef struct Abc_Task_t_ Abc_Task_t;
+
+// task procedure; the task handle can be polled for cancellation
+typedef void * (*Abc_TaskFunc_f)( void * pArg, Abc_Task_t * pTask );
+// parallel loop body processing items [iStart, iStop)
+typedef void   (*Abc_RangeFunc_f)( void * pArg, int iStart, int iStop );
+
+////////////////////////////////////////////////////////////////////////
+///                    FUNCTION DECLARATIONS                         ///
+////////////////////////////////////////////////////////////////////////
+
+/*=== utilPool.c ==========================================================*/
+
+extern void          Abc_PoolSetThreadNum( int nThreads );
+extern int           Abc_PoolThreadNum();
+extern void          Abc_PoolStop();
+extern Abc_Task_t *  Abc_TaskSubmit( Abc_TaskFunc_f pFunc, void * pArg );
+extern int           Abc_TaskDetach( Abc_TaskFunc_f pFunc, void * pArg );
+extern int           Abc_TaskIsDone( Abc_Task_t * pTask );
+extern void *        Abc_TaskWait( Abc_Task_t * pTask );
+extern int           Abc_TaskWaitAny( Abc_Task_t ** ppTasks, int nTasks );
+extern void          Abc_TaskCancel( Abc_Task_t * pTask );
+extern int           Abc_TaskIsCancelled( Abc_Task_t * pTask );
+extern void          Abc_PoolParFor( int nItems, int nTasks, Abc_RangeFunc_f pFunc, void * pArg );
+
+ABC_NAMESPACE_HEADER_END
+
+#endif
+
+////////////////////////////////////////////////////////////////////////
+///                       END OF FILE                                ///
+////////////////////////////////////////////////////////////////////////
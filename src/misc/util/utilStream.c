@@ -0,0 +1,183 @@
+/**CFile****************************************************************
+
+  FileName    [utilStream.c]
+
+  SystemName  [ABC: Logic synthesis and verification system.]
+
+  PackageName [Buffered output streams.]
+
+  Synopsis    [Large-buffer text writer with optional gzip compression.]
+
+  Author      [Alan Mishchenko]
+
+  Affiliation [UC Berkeley]
+
+  Date        [Ver. 1.0. Started - June 20, 2005.]
+
+  Revision    [$Id: utilStream.c,v 1.00 2005/06/20 00:00:00 alanmi Exp $]
+
+***********************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+
+#include "abc_global.h"
+#include "utilStream.h"
+#include "misc/zlib/zlib.h"
+
+ABC_NAMESPACE_IMPL_START
+
+////////////////////////////////////////////////////////////////////////
+///                        DECLARATIONS                              ///
+////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////
+///                     FUNCTION DEFINITIONS                         ///
+////////////////////////////////////////////////////////////////////////
+
+/**Function*************************************************************
+
+  Synopsis    [Opens the output stream.]
+
+  Description [The stream is gzip-compressed if fCompress is set or
+  if the file name ends in ".gz". Returns NULL if the file cannot be
+  opened.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Abc_Ostr_t * Abc_OstrStart( char * pFileName, int fCompress )
+{
+    Abc_Ostr_t * p;
+    void * pFile;
+    int nLength = strlen( pFileName );
+    if ( nLength > 3 && !strcmp( pFileName + nLength - 3, ".gz" ) )
+        fCompress = 1;
+    if ( fCompress )
+    {
+        gzFile pGzFile = gzopen( pFileName, "wb" );
+        if ( pGzFile != NULL )
+            gzbuffer( pGzFile, ABC_OSTR_BUFFER_SIZE );
+        pFile = (void *)pGzFile;
+    }
+    else
+        pFile = (void *)fopen( pFileName, "wb" );
+    if ( pFile == NULL )
+        return NULL;
+    p = ABC_CALLOC( Abc_Ostr_t, 1 );
+    p->nSize     = ABC_OSTR_BUFFER_SIZE;
+    p->pBuffer   = ABC_ALLOC( char, p->nSize );
+    p->fCompress = fCompress;
+    p->pFile     = pFile;
+    return p;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Writes the buffer contents into the file.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Abc_OstrFlush( Abc_Ostr_t * p )
+{
+    int nWritten;
+    if ( p->nUsed == 0 )
+        return;
+    if ( p->fCompress )
+        nWritten = gzwrite( (gzFile)p->pFile, p->pBuffer, (unsigned)p->nUsed );
+    else
+        nWritten = (int)fwrite( p->pBuffer, 1, (size_t)p->nUsed, (FILE *)p->pFile );
+    if ( nWritten != p->nUsed )
+        p->fError = 1;
+    p->nBytes += p->nUsed;
+    p->nUsed   = 0;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Flushes and closes the stream.]
+
+  Description [Returns 1 if all data has been written successfully.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Abc_OstrStop( Abc_Ostr_t * p )
+{
+    int RetValue;
+    Abc_OstrFlush( p );
+    if ( p->fCompress )
+        RetValue = gzclose( (gzFile)p->pFile ) == Z_OK;
+    else
+        RetValue = fclose( (FILE *)p->pFile ) == 0;
+    RetValue = RetValue && !p->fError;
+    ABC_FREE( p->pBuffer );
+    ABC_FREE( p );
+    return RetValue;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Formatted output into the stream.]
+
+  Description [Intended for infrequent output (headers, comments).
+  Inner loops should use Abc_OstrPutS() and Abc_OstrPutNum().]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Abc_OstrPrintf( Abc_Ostr_t * p, const char * pFormat, ... )
+{
+    va_list args;
+    int nBytes;
+    va_start( args, pFormat );
+    nBytes = vsnprintf( p->pBuffer + p->nUsed, (size_t)(p->nSize - p->nUsed), pFormat, args );
+    va_end( args );
+    if ( nBytes < 0 )
+    {
+        p->fError = 1;
+        return;
+    }
+    if ( nBytes < p->nSize - p->nUsed )
+    {
+        p->nUsed += nBytes;
+        return;
+    }
+    // the string did not fit; flush and retry
+    Abc_OstrFlush( p );
+    if ( nBytes < p->nSize )
+    {
+        va_start( args, pFormat );
+        vsnprintf( p->pBuffer, (size_t)p->nSize, pFormat, args );
+        va_end( args );
+        p->nUsed = nBytes;
+    }
+    else
+    {
+        char * pTemp = ABC_ALLOC( char, nBytes + 1 );
+        va_start( args, pFormat );
+        vsnprintf( pTemp, (size_t)nBytes + 1, pFormat, args );
+        va_end( args );
+        Abc_OstrPutBuf( p, pTemp, nBytes );
+        ABC_FREE( pTemp );
+    }
+}
+
+////////////////////////////////////////////////////////////////////////
+///                       END OF FILE                                ///
+////////////////////////////////////////////////////////////////////////
+
+ABC_NAMESPACE_IMPL_END
@@ -0,0 +1,144 @@
+/**CFile****************************************************************
+
+  FileName    [utilStream.h]
+
+  SystemName  [ABC: Logic synthesis and verification system.]
+
+  PackageName [Buffered output streams.]
+
+  Synopsis    [Large-buffer text writer with optional gzip compression.]
+
+  Author      [Alan Mishchenko]
+
+  Affiliation [UC Berkeley]
+
+  Date        [Ver. 1.0. Started - June 20, 2005.]
+
+  Revision    [$Id: utilStream.h,v 1.00 2005/06/20 00:00:00 alanmi Exp $]
+
+***********************************************************************/
+
+#ifndef ABC__misc__util__utilStream_h
+#define ABC__misc__util__utilStream_h
+
+////////////////////////////////////////////////////////////////////////
+///                          INCLUDES                                ///
+////////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+
+////////////////////////////////////////////////////////////////////////
+///                         PARAMETERS                               ///
+////////////////////////////////////////////////////////////////////////
+
+ABC_NAMESPACE_HEADER_START
+
+// default size of the output buffer (1 MB)
+#define ABC_OSTR_BUFFER_SIZE  (1 << 20)
+
+////////////////////////////////////////////////////////////////////////
+///                         BASIC TYPES                              ///
+////////////////////////////////////////////////////////////////////////
+
+typedef struct Abc_Ostr_t_ Abc_Ostr_t;
+struct Abc_Ostr_t_
+{
+    char *       pBuffer;     // output buffer
+    int          nSize;       // buffer size
+    int          nUsed;       // the number of bytes in the buffer
+    int          fCompress;   // the stream is gzip-compressed
+    void *       pFile;       // FILE * or gzFile
+    ABC_INT64_T  nBytes;      // the number of bytes written so far
+    int          fError;      // write error has happened
+};
+
+////////////////////////////////////////////////////////////////////////
+///                    FUNCTION DECLARATIONS                         ///
+////////////////////////////////////////////////////////////////////////
+
+/*=== utilStream.c ==========================================================*/
+
+extern Abc_Ostr_t *  Abc_OstrStart( char * pFileName, int fCompress );
+extern int           Abc_OstrStop( Abc_Ostr_t * p );
+extern void          Abc_OstrFlush( Abc_Ostr_t * p );
+extern void          Abc_OstrPrintf( Abc_Ostr_t * p, const char * pFormat, ... );
+
+////////////////////////////////////////////////////////////////////////
+///                      MACRO DEFINITIONS                           ///
+////////////////////////////////////////////////////////////////////////
+
+/**Function*************************************************************
+
+  Synopsis    [Writing primitives.]
+
+  Description [Each primitive reserves room in the buffer and flushes
+  only when the buffer is full, so the per-call cost is a few stores.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline void Abc_OstrReserve( Abc_Ostr_t * p, int nBytes )
+{
+    if ( p->nUsed + nBytes > p->nSize )
+        Abc_OstrFlush( p );
+}
+static inline void Abc_OstrPutC( Abc_Ostr_t * p, char c )
+{
+    Abc_OstrReserve( p, 1 );
+    p->pBuffer[p->nUsed++] = c;
+}
+static inline void Abc_OstrPutBuf( Abc_Ostr_t * p, const char * pBuf, int nBytes )
+{
+    while ( nBytes > p->nSize - p->nUsed )
+    {
+        int nPart = p->nSize - p->nUsed;
+        memcpy( p->pBuffer + p->nUsed, pBuf, (size_t)nPart );
+        p->nUsed += nPart;
+        pBuf     += nPart;
+        nBytes   -= nPart;
+        Abc_OstrFlush( p );
+    }
+    memcpy( p->pBuffer + p->nUsed, pBuf, (size_t)nBytes );
+    p->nUsed += nBytes;
+}
+static inline void Abc_OstrPutS( Abc_Ostr_t * p, const char * pStr )
+{
+    Abc_OstrPutBuf( p, pStr, (int)strlen(pStr) );
+}
+static inline void Abc_OstrPutNum( Abc_Ostr_t * p, int Num )
+{
+    char Digits[12];
+    unsigned uNum;
+    int nDigits = 0;
+    Abc_OstrReserve( p, 12 );
+    if ( Num < 0 )
+    {
+        p->pBuffer[p->nUsed++] = '-';
+        uNum = 0u - (unsigned)Num;
+    }
+    else
+        uNum = (unsigned)Num;
+    do {
+        Digits[nDigits++] = (char)('0' + uNum % 10);
+        uNum /= 10;
+    } while ( uNum );
+    while ( nDigits )
+        p->pBuffer[p->nUsed++] = Digits[--nDigits];
+}
+// prints the number with the explicit sign (as in the OPB format)
+static inline void Abc_OstrPutNumSigned( Abc_Ostr_t * p, int Num )
+{
+    if ( Num > 0 )
+        Abc_OstrPutC( p, '+' );
+    Abc_OstrPutNum( p, Num );
+}
+
+ABC_NAMESPACE_HEADER_END
+
+#endif
+
+////////////////////////////////////////////////////////////////////////
+///                       END OF FILE                                ///
+////////////////////////////////////////////////////////////////////////
@@ -21,6 +21,7 @@
 #include "abs.h"
 #include "proof/pdr/pdr.h"
 #include "proof/ssw/ssw.h"
+#include "misc/util/utilPool.h"
 
 
 #ifdef ABC_USE_PTHREADS
@@ -60,9 +61,20 @@ typedef struct Abs_ThData_t_
 pthread_mutex_t g_mutex = PTHREAD_MUTEX_INITIALIZER;
 static volatile int g_nRunIds = 0;             // the number of the last prover instance
 static volatile int g_fAbstractionProved = 0;  // set to 1 when prover successed to prove
+static Abc_Task_t * g_pTaskLast = NULL;        // the task of the last prover instance
 
-// call back procedure for PDR
-int Abs_CallBackToStop( int RunId ) { assert( RunId <= g_nRunIds ); return RunId < g_nRunIds; }
+// call back procedure for PDR; also stops when the thread pool is stopped
+int Abs_CallBackToStop( int RunId )
+{
+    int status, fStop;
+    assert( RunId <= g_nRunIds );
+    if ( RunId < g_nRunIds )
+        return 1;
+    status = pthread_mutex_lock(&g_mutex);  assert( status == 0 );
+    fStop = RunId < g_nRunIds || Abc_TaskIsCancelled( g_pTaskLast );
+    status = pthread_mutex_unlock(&g_mutex);  assert( status == 0 );
+    return fStop;
+}
 
 // test procedure to replace PDR
 int Pdr_ManSolve_test( Aig_Man_t * pAig, Pdr_Par_t * pPars, Abc_Cex_t ** ppCex )
@@ -83,7 +95,7 @@ int Pdr_ManSolve_test( Aig_Man_t * pAig, Pdr_Par_t * pPars, Abc_Cex_t ** ppCex )
 
 /**Function*************************************************************
 
-  Synopsis    [Create one thread]
+  Synopsis    [Runs the prover as a background task.]
 
   Description []
                
@@ -92,11 +104,16 @@ int Pdr_ManSolve_test( Aig_Man_t * pAig, Pdr_Par_t * pPars, Abc_Cex_t ** ppCex )
   SeeAlso     []
 
 ***********************************************************************/
-void * Abs_ProverThread( void * pArg )
+void * Abs_ProverTask( void * pArg, Abc_Task_t * pTask )
 {
     Abs_ThData_t * pThData = (Abs_ThData_t *)pArg;
     Pdr_Par_t Pars, * pPars = &Pars;
     int RetValue, status;
+    // let the call back see the cancellation of the task
+    status = pthread_mutex_lock(&g_mutex);  assert( status == 0 );
+    if ( pThData->RunId == g_nRunIds )
+        g_pTaskLast = pTask;
+    status = pthread_mutex_unlock(&g_mutex);  assert( status == 0 );
     // call PDR
     Pdr_ManSetDefaultParams( pPars );
     pPars->fSilent   = 1;
@@ -104,13 +121,13 @@ void * Abs_ProverThread( void * pArg )
     pPars->pFuncStop = Abs_CallBackToStop;
     RetValue = Pdr_ManSolve( pThData->pAig, pPars );
     // update the result
+    status = pthread_mutex_lock(&g_mutex);  assert( status == 0 );
     if ( RetValue == 1 )
-    {
-        status = pthread_mutex_lock(&g_mutex);  assert( status == 0 );
         g_fAbstractionProved = 1;
-        status = pthread_mutex_unlock(&g_mutex);  assert( status == 0 );
-    }
-    // quit this thread
+    if ( g_pTaskLast == pTask )
+        g_pTaskLast = NULL;
+    status = pthread_mutex_unlock(&g_mutex);  assert( status == 0 );
+    // report the result
     if ( pThData->fVerbose )
     {
         if ( RetValue == 1 )
@@ -124,10 +141,7 @@ void * Abs_ProverThread( void * pArg )
     // free memory
     Aig_ManStop( pThData->pAig );
     ABC_FREE( pThData );
-    // quit this thread
-	pthread_exit( NULL );
-	assert(0);
-	return NULL;
+    return NULL;
 }
 void Gia_GlaProveAbsracted( Gia_Man_t * pGia, int fSimpProver, int fVerbose )
 {
@@ -136,7 +150,6 @@ void Gia_GlaProveAbsracted( Gia_Man_t * pGia, int fSimpProver, int fVerbose )
     Ssw_Pars_t Pars, * pPars = &Pars;
     Aig_Man_t * pAig, * pTemp;
     Gia_Man_t * pAbs;
-	pthread_t ProverThread;
     int status;
     // disable verbosity
 //    fVerbose = 0;
@@ -171,10 +184,10 @@ void Gia_GlaProveAbsracted( Gia_Man_t * pGia, int fSimpProver, int fVerbose )
     status = pthread_mutex_lock(&g_mutex);  assert( status == 0 );
     pThData->RunId = ++g_nRunIds;
     status = pthread_mutex_unlock(&g_mutex);  assert( status == 0 );
-    // create thread
+    // start the background task
     if ( fVerbose )  Abc_Print( 1, "\nTrying to prove abstraction %d.\n", pThData->RunId );
-    status = pthread_create( &ProverThread, NULL, Abs_ProverThread, pThData );
-    assert( status == 0 );
+    status = Abc_TaskDetach( Abs_ProverTask, pThData );
+    assert( status == 1 );
 }
 void Gia_GlaProveCancel( int fVerbose )
 {
@@ -25,6 +25,7 @@
 #include "sat/bsat/satSolver.h"
 #include "misc/util/utilTruth.h"
 //#include "bdd/cudd/cuddInt.h"
+#include "misc/util/utilPool.h"
 
 #ifdef ABC_USE_PTHREADS
 
@@ -46,7 +47,7 @@ ABC_NAMESPACE_IMPL_START
 
 #ifndef ABC_USE_PTHREADS
 
-int Cec_GiaSplitTest( Gia_Man_t * p, int nProcs, int nTimeOut, int nIterMax, int LookAhead, int fVerbose, int fVeryVerbose, int fSilent ) { return -1; }
+int Cec_GiaSplitTest( Gia_Man_t * p, int nProcs, int nTimeOut, int nConfLimit, int nIterMax, int LookAhead, int fVerbose, int fVeryVerbose, int fSilent ) { return -1; }
 
 #else // pthreads are used
 
@@ -311,6 +312,15 @@ static inline Cnf_Dat_t * Cec_GiaDeriveGiaRemapped( Gia_Man_t * p )
     Aig_ManStop( pAig );
     return pCnf;
 }
+static inline Cnf_Dat_t * Cec_GiaDeriveGiaRemappedMan( Gia_Man_t * p, Cnf_Man_t * pManCnf )
+{
+    Cnf_Dat_t * pCnf;
+    Aig_Man_t * pAig = Gia_ManToAigSimple( p );
+    pAig->nRegs = 0;
+    pCnf = Cnf_DeriveWithMan( pManCnf, pAig, 0 );
+    Aig_ManStop( pAig );
+    return pCnf;
+}
 static inline sat_solver * Cec_GiaDeriveSolver( Gia_Man_t * p, Cnf_Dat_t * pCnf, int nTimeOut )
 {
     sat_solver * pSat;
@@ -327,21 +337,33 @@ static inline sat_solver * Cec_GiaDeriveSolver( Gia_Man_t * p, Cnf_Dat_t * pCnf,
     sat_solver_set_runtime_limit( pSat, nTimeOut ? nTimeOut * CLOCKS_PER_SEC + Abc_Clock(): 0 );
     return pSat;
 }
-static inline int Cnf_GiaSolveOne( Gia_Man_t * p, Cnf_Dat_t * pCnf, int nTimeOut, int * pnVars, int * pnConfs )
+// if vUnits is given, collects the PIs fixed at level 0 after an undecided run
+static inline int Cnf_GiaSolveOne( Gia_Man_t * p, Cnf_Dat_t * pCnf, int nTimeOut, int nConfLimit, Vec_Int_t * vUnits, int * pnVars, int * pnConfs )
 {
-    int status;
+    Gia_Obj_t * pObj;
+    int i, iVar, Value, status;
     sat_solver * pSat = Cec_GiaDeriveSolver( p, pCnf, nTimeOut );
+    if ( vUnits )
+        Vec_IntClear( vUnits );
     if ( pSat == NULL )
     {
         *pnVars = 0;
         *pnConfs = 0;
         return 1;
     }
-    status   = sat_solver_solve( pSat, NULL, NULL, (ABC_INT64_T)0, (ABC_INT64_T)0, (ABC_INT64_T)0, (ABC_INT64_T)0 );
+    status   = sat_solver_solve( pSat, NULL, NULL, (ABC_INT64_T)nConfLimit, (ABC_INT64_T)0, (ABC_INT64_T)0, (ABC_INT64_T)0 );
     *pnVars  = sat_solver_nvars( pSat );
     *pnConfs = sat_solver_nconflicts( pSat );
     if ( status == l_True )
         p->pCexComb = Cec_SplitDeriveModel( p, pCnf, pSat );
+    if ( status == l_Undef && vUnits )
+        Gia_ManForEachPi( p, pObj, i )
+        {
+            iVar = pCnf->pVarNums[Gia_ObjId(p, pObj)];
+            Value = iVar >= 0 ? sat_solver_get_var_value( pSat, iVar ) : l_Undef;
+            if ( Value != l_Undef )
+                Vec_IntPush( vUnits, Abc_Var2Lit(i, Value == l_False) );
+        }
     sat_solver_delete( pSat );
     if ( status == l_Undef )
         return -1;
@@ -403,7 +425,7 @@ void Cec_GiaSplitPrintRefs( Gia_Man_t * p )
   SeeAlso     []
 
 ***********************************************************************/
-int Cec_GiaSplitTest2( Gia_Man_t * p, int nProcs, int nTimeOut, int nIterMax, int LookAhead, int fVerbose, int fVeryVerbose, int fSilent )
+int Cec_GiaSplitTest2( Gia_Man_t * p, int nProcs, int nTimeOut, int nConfLimit, int nIterMax, int LookAhead, int fVerbose, int fVeryVerbose, int fSilent )
 {
     abctime clkTotal = Abc_Clock();
     Vec_Ptr_t * vStack;
@@ -413,7 +435,7 @@ int Cec_GiaSplitTest2( Gia_Man_t * p, int nProcs, int nTimeOut, int nIterMax, in
     double Progress = 0;
     // check the problem
     pCnf = Cec_GiaDeriveGiaRemapped( p );
-    status = Cnf_GiaSolveOne( p, pCnf, nTimeOut, &nSatVars, &nSatConfs );
+    status = Cnf_GiaSolveOne( p, pCnf, nTimeOut, nConfLimit, NULL, &nSatVars, &nSatConfs );
     Cnf_DataFree( pCnf );
     if ( fVerbose )
         Cec_GiaSplitPrint( 0, 0, nSatVars, nSatConfs, status, Progress, Abc_Clock() - clkTotal );
@@ -459,7 +481,7 @@ int Cec_GiaSplitTest2( Gia_Man_t * p, int nProcs, int nTimeOut, int nIterMax, in
         Vec_IntPush( pPart->vCofVars, Abc_Var2Lit(iVar, 1) );
         // solve the problem
         pCnf = Cec_GiaDeriveGiaRemapped( pPart );
-        status = Cnf_GiaSolveOne( pPart, pCnf, nTimeOut, &nSatVars, &nSatConfs );
+        status = Cnf_GiaSolveOne( pPart, pCnf, nTimeOut, nConfLimit, NULL, &nSatVars, &nSatConfs );
         Cnf_DataFree( pCnf );
         if ( status == 1 )
             Progress += 1.0 / pow(2, Depth);
@@ -486,7 +508,7 @@ int Cec_GiaSplitTest2( Gia_Man_t * p, int nProcs, int nTimeOut, int nIterMax, in
         Gia_ManStop( pLast );
         // solve the problem
         pCnf = Cec_GiaDeriveGiaRemapped( pPart );
-        status = Cnf_GiaSolveOne( pPart, pCnf, nTimeOut, &nSatVars, &nSatConfs );
+        status = Cnf_GiaSolveOne( pPart, pCnf, nTimeOut, nConfLimit, NULL, &nSatVars, &nSatConfs );
         Cnf_DataFree( pCnf );
         if ( status == 1 )
             Progress += 1.0 / pow(2, Depth);
@@ -528,200 +550,346 @@ int Cec_GiaSplitTest2( Gia_Man_t * p, int nProcs, int nTimeOut, int nIterMax, in
 
 /**Function*************************************************************
 
-  Synopsis    []
+  Synopsis    [Cofactors the PIs fixed by the units.]
+
+  Description [Each unit is a literal of the PI index; the positive literal
+  fixes the PI to 1. The PIs are not removed, so PI indexes are preserved.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Gia_Man_t * Cec_GiaSplitCofactorUnits( Gia_Man_t * p, Vec_Int_t * vUnits )
+{
+    Gia_Man_t * pNew, * pTemp;
+    Gia_Obj_t * pObj;
+    int i, iLit;
+    pNew = Gia_ManStart( Gia_ManObjNum(p) );
+    pNew->pName = Abc_UtilStrsav( p->pName );
+    pNew->pSpec = Abc_UtilStrsav( p->pSpec );
+    Gia_ManConst0(p)->Value = 0;
+    Gia_ManForEachCi( p, pObj, i )
+        pObj->Value = Gia_ManAppendCi(pNew);
+    Vec_IntForEachEntry( vUnits, iLit, i )
+        Gia_ManPi( p, Abc_Lit2Var(iLit) )->Value = !Abc_LitIsCompl(iLit);
+    Gia_ManHashAlloc( pNew );
+    Gia_ManForEachAnd( p, pObj, i )
+        pObj->Value = Gia_ManHashAnd( pNew, Gia_ObjFanin0Copy(pObj), Gia_ObjFanin1Copy(pObj) );
+    Gia_ManForEachCo( p, pObj, i )
+        Gia_ManAppendCo( pNew, Gia_ObjFanin0Copy(pObj) );
+    pNew = Gia_ManCleanup( pTemp = pNew );
+    Gia_ManStop( pTemp );
+    return pNew;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Cube-and-conquer with dynamic re-splitting.]
+
+  Description [A cube is a cofactor of the miter w.r.t. some PIs; the
+  cofactoring literals are stored in vCofVars and the number of case-splits
+  leading to the cube in iData. The tasks share a stack of cubes. A task
+  takes a cube and solves it under the runtime and conflict limits. If the
+  cube is undecided, the same task splits it: it pushes one child cube on
+  the shared stack, where it can be taken by any idle task, and continues
+  with the other child. This way, the hard part of the problem is split
+  as long as there are idle tasks, instead of being split in advance.
+  The PIs fixed at level 0 of the solver after an undecided run are implied
+  by the cube, so they are fixed in both children. These units are not
+  passed to other cubes because they may not hold there, except those
+  derived for the original problem, which are inherited by all cubes.]
 
-  Description []
-               
   SideEffects []
 
   SeeAlso     []
 
 ***********************************************************************/
 #define PAR_THR_MAX 100
+typedef struct Cec_SplitMan_t_ Cec_SplitMan_t;
+struct Cec_SplitMan_t_
+{
+    // parameters
+    int             nTimeOut;    // runtime limit per cube
+    int             nConfLimit;  // conflict limit per cube
+    int             nIterMax;    // the max number of case-splits
+    int             LookAhead;   // look-ahead during cofactoring
+    int             fVerbose;    // verbose output
+    int             fVeryVerbose;// very verbose output
+    // shared data (protected by the mutex)
+    pthread_mutex_t Mutex;       // the mutex
+    pthread_cond_t  Cond;        // signals new cubes and termination
+    Vec_Ptr_t *     vStack;      // cubes waiting to be solved
+    Abc_Cex_t *     pCex;        // the counter-example
+    int             nActive;     // the number of tasks working on a cube
+    int             fStop;       // the tasks should stop
+    int             nIter;       // the number of case-splits
+    int             nUnits;      // the number of PIs fixed by the units
+    double          Progress;    // the part of the input space proved UNSAT
+    Vec_Int_t *     vDepthUnsat; // the number of UNSAT cubes at each depth
+    Vec_Int_t *     vDepthSplit; // the number of split cubes at each depth
+    abctime         clkTotal;    // the starting time
+};
 typedef struct Par_ThData_t_
 {
-    Gia_Man_t * p;
-    Cnf_Dat_t * pCnf;
-    int         iThread;
-    int         nTimeOut;
-    int         fWorking;
-    int         Result;
-    int         nVars;
-    int         nConfs;
+    Cec_SplitMan_t * pMan;       // the shared data
+    int         iThread;         // the task number
+    int         nCubes;          // the number of cubes solved
+    int         nSplits;         // the number of cubes split
+    int         nWaits;          // the number of times the stack was empty
+    abctime     clkBusy;         // the runtime of solving and splitting
 } Par_ThData_t;
-void * Cec_GiaSplitWorkerThread( void * pArg )
+static inline void Cec_GiaSplitMarkDepth( Vec_Int_t * vDepths, int Depth )
+{
+    Vec_IntFillExtra( vDepths, Depth + 1, 0 );
+    Vec_IntAddToEntry( vDepths, Depth, 1 );
+}
+// splits the cube on the best PI after fixing the PIs in vUnits
+static void Cec_GiaSplitCube( Cec_SplitMan_t * p, Gia_Man_t * pCube, Vec_Int_t * vUnits, Gia_Man_t ** ppCofs )
+{
+    Gia_Man_t * pTemp;
+    int k, nFanouts, Cost, iVar;
+    if ( pCube->vCofVars == NULL )
+        pCube->vCofVars = Vec_IntAlloc( 100 );
+    if ( Vec_IntSize(vUnits) > 0 )
+    {
+        pCube = Cec_GiaSplitCofactorUnits( pTemp = pCube, vUnits );
+        pCube->vCofVars = pTemp->vCofVars;  pTemp->vCofVars = NULL;
+        pCube->iData = pTemp->iData;
+        Vec_IntAppend( pCube->vCofVars, vUnits );
+        Gia_ManStop( pTemp );
+    }
+    iVar = Gia_SplitCofVar( pCube, p->LookAhead, &nFanouts, &Cost );
+    for ( k = 0; k < 2; k++ )
+    {
+        ppCofs[k] = Gia_ManDupCofactorVar( pCube, iVar, k );
+        ppCofs[k]->vCofVars = Vec_IntAlloc( Vec_IntSize(pCube->vCofVars) + 1 );
+        Vec_IntAppend( ppCofs[k]->vCofVars, pCube->vCofVars );
+        Vec_IntPush( ppCofs[k]->vCofVars, Abc_Var2Lit(iVar, !k) );
+        ppCofs[k]->iData = pCube->iData + 1;
+    }
+    if ( p->fVeryVerbose )
+        printf( "Var = %5d. Fanouts = %5d. Cost = %8d.  AndBefore = %6d.  AndAfter = %6d.\n",
+            iVar, nFanouts, Cost, Gia_ManAndNum(pCube), Gia_ManAndNum(ppCofs[0]) );
+    Gia_ManStop( pCube );
+}
+void * Cec_GiaSplitWorkerTask( void * pArg, Abc_Task_t * pTask )
 {
     Par_ThData_t * pThData = (Par_ThData_t *)pArg;
-    volatile int * pPlace = &pThData->fWorking;
+    Cec_SplitMan_t * p = pThData->pMan;
+    Cnf_Man_t * pManCnf = Cnf_ManStart();
+    Vec_Int_t * vUnits = Vec_IntAlloc( 100 );
+    Gia_Man_t * pCube = NULL, * pCofs[2];
+    Cnf_Dat_t * pCnf;
+    int status, fSplit, Depth, nVars, nConfs;
+    abctime clk;
     while ( 1 )
     {
-        while ( *pPlace == 0 );
-        assert( pThData->fWorking );
-        if ( pThData->p == NULL )
+        // get the next cube unless this task has one
+        pthread_mutex_lock( &p->Mutex );
+        if ( pCube == NULL )
         {
-	        pthread_exit( NULL );
-            assert( 0 );
-            return NULL;
+            while ( !p->fStop && Vec_PtrSize(p->vStack) == 0 && p->nActive > 0 )
+            {
+                pThData->nWaits++;
+                pthread_cond_wait( &p->Cond, &p->Mutex );
+            }
+            if ( p->fStop || Vec_PtrSize(p->vStack) == 0 )
+            {
+                // stopped, or no cubes left and nobody can produce them
+                pthread_cond_broadcast( &p->Cond );
+                pthread_mutex_unlock( &p->Mutex );
+                break;
+            }
+            pCube = (Gia_Man_t *)Vec_PtrPop( p->vStack );
+            p->nActive++;
+        }
+        else if ( p->fStop )
+        {
+            Gia_ManStop( pCube );
+            p->nActive--;
+            pthread_cond_broadcast( &p->Cond );
+            pthread_mutex_unlock( &p->Mutex );
+            break;
+        }
+        pthread_mutex_unlock( &p->Mutex );
+        // solve the cube
+        clk = Abc_Clock();
+        Depth = pCube->iData;
+        pCnf = Cec_GiaDeriveGiaRemappedMan( pCube, pManCnf );
+        status = Cnf_GiaSolveOne( pCube, pCnf, p->nTimeOut, p->nConfLimit, vUnits, &nVars, &nConfs );
+        Cnf_DataFree( pCnf );
+        pCofs[0] = pCofs[1] = NULL;
+        if ( status == -1 )
+        {
+            // reserve a case-split
+            pthread_mutex_lock( &p->Mutex );
+            fSplit = !p->fStop && !(p->nIterMax && p->nIter >= p->nIterMax);
+            p->nIter += fSplit;
+            pthread_mutex_unlock( &p->Mutex );
+            if ( fSplit )
+            {
+                Cec_GiaSplitCube( p, pCube, vUnits, pCofs );
+                pCube = NULL;
+            }
+        }
+        clk = Abc_Clock() - clk;
+        pThData->clkBusy += clk;
+        pThData->nCubes++;
+        // update the shared data
+        pthread_mutex_lock( &p->Mutex );
+        if ( status == 0 ) // SAT
+        {
+            if ( p->pCex == NULL )
+                p->pCex = pCube->pCexComb, pCube->pCexComb = NULL;
+            p->fStop = 1;
+        }
+        else if ( status == 1 ) // UNSAT
+        {
+            p->Progress += 1.0 / pow(2, Depth);
+            Cec_GiaSplitMarkDepth( p->vDepthUnsat, Depth );
         }
-        pThData->Result = Cnf_GiaSolveOne( pThData->p, pThData->pCnf, pThData->nTimeOut, &pThData->nVars, &pThData->nConfs );
-        pThData->fWorking = 0;
+        else if ( pCofs[0] == NULL ) // UNDEC and out of case-splits
+            p->fStop = 1;
+        else // UNDEC
+        {
+            Cec_GiaSplitMarkDepth( p->vDepthSplit, Depth );
+            p->nUnits += Vec_IntSize(vUnits);
+            pThData->nSplits++;
+            // share one child and keep working on the other
+            Vec_PtrPush( p->vStack, pCofs[0] );
+            pthread_cond_signal( &p->Cond );
+        }
+        if ( p->fVerbose )
+            Cec_GiaSplitPrint( pThData->iThread+1, Depth, nVars, nConfs, status, p->Progress, clk );
+        if ( pCofs[1] == NULL )
+            p->nActive--;
+        if ( p->fStop || p->nActive == 0 )
+            pthread_cond_broadcast( &p->Cond );
+        pthread_mutex_unlock( &p->Mutex );
+        if ( pCube )
+            Gia_ManStopP( &pCube );
+        pCube = pCofs[1];
     }
-	assert( 0 );
-	return NULL;
+    Vec_IntFree( vUnits );
+    Cnf_ManStop( pManCnf );
+    return NULL;
 }
-int Cec_GiaSplitTestInt( Gia_Man_t * p, int nProcs, int nTimeOut, int nIterMax, int LookAhead, int fVerbose, int fVeryVerbose, int fSilent )
+void Cec_GiaSplitPrintStats( Cec_SplitMan_t * p, Par_ThData_t * pThData, int nProcs )
+{
+    abctime clkMax = 0, clkSum = 0;
+    int i, nUnsat, nSplit, nDepthMax = Abc_MaxInt( Vec_IntSize(p->vDepthUnsat), Vec_IntSize(p->vDepthSplit) );
+    printf( "Cube depth statistics:\n" );
+    for ( i = 0; i < nDepthMax; i++ )
+    {
+        nUnsat = i < Vec_IntSize(p->vDepthUnsat) ? Vec_IntEntry(p->vDepthUnsat, i) : 0;
+        nSplit = i < Vec_IntSize(p->vDepthSplit) ? Vec_IntEntry(p->vDepthSplit, i) : 0;
+        if ( nUnsat == 0 && nSplit == 0 )
+            continue;
+        printf( "Depth =%3d  :  UNSAT =%6d  Split =%6d\n", i, nUnsat, nSplit );
+    }
+    printf( "Case-splits = %d.  PIs fixed by units = %d.\n", p->nIter, p->nUnits );
+    for ( i = 0; i < nProcs; i++ )
+    {
+        clkMax  = Abc_MaxInt( clkMax, pThData[i].clkBusy );
+        clkSum += pThData[i].clkBusy;
+    }
+    printf( "Load balance statistics:\n" );
+    for ( i = 0; i < nProcs; i++ )
+    {
+        printf( "Task %3d :  Cubes =%6d  Split =%6d  Waits =%6d  Share =%6.2f %%  ",
+            i+1, pThData[i].nCubes, pThData[i].nSplits, pThData[i].nWaits, clkSum ? 100.0 * pThData[i].clkBusy / clkSum : 0.0 );
+        Abc_PrintTime( 1, "Busy", pThData[i].clkBusy );
+    }
+    printf( "Imbalance (max/average busy time) = %.2f.\n", clkSum ? 1.0 * nProcs * clkMax / clkSum : 1.0 );
+    fflush( stdout );
+}
+int Cec_GiaSplitTestInt( Gia_Man_t * p, int nProcs, int nTimeOut, int nConfLimit, int nIterMax, int LookAhead, int fVerbose, int fVeryVerbose, int fSilent )
 {
     abctime clkTotal = Abc_Clock();
     Par_ThData_t ThData[PAR_THR_MAX];
-	pthread_t WorkerThread[PAR_THR_MAX];
-    Vec_Ptr_t * vStack;
+    Abc_Task_t * pTasks[PAR_THR_MAX];
+    Cec_SplitMan_t Man, * pMan = &Man;
+    Vec_Int_t * vUnits;
+    Gia_Man_t * pCube;
     Cnf_Dat_t * pCnf;
-    double Progress = 0;
-    int i, status, nSatVars, nSatConfs;
-    int nIter = 0, RetValue = -1, fWorkToDo = 1;
+    int i, status, nSatVars, nSatConfs, RetValue = -1;
     Abc_CexFreeP( &p->pCexComb );
     if ( fVerbose )
         printf( "Solving CEC problem by cofactoring with the following parameters:\n" );
     if ( fVerbose )
-        printf( "Processes = %d   TimeOut = %d sec   MaxIter = %d   LookAhead = %d   Verbose = %d.\n", nProcs, nTimeOut, nIterMax, LookAhead, fVerbose );
+        printf( "Processes = %d   TimeOut = %d sec   ConfLimit = %d   MaxIter = %d   LookAhead = %d   Verbose = %d.\n", nProcs, nTimeOut, nConfLimit, nIterMax, LookAhead, fVerbose );
     fflush( stdout );
     if ( nProcs == 1 )
-        return Cec_GiaSplitTest2( p, nProcs, nTimeOut, nIterMax, LookAhead, fVerbose, fVeryVerbose, fSilent );
-    // subtract manager thread
-    nProcs--;
+        return Cec_GiaSplitTest2( p, nProcs, nTimeOut, nConfLimit, nIterMax, LookAhead, fVerbose, fVeryVerbose, fSilent );
     assert( nProcs >= 1 && nProcs <= PAR_THR_MAX );
     // check the problem
+    vUnits = Vec_IntAlloc( 100 );
     pCnf = Cec_GiaDeriveGiaRemapped( p );
-    status = Cnf_GiaSolveOne( p, pCnf, nTimeOut, &nSatVars, &nSatConfs );
+    status = Cnf_GiaSolveOne( p, pCnf, nTimeOut, nConfLimit, vUnits, &nSatVars, &nSatConfs );
     Cnf_DataFree( pCnf );
     if ( fVerbose && status != -1 )
-        Cec_GiaSplitPrint( 0, 0, nSatVars, nSatConfs, status, Progress, Abc_Clock() - clkTotal );
+        Cec_GiaSplitPrint( 0, 0, nSatVars, nSatConfs, status, 0, Abc_Clock() - clkTotal );
     if ( status == 0 )
     {
 		if ( !fSilent )
         printf( "The problem is SAT without cofactoring.\n" );
+        Vec_IntFree( vUnits );
         return 0;
     }
     if ( status == 1 )
     {
 		if ( !fSilent )
         printf( "The problem is UNSAT without cofactoring.\n" );
+        Vec_IntFree( vUnits );
         return 1;
     }
     assert( status == -1 );
-    // create local copy
-    vStack = Vec_PtrAlloc( 1000 );
-    Vec_PtrPush( vStack, Gia_ManDup(p) );
-    // start threads
+    // create the first cube with the PIs fixed by the units of the original problem
+    pCube = Vec_IntSize(vUnits) ? Cec_GiaSplitCofactorUnits( p, vUnits ) : Gia_ManDup( p );
+    pCube->vCofVars = Vec_IntDup( vUnits );
+    pCube->iData = 0;
+    // start the shared data
+    memset( pMan, 0, sizeof(Cec_SplitMan_t) );
+    pMan->nTimeOut     = nTimeOut;
+    pMan->nConfLimit   = nConfLimit;
+    pMan->nIterMax     = nIterMax;
+    pMan->LookAhead    = LookAhead;
+    pMan->fVerbose     = fVerbose;
+    pMan->fVeryVerbose = fVeryVerbose;
+    pMan->vStack       = Vec_PtrAlloc( 1000 );
+    pMan->nUnits       = Vec_IntSize(vUnits);
+    pMan->vDepthUnsat  = Vec_IntAlloc( 100 );
+    pMan->vDepthSplit  = Vec_IntAlloc( 100 );
+    pMan->clkTotal     = clkTotal;
+    pthread_mutex_init( &pMan->Mutex, NULL );
+    pthread_cond_init( &pMan->Cond, NULL );
+    Vec_PtrPush( pMan->vStack, pCube );
+    Vec_IntFree( vUnits );
+    // start the tasks and wait till they finish
     for ( i = 0; i < nProcs; i++ )
     {
-        ThData[i].p        = NULL;
-        ThData[i].pCnf     = NULL;
-        ThData[i].iThread  = i;
-        ThData[i].nTimeOut = nTimeOut;
-        ThData[i].fWorking = 0;
-        ThData[i].Result   = -1;
-        ThData[i].nVars    = -1;
-        ThData[i].nConfs   = -1;
-        status = pthread_create( WorkerThread + i, NULL,Cec_GiaSplitWorkerThread, (void *)(ThData + i) );  assert( status == 0 );
+        memset( ThData + i, 0, sizeof(Par_ThData_t) );
+        ThData[i].pMan    = pMan;
+        ThData[i].iThread = i;
+        pTasks[i] = Abc_TaskSubmit( Cec_GiaSplitWorkerTask, ThData + i );
     }
-    // look at the threads
-    while ( fWorkToDo )
-    {
-        fWorkToDo = (int)(Vec_PtrSize(vStack) > 0);
-        for ( i = 0; i < nProcs; i++ )
-        {
-            // check if this thread is working
-            if ( ThData[i].fWorking )
-            {
-                fWorkToDo = 1;
-                continue;
-            }
-            // check if this thread has recently finished
-            if ( ThData[i].p != NULL )
-            {
-                Gia_Man_t * pLast = ThData[i].p;
-                int Depth = pLast->vCofVars ? Vec_IntSize(pLast->vCofVars) : 0;
-                if ( pLast->vCofVars == NULL )
-                    pLast->vCofVars = Vec_IntAlloc( 100 );
-                if ( fVerbose )
-                    Cec_GiaSplitPrint( i+1, Depth, ThData[i].nVars, ThData[i].nConfs, ThData[i].Result, Progress, Abc_Clock() - clkTotal );
-                if ( ThData[i].Result == 0 ) // SAT
-                {
-                    p->pCexComb = pLast->pCexComb;  pLast->pCexComb = NULL;
-                    RetValue = 0;
-                    goto finish;
-                }
-                if ( ThData[i].Result == -1 ) // UNDEC
-                {
-                    // determine cofactoring variable
-                    int nFanouts, Cost, iVar = Gia_SplitCofVar( pLast, LookAhead, &nFanouts, &Cost );
-                    // cofactor
-                    Gia_Man_t * pPart = Gia_ManDupCofactorVar( pLast, iVar, 0 );
-                    pPart->vCofVars = Vec_IntAlloc( Vec_IntSize(pLast->vCofVars) + 1 );
-                    Vec_IntAppend( pPart->vCofVars, pLast->vCofVars );
-                    Vec_IntPush( pPart->vCofVars, Abc_Var2Lit(iVar, 1) );
-                    Vec_PtrPush( vStack, pPart );
-                    // print results
-                    if ( fVeryVerbose )
-                    {
-//                        Cec_GiaSplitPrintRefs( pLast );
-                        printf( "Var = %5d. Fanouts = %5d. Cost = %8d.  AndBefore = %6d.  AndAfter = %6d.\n", 
-                            iVar, nFanouts, Cost, Gia_ManAndNum(pLast), Gia_ManAndNum(pPart) );
-//                        Cec_GiaSplitPrintRefs( pPart );
-                    }
-                    // cofactor
-                    pPart = Gia_ManDupCofactorVar( pLast, iVar, 1 );
-                    pPart->vCofVars = Vec_IntAlloc( Vec_IntSize(pLast->vCofVars) + 1 );
-                    Vec_IntAppend( pPart->vCofVars, pLast->vCofVars );
-                    Vec_IntPush( pPart->vCofVars, Abc_Var2Lit(iVar, 1) );
-                    Vec_PtrPush( vStack, pPart );
-                    // keep working
-                    fWorkToDo = 1;
-                    nIter++;
-                }
-                else
-                    Progress += 1.0 / pow(2, Depth);
-                Gia_ManStopP( &ThData[i].p );
-                if ( ThData[i].pCnf == NULL )
-                    continue;
-                Cnf_DataFree( ThData[i].pCnf );
-                ThData[i].pCnf = NULL;
-            }
-            if ( Vec_PtrSize(vStack) == 0 )
-                continue;
-            // start a new thread
-            assert( ThData[i].p == NULL );
-            ThData[i].p = (Gia_Man_t*)Vec_PtrPop( vStack );
-            ThData[i].pCnf = Cec_GiaDeriveGiaRemapped( ThData[i].p );
-            ThData[i].fWorking = 1;
-        }
-        if ( nIterMax && nIter >= nIterMax )
-            break;
-    }
-    if ( !fWorkToDo )
-        RetValue = 1;
-finish:
-    // wait till threads finish
-    for ( i = 0; i < nProcs; i++ )
-        if ( ThData[i].fWorking )
-            i = 0;
-    // stop threads
     for ( i = 0; i < nProcs; i++ )
-    {
-        assert( !ThData[i].fWorking );
-        // cleanup
-        Gia_ManStopP( &ThData[i].p );
-        if ( ThData[i].pCnf == NULL )
-            continue;
-        Cnf_DataFree( ThData[i].pCnf );
-        ThData[i].pCnf = NULL;
-        // stop
-        ThData[i].p = NULL;
-        ThData[i].fWorking = 1;
-    }
+        Abc_TaskWait( pTasks[i] );
+    assert( pMan->nActive == 0 );
+    // collect the result
+    if ( pMan->pCex )
+        p->pCexComb = pMan->pCex, RetValue = 0;
+    else if ( !pMan->fStop && Vec_PtrSize(pMan->vStack) == 0 )
+        RetValue = 1;
+    if ( fVerbose )
+        Cec_GiaSplitPrintStats( pMan, ThData, nProcs );
     // finish
-    Cec_GiaSplitClean( vStack );
+    Cec_GiaSplitClean( pMan->vStack );
+    Vec_IntFree( pMan->vDepthUnsat );
+    Vec_IntFree( pMan->vDepthSplit );
+    pthread_mutex_destroy( &pMan->Mutex );
+    pthread_cond_destroy( &pMan->Cond );
 	if ( !fSilent )
 	{
 		if ( RetValue == 0 )
@@ -731,13 +899,29 @@ finish:
 		else if ( RetValue == -1 )
 			printf( "Problem is UNDECIDED " );
 		else assert( 0 );
-		printf( "after %d case-splits.  ", nIter );
+		printf( "after %d case-splits.  ", pMan->nIter );
 		Abc_PrintTime( 1, "Time", Abc_Clock() - clkTotal );
 		fflush( stdout );
 	}
     return RetValue;
 }
-int Cec_GiaSplitTest( Gia_Man_t * p, int nProcs, int nTimeOut, int nIterMax, int LookAhead, int fVerbose, int fVeryVerbose, int fSilent )
+// translates the CEX of the output cone (whose PIs are in the DFS order) into the CEX of the original AIG
+static inline Abc_Cex_t * Cec_GiaSplitRemapCex( Gia_Man_t * p, Gia_Man_t * pOne, Abc_Cex_t * pCexOne )
+{
+    Abc_Cex_t * pCex = Abc_CexAlloc( 0, Gia_ManPiNum(p), 1 );
+    Gia_Obj_t * pObj;
+    int i, iPi;
+    Gia_ManForEachPi( p, pObj, i )
+    {
+        if ( !~pObj->Value )
+            continue;
+        iPi = Gia_ObjCioId( Gia_ManObj(pOne, Abc_Lit2Var(pObj->Value)) );
+        if ( Abc_InfoHasBit(pCexOne->pData, iPi) )
+            Abc_InfoSetBit( pCex->pData, i );
+    }
+    return pCex;
+}
+int Cec_GiaSplitTest( Gia_Man_t * p, int nProcs, int nTimeOut, int nConfLimit, int nIterMax, int LookAhead, int fVerbose, int fVeryVerbose, int fSilent )
 {
     Abc_Cex_t * pCex = NULL;
     Gia_Man_t * pOne;
@@ -749,15 +933,15 @@ int Cec_GiaSplitTest( Gia_Man_t * p, int nProcs, int nTimeOut, int nIterMax, int
         pOne = Gia_ManDupOutputGroup( p, i, i+1 );
         if ( fVerbose )
             printf( "\nSolving output %d:\n", i );
-        RetValue1 = Cec_GiaSplitTestInt( pOne, nProcs, nTimeOut, nIterMax, LookAhead,  fVerbose, fVeryVerbose, fSilent );
-        Gia_ManStop( pOne );
+        RetValue1 = Cec_GiaSplitTestInt( pOne, nProcs, nTimeOut, nConfLimit, nIterMax, LookAhead,  fVerbose, fVeryVerbose, fSilent );
         // collect the result
         if ( RetValue1 == 0 && RetValue == -1 )
         {
-            pCex = pOne->pCexComb; pOne->pCexComb = NULL;
+            pCex = Cec_GiaSplitRemapCex( p, pOne, pOne->pCexComb );
             pCex->iPo = i;
             RetValue = 0;
         }
+        Gia_ManStop( pOne );
         if ( RetValue1 == -1 )
             fOneUndef = 1;
     }
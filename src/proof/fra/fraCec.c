@@ -21,6 +21,7 @@
 #include "fra.h"
 #include "sat/cnf/cnf.h"
 #include "sat/bsat/satSolver2.h"
+#include "sat/bsat/satElim.h"
 
 ABC_NAMESPACE_IMPL_START
 
@@ -284,6 +285,136 @@ int Fra_FraigSat( Aig_Man_t * pMan, ABC_INT64_T nConfLimit, ABC_INT64_T nInsLimi
     }
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Solves the combinational miter using a portfolio of solvers.]
+
+  Description [The outputs of the miter are ORed. Returns 1 if the miter
+  is UNSAT, 0 if it is SAT (the CI values are stored in pMan->pData) and
+  -1 if it is undecided.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Fra_FraigSatPortfolio( Aig_Man_t * pMan, Sat_PortPars_t * pPars )
+{
+    Aig_Man_t * pAig;
+    Cnf_Dat_t * pCnf;
+    Vec_Int_t * vCiIds;
+    int i, iVar, status, * pModel = NULL;
+    abctime clk = Abc_Clock();
+    assert( Aig_ManRegNum(pMan) == 0 );
+    pMan->pData = NULL;
+    // derive CNF asserting the OR of the outputs
+    pAig = Aig_ManCoNum(pMan) > 1 ? Aig_ManDupOrpos( pMan, 0 ) : pMan;
+    pCnf = Cnf_Derive( pAig, 0 );
+    vCiIds = Cnf_DataCollectPiSatNums( pCnf, pAig );
+    if ( pAig != pMan )
+        Aig_ManStop( pAig );
+    if ( pPars->fVerbose )
+    {
+        printf( "CNF stats: Vars = %6d. Clauses = %7d. Literals = %8d. ", pCnf->nVars, pCnf->nClauses, pCnf->nLiterals );
+        Abc_PrintTime( 1, "Time", Abc_Clock() - clk );
+    }
+    // solve the miter
+    status = Sat_SolverPortfolio( pCnf->nVars, pCnf->pClauses, pCnf->nClauses, NULL, NULL, pPars, &pModel );
+    if ( status == l_True )
+    {
+        int * pValues = ABC_CALLOC( int, Vec_IntSize(vCiIds) );
+        Vec_IntForEachEntry( vCiIds, iVar, i )
+            if ( iVar >= 0 )
+                pValues[i] = pModel[iVar];
+        pMan->pData = pValues;
+    }
+    ABC_FREE( pModel );
+    Vec_IntFree( vCiIds );
+    Cnf_DataFree( pCnf );
+    if ( status == l_Undef )
+        return -1;
+    return status == l_True ? 0 : 1;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Solves the combinational miter after CNF preprocessing.]
+
+  Description [The outputs of the miter are ORed. The CNF is simplified
+  by subsumption and variable elimination before it is loaded into the
+  solver. Returns 1 if the miter is UNSAT, 0 if it is SAT (the CI values
+  are stored in pMan->pData) and -1 if it is undecided.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Fra_FraigSatElim( Aig_Man_t * pMan, ABC_INT64_T nConfLimit, ABC_INT64_T nInsLimit, int fVerbose )
+{
+    Sat_ElimPars_t Pars, * pPars = &Pars;
+    Sat_Elim_t * pElim;
+    sat_solver * pSat = NULL;
+    Aig_Man_t * pAig;
+    Cnf_Dat_t * pCnf;
+    Vec_Int_t * vCiIds;
+    int i, iVar, status, * pModel, * pValues;
+    abctime clk = Abc_Clock();
+    assert( Aig_ManRegNum(pMan) == 0 );
+    pMan->pData = NULL;
+    // derive CNF asserting the OR of the outputs
+    pAig = Aig_ManCoNum(pMan) > 1 ? Aig_ManDupOrpos( pMan, 0 ) : pMan;
+    pCnf = Cnf_Derive( pAig, 0 );
+    vCiIds = Cnf_DataCollectPiSatNums( pCnf, pAig );
+    if ( pAig != pMan )
+        Aig_ManStop( pAig );
+    if ( fVerbose )
+    {
+        printf( "CNF stats: Vars = %6d. Clauses = %7d. Literals = %8d. ", pCnf->nVars, pCnf->nClauses, pCnf->nLiterals );
+        Abc_PrintTime( 1, "Time", Abc_Clock() - clk );
+    }
+    // simplify the CNF
+    Sat_ElimSetDefaultPars( pPars );
+    pPars->fVerbose = fVerbose;
+    pElim = Sat_ElimAlloc( pCnf->nVars );
+    for ( i = 0; i < pCnf->nClauses; i++ )
+        if ( !Sat_ElimAddClause( pElim, pCnf->pClauses[i], pCnf->pClauses[i+1] ) )
+            break;
+    if ( Sat_ElimPerform( pElim, pPars ) )
+        pSat = Sat_ElimDeriveSolver( pElim );
+    Cnf_DataFree( pCnf );
+    if ( pSat == NULL )
+    {
+        Sat_ElimFree( pElim );
+        Vec_IntFree( vCiIds );
+        return 1;
+    }
+    // solve the miter
+    status = sat_solver_solve( pSat, NULL, NULL, nConfLimit, nInsLimit, (ABC_INT64_T)0, (ABC_INT64_T)0 );
+    if ( status == l_True )
+    {
+        // extend the model to the eliminated variables
+        pModel = ABC_ALLOC( int, sat_solver_nvars(pSat) );
+        for ( i = 0; i < sat_solver_nvars(pSat); i++ )
+            pModel[i] = sat_solver_var_value( pSat, i );
+        Sat_ElimExtendModel( pElim, pModel );
+        pValues = ABC_CALLOC( int, Vec_IntSize(vCiIds) );
+        Vec_IntForEachEntry( vCiIds, iVar, i )
+            if ( iVar >= 0 )
+                pValues[i] = pModel[iVar];
+        pMan->pData = pValues;
+        ABC_FREE( pModel );
+    }
+    if ( fVerbose )
+        Sat_SolverPrintStats( stdout, pSat );
+    sat_solver_delete( pSat );
+    Sat_ElimFree( pElim );
+    Vec_IntFree( vCiIds );
+    if ( status == l_Undef )
+        return -1;
+    return status == l_True ? 0 : 1;
+}
+
 /**Function*************************************************************
 
   Synopsis    [Recognizes what nodes are inputs of the EXOR.]
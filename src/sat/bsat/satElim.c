@@ -0,0 +1,765 @@
+/**CFile****************************************************************
+
+  FileName    [satElim.c]
+
+  SystemName  [ABC: Logic synthesis and verification system.]
+
+  PackageName [CNF preprocessing.]
+
+  Synopsis    [Subsumption and bounded variable elimination.]
+
+  Author      [Alan Mishchenko]
+
+  Affiliation [UC Berkeley]
+
+  Date        [Ver. 1.0. Started - June 20, 2005.]
+
+  Revision    [$Id: satElim.c,v 1.00 2005/06/20 00:00:00 alanmi Exp $]
+
+***********************************************************************/
+
+#include "satElim.h"
+#include "misc/vec/vec.h"
+#include "misc/vec/vecWec.h"
+
+ABC_NAMESPACE_IMPL_START
+
+
+////////////////////////////////////////////////////////////////////////
+///                        DECLARATIONS                              ///
+////////////////////////////////////////////////////////////////////////
+
+/*
+    Each clause is stored in vStore as (size, flags, signature, literals)
+    and is referred to by its offset. The literals are sorted. Clauses are
+    deleted by setting a flag and removed from the occurrence lists lazily.
+
+    The elimination stack is a sequence of records (literals, size), where
+    the first literal belongs to the eliminated variable. The records are
+    processed in the reverse order: if no other literal of a clause is true,
+    the first literal is made true.
+*/
+
+#define SAT_ELIM_DELETED  1
+#define SAT_ELIM_QUEUED   2
+
+struct Sat_Elim_t_
+{
+    int             nVars;         // the number of variables
+    Vec_Int_t *     vStore;        // clause storage
+    Vec_Int_t *     vClauses;      // the clause handles
+    Vec_Wec_t *     vOccurs;       // the clauses of each variable
+    char *          pValues;       // the values fixed at level 0 (2 = none)
+    char *          pFrozen;       // the variables that cannot be eliminated
+    char *          pElimed;       // the eliminated variables
+    char *          pTouched;      // the variables whose clauses have changed
+    Vec_Int_t *     vUnits;        // the fixed literals
+    int             iUnitHead;     // the first literal to be propagated
+    Vec_Int_t *     vQueue;        // the clauses to be checked for subsumption
+    int             iQueueHead;    // the first clause to be checked
+    Vec_Int_t *     vStack;        // the elimination stack
+    Vec_Int_t *     vTemp;         // temporary literals
+    Vec_Int_t *     vTemp2;        // temporary clause handles
+    Vec_Int_t *     vTemp3;        // temporary clause handles (propagation)
+    Vec_Int_t *     vPos;          // positive clauses of a variable
+    Vec_Int_t *     vNeg;          // negative clauses of a variable
+    Vec_Int_t *     vResol;        // resolvents (size, literals)
+    int             fUnsat;        // the problem is UNSAT
+    int             nLive;         // the number of live clauses
+    // statistics
+    int             nSubsumed;     // subsumed clauses
+    int             nStrengthened; // strengthened clauses
+    int             nEliminated;   // eliminated variables
+};
+
+static inline int *    Sat_ElimClause( Sat_Elim_t * p, int h )          { return Vec_IntEntryP( p->vStore, h );          }
+static inline int      Sat_ElimClauseSize( int * pC )                   { return pC[0];                                  }
+static inline int *    Sat_ElimClauseLits( int * pC )                   { return pC + 3;                                 }
+static inline int      Sat_ElimClauseIsDeleted( int * pC )              { return (pC[1] & SAT_ELIM_DELETED) != 0;        }
+static inline unsigned Sat_ElimClauseSign( int * pC )                   { return (unsigned)pC[2];                        }
+static inline int      Sat_ElimLitValue( Sat_Elim_t * p, int Lit )      { return p->pValues[lit_var(Lit)] == 2 ? -1 : p->pValues[lit_var(Lit)] != lit_sign(Lit); }
+
+////////////////////////////////////////////////////////////////////////
+///                     FUNCTION DEFINITIONS                         ///
+////////////////////////////////////////////////////////////////////////
+
+/**Function*************************************************************
+
+  Synopsis    [Sets the default parameters.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Sat_ElimSetDefaultPars( Sat_ElimPars_t * pPars )
+{
+    memset( pPars, 0, sizeof(Sat_ElimPars_t) );
+    pPars->nResSizeMax =   20;   // the largest resolvent
+    pPars->nOccurMax   =  100;   // the largest number of clauses of an eliminated variable
+    pPars->nGrowMax    =    0;   // the allowed increase in the number of clauses per variable
+    pPars->nSubsumeMax = 1000;   // the longest occurrence list checked for subsumption
+    pPars->nRoundMax   =    5;   // the largest number of elimination rounds
+    pPars->fVerbose    =    0;   // verbose output
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Starts and stops the preprocessor.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+Sat_Elim_t * Sat_ElimAlloc( int nVars )
+{
+    Sat_Elim_t * p = ABC_CALLOC( Sat_Elim_t, 1 );
+    p->nVars    = nVars;
+    p->vStore   = Vec_IntAlloc( 1 << 16 );
+    p->vClauses = Vec_IntAlloc( 1 << 12 );
+    p->vOccurs  = Vec_WecStart( nVars );
+    p->pValues  = ABC_ALLOC( char, nVars );
+    p->pFrozen  = ABC_CALLOC( char, nVars );
+    p->pElimed  = ABC_CALLOC( char, nVars );
+    p->pTouched = ABC_CALLOC( char, nVars );
+    p->vUnits   = Vec_IntAlloc( 100 );
+    p->vQueue   = Vec_IntAlloc( 1 << 12 );
+    p->vStack   = Vec_IntAlloc( 1 << 12 );
+    p->vTemp    = Vec_IntAlloc( 100 );
+    p->vTemp2   = Vec_IntAlloc( 100 );
+    p->vTemp3   = Vec_IntAlloc( 100 );
+    p->vPos     = Vec_IntAlloc( 100 );
+    p->vNeg     = Vec_IntAlloc( 100 );
+    p->vResol   = Vec_IntAlloc( 1000 );
+    memset( p->pValues, 2, sizeof(char) * nVars );
+    return p;
+}
+void Sat_ElimFree( Sat_Elim_t * p )
+{
+    Vec_IntFree( p->vStore );
+    Vec_IntFree( p->vClauses );
+    Vec_WecFree( p->vOccurs );
+    ABC_FREE( p->pValues );
+    ABC_FREE( p->pFrozen );
+    ABC_FREE( p->pElimed );
+    ABC_FREE( p->pTouched );
+    Vec_IntFree( p->vUnits );
+    Vec_IntFree( p->vQueue );
+    Vec_IntFree( p->vStack );
+    Vec_IntFree( p->vTemp );
+    Vec_IntFree( p->vTemp2 );
+    Vec_IntFree( p->vTemp3 );
+    Vec_IntFree( p->vPos );
+    Vec_IntFree( p->vNeg );
+    Vec_IntFree( p->vResol );
+    ABC_FREE( p );
+}
+void Sat_ElimSetFrozen( Sat_Elim_t * p, int iVar )
+{
+    assert( iVar >= 0 && iVar < p->nVars );
+    assert( !p->pElimed[iVar] );
+    p->pFrozen[iVar] = 1;
+}
+int Sat_ElimVarIsEliminated( Sat_Elim_t * p, int iVar )
+{
+    assert( iVar >= 0 && iVar < p->nVars );
+    return p->pElimed[iVar];
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Manipulates clauses.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline unsigned Sat_ElimComputeSign( int * pLits, int nLits )
+{
+    unsigned Sign = 0;
+    int i;
+    for ( i = 0; i < nLits; i++ )
+        Sign |= 1u << (lit_var(pLits[i]) & 31);
+    return Sign;
+}
+static inline void Sat_ElimQueueClause( Sat_Elim_t * p, int h )
+{
+    int * pC = Sat_ElimClause( p, h );
+    if ( pC[1] & SAT_ELIM_QUEUED )
+        return;
+    pC[1] |= SAT_ELIM_QUEUED;
+    Vec_IntPush( p->vQueue, h );
+}
+static inline void Sat_ElimDeleteClause( Sat_Elim_t * p, int h )
+{
+    int * pC = Sat_ElimClause( p, h ), i;
+    assert( !Sat_ElimClauseIsDeleted(pC) );
+    pC[1] |= SAT_ELIM_DELETED;
+    for ( i = 0; i < Sat_ElimClauseSize(pC); i++ )
+        p->pTouched[lit_var(Sat_ElimClauseLits(pC)[i])] = 1;
+    p->nLive--;
+}
+static inline void Sat_ElimCleanOccurs( Sat_Elim_t * p, int iVar )
+{
+    Vec_Int_t * vOcc = Vec_WecEntry( p->vOccurs, iVar );
+    int i, h, k = 0;
+    Vec_IntForEachEntry( vOcc, h, i )
+        if ( !Sat_ElimClauseIsDeleted(Sat_ElimClause(p, h)) )
+            Vec_IntWriteEntry( vOcc, k++, h );
+    Vec_IntShrink( vOcc, k );
+}
+static int Sat_ElimClauseNew( Sat_Elim_t * p, int * pLits, int nLits )
+{
+    int i, h = Vec_IntSize( p->vStore );
+    assert( nLits > 1 );
+    Vec_IntPush( p->vStore, nLits );
+    Vec_IntPush( p->vStore, 0 );
+    Vec_IntPush( p->vStore, (int)Sat_ElimComputeSign(pLits, nLits) );
+    for ( i = 0; i < nLits; i++ )
+    {
+        assert( !p->pElimed[lit_var(pLits[i])] );
+        Vec_IntPush( p->vStore, pLits[i] );
+        Vec_WecPush( p->vOccurs, lit_var(pLits[i]), h );
+        p->pTouched[lit_var(pLits[i])] = 1;
+    }
+    Vec_IntPush( p->vClauses, h );
+    Sat_ElimQueueClause( p, h );
+    p->nLive++;
+    return h;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Fixes a literal at level 0.]
+
+  Description [Returns 0 if the literal is already false.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline int Sat_ElimAssign( Sat_Elim_t * p, int Lit )
+{
+    int Value = Sat_ElimLitValue( p, Lit );
+    if ( Value == 0 )
+        return !(p->fUnsat = 1);
+    if ( Value == 1 )
+        return 1;
+    p->pValues[lit_var(Lit)] = !lit_sign(Lit);
+    Vec_IntPush( p->vUnits, Lit );
+    return 1;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Removes a literal from the clause.]
+
+  Description [Returns 0 if the problem becomes UNSAT. If the clause
+  becomes a unit, it is deleted and its literal is fixed.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static int Sat_ElimStrengthen( Sat_Elim_t * p, int h, int Lit, int fUpdateOccurs )
+{
+    int * pC = Sat_ElimClause( p, h );
+    int * pLits = Sat_ElimClauseLits( pC );
+    int i, k = 0;
+    for ( i = 0; i < Sat_ElimClauseSize(pC); i++ )
+        if ( pLits[i] != Lit )
+            pLits[k++] = pLits[i];
+    assert( k == Sat_ElimClauseSize(pC) - 1 );
+    pC[0] = k;
+    pC[2] = (int)Sat_ElimComputeSign( pLits, k );
+    if ( fUpdateOccurs )
+        Vec_IntRemove( Vec_WecEntry(p->vOccurs, lit_var(Lit)), h );
+    p->pTouched[lit_var(Lit)] = 1;
+    if ( k == 0 )
+        return !(p->fUnsat = 1);
+    if ( k == 1 )
+    {
+        Sat_ElimDeleteClause( p, h );
+        return Sat_ElimAssign( p, pLits[0] );
+    }
+    Sat_ElimQueueClause( p, h );
+    return 1;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Propagates the fixed literals through the clauses.]
+
+  Description [Returns 0 if the problem becomes UNSAT. Uses its own 
+  copy of the occurrence list because it is called while the caller
+  iterates over p->vTemp2.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static int Sat_ElimPropagate( Sat_Elim_t * p )
+{
+    int i, h, Lit, * pC, * pLits, k;
+    while ( !p->fUnsat && p->iUnitHead < Vec_IntSize(p->vUnits) )
+    {
+        Lit = Vec_IntEntry( p->vUnits, p->iUnitHead++ );
+        Vec_IntClear( p->vTemp3 );
+        Vec_IntAppend( p->vTemp3, Vec_WecEntry(p->vOccurs, lit_var(Lit)) );
+        Vec_IntClear( Vec_WecEntry(p->vOccurs, lit_var(Lit)) );
+        Vec_IntForEachEntry( p->vTemp3, h, i )
+        {
+            pC = Sat_ElimClause( p, h );
+            if ( Sat_ElimClauseIsDeleted(pC) )
+                continue;
+            pLits = Sat_ElimClauseLits( pC );
+            for ( k = 0; k < Sat_ElimClauseSize(pC); k++ )
+                if ( pLits[k] == Lit )
+                    break;
+            if ( k < Sat_ElimClauseSize(pC) )
+                Sat_ElimDeleteClause( p, h );
+            else if ( !Sat_ElimStrengthen( p, h, lit_neg(Lit), 0 ) )
+                return 0;
+        }
+    }
+    return !p->fUnsat;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Adds a clause to the preprocessor.]
+
+  Description [Returns 0 if the problem becomes UNSAT.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static int Sat_ElimAddClauseInt( Sat_Elim_t * p, Vec_Int_t * vLits )
+{
+    int i, k, Lit, Value, * pLits;
+    if ( p->fUnsat )
+        return 0;
+    Vec_IntSort( vLits, 0 );
+    pLits = Vec_IntArray( vLits );
+    for ( i = k = 0; i < Vec_IntSize(vLits); i++ )
+    {
+        Lit = pLits[i];
+        assert( lit_var(Lit) < p->nVars );
+        Value = Sat_ElimLitValue( p, Lit );
+        if ( Value == 1 )
+            return 1;
+        if ( Value == 0 || (k > 0 && pLits[k-1] == Lit) )
+            continue;
+        if ( k > 0 && pLits[k-1] == lit_neg(Lit) )
+            return 1;
+        pLits[k++] = Lit;
+    }
+    if ( k == 0 )
+        return !(p->fUnsat = 1);
+    if ( k == 1 )
+        return Sat_ElimAssign( p, pLits[0] ) && Sat_ElimPropagate( p );
+    Sat_ElimClauseNew( p, pLits, k );
+    return 1;
+}
+int Sat_ElimAddClause( Sat_Elim_t * p, lit * pBeg, lit * pEnd )
+{
+    lit * pLit;
+    Vec_IntClear( p->vTemp );
+    for ( pLit = pBeg; pLit < pEnd; pLit++ )
+        Vec_IntPush( p->vTemp, *pLit );
+    return Sat_ElimAddClauseInt( p, p->vTemp );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Checks whether clause C subsumes or strengthens clause D.]
+
+  Description [Returns -2 if neither, -1 if C subsumes D, or the literal
+  of C whose complement can be removed from D.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static inline int Sat_ElimSubsumes( int * pC, int * pD )
+{
+    int * pLitsC = Sat_ElimClauseLits( pC );
+    int * pLitsD = Sat_ElimClauseLits( pD );
+    int nLitsD = Sat_ElimClauseSize( pD );
+    int i, k = 0, Res = -1;
+    if ( Sat_ElimClauseSize(pC) > nLitsD || (Sat_ElimClauseSign(pC) & ~Sat_ElimClauseSign(pD)) )
+        return -2;
+    for ( i = 0; i < Sat_ElimClauseSize(pC); i++, k++ )
+    {
+        while ( k < nLitsD && lit_var(pLitsD[k]) < lit_var(pLitsC[i]) )
+            k++;
+        if ( k == nLitsD || lit_var(pLitsD[k]) != lit_var(pLitsC[i]) )
+            return -2;
+        if ( pLitsD[k] == pLitsC[i] )
+            continue;
+        if ( Res != -1 )
+            return -2;
+        Res = pLitsC[i];
+    }
+    return Res;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Uses the clause for backward subsumption and strengthening.]
+
+  Description [Returns 0 if the problem becomes UNSAT.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static int Sat_ElimSubsumeOne( Sat_Elim_t * p, int hC, int nSubsumeMax )
+{
+    int * pC = Sat_ElimClause( p, hC ), * pD;
+    int i, hD, Res, iVar, iVarBest = -1, nOccBest = ABC_INFINITY;
+    pC[1] &= ~SAT_ELIM_QUEUED;
+    if ( Sat_ElimClauseIsDeleted(pC) )
+        return 1;
+    // all clauses containing C contain its variable with the shortest occurrence list
+    for ( i = 0; i < Sat_ElimClauseSize(pC); i++ )
+    {
+        iVar = lit_var( Sat_ElimClauseLits(pC)[i] );
+        if ( nOccBest > Vec_IntSize(Vec_WecEntry(p->vOccurs, iVar)) )
+            nOccBest = Vec_IntSize(Vec_WecEntry(p->vOccurs, iVar)), iVarBest = iVar;
+    }
+    if ( nOccBest > nSubsumeMax )
+        return 1;
+    Sat_ElimCleanOccurs( p, iVarBest );
+    Vec_IntClear( p->vTemp2 );
+    Vec_IntAppend( p->vTemp2, Vec_WecEntry(p->vOccurs, iVarBest) );
+    Vec_IntForEachEntry( p->vTemp2, hD, i )
+    {
+        pC = Sat_ElimClause( p, hC );
+        pD = Sat_ElimClause( p, hD );
+        if ( Sat_ElimClauseIsDeleted(pC) )
+            break;
+        if ( hD == hC || Sat_ElimClauseIsDeleted(pD) )
+            continue;
+        Res = Sat_ElimSubsumes( pC, pD );
+        if ( Res == -1 )
+        {
+            Sat_ElimDeleteClause( p, hD );
+            p->nSubsumed++;
+        }
+        else if ( Res >= 0 )
+        {
+            p->nStrengthened++;
+            if ( !Sat_ElimStrengthen( p, hD, lit_neg(Res), 1 ) || !Sat_ElimPropagate( p ) )
+                return 0;
+        }
+    }
+    return 1;
+}
+static int Sat_ElimSubsume( Sat_Elim_t * p, int nSubsumeMax )
+{
+    while ( p->iQueueHead < Vec_IntSize(p->vQueue) )
+        if ( !Sat_ElimSubsumeOne( p, Vec_IntEntry(p->vQueue, p->iQueueHead++), nSubsumeMax ) )
+            return 0;
+    Vec_IntClear( p->vQueue );
+    p->iQueueHead = 0;
+    return 1;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Computes the resolvent of two clauses on the variable.]
+
+  Description [Returns 0 if the resolvent is a tautology.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static int Sat_ElimResolve( int * pC, int * pD, int iVar, Vec_Int_t * vRes )
+{
+    int * pLitsC = Sat_ElimClauseLits( pC ), nLitsC = Sat_ElimClauseSize( pC );
+    int * pLitsD = Sat_ElimClauseLits( pD ), nLitsD = Sat_ElimClauseSize( pD );
+    int i = 0, k = 0;
+    Vec_IntClear( vRes );
+    while ( i < nLitsC || k < nLitsD )
+    {
+        if ( i < nLitsC && lit_var(pLitsC[i]) == iVar )
+            i++;
+        else if ( k < nLitsD && lit_var(pLitsD[k]) == iVar )
+            k++;
+        else if ( k == nLitsD || (i < nLitsC && pLitsC[i] < pLitsD[k]) )
+        {
+            if ( k < nLitsD && pLitsD[k] == lit_neg(pLitsC[i]) )
+                return 0;
+            Vec_IntPush( vRes, pLitsC[i++] );
+        }
+        else if ( i == nLitsC || pLitsD[k] < pLitsC[i] )
+        {
+            if ( i < nLitsC && pLitsC[i] == lit_neg(pLitsD[k]) )
+                return 0;
+            Vec_IntPush( vRes, pLitsD[k++] );
+        }
+        else // the same literal
+            Vec_IntPush( vRes, pLitsC[i++] ), k++;
+    }
+    return 1;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Saves a clause of the eliminated variable.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Sat_ElimSaveClause( Sat_Elim_t * p, int * pC, int iVar )
+{
+    int i, * pLits = Sat_ElimClauseLits( pC );
+    for ( i = 0; i < Sat_ElimClauseSize(pC); i++ )
+        if ( lit_var(pLits[i]) == iVar )
+            Vec_IntPush( p->vStack, pLits[i] );
+    for ( i = 0; i < Sat_ElimClauseSize(pC); i++ )
+        if ( lit_var(pLits[i]) != iVar )
+            Vec_IntPush( p->vStack, pLits[i] );
+    Vec_IntPush( p->vStack, Sat_ElimClauseSize(pC) );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Eliminates the variable if the CNF does not grow.]
+
+  Description [Returns 0 if the problem becomes UNSAT.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static int Sat_ElimTryVar( Sat_Elim_t * p, int iVar, Sat_ElimPars_t * pPars )
+{
+    Vec_Int_t * vSmall;
+    int i, k, h, hP, hN, nRes = 0, * pC;
+    if ( p->pFrozen[iVar] || p->pElimed[iVar] || p->pValues[iVar] != 2 )
+        return 1;
+    // split the clauses
+    Sat_ElimCleanOccurs( p, iVar );
+    Vec_IntClear( p->vPos );
+    Vec_IntClear( p->vNeg );
+    Vec_IntForEachEntry( Vec_WecEntry(p->vOccurs, iVar), h, i )
+    {
+        pC = Sat_ElimClause( p, h );
+        for ( k = 0; k < Sat_ElimClauseSize(pC); k++ )
+            if ( lit_var(Sat_ElimClauseLits(pC)[k]) == iVar )
+                break;
+        assert( k < Sat_ElimClauseSize(pC) );
+        Vec_IntPush( lit_sign(Sat_ElimClauseLits(pC)[k]) ? p->vNeg : p->vPos, h );
+    }
+    if ( Vec_IntSize(p->vPos) + Vec_IntSize(p->vNeg) == 0 )
+        return 1;
+    if ( Vec_IntSize(p->vPos) > 0 && Vec_IntSize(p->vNeg) > 0 )
+    {
+        if ( Vec_IntSize(p->vPos) + Vec_IntSize(p->vNeg) > pPars->nOccurMax )
+            return 1;
+        // check that the resolvents are few and small
+        Vec_IntForEachEntry( p->vPos, hP, i )
+        Vec_IntForEachEntry( p->vNeg, hN, k )
+        {
+            if ( !Sat_ElimResolve( Sat_ElimClause(p, hP), Sat_ElimClause(p, hN), iVar, p->vTemp ) )
+                continue;
+            if ( Vec_IntSize(p->vTemp) > pPars->nResSizeMax )
+                return 1;
+            if ( ++nRes > Vec_IntSize(p->vPos) + Vec_IntSize(p->vNeg) + pPars->nGrowMax )
+                return 1;
+        }
+    }
+    // collect the resolvents
+    Vec_IntClear( p->vResol );
+    Vec_IntForEachEntry( p->vPos, hP, i )
+    Vec_IntForEachEntry( p->vNeg, hN, k )
+    {
+        if ( !Sat_ElimResolve( Sat_ElimClause(p, hP), Sat_ElimClause(p, hN), iVar, p->vTemp ) )
+            continue;
+        Vec_IntPush( p->vResol, Vec_IntSize(p->vTemp) );
+        Vec_IntAppend( p->vResol, p->vTemp );
+    }
+    // save the clauses of the smaller polarity followed by the unit of the other one
+    vSmall = Vec_IntSize(p->vPos) > Vec_IntSize(p->vNeg) ? p->vNeg : p->vPos;
+    Vec_IntForEachEntry( vSmall, h, i )
+        Sat_ElimSaveClause( p, Sat_ElimClause(p, h), iVar );
+    Vec_IntPush( p->vStack, toLitCond(iVar, vSmall == p->vPos) );
+    Vec_IntPush( p->vStack, 1 );
+    // replace the clauses by the resolvents
+    Vec_IntForEachEntry( Vec_WecEntry(p->vOccurs, iVar), h, i )
+        Sat_ElimDeleteClause( p, h );
+    Vec_IntErase( Vec_WecEntry(p->vOccurs, iVar) );
+    p->pElimed[iVar] = 1;
+    p->nEliminated++;
+    for ( i = 0; i < Vec_IntSize(p->vResol); i += 1 + Vec_IntEntry(p->vResol, i) )
+    {
+        Vec_IntClear( p->vTemp );
+        for ( k = 0; k < Vec_IntEntry(p->vResol, i); k++ )
+            Vec_IntPush( p->vTemp, Vec_IntEntry(p->vResol, i + 1 + k) );
+        if ( !Sat_ElimAddClauseInt( p, p->vTemp ) )
+            return 0;
+    }
+    return Sat_ElimPropagate( p );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Simplifies the CNF.]
+
+  Description [Alternates subsumption with elimination of the variables
+  whose clauses have changed since the previous round, the cheapest
+  variables first. Returns 0 if the problem is UNSAT.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Sat_ElimPerform( Sat_Elim_t * p, Sat_ElimPars_t * pPars )
+{
+    Vec_Int_t * vCands = Vec_IntAlloc( p->nVars );
+    Vec_Int_t * vCosts = Vec_IntAlloc( p->nVars );
+    int i, v, r, * pPerm, nElimOld, nClausesOld = p->nLive, nUnitsOld = Vec_IntSize(p->vUnits);
+    abctime clk = Abc_Clock();
+    if ( !Sat_ElimPropagate( p ) )
+        goto finish;
+    for ( r = 0; r < pPars->nRoundMax; r++ )
+    {
+        if ( !Sat_ElimSubsume( p, pPars->nSubsumeMax ) )
+            goto finish;
+        // collect the touched variables
+        Vec_IntClear( vCands );
+        Vec_IntClear( vCosts );
+        for ( v = 0; v < p->nVars; v++ )
+            if ( p->pTouched[v] && !p->pFrozen[v] && !p->pElimed[v] && p->pValues[v] == 2 )
+            {
+                Vec_IntPush( vCands, v );
+                Vec_IntPush( vCosts, Vec_IntSize(Vec_WecEntry(p->vOccurs, v)) );
+            }
+        memset( p->pTouched, 0, sizeof(char) * p->nVars );
+        if ( Vec_IntSize(vCands) == 0 )
+            break;
+        // eliminate the variables in the order of their occurrences
+        nElimOld = p->nEliminated;
+        pPerm = Abc_MergeSortCost( Vec_IntArray(vCosts), Vec_IntSize(vCosts) );
+        for ( i = 0; i < Vec_IntSize(vCands); i++ )
+            if ( !Sat_ElimTryVar( p, Vec_IntEntry(vCands, pPerm[i]), pPars ) )
+                break;
+        ABC_FREE( pPerm );
+        if ( p->fUnsat )
+            goto finish;
+        if ( nElimOld == p->nEliminated )
+            break;
+    }
+    Sat_ElimSubsume( p, pPars->nSubsumeMax );
+finish:
+    if ( pPars->fVerbose )
+    {
+        printf( "Preprocessing: Vars = %d (elim = %d, fixed = %d).  Clauses = %d -> %d.  Subsumed = %d.  Strengthened = %d.  ",
+            p->nVars, p->nEliminated, Vec_IntSize(p->vUnits) - nUnitsOld, nClausesOld, p->nLive, p->nSubsumed, p->nStrengthened );
+        Abc_PrintTime( 1, "Time", Abc_Clock() - clk );
+        if ( p->fUnsat )
+            printf( "The problem is UNSAT after preprocessing.\n" );
+    }
+    Vec_IntFree( vCands );
+    Vec_IntFree( vCosts );
+    return !p->fUnsat;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Loads the simplified CNF into a new solver.]
+
+  Description [Returns NULL if the problem is UNSAT.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+sat_solver * Sat_ElimDeriveSolver( Sat_Elim_t * p )
+{
+    sat_solver * pSat;
+    int i, h, Lit, * pC;
+    if ( p->fUnsat )
+        return NULL;
+    pSat = sat_solver_new();
+    sat_solver_setnvars( pSat, p->nVars );
+    Vec_IntForEachEntry( p->vUnits, Lit, i )
+        if ( !sat_solver_addclause( pSat, &Lit, &Lit + 1 ) )
+        {
+            sat_solver_delete( pSat );
+            return NULL;
+        }
+    Vec_IntForEachEntry( p->vClauses, h, i )
+    {
+        pC = Sat_ElimClause( p, h );
+        if ( Sat_ElimClauseIsDeleted(pC) )
+            continue;
+        if ( !sat_solver_addclause( pSat, Sat_ElimClauseLits(pC), Sat_ElimClauseLits(pC) + Sat_ElimClauseSize(pC) ) )
+        {
+            sat_solver_delete( pSat );
+            return NULL;
+        }
+    }
+    return pSat;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Extends the model of the simplified CNF to all variables.]
+
+  Description [pModel contains the value (0 or 1) of each variable in
+  the solution of the simplified CNF.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Sat_ElimExtendModel( Sat_Elim_t * p, int * pModel )
+{
+    int * pStack = Vec_IntArray( p->vStack );
+    int i, k, Lit;
+    for ( i = Vec_IntSize(p->vStack) - 1; i > 0; i -= k )
+    {
+        for ( k = pStack[i--]; k > 1; k--, i-- )
+            if ( pModel[lit_var(pStack[i])] == !lit_sign(pStack[i]) )
+                break;
+        if ( k > 1 )
+            continue;
+        Lit = pStack[i];
+        pModel[lit_var(Lit)] = !lit_sign(Lit);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////
+///                       END OF FILE                                ///
+////////////////////////////////////////////////////////////////////////
+
+
+ABC_NAMESPACE_IMPL_END
@@ -0,0 +1,92 @@
+/**CFile****************************************************************
+
+  FileName    [satElim.h]
+
+  SystemName  [ABC: Logic synthesis and verification system.]
+
+  PackageName [CNF preprocessing.]
+
+  Synopsis    [External declarations.]
+
+  Author      [Alan Mishchenko]
+
+  Affiliation [UC Berkeley]
+
+  Date        [Ver. 1.0. Started - June 20, 2005.]
+
+  Revision    [$Id: satElim.h,v 1.00 2005/06/20 00:00:00 alanmi Exp $]
+
+***********************************************************************/
+
+#ifndef ABC__sat__bsat__satElim_h
+#define ABC__sat__bsat__satElim_h
+
+
+/*
+    SatELite-style preprocessing of the CNF before it is loaded into the
+    solver: unit propagation, backward subsumption, self-subsuming
+    resolution and bounded variable elimination. Frozen variables (those
+    used in assumptions or in clauses added later) are never eliminated.
+    The clauses of the eliminated variables are kept on a stack, which is
+    used to extend a model of the simplified CNF to all variables.
+
+    Typical use:
+        p = Sat_ElimAlloc( nVars );
+        Sat_ElimAddClause( p, ... ), Sat_ElimSetFrozen( p, ... );
+        Sat_ElimPerform( p, pPars );
+        pSat = Sat_ElimDeriveSolver( p );
+        ... if SAT, copy the model into pModel and call
+        Sat_ElimExtendModel( p, pModel );
+*/
+
+////////////////////////////////////////////////////////////////////////
+///                          INCLUDES                                ///
+////////////////////////////////////////////////////////////////////////
+
+#include "satSolver.h"
+
+////////////////////////////////////////////////////////////////////////
+///                         PARAMETERS                               ///
+////////////////////////////////////////////////////////////////////////
+
+ABC_NAMESPACE_HEADER_START
+
+////////////////////////////////////////////////////////////////////////
+///                         BASIC TYPES                              ///
+////////////////////////////////////////////////////////////////////////
+
+typedef struct Sat_Elim_t_ Sat_Elim_t;
+
+typedef struct Sat_ElimPars_t_ Sat_ElimPars_t;
+struct Sat_ElimPars_t_
+{
+    int         nResSizeMax;   // the largest resolvent
+    int         nOccurMax;     // the largest number of clauses of an eliminated variable
+    int         nGrowMax;      // the allowed increase in the number of clauses per variable
+    int         nSubsumeMax;   // the longest occurrence list checked for subsumption
+    int         nRoundMax;     // the largest number of elimination rounds
+    int         fVerbose;      // verbose output
+};
+
+////////////////////////////////////////////////////////////////////////
+///                    FUNCTION DECLARATIONS                         ///
+////////////////////////////////////////////////////////////////////////
+
+/*=== satElim.c ==========================================================*/
+extern void         Sat_ElimSetDefaultPars( Sat_ElimPars_t * pPars );
+extern Sat_Elim_t * Sat_ElimAlloc( int nVars );
+extern void         Sat_ElimFree( Sat_Elim_t * p );
+extern void         Sat_ElimSetFrozen( Sat_Elim_t * p, int iVar );
+extern int          Sat_ElimAddClause( Sat_Elim_t * p, lit * pBeg, lit * pEnd );
+extern int          Sat_ElimPerform( Sat_Elim_t * p, Sat_ElimPars_t * pPars );
+extern int          Sat_ElimVarIsEliminated( Sat_Elim_t * p, int iVar );
+extern sat_solver * Sat_ElimDeriveSolver( Sat_Elim_t * p );
+extern void         Sat_ElimExtendModel( Sat_Elim_t * p, int * pModel );
+
+ABC_NAMESPACE_HEADER_END
+
+#endif
+
+////////////////////////////////////////////////////////////////////////
+///                       END OF FILE                                ///
+////////////////////////////////////////////////////////////////////////
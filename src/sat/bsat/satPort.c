@@ -0,0 +1,555 @@
+/**CFile****************************************************************
+
+  FileName    [satPort.c]
+
+  SystemName  [ABC: Logic synthesis and verification system.]
+
+  PackageName [C-language MiniSat solver.]
+
+  Synopsis    [Portfolio of solvers exchanging short learned clauses.]
+
+  Author      [Alan Mishchenko]
+
+  Affiliation [UC Berkeley]
+
+  Date        [Ver. 1.0. Started - June 20, 2005.]
+
+  Revision    [$Id: satPort.c,v 1.4 2005/09/16 22:55:03 casem Exp $]
+
+***********************************************************************/
+
+#include <stdio.h>
+#include <assert.h>
+#include "satSolver.h"
+#include "misc/vec/vec.h"
+#include "misc/util/utilPool.h"
+
+#ifdef ABC_USE_PTHREADS
+
+#ifdef _WIN32
+#include "../lib/pthread.h"
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#endif
+
+ABC_NAMESPACE_IMPL_START
+
+
+////////////////////////////////////////////////////////////////////////
+///                        DECLARATIONS                              ///
+////////////////////////////////////////////////////////////////////////
+
+/*
+    The portfolio runs several differently configured instances of the
+    solver on the same problem. Each instance collects its learned clauses
+    with small LBD in a local buffer. At every restart, the buffer is moved
+    to the shared pool and the clauses added to the pool by the other
+    instances since the last restart are imported as learned clauses.
+    The first instance to solve the problem stops the others.
+
+    The pool is a sequence of records (size, lbd, instance, literals).
+    When it reaches the size limit, the prefix read by all instances is
+    dropped; if this does not free enough space, new clauses are discarded.
+*/
+
+typedef struct Sat_PortMan_t_ Sat_PortMan_t;
+typedef struct Sat_PortThr_t_ Sat_PortThr_t;
+
+struct Sat_PortThr_t_
+{
+    Sat_PortMan_t * pMan;          // portfolio manager
+    int             iSolver;       // the instance number
+    int             iRead;         // the first unread entry of the pool
+    Vec_Int_t *     vExport;       // clauses to be exported
+    Vec_Int_t *     vImport;       // clauses to be imported
+    int             Status;        // the result of this instance
+    int             nConfs;        // the number of conflicts
+    int             nExported;     // the number of exported clauses
+    int             nImported;     // the number of imported clauses
+    abctime         clkTotal;      // runtime of this instance
+};
+
+struct Sat_PortMan_t_
+{
+    // problem
+    int             nVars;         // the number of variables
+    int **          pClauses;      // the clauses
+    int             nClauses;      // the number of clauses
+    lit *           pLitsBeg;      // unit clauses
+    lit *           pLitsEnd;      // unit clauses
+    Sat_PortPars_t* pPars;         // parameters
+    // shared state
+#ifdef ABC_USE_PTHREADS
+    pthread_mutex_t Mutex;         // protects the pool and the result
+#endif
+    Vec_Int_t *     vPool;         // shared clause pool
+    int             nPoolBase;     // the number of entries dropped from the pool
+    int             nDropped;      // the number of discarded clauses
+    Sat_PortThr_t * pThData;       // thread data
+    volatile int    fStop;         // stop all instances
+    int             Status;        // the result
+    int             iWinner;       // the instance that solved the problem
+    int *           pModel;        // the satisfying assignment
+};
+
+////////////////////////////////////////////////////////////////////////
+///                     FUNCTION DEFINITIONS                         ///
+////////////////////////////////////////////////////////////////////////
+
+/**Function*************************************************************
+
+  Synopsis    [Sets the default parameters of the portfolio.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+void Sat_PortSetDefaultPars( Sat_PortPars_t * pPars )
+{
+    memset( pPars, 0, sizeof(Sat_PortPars_t) );
+    pPars->nSolvers   =       4;   // the number of solvers in the portfolio
+    pPars->nLbdMax    =       3;   // the largest LBD of shared learned clauses
+    pPars->nSizeMax   =      30;   // the largest size of shared learned clauses
+    pPars->nPoolMax   = 1 << 20;   // the largest number of literals in the clause pool
+    pPars->nConfLimit =       0;   // conflict limit of each solver (0 = no limit)
+    pPars->nTimeOut   =       0;   // runtime limit in seconds (0 = no limit)
+    pPars->fVerbose   =       0;   // verbose output
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Creates one instance of the portfolio.]
+
+  Description [Instance 0 uses the default settings. The other instances
+  differ in the random seed, the initial polarity and the learned clause
+  limits. Returns NULL if the problem is UNSAT after adding the clauses.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static sat_solver * Sat_PortDeriveSolver( Sat_PortMan_t * p, int iSolver )
+{
+    sat_solver * pSat;
+    lit * pLit;
+    int i;
+    pSat = sat_solver_new();
+    sat_solver_setnvars( pSat, p->nVars );
+    for ( i = 0; i < p->nClauses; i++ )
+        if ( !sat_solver_addclause( pSat, p->pClauses[i], p->pClauses[i+1] ) )
+        {
+            sat_solver_delete( pSat );
+            return NULL;
+        }
+    for ( pLit = p->pLitsBeg; pLit < p->pLitsEnd; pLit++ )
+        if ( !sat_solver_addclause( pSat, pLit, pLit + 1 ) )
+        {
+            sat_solver_delete( pSat );
+            return NULL;
+        }
+    if ( !sat_solver_simplify( pSat ) )
+    {
+        sat_solver_delete( pSat );
+        return NULL;
+    }
+    if ( iSolver == 0 )
+        return pSat;
+    pSat->random_seed += 1000003 * iSolver;
+    if ( iSolver & 1 )
+        for ( i = 0; i < p->nVars; i++ )
+            pSat->polarity[i] = 1;
+    if ( iSolver & 2 )
+    {
+        pSat->nLearntStart *= 2;
+        pSat->nLearntMax    = pSat->nLearntStart;
+    }
+    if ( iSolver & 4 )
+        pSat->fNotUseRandom = 1;
+    return pSat;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Collects a short learned clause of an instance.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Sat_PortExport( void * pArg, lit * begin, lit * end, int lbd )
+{
+    Sat_PortThr_t * pThData = (Sat_PortThr_t *)pArg;
+    lit * pLit;
+    if ( end - begin > pThData->pMan->pPars->nSizeMax )
+        return;
+    Vec_IntPush( pThData->vExport, end - begin );
+    Vec_IntPush( pThData->vExport, lbd );
+    for ( pLit = begin; pLit < end; pLit++ )
+        Vec_IntPush( pThData->vExport, *pLit );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Drops the part of the pool read by all instances.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Sat_PortCompactPool( Sat_PortMan_t * p )
+{
+    int i, iMin = Vec_IntSize(p->vPool) + p->nPoolBase, nDrop;
+    for ( i = 0; i < p->pPars->nSolvers; i++ )
+        iMin = Abc_MinInt( iMin, p->pThData[i].iRead );
+    nDrop = iMin - p->nPoolBase;
+    if ( nDrop == 0 )
+        return;
+    memmove( Vec_IntArray(p->vPool), Vec_IntArray(p->vPool) + nDrop, sizeof(int) * (Vec_IntSize(p->vPool) - nDrop) );
+    Vec_IntShrink( p->vPool, Vec_IntSize(p->vPool) - nDrop );
+    p->nPoolBase += nDrop;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Exchanges learned clauses of an instance with the pool.]
+
+  Description [Copies the clauses added to the pool by the other instances
+  into the import buffer of this instance as records (size, lbd, literals)
+  and moves the clauses of the export buffer into the pool. The caller is
+  responsible for locking the pool.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void Sat_PortPoolExchange( Sat_PortMan_t * p, Sat_PortThr_t * pThData )
+{
+    int i, k, * pArray;
+    if ( Vec_IntSize(p->vPool) + Vec_IntSize(pThData->vExport) > p->pPars->nPoolMax )
+        Sat_PortCompactPool( p );
+    Vec_IntClear( pThData->vImport );
+    pArray = Vec_IntArray( p->vPool );
+    for ( i = pThData->iRead - p->nPoolBase; i < Vec_IntSize(p->vPool); i += 3 + pArray[i] )
+    {
+        if ( pArray[i+2] == pThData->iSolver )
+            continue;
+        Vec_IntPush( pThData->vImport, pArray[i] );
+        Vec_IntPush( pThData->vImport, pArray[i+1] );
+        for ( k = 0; k < pArray[i]; k++ )
+            Vec_IntPush( pThData->vImport, pArray[i+3+k] );
+    }
+    pArray = Vec_IntArray( pThData->vExport );
+    for ( i = 0; i < Vec_IntSize(pThData->vExport); i += 2 + pArray[i] )
+    {
+        if ( Vec_IntSize(p->vPool) + 3 + pArray[i] > p->pPars->nPoolMax )
+        {
+            p->nDropped++;
+            continue;
+        }
+        Vec_IntPush( p->vPool, pArray[i] );
+        Vec_IntPush( p->vPool, pArray[i+1] );
+        Vec_IntPush( p->vPool, pThData->iSolver );
+        for ( k = 0; k < pArray[i]; k++ )
+            Vec_IntPush( p->vPool, pArray[i+2+k] );
+        pThData->nExported++;
+    }
+    pThData->iRead = p->nPoolBase + Vec_IntSize(p->vPool);
+    Vec_IntClear( pThData->vExport );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Checks the exchange of clauses through the pool.]
+
+  Description [Exports two clauses from one instance and imports them
+  into the other instances. Returns 1 if every instance except the
+  exporting one receives the same literals and LBDs.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Sat_PortTest( int fVerbose )
+{
+    Sat_PortPars_t Pars, * pPars = &Pars;
+    Sat_PortThr_t ThData[3];
+    Sat_PortMan_t Man, * p = &Man;
+    lit Clause0[3] = { 2, 7, 8 }, Clause1[2] = { 5, 10 };
+    int Expected[9] = { 3, 2, 2, 7, 8, 2, 1, 5, 10 };
+    int i, k, fOk = 1;
+    Sat_PortSetDefaultPars( pPars );
+    pPars->nSolvers = 3;
+    memset( p, 0, sizeof(Sat_PortMan_t) );
+    memset( ThData, 0, sizeof(ThData) );
+    p->pPars   = pPars;
+    p->pThData = ThData;
+    p->vPool   = Vec_IntAlloc( 100 );
+    for ( i = 0; i < 3; i++ )
+    {
+        ThData[i].pMan    = p;
+        ThData[i].iSolver = i;
+        ThData[i].vExport = Vec_IntAlloc( 100 );
+        ThData[i].vImport = Vec_IntAlloc( 100 );
+    }
+    Sat_PortExport( ThData + 1, Clause0, Clause0 + 3, 2 );
+    Sat_PortExport( ThData + 1, Clause1, Clause1 + 2, 1 );
+    for ( i = 0; i < 3; i++ )
+        Sat_PortPoolExchange( p, ThData + ((i + 1) % 3) );
+    for ( i = 0; i < 3; i++ )
+    {
+        if ( i == 1 )
+        {
+            fOk &= Vec_IntSize(ThData[i].vImport) == 0;
+            continue;
+        }
+        fOk &= Vec_IntSize(ThData[i].vImport) == 9;
+        for ( k = 0; fOk && k < 9; k++ )
+            fOk &= Vec_IntEntry(ThData[i].vImport, k) == Expected[k];
+    }
+    if ( fVerbose )
+        printf( "Clause exchange of the portfolio %s.\n", fOk ? "is correct" : "has failed" );
+    for ( i = 0; i < 3; i++ )
+    {
+        Vec_IntFree( ThData[i].vExport );
+        Vec_IntFree( ThData[i].vImport );
+    }
+    Vec_IntFree( p->vPool );
+    return fOk;
+}
+
+#ifndef ABC_USE_PTHREADS
+
+int Sat_SolverPortfolio( int nVars, int ** pClauses, int nClauses, lit * pLitsBeg, lit * pLitsEnd, Sat_PortPars_t * pPars, int ** ppModel )
+{
+    Sat_PortMan_t Man, * p = &Man;
+    sat_solver * pSat;
+    int i, status;
+    memset( p, 0, sizeof(Sat_PortMan_t) );
+    p->nVars    = nVars;
+    p->pClauses = pClauses;
+    p->nClauses = nClauses;
+    p->pLitsBeg = pLitsBeg;
+    p->pLitsEnd = pLitsEnd;
+    p->pPars    = pPars;
+    if ( ppModel )
+        *ppModel = NULL;
+    pSat = Sat_PortDeriveSolver( p, 0 );
+    if ( pSat == NULL )
+        return l_False;
+    sat_solver_set_runtime_limit( pSat, pPars->nTimeOut ? pPars->nTimeOut * CLOCKS_PER_SEC + Abc_Clock(): 0 );
+    status = sat_solver_solve( pSat, NULL, NULL, (ABC_INT64_T)pPars->nConfLimit, (ABC_INT64_T)0, (ABC_INT64_T)0, (ABC_INT64_T)0 );
+    if ( status == l_True && ppModel )
+    {
+        *ppModel = ABC_ALLOC( int, nVars );
+        for ( i = 0; i < nVars; i++ )
+            (*ppModel)[i] = sat_solver_var_value( pSat, i );
+    }
+    if ( pPars->fVerbose )
+        printf( "Portfolio is not available without pthreads; a single solver was used.\n" );
+    sat_solver_delete( pSat );
+    return status;
+}
+
+#else // pthreads are used
+
+/**Function*************************************************************
+
+  Synopsis    [Exchanges learned clauses of an instance with the pool.]
+
+  Description [Called by the solver at restarts. Returns 0 if the imported
+  clauses make the problem UNSAT.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static int Sat_PortImport( void * pArg, sat_solver * pSat )
+{
+    Sat_PortThr_t * pThData = (Sat_PortThr_t *)pArg;
+    Sat_PortMan_t * p = pThData->pMan;
+    int i, Size, * pArray;
+    // move the local clauses into the pool and copy the new clauses of the others
+    pthread_mutex_lock( &p->Mutex );
+    Sat_PortPoolExchange( p, pThData );
+    pthread_mutex_unlock( &p->Mutex );
+    // add the clauses of the other instances
+    pArray = Vec_IntArray( pThData->vImport );
+    for ( i = 0; i < Vec_IntSize(pThData->vImport); i += Size + 2 )
+    {
+        Size = pArray[i];
+        pThData->nImported++;
+        if ( !sat_solver_addlearnt( pSat, pArray + i + 2, pArray + i + 2 + Size, pArray[i+1] ) )
+            return 0;
+    }
+    return 1;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Runs one instance of the portfolio.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+static void * Sat_PortWorkerTask( void * pArg, Abc_Task_t * pTask )
+{
+    Sat_PortThr_t * pThData = (Sat_PortThr_t *)pArg;
+    Sat_PortMan_t * p = pThData->pMan;
+    sat_solver * pSat = NULL;
+    abctime clk = Abc_Clock();
+    int i, status = l_False;
+    (void)pTask;
+    if ( p->fStop )
+        return NULL;
+    pSat = Sat_PortDeriveSolver( p, pThData->iSolver );
+    if ( pSat != NULL )
+    {
+        pSat->pShareMan    = pThData;
+        pSat->nShareLbd    = p->pPars->nLbdMax;
+        pSat->pShareStop   = &p->fStop;
+        pSat->pShareExport = Sat_PortExport;
+        pSat->pShareImport = Sat_PortImport;
+        sat_solver_set_runtime_limit( pSat, p->pPars->nTimeOut ? p->pPars->nTimeOut * CLOCKS_PER_SEC + Abc_Clock(): 0 );
+        status = sat_solver_solve( pSat, NULL, NULL, (ABC_INT64_T)p->pPars->nConfLimit, (ABC_INT64_T)0, (ABC_INT64_T)0, (ABC_INT64_T)0 );
+        pThData->nConfs = sat_solver_nconflicts( pSat );
+    }
+    pThData->Status = status;
+    // report the result
+    pthread_mutex_lock( &p->Mutex );
+    if ( status != l_Undef && p->Status == l_Undef )
+    {
+        p->Status  = status;
+        p->iWinner = pThData->iSolver;
+        if ( status == l_True )
+        {
+            p->pModel = ABC_ALLOC( int, p->nVars );
+            for ( i = 0; i < p->nVars; i++ )
+                p->pModel[i] = sat_solver_var_value( pSat, i );
+        }
+        p->fStop = 1;
+    }
+    pThData->iRead = ABC_INFINITY; // does not block compaction of the pool
+    pthread_mutex_unlock( &p->Mutex );
+    if ( pSat )
+        sat_solver_delete( pSat );
+    pThData->clkTotal = Abc_Clock() - clk;
+    return NULL;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Solves the problem using a portfolio of solvers.]
+
+  Description [The problem is given by the clauses in the format of
+  Cnf_Dat_t (clause i is stored in pClauses[i] up to pClauses[i+1]).
+  Literals in [pLitsBeg, pLitsEnd) are added as unit clauses. Returns
+  l_True, l_False or l_Undef. If the problem is SAT and ppModel is not
+  NULL, returns the values of all variables in *ppModel.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+int Sat_SolverPortfolio( int nVars, int ** pClauses, int nClauses, lit * pLitsBeg, lit * pLitsEnd, Sat_PortPars_t * pPars, int ** ppModel )
+{
+    Sat_PortMan_t Man, * p = &Man;
+    Abc_Task_t ** pTasks;
+    abctime clk = Abc_Clock();
+    int i, nImported = 0, nExported = 0;
+    assert( pPars->nSolvers > 0 );
+    memset( p, 0, sizeof(Sat_PortMan_t) );
+    p->nVars    = nVars;
+    p->pClauses = pClauses;
+    p->nClauses = nClauses;
+    p->pLitsBeg = pLitsBeg;
+    p->pLitsEnd = pLitsEnd;
+    p->pPars    = pPars;
+    p->vPool    = Vec_IntAlloc( 1 << 12 );
+    p->Status   = l_Undef;
+    p->iWinner  = -1;
+    p->pThData  = ABC_CALLOC( Sat_PortThr_t, pPars->nSolvers );
+    pthread_mutex_init( &p->Mutex, NULL );
+    if ( ppModel )
+        *ppModel = NULL;
+    // start the instances and wait till they finish
+    pTasks = ABC_ALLOC( Abc_Task_t *, pPars->nSolvers );
+    for ( i = 0; i < pPars->nSolvers; i++ )
+    {
+        p->pThData[i].pMan    = p;
+        p->pThData[i].iSolver = i;
+        p->pThData[i].vExport = Vec_IntAlloc( 1000 );
+        p->pThData[i].vImport = Vec_IntAlloc( 1000 );
+        p->pThData[i].Status  = l_Undef;
+    }
+    for ( i = 0; i < pPars->nSolvers; i++ )
+        pTasks[i] = Abc_TaskSubmit( Sat_PortWorkerTask, p->pThData + i );
+    for ( i = 0; i < pPars->nSolvers; i++ )
+        Abc_TaskWait( pTasks[i] );
+    ABC_FREE( pTasks );
+    // report the results
+    if ( pPars->fVerbose )
+    {
+        for ( i = 0; i < pPars->nSolvers; i++ )
+        {
+            Sat_PortThr_t * pThData = p->pThData + i;
+            printf( "Solver %2d : %s  Conf = %9d  Exp = %7d  Imp = %7d  ", i,
+                pThData->Status == l_True ? "SAT  " : (pThData->Status == l_False ? "UNSAT" : "UNDEC"),
+                pThData->nConfs, pThData->nExported, pThData->nImported );
+            Abc_PrintTime( 1, "Time", pThData->clkTotal );
+            nExported += pThData->nExported;
+            nImported += pThData->nImported;
+        }
+        printf( "Portfolio of %d solvers: ", pPars->nSolvers );
+        if ( p->iWinner >= 0 )
+            printf( "solved by solver %d.  ", p->iWinner );
+        else
+            printf( "undecided.  " );
+        printf( "Shared %d clauses (imported %d times, %d discarded).  ", nExported, nImported, p->nDropped );
+        Abc_PrintTime( 1, "Time", Abc_Clock() - clk );
+    }
+    // clean up
+    for ( i = 0; i < pPars->nSolvers; i++ )
+    {
+        Vec_IntFree( p->pThData[i].vExport );
+        Vec_IntFree( p->pThData[i].vImport );
+    }
+    pthread_mutex_destroy( &p->Mutex );
+    ABC_FREE( p->pThData );
+    Vec_IntFree( p->vPool );
+    if ( ppModel )
+        *ppModel = p->pModel;
+    else
+        ABC_FREE( p->pModel );
+    return p->Status;
+}
+
+#endif // pthreads are used
+
+////////////////////////////////////////////////////////////////////////
+///                       END OF FILE                                ///
+////////////////////////////////////////////////////////////////////////
+
+
+ABC_NAMESPACE_IMPL_END
+
@@ -132,6 +132,18 @@ int sat_solver_get_var_value(sat_solver* s, int v)
 static inline int      sat_solver_dl(sat_solver* s)                { return veci_size(&s->trail_lim); }
 static inline veci*    sat_solver_read_wlist(sat_solver* s, lit l) { return &s->wlists[l];            }
 
+// the watcher list of a literal contains two kinds of entries:
+// - a binary clause is one entry, the other literal (see clause_from_lit())
+// - a longer clause is two entries, the clause handle followed by a blocker,
+//   which is a literal of the clause; if the blocker is true, the clause
+//   is satisfied and can be skipped without reading it from memory
+static inline void     sat_solver_watch(sat_solver* s, lit l, cla h, lit blocker) 
+{
+    veci* ws = sat_solver_read_wlist(s,l);
+    veci_push(ws, h);
+    veci_push(ws, blocker);
+}
+
 //=================================================================================================
 // Variable order functions:
 
@@ -453,8 +465,14 @@ int sat_solver_clause_new(sat_solver* s, lit* begin, lit* end, int learnt)
 
     //veci_push(sat_solver_read_wlist(s,lit_neg(begin[0])),c);
     //veci_push(sat_solver_read_wlist(s,lit_neg(begin[1])),c);
-    veci_push(sat_solver_read_wlist(s,lit_neg(begin[0])),(size > 2 ? h : clause_from_lit(begin[1])));
-    veci_push(sat_solver_read_wlist(s,lit_neg(begin[1])),(size > 2 ? h : clause_from_lit(begin[0])));
+    if ( size > 2 )
+    {
+        sat_solver_watch(s, lit_neg(begin[0]), h, begin[1]);
+        sat_solver_watch(s, lit_neg(begin[1]), h, begin[0]);
+        return h;
+    }
+    veci_push(sat_solver_read_wlist(s,lit_neg(begin[0])),clause_from_lit(begin[1]));
+    veci_push(sat_solver_read_wlist(s,lit_neg(begin[1])),clause_from_lit(begin[0]));
 
     return h;
 }
@@ -589,6 +607,12 @@ static void sat_solver_record(sat_solver* s, veci* cls)
     assert(veci_size(cls) > 0);
     if ( h == 0 )
         veci_push( &s->unit_lits, *begin );
+    if ( s->pShareExport )
+    {
+        int lbd = h ? (int)clause_read(s, h)->lbd : 1;
+        if ( lbd <= s->nShareLbd )
+            s->pShareExport( s->pShareMan, begin, end, lbd );
+    }
 
     ///////////////////////////////////
     // add clause to internal storage
@@ -942,10 +966,21 @@ int sat_solver_propagate(sat_solver* s)
                     // Copy the remaining watches:
                     while (i < end)
                         *j++ = *i++;
+                    continue;
                 }
+                i++;
             }else{
 
-                clause* c = clause_read(s,*i);
+                clause* c;
+                lit blocker = i[1];
+                // If the blocker is true, then clause is already satisfied.
+                if (var_value(s, lit_var(blocker)) == lit_sign(blocker)){
+                    *j++ = *i++;
+                    *j++ = *i++;
+                    continue;
+                }
+
+                c = clause_read(s,*i);
                 lits = clause_begin(c);
 
                 // Make sure the false literal is data[1]:
@@ -957,8 +992,10 @@ int sat_solver_propagate(sat_solver* s)
                 assert(lits[1] == false_lit);
 
                 // If 0th watch is true, then clause is already satisfied.
-                if (var_value(s, lit_var(lits[0])) == lit_sign(lits[0]))
+                if (var_value(s, lit_var(lits[0])) == lit_sign(lits[0])){
                     *j++ = *i;
+                    *j++ = lits[0];
+                }
                 else{
                     // Look for new watch:
                     lit* stop = lits + clause_size(c);
@@ -967,24 +1004,27 @@ int sat_solver_propagate(sat_solver* s)
                         if (var_value(s, lit_var(*k)) != !lit_sign(*k)){
                             lits[1] = *k;
                             *k = false_lit;
-                            veci_push(sat_solver_read_wlist(s,lit_neg(lits[1])),*i);
+                            sat_solver_watch(s, lit_neg(lits[1]), *i, lits[0]);
                             goto next; }
                     }
 
                     *j++ = *i;
+                    *j++ = lits[0];
                     // Clause is unit under assignment:
                     if ( c->lrn )
                         c->lbd = sat_clause_compute_lbd(s, c);
                     if (!sat_solver_enqueue(s,lits[0], *i)){
-                        hConfl = *i++;
+                        hConfl = *i;
+                        i += 2;
                         // Copy the remaining watches:
                         while (i < end)
                             *j++ = *i++;
+                        continue;
                     }
                 }
+            next:
+                i += 2;
             }
-        next:
-            i++;
         }
 
         s->stats.inspects += j - veci_begin(ws);
@@ -1374,12 +1414,18 @@ void sat_solver_reducedb(sat_solver* s)
             if ( clause_is_lit(pArray[k]) ) // 2-lit clause
                 pArray[j++] = pArray[k];
             else if ( !clause_learnt_h(pMem, pArray[k]) ) // problem clause
-                pArray[j++] = pArray[k];
+            {
+                pArray[j++] = pArray[k++];
+                pArray[j++] = pArray[k]; // blocker
+            }
             else 
             {
-                c = clause_read(s, pArray[k]);
+                c = clause_read(s, pArray[k++]);
                 if ( !c->mark ) // useful learned clause
+                {
                    pArray[j++] = clause_id(c); // updating handle here!!!
+                   pArray[j++] = pArray[k]; // blocker
+                }
             }
         }
         veci_resize(&s->wlists[i],j);
@@ -1434,8 +1480,16 @@ void sat_solver_rollback( sat_solver* s )
     {
         cla* pArray = veci_begin(&s->wlists[i]);
         for ( j = k = 0; k < veci_size(&s->wlists[i]); k++ )
+        {
+            int fLong = !clause_is_lit(pArray[k]);
             if ( Sat_MemClauseUsed(pMem, pArray[k]) )
+            {
                 pArray[j++] = pArray[k];
+                if ( fLong )
+                    pArray[j++] = pArray[k+1]; // blocker
+            }
+            k += fLong;
+        }
         veci_resize(&s->wlists[i],j);
     }
     // reset watcher lists
@@ -1555,6 +1609,37 @@ int sat_solver_addclause(sat_solver* s, lit* begin, lit* end)
     return true;
 }
 
+/* adds a learned clause derived by another solver from the same problem;
+   should be called at level 0; returns 0 if the problem becomes UNSAT
+ */
+int sat_solver_addlearnt(sat_solver* s, lit* begin, lit* end, int lbd)
+{
+    lit *i, *j;
+    int h;
+    assert( sat_solver_dl(s) == 0 );
+    veci_resize( &s->temp_clause, 0 );
+    for ( i = begin; i < end; i++ )
+        veci_push( &s->temp_clause, *i );
+    begin = veci_begin( &s->temp_clause );
+    end = begin + veci_size( &s->temp_clause );
+    // remove the literals assigned at level 0
+    for ( i = j = begin; i < end; i++ )
+    {
+        assert( lit_var(*i) < s->size );
+        if ( var_value(s, lit_var(*i)) == lit_sign(*i) )
+            return true;   // satisfied
+        if ( var_value(s, lit_var(*i)) == varX )
+            *j++ = *i;
+    }
+    if ( j == begin )      // empty clause
+        return false;
+    if ( j - begin == 1 )  // unit clause
+        return sat_solver_enqueue(s,*begin,0);
+    h = sat_solver_clause_new(s,begin,j,1);
+    clause_read(s, h)->lbd = Abc_MinInt( lbd, (int)(j - begin) );
+    return true;
+}
+
 double luby(double y, int x)
 {
     int size, seq;
@@ -1662,7 +1747,8 @@ static lbool sat_solver_search(sat_solver* s, ABC_INT64_T nof_conflicts)
 
             // Reached bound on number of conflicts:
             if ( (s->nConfLimit && s->stats.conflicts > s->nConfLimit) ||
-                 (s->nInsLimit  && s->stats.propagations > s->nInsLimit) )
+                 (s->nInsLimit  && s->stats.propagations > s->nInsLimit) ||
+                 (s->pShareStop && *s->pShareStop) )
             {
                 s->progress_estimate = sat_solver_progress(s);
                 sat_solver_canceluntil(s,s->root_level);
@@ -1897,6 +1983,12 @@ int sat_solver_solve(sat_solver* s, lit* begin, lit* end, ABC_INT64_T nConfLimit
                 s->progress_estimate*100);
             fflush(stdout);
         }
+        // exchange learned clauses with other solvers
+        if ( s->pShareImport && s->root_level == 0 && !s->pShareImport(s->pShareMan, s) )
+        {
+            status = l_False;
+            break;
+        }
         nof_conflicts = (ABC_INT64_T)( 100 * luby(2, restart_iter++) );
         status = sat_solver_search(s, nof_conflicts);
 //        nof_learnts    = nof_learnts * 11 / 10; //*= 1.1;
@@ -1907,6 +1999,8 @@ int sat_solver_solve(sat_solver* s, lit* begin, lit* end, ABC_INT64_T nConfLimit
             break;
         if ( s->nRuntimeLimit && Abc_Clock() > s->nRuntimeLimit )
             break;
+        if ( s->pShareStop && *s->pShareStop )
+            break;
     }
     if (s->verbosity >= 1)
         printf("==============================================================================\n");
@@ -45,6 +45,7 @@ extern sat_solver* sat_solver_new(void);
 extern void        sat_solver_delete(sat_solver* s);
 
 extern int         sat_solver_addclause(sat_solver* s, lit* begin, lit* end);
+extern int         sat_solver_addlearnt(sat_solver* s, lit* begin, lit* end, int lbd);
 extern int         sat_solver_clause_new(sat_solver* s, lit* begin, lit* end, int learnt);
 extern int         sat_solver_simplify(sat_solver* s);
 extern int         sat_solver_solve(sat_solver* s, lit* begin, lit* end, ABC_INT64_T nConfLimit, ABC_INT64_T nInsLimit, ABC_INT64_T nConfLimitGlobal, ABC_INT64_T nInsLimitGlobal);
@@ -79,6 +80,22 @@ extern void        sat_solver_store_mark_roots( sat_solver * s );
 extern void        sat_solver_store_mark_clauses_a( sat_solver * s );
 extern void *      sat_solver_store_release( sat_solver * s ); 
 
+// portfolio solving
+typedef struct Sat_PortPars_t_ Sat_PortPars_t;
+struct Sat_PortPars_t_
+{
+    int         nSolvers;      // the number of solvers in the portfolio
+    int         nLbdMax;       // the largest LBD of shared learned clauses
+    int         nSizeMax;      // the largest size of shared learned clauses
+    int         nPoolMax;      // the largest number of literals in the clause pool
+    int         nConfLimit;    // conflict limit of each solver (0 = no limit)
+    int         nTimeOut;      // runtime limit in seconds (0 = no limit)
+    int         fVerbose;      // verbose output
+};
+extern void        Sat_PortSetDefaultPars( Sat_PortPars_t * pPars );
+extern int         Sat_SolverPortfolio( int nVars, int ** pClauses, int nClauses, lit * pLitsBeg, lit * pLitsEnd, Sat_PortPars_t * pPars, int ** ppModel );
+extern int         Sat_PortTest( int fVerbose );
+
 //=================================================================================================
 // Solver representation:
 
@@ -193,7 +210,14 @@ struct sat_solver_t
     // CNF loading
     void *      pCnfMan;           // external CNF manager
     int(*pCnfFunc)(void * p, int); // external callback
-};
+
+    // learned clause sharing
+    void *      pShareMan;         // external clause exchange
+    int         nShareLbd;         // the largest LBD of exported clauses
+    volatile int * pShareStop;     // set externally to stop the solver
+    void(*pShareExport)(void * p, lit * begin, lit * end, int lbd); // called for each short learned clause
+    int(*pShareImport)(void * p, sat_solver * s);                  // called at restarts; returns 0 if UNSAT
+};
 
 static inline clause * clause_read( sat_solver * s, cla h )          
 { 
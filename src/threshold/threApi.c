@@ -0,0 +1,575 @@
+/**CFile****************************************************************
+
+  FileName    [threApi.c]
+
+  SystemName  [ABC: Logic synthesis and verification system.]
+
+  PackageName [threshold.]
+
+  Synopsis    [Library interface of the threshold logic flow.]
+
+  Author      [Nian-Ze Lee]
+
+  Affiliation [NTU]
+
+  Date        [May 11, 2016.]
+
+  Revision    [$Id: abc.c,v 1.00 2005/06/20 00:00:00 alanmi Exp $]
+
+***********************************************************************/
+
+////////////////////////////////////////////////////////////////////////
+///                          INCLUDES                                ///
+////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include "threshold.h"
+
+////////////////////////////////////////////////////////////////////////
+///                        DECLARATIONS                              ///
+////////////////////////////////////////////////////////////////////////
+
+struct Th_Ntk_t_
+{
+   Vec_Ptr_t * vTList;   // threshold objects indexed by their IDs (may contain NULLs)
+};
+
+// helper functions
+static Vec_Ptr_t* Th_ApiEnter            ( Th_Ntk_t * );
+static void       Th_ApiLeave            ( Th_Ntk_t * , Vec_Ptr_t * );
+static void       Th_ApiConnectFanouts   ( Vec_Ptr_t * );
+static Gia_Man_t* Th_ApiStrashToGia      ( Abc_Ntk_t * );
+
+////////////////////////////////////////////////////////////////////////
+///                     FUNCTION DEFINITIONS                         ///
+////////////////////////////////////////////////////////////////////////
+
+/**Function*************************************************************
+
+  Synopsis    [Makes the network current for the package functions.]
+
+  Description [The collapse and extraction code works on current_TList
+               and may replace the array (Th_NtkDfs), so the handle's
+               list is swapped in before and read back after each step.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+
+static Vec_Ptr_t*
+Th_ApiEnter( Th_Ntk_t * p )
+{
+   Vec_Ptr_t * vSaved = current_TList;
+   current_TList = p->vTList;
+   return vSaved;
+}
+
+static void
+Th_ApiLeave( Th_Ntk_t * p , Vec_Ptr_t * vSaved )
+{
+   p->vTList     = current_TList;
+   current_TList = vSaved;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Derives fanouts from fanins.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+
+static void
+Th_ApiConnectFanouts( Vec_Ptr_t * vTList )
+{
+   Thre_S * tObj , * tObjFin;
+   int i , k , Entry;
+   Vec_PtrForEachEntry( Thre_S * , vTList , tObj , i )
+   {
+      if ( !tObj ) continue;
+      Vec_IntForEachEntry( tObj->Fanins , Entry , k )
+      {
+         tObjFin = (Thre_S *)Vec_PtrEntry( vTList , Entry );
+         assert( tObjFin != NULL );
+         Vec_IntPush( tObjFin->Fanouts , tObj->Id );
+      }
+   }
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Creates the threshold network from GIA.]
+
+  Description [Each AND node becomes a two-input threshold gate, the
+               same as aig2th does for the current network. The object
+               order is CONST1, CIs, COs, AND nodes.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+
+Th_Ntk_t *
+Th_NtkStartFromGia( Gia_Man_t * pGia )
+{
+   Th_Ntk_t  * p;
+   Vec_Int_t * vMap;
+   Gia_Obj_t * pObj;
+   Thre_S    * tObj;
+   int i , k , fCompl;
+   p = ABC_CALLOC( Th_Ntk_t , 1 );
+   p->vTList = Vec_PtrAlloc( Gia_ManObjNum(pGia) );
+   vMap = Vec_IntStartFull( Gia_ManObjNum(pGia) );
+   Vec_IntWriteEntry( vMap , 0 , Th_CreateObj( p->vTList , Th_CONST1 )->Id );
+   Gia_ManForEachCi( pGia , pObj , i )
+      Vec_IntWriteEntry( vMap , Gia_ObjId(pGia, pObj) , Th_CreateObj( p->vTList , Th_Pi )->Id );
+   Gia_ManForEachCo( pGia , pObj , i )
+      Vec_IntWriteEntry( vMap , Gia_ObjId(pGia, pObj) , Th_CreateObj( p->vTList , Th_Po )->Id );
+   Gia_ManForEachAnd( pGia , pObj , i )
+      Vec_IntWriteEntry( vMap , i , Th_CreateObj( p->vTList , Th_Node )->Id );
+   // the constant node of GIA is 0, while CONST1 is 1
+   Gia_ManForEachCo( pGia , pObj , i )
+   {
+      tObj   = (Thre_S *)Vec_PtrEntry( p->vTList , Vec_IntEntry(vMap, Gia_ObjId(pGia, pObj)) );
+      fCompl = Gia_ObjFaninC0(pObj) ^ (Gia_ObjFaninId0p(pGia, pObj) == 0);
+      Vec_IntPush( tObj->Fanins  , Vec_IntEntry(vMap, Gia_ObjFaninId0p(pGia, pObj)) );
+      Vec_IntPush( tObj->weights , fCompl ? -1 : 1 );
+      tObj->thre = fCompl ? 0 : 1;
+   }
+   Gia_ManForEachAnd( pGia , pObj , i )
+   {
+      tObj = (Thre_S *)Vec_PtrEntry( p->vTList , Vec_IntEntry(vMap, i) );
+      tObj->thre = 2;
+      for ( k = 0 ; k < 2 ; k++ )
+      {
+         int iFanin = k ? Gia_ObjFaninId1(pObj, i) : Gia_ObjFaninId0(pObj, i);
+         fCompl = (k ? Gia_ObjFaninC1(pObj) : Gia_ObjFaninC0(pObj)) ^ (iFanin == 0);
+         Vec_IntPush( tObj->Fanins  , Vec_IntEntry(vMap, iFanin) );
+         Vec_IntPush( tObj->weights , fCompl ? -1 : 1 );
+         tObj->thre -= fCompl;
+      }
+   }
+   Vec_IntFree( vMap );
+   Th_ApiConnectFanouts( p->vTList );
+   return p;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Creates the threshold network from a logic network.]
+
+  Description [Non-AIG networks are strashed; the input is not changed.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+
+Th_Ntk_t *
+Th_NtkStartFromAbc( Abc_Ntk_t * pNtk )
+{
+   Th_Ntk_t  * p;
+   Abc_Ntk_t * pNtkAig = pNtk;
+   if ( !Abc_NtkIsStrash(pNtk) )
+   {
+      pNtkAig = Abc_NtkStrash( pNtk , 0 , 1 , 0 );
+      if ( pNtkAig == NULL )
+         return NULL;
+   }
+   p = ABC_CALLOC( Th_Ntk_t , 1 );
+   p->vTList = aig2Th( pNtkAig );
+   if ( pNtkAig != pNtk )
+      Abc_NtkDelete( pNtkAig );
+   return p;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Creates the threshold network from arrays.]
+
+  Description [Objects of type TH_OBJ_NONE become empty slots, so that
+               object IDs are preserved. Fanouts are derived. Returns
+               NULL if the arrays are inconsistent.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+
+Th_Ntk_t *
+Th_NtkStartFromData( Th_NtkData_t * pData )
+{
+   Th_Ntk_t * p;
+   Thre_S   * tObj;
+   int i , k;
+   if ( pData->nObjs < 1 || pData->pTypes[0] != TH_OBJ_CONST1 )
+      return NULL;
+   for ( i = 0 ; i < pData->nObjs ; i++ )
+   {
+      if ( pData->pTypes[i] < TH_OBJ_NONE || pData->pTypes[i] > TH_OBJ_CONST1 )
+         return NULL;
+      if ( pData->pFanBeg[i] > pData->pFanBeg[i+1] )
+         return NULL;
+      for ( k = pData->pFanBeg[i] ; k < pData->pFanBeg[i+1] ; k++ )
+         if ( pData->pFanins[k] < 0 || pData->pFanins[k] >= pData->nObjs || pData->pTypes[pData->pFanins[k]] == TH_OBJ_NONE )
+            return NULL;
+   }
+   p = ABC_CALLOC( Th_Ntk_t , 1 );
+   p->vTList = Vec_PtrAlloc( pData->nObjs );
+   for ( i = 0 ; i < pData->nObjs ; i++ )
+   {
+      if ( pData->pTypes[i] == TH_OBJ_NONE )
+      {
+         Vec_PtrPush( p->vTList , NULL );
+         continue;
+      }
+      tObj = Th_CreateObj( p->vTList , (Th_Gate_Type)pData->pTypes[i] );
+      tObj->thre = pData->pThres[i];
+      for ( k = pData->pFanBeg[i] ; k < pData->pFanBeg[i+1] ; k++ )
+      {
+         Vec_IntPush( tObj->Fanins  , pData->pFanins[k] );
+         Vec_IntPush( tObj->weights , pData->pWeights[k] );
+      }
+   }
+   Th_ApiConnectFanouts( p->vTList );
+   return p;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Wraps the threshold list into a handle.]
+
+  Description [Takes the ownership of vTList without copying it.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+
+Th_Ntk_t *
+Th_NtkStartFromList( Vec_Ptr_t * vTList )
+{
+   Th_Ntk_t * p = ABC_CALLOC( Th_Ntk_t , 1 );
+   p->vTList = vTList;
+   return p;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Maps GIA directly into a threshold network.]
+
+  Description [Same as &thmap. Uses default parameters if pPars is NULL.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+
+Th_Ntk_t *
+Th_NtkStartFromMap( Gia_Man_t * pGia , Th_MapPar_t * pPars )
+{
+   Th_MapPar_t Pars;
+   if ( pPars == NULL )
+   {
+      Th_MapSetDefaultPars( &Pars );
+      pPars = &Pars;
+   }
+   if ( Gia_ManBufNum(pGia) || Gia_ManHasChoices(pGia) )
+      return NULL;
+   return Th_NtkStartFromList( Th_MapGia( pGia , pPars ) );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Duplicates, releases and deletes the network.]
+
+  Description [Th_NtkReleaseList() returns the threshold list to the
+               caller and frees the handle.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+
+Th_Ntk_t *
+Th_NtkDup( Th_Ntk_t * p )
+{
+   Th_Ntk_t * pNew;
+   Thre_S   * tObj;
+   int i;
+   pNew = ABC_CALLOC( Th_Ntk_t , 1 );
+   pNew->vTList = Vec_PtrAlloc( Vec_PtrSize(p->vTList) );
+   Vec_PtrForEachEntry( Thre_S * , p->vTList , tObj , i )
+      Vec_PtrPush( pNew->vTList , tObj ? Th_CopyObj( tObj ) : NULL );
+   return pNew;
+}
+
+Vec_Ptr_t *
+Th_NtkReleaseList( Th_Ntk_t * p )
+{
+   Vec_Ptr_t * vTList = p->vTList;
+   ABC_FREE( p );
+   return vTList;
+}
+
+void
+Th_NtkStop( Th_Ntk_t * p )
+{
+   if ( p == NULL ) return;
+   DeleteTList( p->vTList );
+   ABC_FREE( p );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Network statistics.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+
+int Th_NtkObjNum( Th_Ntk_t * p )  { return Vec_PtrSize( p->vTList );             }
+int Th_NtkPiNum( Th_Ntk_t * p )   { return Th_CountGate( p->vTList , Th_Pi );    }
+int Th_NtkPoNum( Th_Ntk_t * p )   { return Th_CountGate( p->vTList , Th_Po );    }
+int Th_NtkGateNum( Th_Ntk_t * p ) { return Th_CountGate( p->vTList , Th_Node );  }
+
+int
+Th_NtkLevelNum( Th_Ntk_t * p )
+{
+   Vec_Ptr_t * vSaved = Th_ApiEnter( p );
+   int nLevels = Th_CountLevel( p->vTList );
+   Th_ApiLeave( p , vSaved );
+   return nLevels;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Iterative collapsing (merge_th).]
+
+  Description [Returns the number of gates after collapsing. The network
+               is sorted topologically and NULL objects are removed.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+
+void
+Th_CollapseSetDefaultPars( Th_CollapsePar_t * pPars )
+{
+   memset( pPars , 0 , sizeof(Th_CollapsePar_t) );
+   pPars->fIterative = 0;
+   pPars->nFanoutMax = -1;
+   pPars->fVerbose   = 0;
+}
+
+int
+Th_NtkCollapse( Th_Ntk_t * p , Th_CollapsePar_t * pPars )
+{
+   Vec_Ptr_t * vSaved;
+   abctime clk = Abc_Clock();
+   int i , nGates = Th_NtkGateNum( p );
+   vSaved = Th_ApiEnter( p );
+   if ( pPars->nFanoutMax == -1 )
+      Th_CollapseNtk( current_TList , pPars->fIterative , -1 );
+   else {
+      for ( i = 1 ; i <= pPars->nFanoutMax ; ++i )
+         Th_CollapseNtk( current_TList , pPars->fIterative , i );
+   }
+   Th_NtkDfs();
+   Th_ApiLeave( p , vSaved );
+   if ( pPars->fVerbose )
+   {
+      printf( "Collapsed gates = %d -> %d.  " , nGates , Th_NtkGateNum( p ) );
+      Abc_PrintTime( 1 , "Time" , Abc_Clock() - clk );
+   }
+   return Th_NtkGateNum( p );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Decision-list extraction (thExt).]
+
+  Description [Returns the number of gates after extraction.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+
+void
+Th_ExtractSetDefaultPars( Th_ExtractPar_t * pPars )
+{
+   memset( pPars , 0 , sizeof(Th_ExtractPar_t) );
+   pPars->nLevelMax = -1;
+   pPars->fVerbose  = 0;
+}
+
+int
+Th_NtkExtract( Th_Ntk_t * p , Th_ExtractPar_t * pPars )
+{
+   Vec_Ptr_t * vSaved;
+   abctime clk = Abc_Clock();
+   vSaved = Th_ApiEnter( p );
+   nPi    = Th_CountGate( current_TList , Th_Pi );
+   nPo    = Th_CountGate( current_TList , Th_Po );
+   nThres = Th_CountGate( current_TList , Th_Node );
+   Th_NtkDfs();
+   Th_NtkTransWeight( current_TList );
+   Th_NtkTh2DList( current_TList );
+   while ( Vec_PtrSize(Golden_Vec) > 0 )
+      Th_IterativeUpdatePQ( current_TList , Golden_Vec , pPars->nLevelMax + 1 );
+   Th_RemoveDummy();
+   Th_NtkDfs();
+   Th_NtkTransBack( current_TList );
+   Th_ApiLeave( p , vSaved );
+   if ( pPars->fVerbose )
+   {
+      printf( "Extracted gates = %d -> %d.  " , nThres , Th_NtkGateNum( p ) );
+      Abc_PrintTime( 1 , "Time" , Abc_Clock() - clk );
+   }
+   return Th_NtkGateNum( p );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Conversion into multiplexer trees (th2mux).]
+
+  Description [Th_NtkToMux() returns a strashed network; Th_NtkToGia()
+               returns the same logic as GIA.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+
+void
+Th_ConvertSetDefaultPars( Th_ConvertPar_t * pPars )
+{
+   memset( pPars , 0 , sizeof(Th_ConvertPar_t) );
+   pPars->fDynamic = 1;
+   pPars->fAhead   = 0;
+}
+
+Abc_Ntk_t *
+Th_NtkToMux( Th_Ntk_t * p , Th_ConvertPar_t * pPars )
+{
+   Vec_Ptr_t * vSaved = Th_ApiEnter( p );
+   Abc_Ntk_t * pNtk   = Th_Ntk2Mux( current_TList , pPars->fDynamic , pPars->fAhead );
+   Th_ApiLeave( p , vSaved );
+   return pNtk;
+}
+
+static Gia_Man_t *
+Th_ApiStrashToGia( Abc_Ntk_t * pNtk )
+{
+   Gia_Man_t * pNew;
+   Abc_Obj_t * pObj;
+   int i;
+   assert( Abc_NtkIsStrash(pNtk) );
+   pNew = Gia_ManStart( Abc_NtkObjNumMax(pNtk) );
+   pNew->pName = Abc_UtilStrsav( pNtk->pName );
+   Abc_AigConst1(pNtk)->iTemp = 1;
+   Abc_NtkForEachCi( pNtk , pObj , i )
+      pObj->iTemp = Gia_ManAppendCi( pNew );
+   Abc_AigForEachAnd( pNtk , pObj , i )
+      pObj->iTemp = Gia_ManAppendAnd( pNew , Abc_LitNotCond( Abc_ObjFanin0(pObj)->iTemp , Abc_ObjFaninC0(pObj) ) ,
+                                             Abc_LitNotCond( Abc_ObjFanin1(pObj)->iTemp , Abc_ObjFaninC1(pObj) ) );
+   Abc_NtkForEachCo( pNtk , pObj , i )
+      Gia_ManAppendCo( pNew , Abc_LitNotCond( Abc_ObjFanin0(pObj)->iTemp , Abc_ObjFaninC0(pObj) ) );
+   return pNew;
+}
+
+Gia_Man_t *
+Th_NtkToGia( Th_Ntk_t * p , Th_ConvertPar_t * pPars )
+{
+   Gia_Man_t * pGia , * pTemp;
+   Abc_Ntk_t * pNtk = Th_NtkToMux( p , pPars );
+   if ( pNtk == NULL )
+      return NULL;
+   pGia = Th_ApiStrashToGia( pNtk );
+   Abc_NtkDelete( pNtk );
+   pGia = Gia_ManCleanup( pTemp = pGia );
+   Gia_ManStop( pTemp );
+   return pGia;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Returns the network as arrays.]
+
+  Description [The arrays are owned by the caller and released by
+               Th_NtkDataFree().]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+
+Th_NtkData_t *
+Th_NtkGetData( Th_Ntk_t * p )
+{
+   Th_NtkData_t * pData;
+   Thre_S * tObj;
+   int i , k , nEdges = 0;
+   Vec_PtrForEachEntry( Thre_S * , p->vTList , tObj , i )
+      if ( tObj ) nEdges += Vec_IntSize( tObj->Fanins );
+   pData = ABC_CALLOC( Th_NtkData_t , 1 );
+   pData->nObjs    = Vec_PtrSize( p->vTList );
+   pData->pTypes   = ABC_ALLOC( int , pData->nObjs );
+   pData->pThres   = ABC_ALLOC( int , pData->nObjs );
+   pData->pFanBeg  = ABC_ALLOC( int , pData->nObjs + 1 );
+   pData->pFanins  = ABC_ALLOC( int , nEdges );
+   pData->pWeights = ABC_ALLOC( int , nEdges );
+   pData->pFanBeg[0] = 0;
+   Vec_PtrForEachEntry( Thre_S * , p->vTList , tObj , i )
+   {
+      pData->pTypes[i]    = tObj ? tObj->Type : TH_OBJ_NONE;
+      pData->pThres[i]    = tObj ? tObj->thre : 0;
+      pData->pFanBeg[i+1] = pData->pFanBeg[i] + (tObj ? Vec_IntSize( tObj->Fanins ) : 0);
+      if ( tObj == NULL ) continue;
+      assert( tObj->Id == i );
+      for ( k = 0 ; k < Vec_IntSize( tObj->Fanins ) ; k++ )
+      {
+         pData->pFanins [pData->pFanBeg[i] + k] = Vec_IntEntry( tObj->Fanins  , k );
+         pData->pWeights[pData->pFanBeg[i] + k] = Vec_IntEntry( tObj->weights , k );
+      }
+   }
+   return pData;
+}
+
+void
+Th_NtkDataFree( Th_NtkData_t * pData )
+{
+   if ( pData == NULL ) return;
+   ABC_FREE( pData->pTypes );
+   ABC_FREE( pData->pThres );
+   ABC_FREE( pData->pFanBeg );
+   ABC_FREE( pData->pFanins );
+   ABC_FREE( pData->pWeights );
+   ABC_FREE( pData );
+}
+
+////////////////////////////////////////////////////////////////////////
+///                       END OF FILE                                ///
+////////////////////////////////////////////////////////////////////////
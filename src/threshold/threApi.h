@@ -0,0 +1,163 @@
+/**HFile****************************************************************
+
+  FileName    [threApi.h]
+
+  SystemName  [ABC]
+
+  PackageName [threshold]
+
+  Synopsis    [Library interface of the threshold logic flow.]
+
+  Author      [Nian-Ze Lee]
+
+  Affiliation [NTU]
+
+  Date        [May 11, 2016]
+
+***********************************************************************/
+
+#ifndef THRE_API_H_
+#define THRE_API_H_
+
+/*
+    This header is the entry point for applications that link libabc.a and
+    want to run the threshold flow without going through the command line
+    and the .th file format. It is self-contained: unlike threshold.h it
+    does not define the package globals and can be included from C++.
+
+    A threshold network is kept in an opaque handle (Th_Ntk_t). Object 0 is
+    the constant-1 node, the remaining objects are primary inputs, primary
+    outputs and threshold gates. A gate evaluates to 1 iff the weighted sum
+    of its fanins is not less than its threshold. A primary output has one
+    fanin; weight 1 and threshold 1 copy the fanin, weight -1 and threshold
+    0 complement it.
+
+    Ownership:
+    - Th_NtkStart*() functions return a new handle owned by the caller,
+      to be released with Th_NtkStop().
+    - Th_NtkStartFromList() takes over the Vec_Ptr_t of Thre_S objects
+      without copying; Th_NtkReleaseList() hands it back and frees the
+      handle, so networks move in and out of the package copy-free.
+    - Th_NtkStartFromData() reads the arrays and leaves them to the caller.
+      Th_NtkGetData() returns arrays owned by the caller, to be released
+      with Th_NtkDataFree().
+    - Networks returned by Th_NtkToMux()/Th_NtkToGia() are new objects
+      owned by the caller.
+
+    The flow shares package-level state with the threshold commands, so
+    the functions below are not reentrant: do not call them concurrently
+    from several threads. The current network of the command-line frame
+    (current_TList) is left untouched.
+*/
+
+////////////////////////////////////////////////////////////////////////
+///                          INCLUDES                                ///
+////////////////////////////////////////////////////////////////////////
+
+#include "base/abc/abc.h"
+#include "aig/gia/gia.h"
+
+ABC_NAMESPACE_HEADER_START
+
+////////////////////////////////////////////////////////////////////////
+///                         BASIC TYPES                              ///
+////////////////////////////////////////////////////////////////////////
+
+typedef struct Th_Ntk_t_         Th_Ntk_t;          // opaque network handle
+typedef struct Th_NtkData_t_     Th_NtkData_t;
+typedef struct Th_CollapsePar_t_ Th_CollapsePar_t;
+typedef struct Th_ExtractPar_t_  Th_ExtractPar_t;
+typedef struct Th_ConvertPar_t_  Th_ConvertPar_t;
+typedef struct Th_MapPar_t_      Th_MapPar_t;
+
+// object types stored in Th_NtkData_t::pTypes (same values as Th_Gate_Type)
+enum { TH_OBJ_NONE = 0, TH_OBJ_PI, TH_OBJ_PO, TH_OBJ_GATE, TH_OBJ_CONST1 };
+
+// flat array representation of a threshold network
+struct Th_NtkData_t_
+{
+    int    nObjs;       // the number of objects (object 0 is constant 1)
+    int *  pTypes;      // [nObjs] object types (TH_OBJ_*)
+    int *  pThres;      // [nObjs] thresholds of gates and POs
+    int *  pFanBeg;     // [nObjs+1] first fanin of each object in pFanins/pWeights
+    int *  pFanins;     // [pFanBeg[nObjs]] fanin object IDs
+    int *  pWeights;    // [pFanBeg[nObjs]] fanin weights
+};
+
+// parameters of iterative collapsing (command merge_th)
+struct Th_CollapsePar_t_
+{
+    int    fIterative;  // repeat until no more gates can be collapsed
+    int    nFanoutMax;  // collapse nodes with up to this many fanouts (-1 = single-fanout only)
+    int    fVerbose;    // verbose output
+};
+
+// parameters of decision-list extraction (command thExt)
+struct Th_ExtractPar_t_
+{
+    int    nLevelMax;   // the max number of logic levels (-1 = unlimited)
+    int    fVerbose;    // verbose output
+};
+
+// parameters of direct threshold mapping of GIA (command &thmap)
+struct Th_MapPar_t_
+{
+    int    nLutSize;    // the max number of cut leaves
+    int    nCutNum;     // the max number of cuts per node
+    int    nProcNum;    // the number of worker threads (0 = serial)
+    int    fWeightCost; // minimize weights and thresholds instead of the gate count
+    int    fVerbose;    // verbose output
+    int    nLutSizeMax; // the limits
+    int    nCutNumMax;
+    int    nProcNumMax;
+};
+
+// parameters of the conversion into multiplexer trees (command th2mux)
+struct Th_ConvertPar_t_
+{
+    int    fDynamic;    // dynamic variable selection
+    int    fAhead;      // look-ahead dynamic variable selection
+};
+
+////////////////////////////////////////////////////////////////////////
+///                    FUNCTION DECLARATIONS                         ///
+////////////////////////////////////////////////////////////////////////
+
+/*=== threGiaMap.c ==========================================================*/
+extern void           Th_MapSetDefaultPars( Th_MapPar_t * pPars );
+
+/*=== threApi.c ==========================================================*/
+// construction and destruction
+extern Th_Ntk_t *     Th_NtkStartFromGia( Gia_Man_t * pGia );
+extern Th_Ntk_t *     Th_NtkStartFromAbc( Abc_Ntk_t * pNtk );
+extern Th_Ntk_t *     Th_NtkStartFromData( Th_NtkData_t * pData );
+extern Th_Ntk_t *     Th_NtkStartFromList( Vec_Ptr_t * vTList );
+extern Th_Ntk_t *     Th_NtkStartFromMap( Gia_Man_t * pGia, Th_MapPar_t * pPars );
+extern Th_Ntk_t *     Th_NtkDup( Th_Ntk_t * p );
+extern Vec_Ptr_t *    Th_NtkReleaseList( Th_Ntk_t * p );
+extern void           Th_NtkStop( Th_Ntk_t * p );
+// statistics
+extern int            Th_NtkObjNum( Th_Ntk_t * p );
+extern int            Th_NtkPiNum( Th_Ntk_t * p );
+extern int            Th_NtkPoNum( Th_Ntk_t * p );
+extern int            Th_NtkGateNum( Th_Ntk_t * p );
+extern int            Th_NtkLevelNum( Th_Ntk_t * p );
+// synthesis steps
+extern void           Th_CollapseSetDefaultPars( Th_CollapsePar_t * pPars );
+extern int            Th_NtkCollapse( Th_Ntk_t * p, Th_CollapsePar_t * pPars );
+extern void           Th_ExtractSetDefaultPars( Th_ExtractPar_t * pPars );
+extern int            Th_NtkExtract( Th_Ntk_t * p, Th_ExtractPar_t * pPars );
+extern void           Th_ConvertSetDefaultPars( Th_ConvertPar_t * pPars );
+extern Abc_Ntk_t *    Th_NtkToMux( Th_Ntk_t * p, Th_ConvertPar_t * pPars );
+extern Gia_Man_t *    Th_NtkToGia( Th_Ntk_t * p, Th_ConvertPar_t * pPars );
+// results as arrays
+extern Th_NtkData_t * Th_NtkGetData( Th_Ntk_t * p );
+extern void           Th_NtkDataFree( Th_NtkData_t * pData );
+
+ABC_NAMESPACE_HEADER_END
+
+#endif
+
+////////////////////////////////////////////////////////////////////////
+///                       END OF FILE                                ///
+////////////////////////////////////////////////////////////////////////
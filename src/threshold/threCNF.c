@@ -5,13 +5,13 @@
 
 extern void func_EC_writeCNF(Abc_Ntk_t*, Vec_Ptr_t*, char*);
 void        my_Vec_StrPrintNum( Vec_Str_t *, int );
-Vec_Ptr_t*  alan_CNF(FILE*, Abc_Ntk_t *);
-Vec_Ptr_t*  thre_CNF(FILE*, Vec_Ptr_t *);
-void        miter_CNF(FILE*, Vec_Ptr_t *, Vec_Ptr_t *);
+Vec_Ptr_t*  alan_CNF(Abc_Ostr_t*, Abc_Ntk_t *);
+Vec_Ptr_t*  thre_CNF(Abc_Ostr_t*, Vec_Ptr_t *);
+void        miter_CNF(Abc_Ostr_t*, Vec_Ptr_t *, Vec_Ptr_t *);
 ///
 Thre_S*     slow_sortByWeights(Thre_S*);
 void        delete_sortedNode(Thre_S*);
-void        Recurrsive_CNF(FILE*,Thre_S*, Vec_Str_t*, int, int);
+void        Recurrsive_CNF(Abc_Ostr_t*,Thre_S*, Vec_Str_t*, int, int);
 int         Thre_LocalMax(Thre_S*, int);
 int         Thre_LocalMin(Thre_S*, int);
 ///
@@ -19,10 +19,14 @@ int         Thre_LocalMin(Thre_S*, int);
 void func_EC_writeCNF(Abc_Ntk_t * pNtk, Vec_Ptr_t* TList, char* fileName)
 {
     //char* fileName = "EC.cnf";
-    FILE* oFile = fopen(fileName, "w");
+    Abc_Ostr_t* oFile = Abc_OstrStart(fileName, 0);
+    if ( oFile == NULL ){
+        printf("\tERROR: cannot open output file %s\n", fileName);
+        return;
+    }
     printf("\tchecking Equalivance of ABC_ntk and threshold_ntk...\n");
     printf("\tOutputFile: %s\n", fileName);
-    fprintf(oFile, "c CNF file for aig<->th equiv checking\n");
+    Abc_OstrPutS(oFile, "c CNF file for aig<->th equiv checking\n");
     
     Vec_Ptr_t* aigPO = alan_CNF( oFile, pNtk );
     Vec_Ptr_t* thPO  = thre_CNF( oFile, TList );
@@ -30,11 +34,12 @@ void func_EC_writeCNF(Abc_Ntk_t * pNtk, Vec_Ptr_t* TList, char* fileName)
 
     Vec_PtrFree(aigPO);
     Vec_PtrFree(thPO);
-    fclose(oFile);
+    if ( !Abc_OstrStop(oFile) )
+        printf("\tERROR: writing file %s has failed\n", fileName);
 }
 /////////////////////////////////////////////////////
 
-void miter_CNF(FILE* oFile, Vec_Ptr_t* aig, Vec_Ptr_t * th){
+void miter_CNF(Abc_Ostr_t* oFile, Vec_Ptr_t* aig, Vec_Ptr_t * th){
     // VAR naming:
     // aig_PO    : 3*id+1
     // th_PO     : 3*id
@@ -63,29 +68,25 @@ void miter_CNF(FILE* oFile, Vec_Ptr_t* aig, Vec_Ptr_t * th){
         Vec_StrClear(sMit);
         my_Vec_StrPrintNum( sMit, i*3 + 2 );
         
-        fprintf(oFile, "-%s  %s  %s 0\n", 
-               sAig->pArray, sTh->pArray, sMit->pArray);
-        fprintf(oFile, " %s -%s  %s 0\n", 
-               sAig->pArray, sTh->pArray, sMit->pArray);
-        fprintf(oFile, " %s  %s -%s 0\n", 
-               sAig->pArray, sTh->pArray, sMit->pArray);
-        fprintf(oFile, "-%s -%s -%s 0\n", 
-               sAig->pArray, sTh->pArray, sMit->pArray);
+        Th_OstrPutName(oFile, "-", sAig); Th_OstrPutName(oFile, "  ", sTh); Th_OstrPutName(oFile, "  ", sMit); Abc_OstrPutS(oFile, " 0\n");
+        Th_OstrPutName(oFile, " ", sAig); Th_OstrPutName(oFile, " -", sTh); Th_OstrPutName(oFile, "  ", sMit); Abc_OstrPutS(oFile, " 0\n");
+        Th_OstrPutName(oFile, " ", sAig); Th_OstrPutName(oFile, "  ", sTh); Th_OstrPutName(oFile, " -", sMit); Abc_OstrPutS(oFile, " 0\n");
+        Th_OstrPutName(oFile, "-", sAig); Th_OstrPutName(oFile, " -", sTh); Th_OstrPutName(oFile, " -", sMit); Abc_OstrPutS(oFile, " 0\n");
     }
     int PO_size = Vec_PtrSize(aig);
     Vec_StrPrintStr(sOR, " 2 ");
-    fprintf(oFile, "-2 %d 0\n" , PO_size*3 +2 );
+    Abc_OstrPutS(oFile, "-2 "); Abc_OstrPutNum(oFile, PO_size*3 +2); Abc_OstrPutS(oFile, " 0\n");
     for( i = 1; i < PO_size; ++i ){
         Vec_StrPrintNum(sOR, i*3+2);
         Vec_StrAppend(sOR, " ");
-        fprintf(oFile, "-%d %d 0\n", i*3+2, PO_size*3+2);
+        Abc_OstrPutC(oFile, '-'); Abc_OstrPutNum(oFile, i*3+2); Abc_OstrPutC(oFile, ' '); Abc_OstrPutNum(oFile, PO_size*3+2); Abc_OstrPutS(oFile, " 0\n");
     }
     Vec_StrAppend(sOR, "-");
     Vec_StrPrintNum(sOR, PO_size*3 + 2);
     Vec_StrAppend(sOR, " 0\n");
     Vec_StrPush(sOR, '\0');
-    fprintf(oFile,sOR->pArray);
-    fprintf(oFile," %d 0\n", PO_size*3 +2);
+    Abc_OstrPutS(oFile, sOR->pArray);
+    Abc_OstrPutC(oFile, ' '); Abc_OstrPutNum(oFile, PO_size*3 +2); Abc_OstrPutS(oFile, " 0\n");
 
     printf("\tdone\n");
     Vec_StrFree(sAig);
@@ -96,7 +97,7 @@ void miter_CNF(FILE* oFile, Vec_Ptr_t* aig, Vec_Ptr_t * th){
 }
 /////////////////////////////
 
-Vec_Ptr_t* thre_CNF(FILE* oFile, Vec_Ptr_t* TList )
+Vec_Ptr_t* thre_CNF(Abc_Ostr_t* oFile, Vec_Ptr_t* TList )
 {
     Vec_Ptr_t * thPOList = Vec_PtrAlloc(10);
     /*
@@ -133,57 +134,47 @@ Vec_Ptr_t* thre_CNF(FILE* oFile, Vec_Ptr_t* TList )
     return thPOList;
 }
 
-void Recurrsive_CNF(FILE* oFile, Thre_S* t, Vec_Str_t* sCNF, int thre, int lvl)
+// writes the clause "<prefix> [-]y 0" for the cofactor or recurs further
+static void Recurrsive_CNFCof(Abc_Ostr_t* oFile, Thre_S* t, Vec_Str_t* sCNF, int thre, int lvl, int minF, int maxF)
 {
-    //if (lvl >= Vec_IntSize(t->Fanins))  return;
-    assert(lvl < Vec_IntSize(t->Fanins));
-   
-    Vec_Str_t * pos_cof_CNF = Vec_StrDup( sCNF );
-    Vec_StrAppend( pos_cof_CNF, "-" );
-    // ID X 3
-    Vec_StrPrintNum( pos_cof_CNF, 3 * Vec_IntEntry(t->Fanins, lvl));
-    Vec_StrAppend( pos_cof_CNF, " ");
-
-    Vec_Str_t * neg_cof_CNF = Vec_StrDup( sCNF );
-    // ID X3
-    Vec_StrPrintNum( neg_cof_CNF, 3 * Vec_IntEntry(t->Fanins, lvl));
-    Vec_StrAppend( neg_cof_CNF, " ");
-    
-    
-    int current_w = Vec_IntEntry(t->weights, lvl);
-    int maxF  = Thre_LocalMax(t, lvl);
-    int minF  = Thre_LocalMin(t, lvl);
-    
-    int pos_cof_thre = thre - current_w;
-    if ( pos_cof_thre <= minF) {
+    if ( thre <= minF ) {
         // on-set
-        Vec_StrPush( pos_cof_CNF, '\0');
-        fprintf(oFile,"%s%d 0\n", pos_cof_CNF->pArray, 3*t->Id);
+        Abc_OstrPutBuf(oFile, Vec_StrArray(sCNF), Vec_StrSize(sCNF));
+        Abc_OstrPutNum(oFile, 3*t->Id);
+        Abc_OstrPutS(oFile, " 0\n");
     }
-    else if ( maxF < pos_cof_thre ){
+    else if ( maxF < thre ){
         // off-set
-        Vec_StrPush( pos_cof_CNF, '\0');
-        fprintf(oFile,"%s-%d 0\n", pos_cof_CNF->pArray, 3*t->Id);
+        Abc_OstrPutBuf(oFile, Vec_StrArray(sCNF), Vec_StrSize(sCNF));
+        Abc_OstrPutC(oFile, '-');
+        Abc_OstrPutNum(oFile, 3*t->Id);
+        Abc_OstrPutS(oFile, " 0\n");
     }
     else
-        Recurrsive_CNF(oFile, t, pos_cof_CNF, pos_cof_thre, lvl+1);
-    
-    int neg_cof_thre = thre;
-    if( neg_cof_thre <= minF){
-        // on-set
-        Vec_StrPush( neg_cof_CNF, '\0');
-        fprintf(oFile,"%s%d 0\n", neg_cof_CNF->pArray, 3*t->Id);
-    }
-    else if ( maxF < neg_cof_thre ){
-        // off-set
-        Vec_StrPush( neg_cof_CNF, '\0');
-        fprintf(oFile,"%s-%d 0\n", neg_cof_CNF->pArray, 3*t->Id);
-    }
-    else
-        Recurrsive_CNF(oFile, t, neg_cof_CNF, neg_cof_thre, lvl+1);
-    Vec_StrFree(pos_cof_CNF);
-    Vec_StrFree(neg_cof_CNF);
-    
+        Recurrsive_CNF(oFile, t, sCNF, thre, lvl+1);
+}
+void Recurrsive_CNF(Abc_Ostr_t* oFile, Thre_S* t, Vec_Str_t* sCNF, int thre, int lvl)
+{
+    //if (lvl >= Vec_IntSize(t->Fanins))  return;
+    assert(lvl < Vec_IntSize(t->Fanins));
+    // the clause prefix is extended in place and restored after each cofactor
+    int nPrefix   = Vec_StrSize(sCNF);
+    int current_w = Vec_IntEntry(t->weights, lvl);
+    int maxF  = Thre_LocalMax(t, lvl);
+    int minF  = Thre_LocalMin(t, lvl);
+
+    // positive cofactor: ID X 3
+    Vec_StrPush( sCNF, '-' );
+    Vec_StrPrintNum( sCNF, 3 * Vec_IntEntry(t->Fanins, lvl));
+    Vec_StrPush( sCNF, ' ' );
+    Recurrsive_CNFCof(oFile, t, sCNF, thre - current_w, lvl, minF, maxF);
+    Vec_StrShrink( sCNF, nPrefix );
+
+    // negative cofactor: ID X 3
+    Vec_StrPrintNum( sCNF, 3 * Vec_IntEntry(t->Fanins, lvl));
+    Vec_StrPush( sCNF, ' ' );
+    Recurrsive_CNFCof(oFile, t, sCNF, thre, lvl, minF, maxF);
+    Vec_StrShrink( sCNF, nPrefix );
 } 
 
 
@@ -311,7 +302,7 @@ void my_Vec_StrPrintNum( Vec_Str_t* s, int n)
     Vec_StrPush( s, '\0' );
 }
 
-Vec_Ptr_t* alan_CNF(FILE* oFile, Abc_Ntk_t * pNtk)
+Vec_Ptr_t* alan_CNF(Abc_Ostr_t* oFile, Abc_Ntk_t * pNtk)
 {
     /* VAR naming:
      * PI:  3*id
@@ -348,13 +339,13 @@ Vec_Ptr_t* alan_CNF(FILE* oFile, Abc_Ntk_t * pNtk)
 
             if(Abc_ObjFaninC0(pObj)){
             //    printf( "!%s -> %s\n", sFin0->pArray, sNode->pArray);
-                fprintf(oFile, "-%s -%s 0\n", sFin0->pArray, sNode->pArray);
-                fprintf(oFile, " %s  %s 0\n", sFin0->pArray, sNode->pArray);
+                Th_OstrPutName(oFile, "-", sFin0); Th_OstrPutName(oFile, " -", sNode); Abc_OstrPutS(oFile, " 0\n");
+                Th_OstrPutName(oFile, " ", sFin0); Th_OstrPutName(oFile, "  ", sNode); Abc_OstrPutS(oFile, " 0\n");
             }
             else{
             //    printf( " %s -> %s\n", sFin0->pArray, sNode->pArray);
-                fprintf(oFile, " %s -%s 0\n", sFin0->pArray, sNode->pArray);
-                fprintf(oFile, "-%s  %s 0\n", sFin0->pArray, sNode->pArray);
+                Th_OstrPutName(oFile, " ", sFin0); Th_OstrPutName(oFile, " -", sNode); Abc_OstrPutS(oFile, " 0\n");
+                Th_OstrPutName(oFile, "-", sFin0); Th_OstrPutName(oFile, "  ", sNode); Abc_OstrPutS(oFile, " 0\n");
             }
 
         }
@@ -385,32 +376,28 @@ Vec_Ptr_t* alan_CNF(FILE* oFile, Abc_Ntk_t * pNtk)
             
             if( Abc_ObjFaninC0(pObj) == 0 && Abc_ObjFaninC1(pObj) == 0){
                 //printf(" %s  &  %s -> %s\n", sFin0->pArray, sFin1->pArray, sNode->pArray);
-                fprintf(oFile," %s -%s 0\n", sFin0->pArray, sNode->pArray);
-                fprintf(oFile," %s -%s 0\n", sFin1->pArray, sNode->pArray);
-                fprintf(oFile,"-%s -%s  %s 0\n",
-                        sFin0->pArray, sFin1->pArray, sNode->pArray);
+                Th_OstrPutName(oFile, " ", sFin0); Th_OstrPutName(oFile, " -", sNode); Abc_OstrPutS(oFile, " 0\n");
+                Th_OstrPutName(oFile, " ", sFin1); Th_OstrPutName(oFile, " -", sNode); Abc_OstrPutS(oFile, " 0\n");
+                Th_OstrPutName(oFile, "-", sFin0); Th_OstrPutName(oFile, " -", sFin1); Th_OstrPutName(oFile, "  ", sNode); Abc_OstrPutS(oFile, " 0\n");
 
             }
             else if( Abc_ObjFaninC0(pObj) == 1 && Abc_ObjFaninC1(pObj) == 0){
                 //printf("!%s  &  %s -> %s\n", sFin0->pArray, sFin1->pArray, sNode->pArray);
-                fprintf(oFile,"-%s -%s 0\n", sFin0->pArray, sNode->pArray);
-                fprintf(oFile," %s -%s 0\n", sFin1->pArray, sNode->pArray);
-                fprintf(oFile," %s -%s  %s 0\n",
-                        sFin0->pArray, sFin1->pArray, sNode->pArray);
+                Th_OstrPutName(oFile, "-", sFin0); Th_OstrPutName(oFile, " -", sNode); Abc_OstrPutS(oFile, " 0\n");
+                Th_OstrPutName(oFile, " ", sFin1); Th_OstrPutName(oFile, " -", sNode); Abc_OstrPutS(oFile, " 0\n");
+                Th_OstrPutName(oFile, " ", sFin0); Th_OstrPutName(oFile, " -", sFin1); Th_OstrPutName(oFile, "  ", sNode); Abc_OstrPutS(oFile, " 0\n");
             }
             else if( Abc_ObjFaninC0(pObj) == 0 && Abc_ObjFaninC1(pObj) == 1){
                 //printf(" %s  & !%s -> %s\n", sFin0->pArray, sFin1->pArray, sNode->pArray);
-                fprintf(oFile," %s -%s 0\n", sFin0->pArray, sNode->pArray);
-                fprintf(oFile,"-%s -%s 0\n", sFin1->pArray, sNode->pArray);
-                fprintf(oFile,"-%s  %s  %s 0\n",
-                        sFin0->pArray, sFin1->pArray, sNode->pArray);
+                Th_OstrPutName(oFile, " ", sFin0); Th_OstrPutName(oFile, " -", sNode); Abc_OstrPutS(oFile, " 0\n");
+                Th_OstrPutName(oFile, "-", sFin1); Th_OstrPutName(oFile, " -", sNode); Abc_OstrPutS(oFile, " 0\n");
+                Th_OstrPutName(oFile, "-", sFin0); Th_OstrPutName(oFile, "  ", sFin1); Th_OstrPutName(oFile, "  ", sNode); Abc_OstrPutS(oFile, " 0\n");
             }
             else {
                 //printf("!%s  & !%s -> %s\n", sFin0->pArray, sFin1->pArray, sNode->pArray);
-                fprintf(oFile,"-%s -%s 0\n", sFin0->pArray, sNode->pArray);
-                fprintf(oFile,"-%s -%s 0\n", sFin1->pArray, sNode->pArray);
-                fprintf(oFile," %s  %s  %s 0\n",
-                        sFin0->pArray, sFin1->pArray, sNode->pArray);
+                Th_OstrPutName(oFile, "-", sFin0); Th_OstrPutName(oFile, " -", sNode); Abc_OstrPutS(oFile, " 0\n");
+                Th_OstrPutName(oFile, "-", sFin1); Th_OstrPutName(oFile, " -", sNode); Abc_OstrPutS(oFile, " 0\n");
+                Th_OstrPutName(oFile, " ", sFin0); Th_OstrPutName(oFile, "  ", sFin1); Th_OstrPutName(oFile, "  ", sNode); Abc_OstrPutS(oFile, " 0\n");
             }
         }
     }
@@ -24,6 +24,7 @@
 
 #include <stdio.h>
 #include <math.h>
+#include <limits.h>
 #include "base/abc/abc.h"
 #include "map/if/if.h"
 #include "map/if/ifCount.h"
@@ -53,6 +54,8 @@ void       Th_IfCoeff             ( const Thre_S * , int , int * , int * );
 Pair_S*    Th_IfSolveKL           ( int * , int * , int );
 int        Th_IfCheckCoeff        ( int * , int * );
 int        Th_IfCheckKL           ( Pair_S * , int * , int * );
+ABC_INT64_T Th_IfDivRound         ( ABC_INT64_T , ABC_INT64_T );
+int        Th_IfClamp             ( ABC_INT64_T );
 // iff conditions
 void       Th_DPCoeff             ( const Thre_S * , const Thre_S * , int , int , int , int * , int * );
 int        Th_subSum              ( const Thre_S * , int , int , int );
@@ -204,10 +207,10 @@ Th_IfCoeff( const Thre_S * tObj1 , int w , int * cond , int * n )
 	T1      = tObj1->thre;
 	maxf1   = MaxF( tObj1->weights , Vec_IntSize( tObj1->weights ) ); 
 	minf1   = MinF( tObj1->weights , Vec_IntSize( tObj1->weights ) ); 
-   if ( cond[0] ) n[0] = maxf1 - T1; 
+   if ( cond[0] ) n[0] = Th_IfClamp( (ABC_INT64_T)maxf1 - T1 ); 
 	if ( cond[1] ) {
 		n[1]  = w;
-		n[2]  = T1 - minf1;
+		n[2]  = Th_IfClamp( (ABC_INT64_T)T1 - minf1 );
 	}
    // assume 3-rd cond must be satisfied
 	n[3] = w - 1;
@@ -406,40 +409,44 @@ Th_IfSolveKL( int * cond , int * n , int w )
 	}
 #endif
 	Pair_S * pair;
+	// the products of two coefficients are computed in 64 bits
+	ABC_INT64_T n0 = n[0] , n1 = n[1] , n2 = n[2] , n3 = n[3] , K = 0 , L = 0;
 	pair = ABC_ALLOC( Pair_S , 1 );
 	pair->IntK = pair->IntL = 0;
 
 	if ( cond[0] && cond[1] ) {
-		if ( (1 > n[0]*n[3]) && (n[1] > n[2]*n[3]) ) {
+		if ( (1 > n0*n3) && (n1 > n2*n3) ) {
 		   double x , y , slope;
-	      x     = (n[0] + 1) / (1 - n[0]*n[3]);
-			y     = n[3]*x + 1;
+	      x     = (double)( (n0 + 1) / (1 - n0*n3) );
+			y     = n3*x + 1;
 			slope = y / x;
-			if ( (double)n[1] >= n[2]*slope ) {
-	         pair->IntL = Th_DPDivRound( n[0]+1 , 1-n[0]*n[3] );
-		      pair->IntK = pair->IntL*n[3] + 1;
-			}
-			else {
-	         pair->IntL = Th_DPDivRound( n[2] , n[1]-n[2]*n[3] );
-		      pair->IntK = pair->IntL*n[3] + 1;
-			} 
+			if ( (double)n1 >= n2*slope )
+	         L = Th_IfDivRound( n0+1 , 1-n0*n3 );
+			else
+	         L = Th_IfDivRound( n2 , n1-n2*n3 );
+		   K = L*n3 + 1;
 		}
 	}
 	else if ( cond[0] ) {
-      if ( 1 > n[0]*n[3] ) {
-	      pair->IntL = Th_DPDivRound( n[0]+1 , 1-n[0]*n[3] );
-		   pair->IntK = pair->IntL*n[3] + 1;
+      if ( 1 > n0*n3 ) {
+	      L = Th_IfDivRound( n0+1 , 1-n0*n3 );
+		   K = L*n3 + 1;
 		}
 	}
 	else if ( cond[1] ) {
-      if ( n[1] > n[2]*n[3] ) {
-	      pair->IntL = Th_DPDivRound( n[2] , n[1]-n[2]*n[3] );
-		   pair->IntK = pair->IntL*n[3] + 1;
+      if ( n1 > n2*n3 ) {
+	      L = Th_IfDivRound( n2 , n1-n2*n3 );
+		   K = L*n3 + 1;
 		}
 	}
 	else {
-		pair->IntL = 1;
-		pair->IntK = n[3] + 1;
+		L = 1;
+		K = n3 + 1;
+	}
+	// no solution if K or L does not fit into int
+	if ( Th_FitsInt( K ) && Th_FitsInt( L ) ) {
+		pair->IntK = (int)K;
+		pair->IntL = (int)L;
 	}
 #ifdef CHECK
 	if ( !Th_IfCheckKL( pair , cond , n ) ) {
@@ -465,7 +472,7 @@ Th_IfCheckCoeff( int * cond , int * n )
 int
 Th_IfCheckKL( Pair_S * pair , int * cond , int * n )
 {
-	int k , l;
+	ABC_INT64_T k , l;
 	k = pair->IntK;
 	l = pair->IntL;
 
@@ -478,6 +485,18 @@ Th_IfCheckKL( Pair_S * pair , int * cond , int * n )
 	return 1;
 }
 
+ABC_INT64_T
+Th_IfDivRound( ABC_INT64_T num1 , ABC_INT64_T num2 )
+{
+	return ( num1 % num2 == 0 ) ? (num1 / num2) : (num1 / num2)+1;
+}
+
+int
+Th_IfClamp( ABC_INT64_T num )
+{
+	return num > INT_MAX ? INT_MAX : (num < INT_MIN ? INT_MIN : (int)num);
+}
+
 /**Function*************************************************************
 
   Synopsis    [DP : Solve for K and L analytically.]
@@ -39,6 +39,7 @@ static int Abc_CommandAig2Th           ( Abc_Frame_t * pAbc, int argc, char ** a
 static int Abc_CommandMerge            ( Abc_Frame_t * pAbc, int argc, char ** argv );
 static int Abc_CommandTh2Mux           ( Abc_Frame_t * pAbc, int argc, char ** argv );
 static int Abc_CommandTh2Blif          ( Abc_Frame_t * pAbc, int argc, char ** argv );
+static int Abc_CommandThMap            ( Abc_Frame_t * pAbc, int argc, char ** argv );
 // Verification commands
 static int Abc_CommandPB_Threshold     ( Abc_Frame_t * pAbc, int argc, char ** argv );
 static int Abc_CommandCNF_Threshold    ( Abc_Frame_t * pAbc, int argc, char ** argv );
@@ -94,6 +95,7 @@ Threshold_Init( Abc_Frame_t *pAbc)
     Cmd_CommandAdd( pAbc, "z Alcom", "merge_th"    , Abc_CommandMerge,          1 );
     Cmd_CommandAdd( pAbc, "z Alcom", "th2blif"     , Abc_CommandTh2Blif,        0 );
     Cmd_CommandAdd( pAbc, "z Alcom", "th2mux"      , Abc_CommandTh2Mux,         1 );
+    Cmd_CommandAdd( pAbc, "z Alcom", "&thmap"      , Abc_CommandThMap,          0 );
     Cmd_CommandAdd( pAbc, "z Alcom", "PB_th"       , Abc_CommandPB_Threshold,   0 );
     Cmd_CommandAdd( pAbc, "z Alcom", "CNF_th"      , Abc_CommandCNF_Threshold,  0 );
     Cmd_CommandAdd( pAbc, "z Alcom", "thverify"    , Abc_CommandThVerify,       0 );
@@ -421,6 +423,114 @@ usage:
 	 return 1;
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Map the current GIA directly into a threshold network.]
+
+  Description [The result becomes cut_TList and current_TList is its copy,
+               the same as the threshold network derived by &if.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+
+int 
+Abc_CommandThMap( Abc_Frame_t * pAbc, int argc, char ** argv )
+{
+    extern Vec_Ptr_t * Th_CopyList( Vec_Ptr_t * );
+    Th_MapPar_t Pars, * pPars = &Pars;
+    Vec_Ptr_t * vTList;
+    int c;
+    Th_MapSetDefaultPars( pPars );
+    Extra_UtilGetoptReset();
+    while ( ( c = Extra_UtilGetopt( argc, argv, "KCPwvh" ) ) != EOF )
+    {
+        switch ( c )
+        {
+        case 'K':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-K\" should be followed by a positive integer.\n" );
+                goto usage;
+            }
+            pPars->nLutSize = atoi(argv[globalUtilOptind]);
+            globalUtilOptind++;
+            if ( pPars->nLutSize < 2 || pPars->nLutSize > pPars->nLutSizeMax )
+            {
+                Abc_Print( -1, "Cut size %d is not supported.\n", pPars->nLutSize );
+                goto usage;
+            }
+            break;
+        case 'C':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-C\" should be followed by a positive integer.\n" );
+                goto usage;
+            }
+            pPars->nCutNum = atoi(argv[globalUtilOptind]);
+            globalUtilOptind++;
+            if ( pPars->nCutNum < 2 || pPars->nCutNum > pPars->nCutNumMax )
+            {
+                Abc_Print( -1, "This number of cuts (%d) is not supported.\n", pPars->nCutNum );
+                goto usage;
+            }
+            break;
+        case 'P':
+            if ( globalUtilOptind >= argc )
+            {
+                Abc_Print( -1, "Command line switch \"-P\" should be followed by a positive integer.\n" );
+                goto usage;
+            }
+            pPars->nProcNum = atoi(argv[globalUtilOptind]);
+            globalUtilOptind++;
+            if ( pPars->nProcNum < 0 || pPars->nProcNum > pPars->nProcNumMax )
+            {
+                Abc_Print( -1, "The number of threads (%d) should be from 0 to %d.\n", pPars->nProcNum, pPars->nProcNumMax );
+                goto usage;
+            }
+            break;
+        case 'w':
+            pPars->fWeightCost ^= 1;
+            break;
+        case 'v':
+            pPars->fVerbose ^= 1;
+            break;
+        case 'h':
+        default:
+            goto usage;
+        }
+    }
+    if ( pAbc->pGia == NULL )
+    {
+        Abc_Print( -1, "Empty GIA network.\n" );
+        return 1;
+    }
+    if ( Gia_ManBufNum(pAbc->pGia) || Gia_ManHasChoices(pAbc->pGia) )
+    {
+        Abc_Print( -1, "The network should not have buffers or choices.\n" );
+        return 1;
+    }
+    vTList = Th_MapGia( pAbc->pGia, pPars );
+    if ( cut_TList )     DeleteTList( cut_TList );
+    if ( current_TList ) DeleteTList( current_TList );
+    cut_TList     = vTList;
+    current_TList = Th_CopyList( cut_TList );
+    return 0;
+
+usage:
+    Abc_Print( -2, "usage: &thmap [-KCP num] [-wvh]\n" );
+    Abc_Print( -2, "\t           maps the current GIA into a threshold network\n" );
+    Abc_Print( -2, "\t-K num   : the max cut size (2 <= K <= %d) [default = %d]\n", pPars->nLutSizeMax, pPars->nLutSize );
+    Abc_Print( -2, "\t-C num   : the max number of priority cuts (2 <= C <= %d) [default = %d]\n", pPars->nCutNumMax, pPars->nCutNum );
+    Abc_Print( -2, "\t-P num   : the number of cut computation threads (0 <= P <= %d) [default = %d]\n", pPars->nProcNumMax, pPars->nProcNum );
+    Abc_Print( -2, "\t-w       : toggles minimizing weights instead of gate count [default = %s]\n", pPars->fWeightCost? "yes": "no" );
+    Abc_Print( -2, "\t-v       : toggles verbose output [default = %s]\n", pPars->fVerbose? "yes": "no" );
+    Abc_Print( -2, "\t-h       : print the command usage\n");
+    return 1;
+}
+
 /**Function*************************************************************
 
   Synopsis    [Write out threshold network as blif file.]
@@ -5,29 +5,34 @@
  * Function: Equiv-Checking: Using minisat+  *
  *************************** *****************/
 void        func_EC_writePB(Abc_Ntk_t *, Vec_Ptr_t *, char*);
-Vec_Ptr_t*  thre_PB(FILE*, Vec_Ptr_t *);
-Vec_Ptr_t*  alan_PB(FILE*, Abc_Ntk_t *);
-void        miter_PB(FILE*, Vec_Ptr_t*, Vec_Ptr_t *);
+Vec_Ptr_t*  thre_PB(Abc_Ostr_t*, Vec_Ptr_t *);
+Vec_Ptr_t*  alan_PB(Abc_Ostr_t*, Abc_Ntk_t *);
+void        miter_PB(Abc_Ostr_t*, Vec_Ptr_t*, Vec_Ptr_t *);
 int         Max_Thre(Thre_S *);
 int         min_Thre(Thre_S *);
 
 //////////////////////////////////////////////////////////////////
 void func_EC_writePB(Abc_Ntk_t *pNtk, Vec_Ptr_t *thList, char *fileName)
 {
-    FILE* oFile = fopen(fileName, "w");
+    Abc_Ostr_t* oFile = Abc_OstrStart(fileName, 0);
+    if ( oFile == NULL ){
+        printf("\tERROR: cannot open output file %s\n", fileName);
+        return;
+    }
     printf("\tchecking Equalivance of ABC_ntk and threshold_ntk...\n");
     printf("\tOutputFile: %s\n", fileName);
-    fprintf(oFile, "min: -1*Z;\n");
+    Abc_OstrPutS(oFile, "min: -1*Z;\n");
     Vec_Ptr_t* aigPO = alan_PB(oFile, pNtk);
     Vec_Ptr_t* thPO  = thre_PB(oFile, thList);
     miter_PB(oFile, aigPO, thPO);
     
     Vec_PtrFree(aigPO);
     Vec_PtrFree(thPO);
-    fclose(oFile);
+    if ( !Abc_OstrStop(oFile) )
+        printf("\tERROR: writing file %s has failed\n", fileName);
 }
 /////////////////////////////////////////////////////////////////
-void miter_PB(FILE* oFile, Vec_Ptr_t *aig, Vec_Ptr_t * th){
+void miter_PB(Abc_Ostr_t* oFile, Vec_Ptr_t *aig, Vec_Ptr_t * th){
     // VAR naming:
     // aig_PO  : PO_<id>
     // th_PO   : TO_<id>
@@ -62,25 +67,21 @@ void miter_PB(FILE* oFile, Vec_Ptr_t *aig, Vec_Ptr_t * th){
         Vec_StrPrintNum(sMit, i);
         Vec_StrPush(sMit, '\0');
 
-        fprintf(oFile, "+1*%s -1*%s +1*%s >= 0;\n", 
-               sAig->pArray, sTh->pArray, sMit->pArray);
-        fprintf(oFile, "+1*%s +1*%s -1*%s >= 0;\n", 
-               sAig->pArray, sTh->pArray, sMit->pArray);
-        fprintf(oFile, "+1*%s -1*%s -1*%s <= 0;\n", 
-               sAig->pArray, sTh->pArray, sMit->pArray);
-        fprintf(oFile, "+1*%s +1*%s +1*%s <= 2;\n", 
-               sAig->pArray, sTh->pArray, sMit->pArray);
+        Th_OstrPutName(oFile, "+1*", sAig); Th_OstrPutName(oFile, " -1*", sTh); Th_OstrPutName(oFile, " +1*", sMit); Abc_OstrPutS(oFile, " >= 0;\n");
+        Th_OstrPutName(oFile, "+1*", sAig); Th_OstrPutName(oFile, " +1*", sTh); Th_OstrPutName(oFile, " -1*", sMit); Abc_OstrPutS(oFile, " >= 0;\n");
+        Th_OstrPutName(oFile, "+1*", sAig); Th_OstrPutName(oFile, " -1*", sTh); Th_OstrPutName(oFile, " -1*", sMit); Abc_OstrPutS(oFile, " <= 0;\n");
+        Th_OstrPutName(oFile, "+1*", sAig); Th_OstrPutName(oFile, " +1*", sTh); Th_OstrPutName(oFile, " +1*", sMit); Abc_OstrPutS(oFile, " <= 2;\n");
     }
     Vec_StrPrintStr(sOR, "+1*M_0");
-    fprintf(oFile, "-1*M_0 +1*Z >= 0;\n");
+    Abc_OstrPutS(oFile, "-1*M_0 +1*Z >= 0;\n");
     for( i = 1; i < Vec_PtrSize(aig); i++){
         Vec_StrAppend(sOR, " +1*M_");
         Vec_StrPrintNum(sOR, i);
-        fprintf(oFile, "-1*M_%d +1*Z >= 0;\n", i);
+        Abc_OstrPutS(oFile, "-1*M_"); Abc_OstrPutNum(oFile, i); Abc_OstrPutS(oFile, " +1*Z >= 0;\n");
     }
     Vec_StrAppend(sOR, " -1*Z >= 0;\n");
     Vec_StrPush(sOR, '\0');
-    fprintf(oFile, sOR->pArray);
+    Abc_OstrPutS(oFile, sOR->pArray);
     
     printf("\tdone\n");
     Vec_StrFree(sAig);
@@ -89,7 +90,23 @@ void miter_PB(FILE* oFile, Vec_Ptr_t *aig, Vec_Ptr_t * th){
     Vec_StrFree(sOR);
 }
 //////////////////////////////////////////////////////////////////
-Vec_Ptr_t* thre_PB(FILE* oFile, Vec_Ptr_t *thList){
+// writes the PB variable of fanin finId
+static inline void thre_PBPutFanin(Abc_Ostr_t* oFile, Vec_Ptr_t *thList, int finId){
+    Thre_S * finObj = (Thre_S *) Vec_PtrEntry( thList, finId );
+    if( finObj->Type == 1 ){
+        Abc_OstrPutS(oFile, "I_");
+        Abc_OstrPutNum(oFile, finId);
+    }
+    else if ( finObj->Type == 3 ){
+        Abc_OstrPutS(oFile, "th_");
+        Abc_OstrPutNum(oFile, finId);
+    }
+    else{
+        // const gate
+        Abc_OstrPutS(oFile, "CONST1");
+    }
+}
+Vec_Ptr_t* thre_PB(Abc_Ostr_t* oFile, Vec_Ptr_t *thList){
     Vec_Ptr_t * thPOList = Vec_PtrAlloc(10);
     /* Reminder:
      * Con1: (M-T+1)y - sigma_N ( wixi ) >= 1-T
@@ -101,13 +118,9 @@ Vec_Ptr_t* thre_PB(FILE* oFile, Vec_Ptr_t *thList){
      * TH: th_<id>
      */
     int i, j, finId;
-    Thre_S *tObj, *finObj;
-    // node names
+    Thre_S *tObj;
+    // node name
     Vec_Str_t* sNode = Vec_StrAlloc(5);
-    Vec_Str_t* sFin  = Vec_StrAlloc(5); 
-    // constraint string
-    Vec_Str_t* sCon1 = Vec_StrAlloc(5);
-    Vec_Str_t* sCon2 = Vec_StrAlloc(5);
     Vec_PtrForEachEntry( Thre_S*, thList, tObj, i){
         if( tObj == NULL ) continue;
         if( tObj->Type == 1 || tObj->Type == 4 )  continue;
@@ -128,73 +141,32 @@ Vec_Ptr_t* thre_PB(FILE* oFile, Vec_Ptr_t *thList){
         int MaxF = Max_Thre(tObj);
         int minF = min_Thre(tObj);
         int T    = tObj->thre;
-        // c1: (M-T+1)y
-        // c2: (m-T) y
-        Vec_StrClear( sCon1 );
-        Vec_StrClear( sCon2 );
-        if (MaxF - T + 1 > 0)
-            Vec_StrAppend(sCon1, "+");
-        Vec_StrPrintNum( sCon1, MaxF - T + 1);
-        Vec_StrAppend( sCon1, "*");
-        Vec_StrAppend( sCon1, sNode->pArray );
-        
-        if (minF - T > 0)
-            Vec_StrAppend(sCon2, "+");
-        Vec_StrPrintNum( sCon2, minF - T );
-        Vec_StrAppend( sCon2, "*");
-        Vec_StrAppend( sCon2, sNode->pArray);
-        
-        Vec_IntForEachEntry( tObj->Fanins, finId,j ){
-            finObj = (Thre_S *) Vec_PtrEntry( thList, finId );
-            int w  = Vec_IntEntry( tObj->weights, j );
-            Vec_StrClear( sFin );
-            if( finObj->Type == 1){
-                Vec_StrPrintStr(sFin, "I_");
-                Vec_StrPrintNum(sFin, finId);
-            }
-            else if ( finObj->Type == 3 ){
-                Vec_StrPrintStr(sFin, "th_");
-                Vec_StrPrintNum(sFin, finId);
-            }
-            else{
-                // const gate
-                Vec_StrPrintStr(sFin, "CONST1");
-            }
-            Vec_StrPush(sFin, '\0');
-            // c1: -wixi
-            // c2: wixi
-            Vec_StrAppend(sCon1, " ");
-            if (-w > 0)
-                Vec_StrAppend(sCon1, "+");
-            Vec_StrPrintNum(sCon1, -w);
-            Vec_StrAppend(sCon1, "*");
-            Vec_StrAppend(sCon1, sFin->pArray);
-            
-            Vec_StrAppend(sCon2, " ");
-            if (w > 0)
-                Vec_StrAppend(sCon2, "+");
-            Vec_StrPrintNum(sCon2, w);
-            Vec_StrAppend(sCon2, "*");
-            Vec_StrAppend(sCon2, sFin->pArray);
+        // c1: (M-T+1)y - wixi >= 1-T
+        Abc_OstrPutNumSigned( oFile, MaxF - T + 1 );
+        Th_OstrPutName( oFile, "*", sNode );
+        Vec_IntForEachEntry( tObj->Fanins, finId, j ){
+            Abc_OstrPutC( oFile, ' ' );
+            Abc_OstrPutNumSigned( oFile, -Vec_IntEntry( tObj->weights, j ) );
+            Abc_OstrPutC( oFile, '*' );
+            thre_PBPutFanin( oFile, thList, finId );
         }
-        // c1: >= 1-T
-        // c2: >= m
-        Vec_StrAppend(sCon1, " >= ");
-        Vec_StrPrintNum(sCon1, 1-T);
-        Vec_StrAppend(sCon1, ";\n");
-        Vec_StrPush(sCon1, '\0');
-        
-        Vec_StrAppend(sCon2, " >= ");
-        Vec_StrPrintNum(sCon2, minF);
-        Vec_StrAppend(sCon2, ";\n");
-        Vec_StrPush(sCon2, '\0');
-
-        fprintf(oFile, "%s%s",sCon1->pArray ,sCon2->pArray);
+        Abc_OstrPutS( oFile, " >= " );
+        Abc_OstrPutNum( oFile, 1-T );
+        Abc_OstrPutS( oFile, ";\n" );
+        // c2: (m-T) y + wixi >= m
+        Abc_OstrPutNumSigned( oFile, minF - T );
+        Th_OstrPutName( oFile, "*", sNode );
+        Vec_IntForEachEntry( tObj->Fanins, finId, j ){
+            Abc_OstrPutC( oFile, ' ' );
+            Abc_OstrPutNumSigned( oFile, Vec_IntEntry( tObj->weights, j ) );
+            Abc_OstrPutC( oFile, '*' );
+            thre_PBPutFanin( oFile, thList, finId );
+        }
+        Abc_OstrPutS( oFile, " >= " );
+        Abc_OstrPutNum( oFile, minF );
+        Abc_OstrPutS( oFile, ";\n" );
     }
     Vec_StrFree( sNode );
-    Vec_StrFree( sFin  );
-    Vec_StrFree( sCon1 );
-    Vec_StrFree( sCon2 );
     return thPOList;
 }
 //////////////
@@ -216,7 +188,7 @@ int min_Thre(Thre_S* tObj){
     return sum;
 }
 //////////////////////////////////////////////////////////////////
-Vec_Ptr_t* alan_PB(FILE* oF, Abc_Ntk_t *pNtk)
+Vec_Ptr_t* alan_PB(Abc_Ostr_t* oF, Abc_Ntk_t *pNtk)
 {
     /* VAR naming:
      * PI: I_<id>
@@ -259,13 +231,13 @@ Vec_Ptr_t* alan_PB(FILE* oF, Abc_Ntk_t *pNtk)
             Vec_StrPush(sFin0, '\0');
             if(Abc_ObjFaninC0(pObj)){
                // printf( "!%s -> %s\n", sFin0->pArray, sNode->pArray);
-                fprintf(oF,"-1*%s -1*%s >= -1;\n", sFin0->pArray, sNode->pArray);
-                fprintf(oF,"+1*%s +1*%s >=  1;\n", sFin0->pArray, sNode->pArray);
+                Th_OstrPutName(oF, "-1*", sFin0); Th_OstrPutName(oF, " -1*", sNode); Abc_OstrPutS(oF, " >= -1;\n");
+                Th_OstrPutName(oF, "+1*", sFin0); Th_OstrPutName(oF, " +1*", sNode); Abc_OstrPutS(oF, " >=  1;\n");
             }
             else{
                // printf( " %s -> %s\n", sFin0->pArray, sNode->pArray);
-                fprintf(oF,"-1*%s +1*%s >= 0;\n", sFin0->pArray, sNode->pArray );
-                fprintf(oF,"+1*%s -1*%s >= 0;\n", sFin0->pArray, sNode->pArray );
+                Th_OstrPutName(oF, "-1*", sFin0); Th_OstrPutName(oF, " +1*", sNode); Abc_OstrPutS(oF, " >= 0;\n");
+                Th_OstrPutName(oF, "+1*", sFin0); Th_OstrPutName(oF, " -1*", sNode); Abc_OstrPutS(oF, " >= 0;\n");
             }
         }
         else{
@@ -309,32 +281,28 @@ Vec_Ptr_t* alan_PB(FILE* oF, Abc_Ntk_t *pNtk)
             
             if( Abc_ObjFaninC0(pObj) == 0 && Abc_ObjFaninC1(pObj) == 0){
                 //printf(" %s  &  %s -> %s\n", sFin0->pArray, sFin1->pArray, sNode->pArray);
-                fprintf(oF,"+1*%s -1*%s >= 0;\n", sFin0->pArray, sNode->pArray);
-                fprintf(oF,"+1*%s -1*%s >= 0;\n", sFin1->pArray, sNode->pArray);
-                fprintf(oF,"-1*%s -1*%s +1*%s >= -1;\n",
-                        sFin0->pArray, sFin1->pArray, sNode->pArray);
+                Th_OstrPutName(oF, "+1*", sFin0); Th_OstrPutName(oF, " -1*", sNode); Abc_OstrPutS(oF, " >= 0;\n");
+                Th_OstrPutName(oF, "+1*", sFin1); Th_OstrPutName(oF, " -1*", sNode); Abc_OstrPutS(oF, " >= 0;\n");
+                Th_OstrPutName(oF, "-1*", sFin0); Th_OstrPutName(oF, " -1*", sFin1); Th_OstrPutName(oF, " +1*", sNode); Abc_OstrPutS(oF, " >= -1;\n");
 
             }
             else if( Abc_ObjFaninC0(pObj) == 1 && Abc_ObjFaninC1(pObj) == 0){
                 //printf("!%s  &  %s -> %s\n", sFin0->pArray, sFin1->pArray, sNode->pArray);
-                fprintf(oF,"-1*%s -1*%s >= -1;\n", sFin0->pArray, sNode->pArray);
-                fprintf(oF,"+1*%s -1*%s >= 0;\n", sFin1->pArray, sNode->pArray);
-                fprintf(oF,"+1*%s -1*%s +1*%s >= 0;\n",
-                        sFin0->pArray, sFin1->pArray, sNode->pArray);
+                Th_OstrPutName(oF, "-1*", sFin0); Th_OstrPutName(oF, " -1*", sNode); Abc_OstrPutS(oF, " >= -1;\n");
+                Th_OstrPutName(oF, "+1*", sFin1); Th_OstrPutName(oF, " -1*", sNode); Abc_OstrPutS(oF, " >= 0;\n");
+                Th_OstrPutName(oF, "+1*", sFin0); Th_OstrPutName(oF, " -1*", sFin1); Th_OstrPutName(oF, " +1*", sNode); Abc_OstrPutS(oF, " >= 0;\n");
             }
             else if( Abc_ObjFaninC0(pObj) == 0 && Abc_ObjFaninC1(pObj) == 1){
                 //printf(" %s  & !%s -> %s\n", sFin0->pArray, sFin1->pArray, sNode->pArray);
-                fprintf(oF,"+1*%s -1*%s >= 0;\n", sFin0->pArray, sNode->pArray);
-                fprintf(oF,"-1*%s -1*%s >= -1;\n", sFin1->pArray, sNode->pArray);
-                fprintf(oF,"-1*%s +1*%s +1*%s >= 0;\n",
-                        sFin0->pArray, sFin1->pArray, sNode->pArray);
+                Th_OstrPutName(oF, "+1*", sFin0); Th_OstrPutName(oF, " -1*", sNode); Abc_OstrPutS(oF, " >= 0;\n");
+                Th_OstrPutName(oF, "-1*", sFin1); Th_OstrPutName(oF, " -1*", sNode); Abc_OstrPutS(oF, " >= -1;\n");
+                Th_OstrPutName(oF, "-1*", sFin0); Th_OstrPutName(oF, " +1*", sFin1); Th_OstrPutName(oF, " +1*", sNode); Abc_OstrPutS(oF, " >= 0;\n");
             }
             else {
                 //printf("!%s  & !%s -> %s\n", sFin0->pArray, sFin1->pArray, sNode->pArray);
-                fprintf(oF,"-1*%s -1*%s >= -1;\n", sFin0->pArray, sNode->pArray);
-                fprintf(oF,"-1*%s -1*%s >= -1;\n", sFin1->pArray, sNode->pArray);
-                fprintf(oF,"+1*%s +1*%s +1*%s >= +1;\n",
-                        sFin0->pArray, sFin1->pArray, sNode->pArray);
+                Th_OstrPutName(oF, "-1*", sFin0); Th_OstrPutName(oF, " -1*", sNode); Abc_OstrPutS(oF, " >= -1;\n");
+                Th_OstrPutName(oF, "-1*", sFin1); Th_OstrPutName(oF, " -1*", sNode); Abc_OstrPutS(oF, " >= -1;\n");
+                Th_OstrPutName(oF, "+1*", sFin0); Th_OstrPutName(oF, " +1*", sFin1); Th_OstrPutName(oF, " +1*", sNode); Abc_OstrPutS(oF, " >= +1;\n");
             }
         }
     }
@@ -234,20 +234,17 @@ void  printNodeStats(Vec_Ptr_t* vTG){
 
 void dumpTh2FileNZ( Vec_Ptr_t * thre_list , char * name )
 {   
-    FILE * pFile;
-    char filename[30];
+    Abc_Ostr_t * pFile;
     Thre_S * tObj;
     Vec_Ptr_t * vPi , * vPo , * vTh; 
     int i;
     int j = 0;
-   
-    while (1) {
-        filename[j] = name[j];
-        if ( name[j] == '\0' ) break;
-        else ++j;
-    }
 
-    pFile = fopen( name , "w" );
+    pFile = Abc_OstrStart( name , 0 );
+    if ( pFile == NULL ) {
+        printf( "[Error] cannot open file %s for writing!\n" , name );
+        return;
+    }
     vPi   = Vec_PtrAlloc(16); 
     vPo   = Vec_PtrAlloc(16); 
     vTh   = Vec_PtrAlloc(16); 
@@ -261,48 +258,63 @@ void dumpTh2FileNZ( Vec_Ptr_t * thre_list , char * name )
     }
 
     // write header
-    fprintf( pFile , "Threshold logic gate list written by NZ.\n" );
+    Abc_OstrPutS( pFile , "Threshold logic gate list written by NZ.\n" );
     // write model
-    fprintf( pFile , ".model %s\n" , name );
+    Abc_OstrPrintf( pFile , ".model %s\n" , name );
     // write input
-    fprintf( pFile , ".input");
+    Abc_OstrPutS( pFile , ".input");
     for ( i = 0 ; i < Vec_PtrSize( vPi ) ; ++i ) {
         tObj = Vec_PtrEntry( vPi , i);
-        fprintf( pFile , " %d" , tObj->Id );
+        Abc_OstrPutC( pFile , ' ' );
+        Abc_OstrPutNum( pFile , tObj->Id );
     }
-    fprintf( pFile , "\n");
+    Abc_OstrPutC( pFile , '\n');
     // write output
-    fprintf( pFile , ".output");
+    Abc_OstrPutS( pFile , ".output");
     for ( i = 0 ; i < Vec_PtrSize( vPo ) ; ++i ) {
         tObj = Vec_PtrEntry( vPo , i);
-        fprintf( pFile , " %d" , tObj->Id );
+        Abc_OstrPutC( pFile , ' ' );
+        Abc_OstrPutNum( pFile , tObj->Id );
     }
-    fprintf( pFile , "\n");
+    Abc_OstrPutC( pFile , '\n');
     // write threshold gate
     for ( i = 0 ; i < Vec_PtrSize( vPo ) ; ++i ) {
         tObj = Vec_PtrEntry( vPo , i );
-		  if ( Vec_IntEntry( tObj->Fanins , 0 ) == 0 ) fprintf( pFile , ".threshold %s %d\n" , "CONST1" , tObj->Id );
-		  else fprintf( pFile , ".threshold %d %d\n" , Vec_IntEntry( tObj->Fanins , 0 ) , tObj->Id );
-        fprintf( pFile , "%d %d\n" , Vec_IntEntry( tObj->weights , 0 ) , tObj->thre );
+        Abc_OstrPutS( pFile , ".threshold " );
+		  if ( Vec_IntEntry( tObj->Fanins , 0 ) == 0 ) Abc_OstrPutS( pFile , "CONST1" );
+		  else Abc_OstrPutNum( pFile , Vec_IntEntry( tObj->Fanins , 0 ) );
+        Abc_OstrPutC( pFile , ' ' );
+        Abc_OstrPutNum( pFile , tObj->Id );
+        Abc_OstrPutC( pFile , '\n' );
+        Abc_OstrPutNum( pFile , Vec_IntEntry( tObj->weights , 0 ) );
+        Abc_OstrPutC( pFile , ' ' );
+        Abc_OstrPutNum( pFile , tObj->thre );
+        Abc_OstrPutC( pFile , '\n' );
     }
     for ( i = 0 ; i < Vec_PtrSize( vTh ) ; ++i ) {
         tObj = Vec_PtrEntry( vTh , i );
-        fprintf( pFile , ".threshold" );
+        Abc_OstrPutS( pFile , ".threshold" );
         for ( j = 0 ; j < Vec_IntSize( tObj->Fanins ) ; ++j ) {
-           fprintf( pFile , " %d" , Vec_IntEntry( tObj->Fanins , j ) );
+           Abc_OstrPutC( pFile , ' ' );
+           Abc_OstrPutNum( pFile , Vec_IntEntry( tObj->Fanins , j ) );
         }
-        fprintf( pFile , " %d\n" , tObj->Id );
+        Abc_OstrPutC( pFile , ' ' );
+        Abc_OstrPutNum( pFile , tObj->Id );
+        Abc_OstrPutC( pFile , '\n' );
         for ( j = 0 ; j < Vec_IntSize( tObj->weights ) ; ++j ) {
-           fprintf( pFile , "%d " , Vec_IntEntry( tObj->weights , j ) );
+           Abc_OstrPutNum( pFile , Vec_IntEntry( tObj->weights , j ) );
+           Abc_OstrPutC( pFile , ' ' );
         }
-        fprintf( pFile , "%d\n" , tObj->thre );
+        Abc_OstrPutNum( pFile , tObj->thre );
+        Abc_OstrPutC( pFile , '\n' );
     }
 
 	 Vec_PtrFree(vPi);
 	 Vec_PtrFree(vPo);
 	 Vec_PtrFree(vTh);
 
-	 fclose(pFile);
+	 if ( !Abc_OstrStop( pFile ) )
+        printf( "[Error] writing file %s has failed!\n" , name );
 }
 
 
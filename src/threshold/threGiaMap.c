@@ -0,0 +1,773 @@
+/**CFile****************************************************************
+
+  FileName    [threGiaMap.c]
+
+  SystemName  [ABC: Logic synthesis and verification system.]
+
+  PackageName [threshold.]
+
+  Synopsis    [Direct threshold mapping of GIA with priority cuts.]
+
+  Author      [Nian-Ze Lee]
+
+  Affiliation [NTU]
+
+  Date        [Oct 19, 2016.]
+
+  Revision    [$Id: abc.c,v 1.00 2005/06/20 00:00:00 alanmi Exp $]
+
+***********************************************************************/
+
+////////////////////////////////////////////////////////////////////////
+///                          INCLUDES                                ///
+////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <math.h>
+#include "base/abc/abc.h"
+#include "aig/gia/gia.h"
+#include "misc/vec/vecMem.h"
+#include "misc/vec/vecWec.h"
+#include "misc/util/utilTruth.h"
+#include "misc/util/utilPool.h"
+#include "threshold.h"
+
+////////////////////////////////////////////////////////////////////////
+///                        DECLARATIONS                              ///
+////////////////////////////////////////////////////////////////////////
+
+#define TH_MAP_LEAF_MAX   8
+#define TH_MAP_CUT_MAX   16
+#define TH_MAP_WORD_MAX   4  // truth tables are kept in the 8-variable space
+#define TH_MAP_PROC_MAX  32
+
+typedef struct Th_MapCut_t_   Th_MapCut_t;
+typedef struct Th_MapCache_t_ Th_MapCache_t;
+typedef struct Th_MapMan_t_   Th_MapMan_t;
+typedef struct Th_MapThData_t_ Th_MapThData_t;
+
+struct Th_MapCut_t_
+{
+    word            Sign;        // leaf signature
+    float           Flow;        // area flow of the cut
+    int             Cost;        // cost of the gate implementing the cut
+    int             iFunc;       // function entry in the cache (-1 for trivial cut)
+    int             nLeaves;     // number of leaves
+    int             pLeaves[TH_MAP_LEAF_MAX];
+    word            pTruth[TH_MAP_WORD_MAX];
+};
+struct Th_MapCache_t_
+{
+    Vec_Mem_t *     vTtMem[TH_MAP_LEAF_MAX+1]; // truth tables hashed by cut size
+    Vec_Int_t *     vRes[TH_MAP_LEAF_MAX+1];   // (fThresh, T, w0, ..., wn-1) for each truth table
+    word            nHits;       // cache hits
+    word            nMisses;     // cache misses (calls to Extra_ThreshCheckNZ)
+    word            nThresh;     // threshold functions among misses
+};
+struct Th_MapMan_t_
+{
+    Gia_Man_t *     pGia;        // user's AIG
+    Th_MapPar_t *   pPars;       // user's parameters
+    Th_MapCut_t **  ppCuts;      // cut sets of each object (freed when no longer needed)
+    int *           pnCuts;      // the number of cuts of each object
+    int *           pnRefs;      // the number of AND fanouts still to be processed
+    float *         pFlowRefs;   // estimated fanout counts for area flow
+    float *         pFlow;       // area flow of the best cut
+    int *           pBest;       // best cut for each node: nLeaves, leaves, T, weights
+    int             nBestSize;   // entry size in pBest
+    Vec_Wec_t *     vWaves;      // AND nodes grouped by level
+    Th_MapCache_t   pCaches[TH_MAP_PROC_MAX];
+    word            nCutsMerged; // statistics
+    word            nCutsThresh;
+    abctime         clkStart;
+};
+struct Th_MapThData_t_
+{
+    Th_MapMan_t *   pMan;        // mapping manager
+    Th_MapCache_t * pCache;      // thread-local thresholdness cache
+    Vec_Int_t *     vWave;       // current wave
+    int             iStart;      // first node of the wave for this thread
+    int             iStop;       // last node of the wave for this thread (exclusive)
+    word            nMerged;     // statistics
+    word            nThresh;
+    abctime         clkUsed;
+    Th_MapCut_t     pCands[TH_MAP_CUT_MAX * TH_MAP_CUT_MAX + 1];
+};
+
+static inline int * Th_MapObjBest( Th_MapMan_t * p, int i )  { return p->pBest + i * p->nBestSize; }
+
+extern int  Extra_ThreshCheckNZ ( word * , int , int * , int * );
+extern int  Th_InvertFanin      ( int * , int , int * , int );
+
+////////////////////////////////////////////////////////////////////////
+///                     FUNCTION DEFINITIONS                         ///
+////////////////////////////////////////////////////////////////////////
+
+/**Function*************************************************************
+
+  Synopsis    [Sets default parameters of the threshold mapper.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+
+void
+Th_MapSetDefaultPars( Th_MapPar_t * pPars )
+{
+   memset( pPars, 0, sizeof(Th_MapPar_t) );
+   pPars->nLutSize    = 6;
+   pPars->nCutNum     = 8;
+   pPars->nProcNum    = 0;
+   pPars->fWeightCost = 0;
+   pPars->fVerbose    = 0;
+   pPars->nLutSizeMax = TH_MAP_LEAF_MAX;
+   pPars->nCutNumMax  = TH_MAP_CUT_MAX;
+   pPars->nProcNumMax = TH_MAP_PROC_MAX;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Thresholdness cache.]
+
+  Description [Results are stored relative to the cut variable order:
+               entry 0 is 1 if the function is threshold, entry 1 is the
+               threshold and the following entries are the weights of
+               the cut variables (complemented variables get negative
+               weights, as done by Th_InvertFanin() in threCut2Th.c).]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+
+static void
+Th_MapCacheStart( Th_MapCache_t * p, int nLutSize )
+{
+   int i;
+   memset( p, 0, sizeof(Th_MapCache_t) );
+   for ( i = 1; i <= nLutSize; ++i ) {
+      p->vTtMem[i] = Vec_MemAlloc( Abc_TtWordNum(i), 10 );
+      Vec_MemHashAlloc( p->vTtMem[i], 1000 );
+      p->vRes[i]   = Vec_IntAlloc( 1000 * (i + 2) );
+   }
+}
+
+static void
+Th_MapCacheStop( Th_MapCache_t * p )
+{
+   int i;
+   for ( i = 0; i <= TH_MAP_LEAF_MAX; ++i ) {
+      if ( p->vTtMem[i] == NULL ) continue;
+      Vec_MemHashFree( p->vTtMem[i] );
+      Vec_MemFree( p->vTtMem[i] );
+      Vec_IntFree( p->vRes[i] );
+   }
+   memset( p, 0, sizeof(Th_MapCache_t) );
+}
+
+static int *
+Th_MapCacheLookup( Th_MapCache_t * p, word * pTruth, int nVars )
+{
+   word pCopy[TH_MAP_WORD_MAX];
+   int pLeaves[TH_MAP_LEAF_MAX], pWeights[TH_MAP_LEAF_MAX], pRes[TH_MAP_LEAF_MAX+2];
+   int nEntries, iEntry, T, Var, i;
+   assert( nVars >= 1 && nVars <= TH_MAP_LEAF_MAX );
+   nEntries = Vec_MemEntryNum( p->vTtMem[nVars] );
+   iEntry   = Vec_MemHashInsert( p->vTtMem[nVars], pTruth );
+   if ( iEntry < nEntries ) {
+      ++p->nHits;
+      return Vec_IntEntryP( p->vRes[nVars], iEntry * (nVars + 2) );
+   }
+   ++p->nMisses;
+   // leaves are 1-based so that Extra_ThreshCheckNZ() can record polarity by negation
+   for ( i = 0; i < nVars; ++i ) {
+      pLeaves[i]  = i + 1;
+      pWeights[i] = 0;
+   }
+   memset( pRes, 0, sizeof(int) * (nVars + 2) );
+   Abc_TtCopy( pCopy, pTruth, Abc_TtWordNum(nVars), 0 );
+   T = Extra_ThreshCheckNZ( pCopy, nVars, pWeights, pLeaves );
+   if ( T ) {
+      T       = Th_InvertFanin( pLeaves, nVars, pWeights, T );
+      pRes[0] = 1;
+      pRes[1] = T;
+      for ( i = 0; i < nVars; ++i ) {
+         Var = pLeaves[i] - 1;
+         assert( Var >= 0 && Var < nVars );
+         pRes[2 + Var] = pWeights[i];
+      }
+      ++p->nThresh;
+   }
+   for ( i = 0; i < nVars + 2; ++i )
+      Vec_IntPush( p->vRes[nVars], pRes[i] );
+   assert( Vec_IntSize(p->vRes[nVars]) == (iEntry + 1) * (nVars + 2) );
+   return Vec_IntEntryP( p->vRes[nVars], iEntry * (nVars + 2) );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Cut utilities.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+
+static inline word
+Th_MapCutSign( Th_MapCut_t * pCut )
+{
+   word Sign = 0; int i;
+   for ( i = 0; i < pCut->nLeaves; ++i )
+      Sign |= ((word)1) << (pCut->pLeaves[i] & 0x3F);
+   return Sign;
+}
+
+static inline int
+Th_MapCutMergeLeaves( Th_MapCut_t * pCut0, Th_MapCut_t * pCut1, Th_MapCut_t * pCut, int nLutSize )
+{
+   int i = 0, k = 0, c = 0;
+   if ( Abc_TtCountOnes( pCut0->Sign | pCut1->Sign ) > nLutSize )
+      return 0;
+   while ( i < pCut0->nLeaves || k < pCut1->nLeaves ) {
+      if ( c == nLutSize )
+         return 0;
+      if ( k == pCut1->nLeaves || (i < pCut0->nLeaves && pCut0->pLeaves[i] < pCut1->pLeaves[k]) )
+         pCut->pLeaves[c++] = pCut0->pLeaves[i++];
+      else if ( i == pCut0->nLeaves || pCut0->pLeaves[i] > pCut1->pLeaves[k] )
+         pCut->pLeaves[c++] = pCut1->pLeaves[k++];
+      else
+         pCut->pLeaves[c++] = pCut0->pLeaves[i++], k++;
+   }
+   pCut->nLeaves = c;
+   return 1;
+}
+
+static inline int
+Th_MapCutDominates( Th_MapCut_t * pDom, Th_MapCut_t * pCut )
+{
+   int i, k;
+   if ( pDom->nLeaves > pCut->nLeaves || (pDom->Sign & pCut->Sign) != pDom->Sign )
+      return 0;
+   for ( i = k = 0; i < pDom->nLeaves; ++i ) {
+      while ( k < pCut->nLeaves && pCut->pLeaves[k] < pDom->pLeaves[i] ) ++k;
+      if ( k == pCut->nLeaves || pCut->pLeaves[k] != pDom->pLeaves[i] )
+         return 0;
+   }
+   return 1;
+}
+
+static inline int
+Th_MapCutCompare( Th_MapCut_t * pCut0, Th_MapCut_t * pCut1 )
+{
+   if ( pCut0->Flow < pCut1->Flow - 0.001 ) return -1;
+   if ( pCut0->Flow > pCut1->Flow + 0.001 ) return  1;
+   if ( pCut0->nLeaves < pCut1->nLeaves )   return -1;
+   if ( pCut0->nLeaves > pCut1->nLeaves )   return  1;
+   if ( pCut0->Cost < pCut1->Cost )         return -1;
+   if ( pCut0->Cost > pCut1->Cost )         return  1;
+   return memcmp( pCut0->pLeaves, pCut1->pLeaves, sizeof(int) * pCut0->nLeaves );
+}
+
+static inline void
+Th_MapCutSetTrivial( Th_MapCut_t * pCut, int iObj, float Flow )
+{
+   int i;
+   memset( pCut, 0, sizeof(Th_MapCut_t) );
+   pCut->nLeaves    = 1;
+   pCut->pLeaves[0] = iObj;
+   pCut->Sign       = ((word)1) << (iObj & 0x3F);
+   pCut->Flow       = Flow;
+   pCut->iFunc      = -1;
+   for ( i = 0; i < TH_MAP_WORD_MAX; ++i )
+      pCut->pTruth[i] = s_Truths6[0];
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Computes cuts of one AND node.]
+
+  Description [Only depends on the cuts of the fanins, which belong to
+               lower level waves, so nodes of one wave can be processed
+               in any order and by any thread.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+
+static void
+Th_MapNodeCuts( Th_MapMan_t * p, Th_MapThData_t * pTh, int iObj )
+{
+   Gia_Obj_t   * pObj = Gia_ManObj( p->pGia, iObj );
+   Th_MapCut_t * pCuts0, * pCuts1, * pCut0, * pCut1, * pCut, * pRes;
+   word          pTemp[TH_MAP_WORD_MAX];
+   int           iFan0 = Gia_ObjFaninId0( pObj, iObj );
+   int           iFan1 = Gia_ObjFaninId1( pObj, iObj );
+   int           nLutSize = p->pPars->nLutSize;
+   int           i, k, c, nCands, nCuts, nVars, * pFunc, * pBest;
+   pCuts0 = p->ppCuts[iFan0];
+   pCuts1 = p->ppCuts[iFan1];
+   assert( pCuts0 && pCuts1 );
+   nCands = 0;
+   for ( i = 0; i < p->pnCuts[iFan0]; ++i )
+   for ( k = 0; k < p->pnCuts[iFan1]; ++k )
+   {
+      pCut0 = pCuts0 + i;
+      pCut1 = pCuts1 + k;
+      pCut  = pTh->pCands + nCands;
+      if ( !Th_MapCutMergeLeaves( pCut0, pCut1, pCut, nLutSize ) )
+         continue;
+      ++pTh->nMerged;
+      // derive the function in the 8-variable space
+      Abc_TtCopy( pCut->pTruth, pCut0->pTruth, TH_MAP_WORD_MAX, Gia_ObjFaninC0(pObj) );
+      Abc_TtExpand( pCut->pTruth, TH_MAP_LEAF_MAX, pCut0->pLeaves, pCut0->nLeaves, pCut->pLeaves, pCut->nLeaves );
+      Abc_TtCopy( pTemp, pCut1->pTruth, TH_MAP_WORD_MAX, Gia_ObjFaninC1(pObj) );
+      Abc_TtExpand( pTemp, TH_MAP_LEAF_MAX, pCut1->pLeaves, pCut1->nLeaves, pCut->pLeaves, pCut->nLeaves );
+      Abc_TtAnd( pCut->pTruth, pCut->pTruth, pTemp, TH_MAP_WORD_MAX, 0 );
+      Abc_TtMinimumBase( pCut->pTruth, pCut->pLeaves, TH_MAP_LEAF_MAX, &nVars );
+      if ( nVars == 0 ) // constant node, should not happen in a strashed AIG
+         continue;
+      pCut->nLeaves = nVars;
+      pCut->Sign    = Th_MapCutSign( pCut );
+      // skip duplicates and dominated cuts
+      for ( c = 0; c < nCands; ++c )
+         if ( Th_MapCutDominates( pTh->pCands + c, pCut ) )
+            break;
+      if ( c < nCands )
+         continue;
+      // test thresholdness
+      pFunc = Th_MapCacheLookup( pTh->pCache, pCut->pTruth, pCut->nLeaves );
+      if ( !pFunc[0] )
+         continue;
+      ++pTh->nThresh;
+      pCut->iFunc = pFunc - Vec_IntArray( pTh->pCache->vRes[pCut->nLeaves] );
+      pCut->Cost  = 1;
+      if ( p->pPars->fWeightCost ) {
+         pCut->Cost = Abc_AbsInt( pFunc[1] );
+         for ( c = 0; c < pCut->nLeaves; ++c )
+            pCut->Cost += Abc_AbsInt( pFunc[2 + c] );
+      }
+      pCut->Flow = pCut->Cost;
+      for ( c = 0; c < pCut->nLeaves; ++c )
+         pCut->Flow += p->pFlow[pCut->pLeaves[c]] / p->pFlowRefs[pCut->pLeaves[c]];
+      // remove the previous candidates dominated by this one
+      for ( c = k = 0; c < nCands; ++c )
+         if ( !Th_MapCutDominates( pCut, pTh->pCands + c ) )
+            pTh->pCands[k++] = pTh->pCands[c];
+      if ( k < nCands )
+         pTh->pCands[k] = *pCut;
+      nCands = k + 1;
+   }
+   // the fanin cut is always threshold (AND of two literals), so there is a candidate
+   assert( nCands > 0 );
+   // select the best cuts (insertion sort is fine for small sets)
+   for ( i = 1; i < nCands; ++i )
+      for ( k = i; k > 0 && Th_MapCutCompare( pTh->pCands + k, pTh->pCands + k - 1 ) < 0; --k )
+      {
+         Th_MapCut_t Temp   = pTh->pCands[k];
+         pTh->pCands[k]     = pTh->pCands[k - 1];
+         pTh->pCands[k - 1] = Temp;
+      }
+   nCuts = Abc_MinInt( nCands, p->pPars->nCutNum - 1 );
+   // save the best cut in the compact form
+   pCut  = pTh->pCands;
+   pFunc = Vec_IntEntryP( pTh->pCache->vRes[pCut->nLeaves], pCut->iFunc );
+   pBest = Th_MapObjBest( p, iObj );
+   pBest[0] = pCut->nLeaves;
+   pBest[1] = pFunc[1];
+   for ( c = 0; c < pCut->nLeaves; ++c ) {
+      pBest[2 + c]                  = pCut->pLeaves[c];
+      pBest[2 + TH_MAP_LEAF_MAX + c] = pFunc[2 + c];
+   }
+   p->pFlow[iObj] = pCut->Flow;
+   // save the cut set followed by the trivial cut
+   pRes = ABC_ALLOC( Th_MapCut_t, nCuts + 1 );
+   memcpy( pRes, pTh->pCands, sizeof(Th_MapCut_t) * nCuts );
+   Th_MapCutSetTrivial( pRes + nCuts, iObj, pCut->Flow );
+   p->ppCuts[iObj] = pRes;
+   p->pnCuts[iObj] = nCuts + 1;
+}
+
+static void
+Th_MapProcessRange( Th_MapThData_t * pTh )
+{
+   int i;
+   for ( i = pTh->iStart; i < pTh->iStop; ++i )
+      Th_MapNodeCuts( pTh->pMan, pTh, Vec_IntEntry( pTh->vWave, i ) );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Releases the cut sets of the fanins of the last wave.]
+
+  Description [Called by the main thread only.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+
+static void
+Th_MapReleaseFanins( Th_MapMan_t * p, Vec_Int_t * vWave )
+{
+   Gia_Obj_t * pObj;
+   int i, iObj, iFan;
+   Vec_IntForEachEntry( vWave, iObj, i )
+   {
+      pObj = Gia_ManObj( p->pGia, iObj );
+      iFan = Gia_ObjFaninId0( pObj, iObj );
+      if ( --p->pnRefs[iFan] == 0 ) ABC_FREE( p->ppCuts[iFan] );
+      iFan = Gia_ObjFaninId1( pObj, iObj );
+      if ( --p->pnRefs[iFan] == 0 ) ABC_FREE( p->ppCuts[iFan] );
+   }
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Processes level waves in parallel.]
+
+  Description [The main thread splits each wave evenly into pool tasks
+               and waits for them to finish before starting the next
+               wave.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+
+static void *
+Th_MapWorkerTask( void * pArg , Abc_Task_t * pTask )
+{
+   Th_MapThData_t * pTh = (Th_MapThData_t *)pArg;
+   abctime clk = Abc_Clock();
+   Th_MapProcessRange( pTh );
+   pTh->clkUsed += Abc_Clock() - clk;
+   return NULL;
+}
+
+static void
+Th_MapComputeWavesPar( Th_MapMan_t * p, Th_MapThData_t * pThData )
+{
+   Abc_Task_t * pTasks[TH_MAP_PROC_MAX];
+   Vec_Int_t * vWave;
+   int nProcs = p->pPars->nProcNum;
+   int i, w, nPerThread;
+   Vec_WecForEachLevel( p->vWaves, vWave, w )
+   {
+      if ( Vec_IntSize(vWave) == 0 )
+         continue;
+      nPerThread = (Vec_IntSize(vWave) + nProcs - 1) / nProcs;
+      for ( i = 0; i < nProcs; ++i )
+      {
+         pThData[i].vWave  = vWave;
+         pThData[i].iStart = Abc_MinInt( i * nPerThread, Vec_IntSize(vWave) );
+         pThData[i].iStop  = Abc_MinInt( (i + 1) * nPerThread, Vec_IntSize(vWave) );
+         pTasks[i] = NULL;
+         if ( pThData[i].iStart < pThData[i].iStop )
+            pTasks[i] = Abc_TaskSubmit( Th_MapWorkerTask, pThData + i );
+      }
+      for ( i = 0; i < nProcs; ++i )
+         if ( pTasks[i] )
+            Abc_TaskWait( pTasks[i] );
+      Th_MapReleaseFanins( p, vWave );
+   }
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Computes cuts and best threshold cuts for all nodes.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+
+static void
+Th_MapComputeCuts( Th_MapMan_t * p )
+{
+   Th_MapThData_t * pThData;
+   Vec_Int_t * vWave;
+   Gia_Obj_t * pObj;
+   int nThreads = Abc_MaxInt( 1, p->pPars->nProcNum );
+   int i, w;
+   pThData = ABC_CALLOC( Th_MapThData_t, nThreads );
+   for ( i = 0; i < nThreads; ++i )
+   {
+      Th_MapCacheStart( p->pCaches + i, p->pPars->nLutSize );
+      pThData[i].pMan   = p;
+      pThData[i].pCache = p->pCaches + i;
+   }
+   // constant and CIs have trivial cuts only
+   Gia_ManForEachCi( p->pGia, pObj, i )
+   {
+      int iObj = Gia_ObjId( p->pGia, pObj );
+      p->ppCuts[iObj] = ABC_ALLOC( Th_MapCut_t, 1 );
+      p->pnCuts[iObj] = 1;
+      Th_MapCutSetTrivial( p->ppCuts[iObj], iObj, 0 );
+   }
+   p->ppCuts[0] = ABC_ALLOC( Th_MapCut_t, 1 );
+   p->pnCuts[0] = 1;
+   Th_MapCutSetTrivial( p->ppCuts[0], 0, 0 );
+   if ( p->pPars->nProcNum > 0 )
+      Th_MapComputeWavesPar( p, pThData );
+   else
+   {
+      Vec_WecForEachLevel( p->vWaves, vWave, w )
+      {
+         pThData->vWave  = vWave;
+         pThData->iStart = 0;
+         pThData->iStop  = Vec_IntSize(vWave);
+         Th_MapProcessRange( pThData );
+         Th_MapReleaseFanins( p, vWave );
+      }
+   }
+   for ( i = 0; i < nThreads; ++i )
+   {
+      p->nCutsMerged += pThData[i].nMerged;
+      p->nCutsThresh += pThData[i].nThresh;
+   }
+   if ( p->pPars->fVerbose && p->pPars->nProcNum > 0 )
+      for ( i = 0; i < nThreads; ++i )
+      {
+         printf( "Thread %d : ", i );
+         Abc_PrintTime( 1, "Time", pThData[i].clkUsed );
+      }
+   ABC_FREE( pThData );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Manager.]
+
+  Description []
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+
+static Th_MapMan_t *
+Th_MapManStart( Gia_Man_t * pGia, Th_MapPar_t * pPars )
+{
+   Th_MapMan_t * p;
+   Gia_Obj_t * pObj;
+   int i, nObjs = Gia_ManObjNum( pGia );
+   p = ABC_CALLOC( Th_MapMan_t, 1 );
+   p->clkStart  = Abc_Clock();
+   p->pGia      = pGia;
+   p->pPars     = pPars;
+   p->ppCuts    = ABC_CALLOC( Th_MapCut_t *, nObjs );
+   p->pnCuts    = ABC_CALLOC( int, nObjs );
+   p->pnRefs    = ABC_CALLOC( int, nObjs );
+   p->pFlowRefs = ABC_ALLOC( float, nObjs );
+   p->pFlow     = ABC_CALLOC( float, nObjs );
+   p->nBestSize = 2 + 2 * TH_MAP_LEAF_MAX;
+   p->pBest     = ABC_CALLOC( int, nObjs * p->nBestSize );
+   // AND fanouts count when releasing cuts; all fanouts count for area flow
+   ABC_FREE( pGia->pRefs );
+   Gia_ManCreateRefs( pGia );
+   Gia_ManForEachAnd( pGia, pObj, i )
+   {
+      p->pnRefs[Gia_ObjFaninId0(pObj, i)]++;
+      p->pnRefs[Gia_ObjFaninId1(pObj, i)]++;
+   }
+   for ( i = 0; i < nObjs; ++i )
+      p->pFlowRefs[i] = (float)Abc_MaxInt( 1, Gia_ObjRefNumId(pGia, i) );
+   // group nodes into level waves
+   Gia_ManLevelNum( pGia );
+   p->vWaves = Vec_WecStart( Gia_ManLevelNum(pGia) + 1 );
+   Gia_ManForEachAnd( pGia, pObj, i )
+      Vec_WecPush( p->vWaves, Gia_ObjLevelId(pGia, i), i );
+   return p;
+}
+
+static void
+Th_MapManStop( Th_MapMan_t * p )
+{
+   int i;
+   for ( i = 0; i < Gia_ManObjNum(p->pGia); ++i )
+      ABC_FREE( p->ppCuts[i] );
+   for ( i = 0; i < TH_MAP_PROC_MAX; ++i )
+      Th_MapCacheStop( p->pCaches + i );
+   Vec_WecFree( p->vWaves );
+   ABC_FREE( p->pGia->pRefs );
+   ABC_FREE( p->ppCuts );
+   ABC_FREE( p->pnCuts );
+   ABC_FREE( p->pnRefs );
+   ABC_FREE( p->pFlowRefs );
+   ABC_FREE( p->pFlow );
+   ABC_FREE( p->pBest );
+   ABC_FREE( p );
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Derives the threshold network from the best cuts.]
+
+  Description [Object order follows cut2Th(): CONST1, PIs, POs, gates.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+
+static Vec_Ptr_t *
+Th_MapDeriveNtk( Th_MapMan_t * p )
+{
+   Vec_Ptr_t * vTList;
+   Vec_Int_t * vMap, * vStack;
+   Thre_S    * tObj, * tObjFanin;
+   Gia_Obj_t * pObj;
+   int i, k, iObj, iLeaf, * pBest;
+   int nGates = 0, nEdges = 0, nWeight = 0, nLevels = 0, * pLevels;
+   vTList  = Vec_PtrAlloc( Gia_ManCiNum(p->pGia) + Gia_ManCoNum(p->pGia) + 1000 );
+   vMap    = Vec_IntStartFull( Gia_ManObjNum(p->pGia) );
+   vStack  = Vec_IntAlloc( 1000 );
+   pLevels = ABC_CALLOC( int, Gia_ManObjNum(p->pGia) );
+   // mark the nodes used in the cover
+   Gia_ManIncrementTravId( p->pGia );
+   Gia_ManForEachCo( p->pGia, pObj, i )
+      Vec_IntPush( vStack, Gia_ObjFaninId0p(p->pGia, pObj) );
+   while ( Vec_IntSize(vStack) )
+   {
+      iObj = Vec_IntPop( vStack );
+      pObj = Gia_ManObj( p->pGia, iObj );
+      if ( !Gia_ObjIsAnd(pObj) || Gia_ObjIsTravIdCurrent(p->pGia, pObj) )
+         continue;
+      Gia_ObjSetTravIdCurrent( p->pGia, pObj );
+      pBest = Th_MapObjBest( p, iObj );
+      for ( k = 0; k < pBest[0]; ++k )
+         Vec_IntPush( vStack, pBest[2 + k] );
+   }
+   // create objects
+   tObj = Th_CreateObj( vTList, Th_CONST1 );
+   Vec_IntWriteEntry( vMap, 0, tObj->Id );
+   Gia_ManForEachCi( p->pGia, pObj, i )
+   {
+      tObj = Th_CreateObj( vTList, Th_Pi );
+      Vec_IntWriteEntry( vMap, Gia_ObjId(p->pGia, pObj), tObj->Id );
+   }
+   Gia_ManForEachCo( p->pGia, pObj, i )
+      Th_CreateObj( vTList, Th_Po );
+   Gia_ManForEachAnd( p->pGia, pObj, i )
+   {
+      if ( !Gia_ObjIsTravIdCurrent(p->pGia, pObj) )
+         continue;
+      tObj = Th_CreateObj( vTList, Th_Node );
+      Vec_IntWriteEntry( vMap, i, tObj->Id );
+   }
+   // connect gates
+   Gia_ManForEachAnd( p->pGia, pObj, i )
+   {
+      if ( !Gia_ObjIsTravIdCurrent(p->pGia, pObj) )
+         continue;
+      tObj  = Th_GetObjById( vTList, Vec_IntEntry(vMap, i) );
+      pBest = Th_MapObjBest( p, i );
+      tObj->thre = pBest[1];
+      nWeight += Abc_AbsInt( pBest[1] );
+      for ( k = 0; k < pBest[0]; ++k )
+      {
+         iLeaf = pBest[2 + k];
+         assert( Vec_IntEntry(vMap, iLeaf) >= 0 );
+         pLevels[i] = Abc_MaxInt( pLevels[i], pLevels[iLeaf] + 1 );
+         // constant-0 leaves never contribute to the weighted sum
+         if ( iLeaf == 0 || pBest[2 + TH_MAP_LEAF_MAX + k] == 0 )
+            continue;
+         tObjFanin = Th_GetObjById( vTList, Vec_IntEntry(vMap, iLeaf) );
+         Vec_IntPush( tObj->Fanins      , tObjFanin->Id );
+         Vec_IntPush( tObj->weights     , pBest[2 + TH_MAP_LEAF_MAX + k] );
+         Vec_IntPush( tObjFanin->Fanouts, tObj->Id );
+         nWeight += Abc_AbsInt( pBest[2 + TH_MAP_LEAF_MAX + k] );
+         ++nEdges;
+      }
+      ++nGates;
+   }
+   // connect POs (complemented PO drivers use weight -1 as in cut2Th())
+   // GIA constant is constant-0 while the threshold network has CONST1
+   Gia_ManForEachCo( p->pGia, pObj, i )
+   {
+      int fCompl = Gia_ObjFaninC0(pObj) ^ (Gia_ObjFaninId0p(p->pGia, pObj) == 0);
+      tObj      = Th_GetObjById( vTList, 1 + Gia_ManCiNum(p->pGia) + i );
+      tObjFanin = Th_GetObjById( vTList, Vec_IntEntry(vMap, Gia_ObjFaninId0p(p->pGia, pObj)) );
+      Vec_IntPush( tObj->Fanins      , tObjFanin->Id );
+      Vec_IntPush( tObjFanin->Fanouts, tObj->Id );
+      tObj->thre = fCompl ? 0 : 1;
+      Vec_IntPush( tObj->weights, fCompl ? -1 : 1 );
+      nLevels = Abc_MaxInt( nLevels, pLevels[Gia_ObjFaninId0p(p->pGia, pObj)] );
+   }
+   printf( "Gates = %d  Edges = %d  Weights = %d  Levels = %d  ", nGates, nEdges, nWeight, nLevels );
+   Abc_PrintTime( 1, "Time", Abc_Clock() - p->clkStart );
+   ABC_FREE( pLevels );
+   Vec_IntFree( vStack );
+   Vec_IntFree( vMap );
+   return vTList;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Maps the AIG into a threshold network.]
+
+  Description [Enumerates priority cuts in level waves, keeps only the
+               cuts whose functions are threshold and selects the cover
+               minimizing the area flow of the gate count (or the sum of
+               absolute weights and thresholds with fWeightCost).]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+
+Vec_Ptr_t *
+Th_MapGia( Gia_Man_t * pGia, Th_MapPar_t * pPars )
+{
+   Th_MapMan_t * p;
+   Vec_Ptr_t * vTList;
+   int i;
+   assert( pPars->nLutSize >= 2 && pPars->nLutSize <= TH_MAP_LEAF_MAX );
+   assert( pPars->nCutNum  >= 2 && pPars->nCutNum  <= TH_MAP_CUT_MAX  );
+   assert( pPars->nProcNum >= 0 && pPars->nProcNum <= TH_MAP_PROC_MAX );
+   p = Th_MapManStart( pGia, pPars );
+   if ( pPars->fVerbose )
+   {
+      printf( "Aig: CI = %d  CO = %d  AND = %d  Level = %d    ", Gia_ManCiNum(pGia), Gia_ManCoNum(pGia), Gia_ManAndNum(pGia), Vec_WecSize(p->vWaves) - 1 );
+      printf( "CutSize = %d  CutNum = %d  Threads = %d\n", pPars->nLutSize, pPars->nCutNum, pPars->nProcNum );
+   }
+   Th_MapComputeCuts( p );
+   if ( pPars->fVerbose )
+   {
+      word nHits = 0, nMisses = 0, nThresh = 0;
+      for ( i = 0; i < TH_MAP_PROC_MAX; ++i )
+      {
+         nHits   += p->pCaches[i].nHits;
+         nMisses += p->pCaches[i].nMisses;
+         nThresh += p->pCaches[i].nThresh;
+      }
+      printf( "Merged = %lu  Thresh = %lu  Cache: Hits = %lu  Misses = %lu (thresh %lu)  ",
+         (unsigned long)p->nCutsMerged, (unsigned long)p->nCutsThresh, (unsigned long)nHits, (unsigned long)nMisses, (unsigned long)nThresh );
+      Abc_PrintTime( 1, "Time", Abc_Clock() - p->clkStart );
+   }
+   vTList = Th_MapDeriveNtk( p );
+   Th_MapManStop( p );
+   return vTList;
+}
+
+////////////////////////////////////////////////////////////////////////
+///                       END OF FILE                                ///
+////////////////////////////////////////////////////////////////////////
@@ -24,6 +24,7 @@
 
 #include <stdio.h>
 #include <math.h>
+#include <limits.h>
 #include "base/abc/abc.h"
 #include "map/if/if.h"
 #include "map/if/ifCount.h"
@@ -45,13 +46,15 @@ extern int        Th_ObjIsConst               ( const Thre_S * );
 extern Thre_S*    Th_GetObjById               ( Vec_Ptr_t * , int );
 extern int        Th_Check2FoutCollapse       ( const Thre_S * , const Thre_S * , int );
 extern int        Th_CheckMultiFoutCollapse   ( const Thre_S * , int );
+extern int        Th_CheckPairCollapse        ( const Thre_S * , const Thre_S * , int );
 extern int        Th_ObjFanoutFaninNum        ( const Thre_S * , const Thre_S * );
+extern int        Th_ClpMarkBlocked;
 // main functions
 void       Th_CollapseNtk         ( Vec_Ptr_t * , int , int );
 // main helper functions for collapse
 int        Th_CollapseNodes       ( const Thre_S * , int , int );
 int        Th_CalKLCollapse       ( const Thre_S * );
-void       Th_CollapsePair        ( const Thre_S * , const Thre_S * , int );
+int        Th_CollapsePair        ( const Thre_S * , const Thre_S * , int );
 Pair_S*    Th_CalKL               ( const Thre_S * , const Thre_S * , int , int , int );
 Thre_S*    Th_KLCollapse          ( const Thre_S * , const Thre_S * , const Pair_S * , int , int );
 Thre_S*    Th_KLCreateClpObj      ( const Thre_S * , const Thre_S * , const Pair_S * , int , int );
@@ -78,6 +81,23 @@ int        Th_NtkMaxFanout        ();
 void       Th_NtkDfs              ();
 void       Th_NtkDfs_rec          ( Thre_S * , Vec_Ptr_t * );
 void       Th_NtkDfsUpdateId      ( Vec_Int_t * );
+// non-collapsible node cache
+static void Th_ClpCacheStart      ();
+static void Th_ClpCacheStop       ();
+static void Th_ClpTouchFanins     ( int );
+static void Th_ClpTouchFanouts    ( int );
+static void Th_ClpRecordFail      ( const Thre_S * );
+static int  Th_ClpFailIsValid     ( const Thre_S * , int );
+
+// The cache remembers nodes that were found non-collapsible (black) and
+// keeps them black across the passes of Th_CollapseNtk() until the node,
+// one of its fanins, or one of the fanouts of its fanins changes.
+// Two version stamps are kept for each node ID, bumped when collapsing
+// rewires the fanins or the fanouts of the node, respectively.
+static Vec_Int_t * s_vClpFinVer  = NULL; // the last change of the fanins of each node
+static Vec_Int_t * s_vClpFoutVer = NULL; // the last change of the fanouts of each node
+static Vec_Int_t * s_vClpFail    = NULL; // the version at which the node was found black
+static int         s_nClpVer     = 0;    // the current version
 
 /**Function*************************************************************
 
@@ -304,26 +324,27 @@ Th_InvertObj( const Thre_S * tObj )
    return tObjInvert;
 }
 
+// the sums are accumulated in 64 bits and saturated to the int range
 int 
 MaxF(Vec_Int_t * weights , int nFanin )
 {
-	int Entry , i , sum;
-	sum = 0;
+	ABC_INT64_T sum = 0;
+	int Entry , i;
 
    Vec_IntForEachEntry( weights , Entry , i )
       if ( i != nFanin && Entry > 0 ) sum += Entry;
-	return sum;
+	return sum > INT_MAX ? INT_MAX : (int)sum;
 }
 
 int 
 MinF(Vec_Int_t * weights , int nFanin )
 {
-	int Entry , i , sum;
-	sum = 0;
+	ABC_INT64_T sum = 0;
+	int Entry , i;
 
    Vec_IntForEachEntry( weights , Entry , i )
       if ( i != nFanin && Entry < 0 ) sum += Entry;
-	return sum;
+	return sum < INT_MIN ? INT_MIN : (int)sum;
 }
 
 void 
@@ -474,6 +495,7 @@ Th_KLCollapse( const Thre_S * tObj1 , const Thre_S * tObj2 , const Pair_S * pair
 	Thre_S * tObjMerge;
 
 	tObjMerge = Th_KLCreateClpObj( tObj1 , tObj2 , pair , w , fInvert );
+	if ( tObjMerge == NULL ) return NULL;
    Th_KLPatchFanio( tObj1 , tObj2 , tObjMerge );
 	return tObjMerge;
 }
@@ -482,34 +504,18 @@ Thre_S*
 Th_KLCreateClpObj( const Thre_S * tObj1 , const Thre_S * tObj2 , 
 		             const Pair_S * pair , int w , int fInvert )
 {
-	Thre_S * tObjMerge;
-	int T1 , T2 , fMark , Entry , i;
+	Thre_S    * tObjMerge;
+	Th_Pack_t * pMerge;
+	int RetValue , Entry , i;
    
-	T1 = tObj1->thre;
-	T2 = (fInvert) ? (tObj2->thre + w) : (tObj2->thre);
-
+	// merged threshold , weights and fanins (checked in Th_KLClpCheck())
+	pMerge    = Th_PackMerge( tObj1 , tObj2 , pair , w , fInvert );
+	if ( pMerge == NULL ) return NULL; // overflow; the network is not changed
 	tObjMerge = Th_CreateObj( current_TList , Th_Node );
-	tObjMerge->thre = pair->IntK * T1 + pair->IntL * (T2 - w);
-	// set merged weights and fanins , tObj1 part
-	Vec_IntForEachEntry( tObj1->weights , Entry , i )
-		Vec_IntPush( tObjMerge->weights , pair->IntK * Entry );
-	Vec_IntForEachEntry( tObj1->Fanins , Entry , i )
-		Vec_IntPush( tObjMerge->Fanins , Entry );
-
-	// set merged weights and fanins , tObj2 part , take care of joint fanins
-	Vec_IntForEachEntry( tObj2->Fanins , Entry , i )
-	{
-		if ( Entry == tObj1->Id ) continue;
-      fMark = Th_ObjIsFanin( tObj1 , Entry );
-		if ( fMark > -1 ) { // joint fanin , sum weights up
-		   Vec_IntWriteEntry( tObjMerge->weights , fMark , Vec_IntEntry( tObjMerge->weights , fMark ) + 
-					                                          pair->IntL * Vec_IntEntry( tObj2->weights , i ));
-		}
-		else {
-			Vec_IntPush( tObjMerge->weights , pair->IntL * Vec_IntEntry( tObj2->weights , i ) );
-         Vec_IntPush( tObjMerge->Fanins  , Entry );
-		}
-   }
+	Th_ClpTouchFanins( tObjMerge->Id );
+	RetValue  = Th_PackToObj( pMerge , tObjMerge );
+	assert( RetValue ); // the weights are bounded in Th_KLClpCheck()
+	ABC_FREE( pMerge );
 	// connect fanouts , tObjMerge part
 	Vec_IntForEachEntry( tObj2->Fanouts , Entry , i )
 		Vec_IntPush( tObjMerge->Fanouts , Entry );
@@ -540,6 +546,7 @@ Th_KLPatchFanio( const Thre_S * tObj1 , const Thre_S * tObj2 , const Thre_S * tO
 	   assert(tObjFanout);
 		// Unmark a node if some of its fanins are merged
 		if ( tObjFanout->nId == globalRef ) --(tObjFanout->nId);
+		Th_ClpTouchFanins( tObjFanout->Id );
 	   nFanin = Th_ObjFanoutFaninNum( tObj2 , tObjFanout );
 	   Vec_IntWriteEntry( tObjFanout->Fanins , nFanin , tObjMerge->Id );
 	   assert( Vec_IntSize(tObjFanout->Fanins) == Vec_IntSize(tObjFanout->weights) );
@@ -551,6 +558,7 @@ Th_KLPatchFanio( const Thre_S * tObj1 , const Thre_S * tObj2 , const Thre_S * tO
 	   assert(tObjFanin);
 		Vec_IntRemove( tObjFanin->Fanouts , tObj1->Id );
 		Vec_IntPush  ( tObjFanin->Fanouts , tObjMerge->Id );
+		Th_ClpTouchFanouts( tObjFanin->Id );
 	}
 	// connect fanouts , tObj2 fanin part 
 	Vec_IntForEachEntry( tObj2->Fanins , Entry , i )
@@ -560,6 +568,7 @@ Th_KLPatchFanio( const Thre_S * tObj1 , const Thre_S * tObj2 , const Thre_S * tO
 	   assert(tObjFanin);
 		Vec_IntRemove( tObjFanin->Fanouts , tObj2->Id );
 		Vec_IntPushUnique  ( tObjFanin->Fanouts , tObjMerge->Id );
+		Th_ClpTouchFanouts( tObjFanin->Id );
 	}
 	assert( Vec_IntSize(tObjMerge->Fanins) == Vec_IntSize(tObjMerge->weights) );
 }
@@ -568,7 +577,10 @@ Th_KLPatchFanio( const Thre_S * tObj1 , const Thre_S * tObj2 , const Thre_S * tO
 
   Synopsis    [Th_CalKLCollapse(interface); Th_CollapsePair(internal).]
 
-  Description [Multi-fanout : tObj1 can be collapsed to all its fanouts.]
+  Description [Multi-fanout : tObj1 can be collapsed to all its fanouts.
+               All pairs are checked before the network is changed, so 
+               that the candidate is skipped (returns 0) if one of the 
+               merged gates does not fit.]
                
   SideEffects []
 
@@ -580,19 +592,25 @@ int
 Th_CalKLCollapse( const Thre_S * tObj1 )
 {
 	Thre_S * tObj2;
-	int nFanin , Entry , i;
+	int nFanin , Entry , i , RetValue;
    Vec_IntForEachEntry( tObj1->Fanouts , Entry , i )
 	{
       tObj2  = Th_GetObjById( current_TList , Entry );
 		assert( tObj2 && tObj2->Type == Th_Node );
 	   nFanin = Th_ObjFanoutFaninNum( tObj1 , tObj2 );
-		assert( Th_CheckPairCollapse( tObj1 , tObj2 , nFanin ) );
-		Th_CollapsePair( tObj1 , tObj2 , nFanin );
+		if ( !Th_CheckPairCollapse( tObj1 , tObj2 , nFanin ) ) return 0;
+	}
+   Vec_IntForEachEntry( tObj1->Fanouts , Entry , i )
+	{
+      tObj2  = Th_GetObjById( current_TList , Entry );
+	   nFanin = Th_ObjFanoutFaninNum( tObj1 , tObj2 );
+		RetValue = Th_CollapsePair( tObj1 , tObj2 , nFanin );
+		assert( RetValue ); // checked above
 	}
 	return 1;
 }
 
-void
+int
 Th_CollapsePair( const Thre_S * tObj1 , const Thre_S * tObj2 , int nFanin )
 {
 	Pair_S * pair;
@@ -617,6 +635,7 @@ Th_CollapsePair( const Thre_S * tObj1 , const Thre_S * tObj2 , int nFanin )
    if ( fInvert ) Th_DeleteObjNoInsert( tObj1 ); // delete the inverted object created in this function
 	ABC_FREE(pair);
 	if (tObjMerge) assert( Vec_IntSize(tObjMerge->Fanins) == Vec_IntSize(tObjMerge->weights) );
+	return tObjMerge != NULL;
 }
 
 /**Function*************************************************************
@@ -639,6 +658,7 @@ Th_CollapseNtk( Vec_Ptr_t * TList , int fIterative , int fOutBound )
 	
 	//printf( "Th_CollapseNtk() : fIterative = %d\n" , fIterative );
 	//printf( "Th_CollapseNtk() : fOutBound  = %d\n" , fOutBound  );
+   Th_ClpCacheStart();
    do {
 	   Th_UnmarkAllNode();
       sizeBeforeIter = Vec_PtrSize( TList );
@@ -650,8 +670,13 @@ Th_CollapseNtk( Vec_Ptr_t * TList , int fIterative , int fOutBound )
             if ( !tObj )                    continue; // NULL  node
             if ( tObj->Type != Th_Node )    continue; // PI/PO/CONST
             if ( tObj->nId == globalRef )   continue; // black node : those who have nId = 1
+            if ( Th_ClpFailIsValid(tObj, fOutBound) ) {          // black in an earlier pass and unchanged since
+               tObj->nId = globalRef;
+               continue;
+            }
 			   if ( !Th_ObjNormalCheck(tObj) ) continue; // Abnormal node : const or 0-weight, collect and clean
                
+            Th_ClpMarkBlocked = 0;
 		      Vec_IntForEachEntry( tObj->Fanins , FinId , j )
 			   {
                if ( Th_CollapseNodes( tObj , j , fOutBound ) ) {
@@ -661,13 +686,17 @@ Th_CollapseNtk( Vec_Ptr_t * TList , int fIterative , int fOutBound )
                }
                //printf("(%d) cannot be merged.\n", tObj->Id);
                // non-mergable node-> color = black
-               if ( j == Vec_IntSize( tObj->Fanins ) - 1 ) tObj->nId = globalRef;
+               if ( j == Vec_IntSize( tObj->Fanins ) - 1 ) {
+                  tObj->nId = globalRef;
+                  Th_ClpRecordFail( tObj );
+               }
             }
             //printf("%d / %d\n", i, sizeBeforeMerge);
          } 
          if ( sizeBeforeCollapse == Vec_PtrSize(TList) ) break;
       }
 	} while ( fIterative && Vec_PtrSize( TList ) > sizeBeforeIter );
+   Th_ClpCacheStop();
     
 	//printf("merging process completed...\n");
 }
@@ -691,6 +720,80 @@ Th_DeleteClpObj( Thre_S * tObj2 , int nFanin )
    Th_DeleteNode( tObj1 );
 }
 
+/**Function*************************************************************
+
+  Synopsis    [Non-collapsible node cache.]
+
+  Description [A black mark is reused only if it was not caused by the
+               black mark of another node in the same pass (see
+               Th_ClpMarkBlocked), since those are reset in every pass.]
+               
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+
+static void
+Th_ClpCacheStart()
+{
+	assert( s_vClpFail == NULL );
+	s_vClpFinVer  = Vec_IntStart( Vec_PtrSize(current_TList) );
+	s_vClpFoutVer = Vec_IntStart( Vec_PtrSize(current_TList) );
+	s_vClpFail    = Vec_IntStart( Vec_PtrSize(current_TList) );
+	s_nClpVer     = 1;
+}
+
+static void
+Th_ClpCacheStop()
+{
+	Vec_IntFreeP( &s_vClpFinVer );
+	Vec_IntFreeP( &s_vClpFoutVer );
+	Vec_IntFreeP( &s_vClpFail );
+}
+
+static void
+Th_ClpTouchFanins( int Id )
+{
+	if ( s_vClpFail ) Vec_IntSetEntry( s_vClpFinVer , Id , ++s_nClpVer );
+}
+
+static void
+Th_ClpTouchFanouts( int Id )
+{
+	if ( s_vClpFail ) Vec_IntSetEntry( s_vClpFoutVer , Id , ++s_nClpVer );
+}
+
+static void
+Th_ClpRecordFail( const Thre_S * tObj )
+{
+	if ( !Th_ClpMarkBlocked )
+		Vec_IntSetEntry( s_vClpFail , tObj->Id , s_nClpVer );
+}
+
+static int
+Th_ClpFailIsValid( const Thre_S * tObj , int fOutBound )
+{
+	Thre_S * tObjFin;
+	int Stamp , FinId , FoutId , i , k;
+	Stamp = Vec_IntGetEntry( s_vClpFail , tObj->Id );
+	if ( Stamp == 0 || Vec_IntGetEntry( s_vClpFinVer , tObj->Id ) > Stamp )
+		return 0;
+	Vec_IntForEachEntry( tObj->Fanins , FinId , i )
+	{
+		if ( Vec_IntGetEntry( s_vClpFinVer , FinId ) > Stamp || Vec_IntGetEntry( s_vClpFoutVer , FinId ) > Stamp )
+			return 0;
+		tObjFin = Th_GetObjById( current_TList , FinId );
+		// fanins that cannot be collapsed regardless of their fanouts
+		if ( tObjFin->Type != Th_Node || (fOutBound != -1 && Vec_IntSize(tObjFin->Fanouts) > fOutBound) )
+			continue;
+		Vec_IntForEachEntry( tObjFin->Fanouts , FoutId , k )
+			if ( FoutId != tObj->Id && Vec_IntGetEntry( s_vClpFinVer , FoutId ) > Stamp )
+				return 0;
+	}
+	return 1;
+}
+
 int
 Th_NtkMaxFanout()
 {
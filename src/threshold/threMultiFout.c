@@ -40,6 +40,7 @@
 
 // extern functions
 extern  Thre_S* Th_GetObjById       ( Vec_Ptr_t * , int );
+extern  Pair_S* Th_CalKLIf          ( const Thre_S * , const Thre_S * , int , int , int );
 // main functions
 int     Th_Check2FoutCollapse       ( const Thre_S * , const Thre_S * , int );
 int     Th_CheckMultiFoutCollapse   ( const Thre_S * , int );
@@ -49,6 +50,9 @@ int     Th_ObjFanoutFaninNum        ( const Thre_S * , const Thre_S * );
 int     Th_CheckPairCollapse        ( const Thre_S * , const Thre_S * , int );
 int     Th_KLClpCheck               ( const Thre_S * , const Thre_S * , const Pair_S * , int , int );
 
+// set when a collapse is rejected because of a black fanout (not structural)
+int     Th_ClpMarkBlocked = 0;
+
 ////////////////////////////////////////////////////////////////////////
 ///                     FUNCTION DEFINITIONS                         ///
 ////////////////////////////////////////////////////////////////////////
@@ -150,48 +154,18 @@ Th_CheckPairCollapse( const Thre_S * tObj1 , const Thre_S * tObj2 , int nFanin )
 int 
 Th_KLClpCheck( const Thre_S * tObj1 , const Thre_S * tObj2 , const Pair_S * pair , int w , int fInvert )
 {	
-	Thre_S * tObjMerge;
-	int T1 , T2 , fMark , Entry , i , limit;
+	Th_Pack_t * pMerge;
+	int RetValue , i , limit;
    
-	limit = 255;
-	T1    = tObj1->thre;
-	T2    = (fInvert) ? (tObj2->thre + w) : (tObj2->thre);
-
-	tObjMerge = Th_CreateObjNoInsert( Th_Node );
-	tObjMerge->thre = pair->IntK * T1 + pair->IntL * (T2 - w);
-	if ( tObjMerge->thre > limit || tObjMerge->thre < -limit ) {
-	   Th_DeleteObjNoInsert( tObjMerge );
-		return 0;
-	}
-	// set merged weights and fanins , tObj1 part
-	Vec_IntForEachEntry( tObj1->weights , Entry , i )
-		Vec_IntPush( tObjMerge->weights , pair->IntK * Entry );
-	Vec_IntForEachEntry( tObj1->Fanins , Entry , i )
-		Vec_IntPush( tObjMerge->Fanins , Entry );
-
-	// set merged weights and fanins , tObj2 part , take care of joint fanins
-	Vec_IntForEachEntry( tObj2->Fanins , Entry , i )
-	{
-		if ( Entry == tObj1->Id ) continue;
-      fMark = Th_ObjIsFanin( tObj1 , Entry );
-		if ( fMark > -1 ) { // joint fanin , sum weights up
-		   Vec_IntWriteEntry( tObjMerge->weights , fMark , Vec_IntEntry( tObjMerge->weights , fMark ) + 
-					                                          pair->IntL * Vec_IntEntry( tObj2->weights , i ));
-		}
-		else {
-			Vec_IntPush( tObjMerge->weights , pair->IntL * Vec_IntEntry( tObj2->weights , i ) );
-         Vec_IntPush( tObjMerge->Fanins  , Entry );
-		}
-   }
-	Vec_IntForEachEntry( tObjMerge->weights , Entry , i )
-	{
-	   if ( Entry > limit || Entry < -limit ) {
-	      Th_DeleteObjNoInsert( tObjMerge );
-		   return 0;
-		}
-	}
-	Th_DeleteObjNoInsert( tObjMerge );
-	return 1;
+	limit    = 255;
+	pMerge   = Th_PackMerge( tObj1 , tObj2 , pair , w , fInvert );
+	if ( pMerge == NULL ) return 0; // overflow
+	RetValue = ( pMerge->thre <= limit && pMerge->thre >= -limit );
+	for ( i = 0 ; RetValue && i < pMerge->nFanins ; ++i )
+	   if ( Th_PackWeight( pMerge , i ) > limit || Th_PackWeight( pMerge , i ) < -limit )
+		   RetValue = 0;
+	ABC_FREE( pMerge );
+	return RetValue;
 }
 
 /**Function*************************************************************
@@ -225,6 +199,7 @@ Th_CheckMultiFoutCollapse( const Thre_S * tObj1 , int fOutBound )
 	   nFanin = Th_ObjFanoutFaninNum( tObj1 , tObj2 );
 	   assert( nFanin >=0 && nFanin < Vec_IntSize(tObj2->Fanins) );
 		if ( tObj2->nId == globalRef || tObj2->Type != Th_Node || !Th_CheckPairCollapse(tObj1 , tObj2 , nFanin) ) {
+		   if ( tObj2->nId == globalRef ) Th_ClpMarkBlocked = 1;
 		   RetValue = 0;
 			break;
 		}
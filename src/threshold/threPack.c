@@ -0,0 +1,238 @@
+/**CFile****************************************************************
+
+  FileName    [threPack.c]
+
+  SystemName  [ABC: Logic synthesis and verification system.]
+
+  PackageName [threshold.]
+
+  Synopsis    [Packed gates and overflow-safe merge kernels.]
+
+  Author      [Nian-Ze Lee]
+
+  Affiliation [NTU]
+
+  Date        [May 11, 2016.]
+
+  Revision    [$Id: abc.c,v 1.00 2005/06/20 00:00:00 alanmi Exp $]
+
+***********************************************************************/
+
+////////////////////////////////////////////////////////////////////////
+///                          INCLUDES                                ///
+////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include "base/abc/abc.h"
+#include "threshold.h"
+
+////////////////////////////////////////////////////////////////////////
+///                        DECLARATIONS                              ///
+////////////////////////////////////////////////////////////////////////
+
+// extern functions
+extern int        Th_ObjIsFanin          ( const Thre_S * , int );
+// helper functions
+static void       Th_PackNarrow          ( Th_Pack_t * );
+
+////////////////////////////////////////////////////////////////////////
+///                     FUNCTION DEFINITIONS                         ///
+////////////////////////////////////////////////////////////////////////
+
+/**Function*************************************************************
+
+  Synopsis    [Allocates the packed gate.]
+
+  Description [Weights are 16-bit unless fWide is set.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+
+Th_Pack_t*
+Th_PackAlloc( int nFanins , int fWide )
+{
+   Th_Pack_t * p = (Th_Pack_t *)ABC_ALLOC( char , Th_PackSize( nFanins , fWide ) );
+   p->nFanins = nFanins;
+   p->fWide   = fWide;
+   p->thre    = 0;
+   return p;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Converts 64-bit weights into 16-bit weights if they fit.]
+
+  Description [Done in place: the 16-bit array starts where the 64-bit
+               array starts and is shorter, so the memory is reused.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+
+static void
+Th_PackNarrow( Th_Pack_t * p )
+{
+   ABC_INT64_T * pW64 = Th_PackWeights64( p );
+   short * pW16;
+   int i;
+   assert( p->fWide );
+   for ( i = 0 ; i < p->nFanins ; ++i )
+      if ( !Th_Fits16( pW64[i] ) ) return;
+   pW16 = Th_PackWeights16( p );
+   for ( i = 0 ; i < p->nFanins ; ++i )
+      pW16[i] = (short)pW64[i];
+   p->fWide = 0;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Conversion between Thre_S and the packed gate.]
+
+  Description [Th_PackToObj() overwrites weights and threshold of tObj
+               and fanins if they differ in size; returns 0 if some
+               value does not fit into int.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+
+Th_Pack_t*
+Th_PackFromObj( const Thre_S * tObj )
+{
+   Th_Pack_t * p;
+   int Entry , i , fWide = 0;
+   Vec_IntForEachEntry( tObj->weights , Entry , i )
+      if ( !Th_Fits16( Entry ) ) { fWide = 1; break; }
+   p = Th_PackAlloc( Vec_IntSize(tObj->Fanins) , fWide );
+   p->thre = tObj->thre;
+   memcpy( p->pFanins , Vec_IntArray(tObj->Fanins) , sizeof(int) * p->nFanins );
+   Vec_IntForEachEntry( tObj->weights , Entry , i )
+      if ( fWide ) Th_PackWeights64(p)[i] = Entry;
+      else         Th_PackWeights16(p)[i] = (short)Entry;
+   return p;
+}
+
+int
+Th_PackToObj( Th_Pack_t * p , Thre_S * tObj )
+{
+   int i;
+   if ( !Th_FitsInt( p->thre ) ) return 0;
+   for ( i = 0 ; i < p->nFanins ; ++i )
+      if ( !Th_FitsInt( Th_PackWeight( p , i ) ) ) return 0;
+   tObj->thre = (int)p->thre;
+   Vec_IntClear( tObj->Fanins );
+   Vec_IntClear( tObj->weights );
+   for ( i = 0 ; i < p->nFanins ; ++i )
+   {
+      Vec_IntPush( tObj->Fanins  , p->pFanins[i] );
+      Vec_IntPush( tObj->weights , (int)Th_PackWeight( p , i ) );
+   }
+   return 1;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Sums of positive/negative weights except the nFanin-th.]
+
+  Description [Same as MaxF()/MinF() on the packed gate.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+
+ABC_INT64_T
+Th_PackMaxF( Th_Pack_t * p , int nFanin , int * pfOver )
+{
+   ABC_INT64_T Entry , sum = 0;
+   int i;
+   for ( i = 0 ; i < p->nFanins ; ++i )
+      if ( i != nFanin && (Entry = Th_PackWeight( p , i )) > 0 )
+         sum = Th_AddCheck( sum , Entry , pfOver );
+   return sum;
+}
+
+ABC_INT64_T
+Th_PackMinF( Th_Pack_t * p , int nFanin , int * pfOver )
+{
+   ABC_INT64_T Entry , sum = 0;
+   int i;
+   for ( i = 0 ; i < p->nFanins ; ++i )
+      if ( i != nFanin && (Entry = Th_PackWeight( p , i )) < 0 )
+         sum = Th_AddCheck( sum , Entry , pfOver );
+   return sum;
+}
+
+/**Function*************************************************************
+
+  Synopsis    [Computes the gate obtained by collapsing tObj1 into tObj2.]
+
+  Description [Threshold is K*T1 + L*(T2-w), weights of tObj1 are scaled
+               by K and those of tObj2 by L; weights of joint fanins are
+               added. Fanin order is that of Th_KLCreateClpObj(). The
+               arithmetic is 64-bit and checked; returns NULL on
+               overflow. Weights are packed into 16 bits if they fit.]
+
+  SideEffects []
+
+  SeeAlso     []
+
+***********************************************************************/
+
+Th_Pack_t*
+Th_PackMerge( const Thre_S * tObj1 , const Thre_S * tObj2 , const Pair_S * pair , int w , int fInvert )
+{
+   Th_Pack_t   * p;
+   ABC_INT64_T * pW64;
+   int nFanins , fMark , fOver = 0 , Entry , i;
+   ABC_INT64_T T2 = (ABC_INT64_T)tObj2->thre + (fInvert ? w : 0);
+
+   // count fanins
+   nFanins = Vec_IntSize( tObj1->Fanins );
+   Vec_IntForEachEntry( tObj2->Fanins , Entry , i )
+      if ( Entry != tObj1->Id && Th_ObjIsFanin( tObj1 , Entry ) == -1 )
+         ++nFanins;
+   p    = Th_PackAlloc( nFanins , 1 );
+   pW64 = Th_PackWeights64( p );
+
+   p->thre = Th_AddCheck( Th_MulCheck( pair->IntK , tObj1->thre , &fOver ) ,
+                          Th_MulCheck( pair->IntL , T2 - w , &fOver ) , &fOver );
+   // tObj1 part
+   nFanins = 0;
+   Vec_IntForEachEntry( tObj1->weights , Entry , i )
+   {
+      p->pFanins[nFanins] = Vec_IntEntry( tObj1->Fanins , i );
+      pW64[nFanins++]     = Th_MulCheck( pair->IntK , Entry , &fOver );
+   }
+   // tObj2 part , take care of joint fanins
+   Vec_IntForEachEntry( tObj2->Fanins , Entry , i )
+   {
+      if ( Entry == tObj1->Id ) continue;
+      fMark = Th_ObjIsFanin( tObj1 , Entry );
+      if ( fMark > -1 ) // joint fanin , sum weights up
+         pW64[fMark] = Th_AddCheck( pW64[fMark] , Th_MulCheck( pair->IntL , Vec_IntEntry(tObj2->weights, i) , &fOver ) , &fOver );
+      else {
+         p->pFanins[nFanins] = Entry;
+         pW64[nFanins++]     = Th_MulCheck( pair->IntL , Vec_IntEntry(tObj2->weights, i) , &fOver );
+      }
+   }
+   assert( nFanins == p->nFanins );
+   if ( fOver ) {
+      ABC_FREE( p );
+      return NULL;
+   }
+   Th_PackNarrow( p );
+   return p;
+}
+
+////////////////////////////////////////////////////////////////////////
+///                       END OF FILE                                ///
+////////////////////////////////////////////////////////////////////////
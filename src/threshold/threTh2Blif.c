@@ -47,19 +47,19 @@ extern int      Thre_LocalMin              (Thre_S * , int );
 
 // main function
 void   Th_WriteBlif            ( Vec_Ptr_t * thre_list , const char * );
-void   Th_WriteBlifInput       ( FILE * , Vec_Ptr_t * );
-void   Th_WriteBlifOutput      ( FILE * , Vec_Ptr_t * );
-void   Th_WriteBlifName        ( FILE * , Vec_Ptr_t * );
-void   Th_WriteBlifOneName     ( FILE * , Thre_S * );
-void   Th_ObjBuildSop          ( FILE * , Thre_S * , Vec_Str_t * , int , int );
-void   Th_StrOnFinalize        ( Vec_Str_t * , int );
+void   Th_WriteBlifInput       ( Abc_Ostr_t * , Vec_Ptr_t * );
+void   Th_WriteBlifOutput      ( Abc_Ostr_t * , Vec_Ptr_t * );
+void   Th_WriteBlifName        ( Abc_Ostr_t * , Vec_Ptr_t * );
+void   Th_WriteBlifOneName     ( Abc_Ostr_t * , Thre_S * );
+void   Th_ObjBuildSop          ( Abc_Ostr_t * , Thre_S * , Vec_Str_t * , int , int );
+void   Th_StrOnFinalize        ( Abc_Ostr_t * , Vec_Str_t * , int );
 
 
 /**Function*************************************************************
 
   Synopsis    [Main function to write threshold ntk as blif.]
 
-  Description []
+  Description [The file is gzip-compressed if its name ends in ".gz".]
                
   SideEffects []
 
@@ -70,14 +70,18 @@ void   Th_StrOnFinalize        ( Vec_Str_t * , int );
 void
 Th_WriteBlif( Vec_Ptr_t * thre_list , const char * name )
 {
-	FILE * out;
+	Abc_Ostr_t * out;
 	Vec_Ptr_t * vPi , * vPo , * vTh;
 	Thre_S * tObj;
 	int i;
 
 	printf( "Write out threshold network as blif file...\n" );
 	
-	out = fopen( name , "w" );
+	out = Abc_OstrStart( (char *)name , 0 );
+	if ( out == NULL ) {
+		printf( "[Error] cannot open file %s for writing!\n" , name );
+		return;
+	}
 	vPi = Vec_PtrAlloc( 100 );
 	vPo = Vec_PtrAlloc( 100 );
 	vTh = Vec_PtrAlloc( 100 );
@@ -90,57 +94,63 @@ Th_WriteBlif( Vec_Ptr_t * thre_list , const char * name )
       else if ( tObj-> Type == Th_Node )  Vec_PtrPush( vTh , tObj );
 	}
 
-   fprintf( out , ".model %s\n" , name );
+   Abc_OstrPutS( out , ".model " ); Abc_OstrPutS( out , name ); Abc_OstrPutC( out , '\n' );
 	Th_WriteBlifInput     ( out , vPi );
 	Th_WriteBlifOutput    ( out , vPo );
 	Th_WriteBlifName      ( out , vTh );
-   fprintf( out , ".end\n" );
+   Abc_OstrPutS( out , ".end\n" );
 	
 	Vec_PtrFree(vPi);
 	Vec_PtrFree(vPo);
 	Vec_PtrFree(vTh);
-	fclose( out );
+	if ( !Abc_OstrStop( out ) )
+		printf( "[Error] writing file %s has failed!\n" , name );
 }
 
 void 
-Th_WriteBlifInput( FILE * out , Vec_Ptr_t * vPi )
+Th_WriteBlifInput( Abc_Ostr_t * out , Vec_Ptr_t * vPi )
 {
 	Thre_S * tObj;
 	int i;
 
 	Vec_PtrForEachEntry( Thre_S * , vPi , tObj , i )
-		fprintf( out , ".inputs %d\n" , tObj->Id );
+	{
+		Abc_OstrPutS( out , ".inputs " ); Abc_OstrPutNum( out , tObj->Id ); Abc_OstrPutC( out , '\n' );
+	}
 }
 
 void 
-Th_WriteBlifOutput( FILE * out , Vec_Ptr_t * vPo )
+Th_WriteBlifOutput( Abc_Ostr_t * out , Vec_Ptr_t * vPo )
 {
 	Thre_S * tObj;
 	int i;
 
 	Vec_PtrForEachEntry( Thre_S * , vPo , tObj , i )
-		fprintf( out , ".outputs %d\n" , tObj->Id );
+	{
+		Abc_OstrPutS( out , ".outputs " ); Abc_OstrPutNum( out , tObj->Id ); Abc_OstrPutC( out , '\n' );
+	}
 	
 	Vec_PtrForEachEntry( Thre_S * , vPo , tObj , i )
 	{
       if ( Vec_IntEntry( tObj->Fanins , 0 ) == 0 ) {
 			//printf( "[Warning] constant output!\n" );
-			fprintf( out , ".names %d\n" , tObj->Id );
-			if ( tObj->thre == 1 ) fprintf( out , " 1\n" );
-			else if ( tObj->thre == 0 )  fprintf( out , " 0\n" );
+			Abc_OstrPutS( out , ".names " ); Abc_OstrPutNum( out , tObj->Id ); Abc_OstrPutC( out , '\n' );
+			if ( tObj->thre == 1 ) Abc_OstrPutS( out , " 1\n" );
+			else if ( tObj->thre == 0 )  Abc_OstrPutS( out , " 0\n" );
 			else printf( "[Error] wrong output threshold!\n" );
 		}
 		else {
-			fprintf( out , ".names %d %d\n" , Vec_IntEntry( tObj->Fanins , 0 ) , tObj->Id );
-			if ( tObj->thre == 1 )       fprintf( out , "1 1\n" );
-			else if ( tObj->thre == 0 )  fprintf( out , "0 1\n" );
+			Abc_OstrPutS( out , ".names " ); Abc_OstrPutNum( out , Vec_IntEntry( tObj->Fanins , 0 ) );
+			Abc_OstrPutC( out , ' ' ); Abc_OstrPutNum( out , tObj->Id ); Abc_OstrPutC( out , '\n' );
+			if ( tObj->thre == 1 )       Abc_OstrPutS( out , "1 1\n" );
+			else if ( tObj->thre == 0 )  Abc_OstrPutS( out , "0 1\n" );
 			else printf( "[Error] wrong output threshold!\n" );
 		}
 	}
 }
 
 void 
-Th_WriteBlifName( FILE * out , Vec_Ptr_t * vTh )
+Th_WriteBlifName( Abc_Ostr_t * out , Vec_Ptr_t * vTh )
 {
 	Thre_S * tObj;
 	int i;
@@ -162,7 +172,7 @@ Th_WriteBlifName( FILE * out , Vec_Ptr_t * vTh )
 ***********************************************************************/
 
 void
-Th_WriteBlifOneName( FILE * out , Thre_S * tObj )
+Th_WriteBlifOneName( Abc_Ostr_t * out , Thre_S * tObj )
 {
 	Vec_Str_t * Sop;
 	Thre_S * tObjSort;
@@ -172,9 +182,9 @@ Th_WriteBlifOneName( FILE * out , Thre_S * tObj )
    //tObjSort = slow_sortByWeights( tObj );
    tObjSort = slow_sortByAbsWeights( tObj );
 
-	fprintf( out , ".names" );
-   Vec_IntForEachEntry( tObjSort->Fanins , Entry , i ) fprintf( out , " %d" , Entry );
-	fprintf( out , " %d\n" , tObjSort->Id );
+	Abc_OstrPutS( out , ".names" );
+   Vec_IntForEachEntry( tObjSort->Fanins , Entry , i ) { Abc_OstrPutC( out , ' ' ); Abc_OstrPutNum( out , Entry ); }
+	Abc_OstrPutC( out , ' ' ); Abc_OstrPutNum( out , tObjSort->Id ); Abc_OstrPutC( out , '\n' );
 
    Vec_StrClear( Sop );
    Th_ObjBuildSop( out , tObjSort , Sop , tObjSort->thre , 0 );
@@ -183,59 +193,52 @@ Th_WriteBlifOneName( FILE * out , Thre_S * tObj )
 }
 
 void
-Th_ObjBuildSop( FILE * out , Thre_S * tObj , Vec_Str_t * Sop , int thre , int lvl )
+Th_ObjBuildSop( Abc_Ostr_t * out , Thre_S * tObj , Vec_Str_t * Sop , int thre , int lvl )
 {
    assert( lvl < Vec_IntSize( tObj->Fanins ) );
 
-	Vec_Str_t * posSop , * negSop;
-	int curW , maxF , minF , posT , negT;
-
-	posSop = Vec_StrDup( Sop );
-   Vec_StrPrintNum( posSop , 1 ); 
-	negSop = Vec_StrDup( Sop );
-   Vec_StrPrintNum( negSop , 0 ); 
+	int nPrefix , curW , maxF , minF , posT , negT;
 
+   // the cube prefix is extended in place and restored after each cofactor
+	nPrefix = Vec_StrSize( Sop );
 	curW  = Vec_IntEntry( tObj->weights , lvl );
    maxF  = Thre_LocalMax( tObj , lvl );
    minF  = Thre_LocalMin( tObj , lvl );
 
+   Vec_StrPush( Sop , '1' );
 	posT = thre - curW;
    if ( posT <= minF ) {
       // on-set
-		Th_StrOnFinalize( posSop , Vec_IntSize( tObj->Fanins )-lvl-1 );
-      fprintf( out , "%s\n" , posSop->pArray );
+		Th_StrOnFinalize( out , Sop , Vec_IntSize( tObj->Fanins )-lvl-1 );
    }
    else if ( maxF < posT ) {
       // off-set : do nothing
    }
-   else Th_ObjBuildSop( out , tObj , posSop , posT , lvl+1 );
+   else Th_ObjBuildSop( out , tObj , Sop , posT , lvl+1 );
+   Vec_StrShrink( Sop , nPrefix );
    
+   Vec_StrPush( Sop , '0' );
 	negT = thre;
    if ( negT <= minF ) {
       // on-set
-		Th_StrOnFinalize( negSop , Vec_IntSize( tObj->Fanins )-lvl-1 );
-      fprintf( out , "%s\n" , negSop->pArray );
+		Th_StrOnFinalize( out , Sop , Vec_IntSize( tObj->Fanins )-lvl-1 );
    }
    else if ( maxF < negT ) {
       // off-set : do nothing
    }
-   else Th_ObjBuildSop( out , tObj , negSop , negT , lvl+1 );
-    
-	Vec_StrFree( posSop );
-   Vec_StrFree( negSop );
+   else Th_ObjBuildSop( out , tObj , Sop , negT , lvl+1 );
+   Vec_StrShrink( Sop , nPrefix );
 }
 
 void
-Th_StrOnFinalize( Vec_Str_t * Sop , int numDc )
+Th_StrOnFinalize( Abc_Ostr_t * out , Vec_Str_t * Sop , int numDc )
 {
 	int i;
 
+   Abc_OstrPutBuf( out , Vec_StrArray( Sop ) , Vec_StrSize( Sop ) );
 	for ( i = 0 ; i < numDc ; ++i ) 
-      Vec_StrAppend( Sop , "-" );
-	
-	Vec_StrAppend   ( Sop , " " );
-   Vec_StrPrintNum ( Sop , 1 );
-   Vec_StrPush     ( Sop , '\0');
+      Abc_OstrPutC( out , '-' );
+   Abc_OstrPutS( out , " 1\n" );
 }
 
 ////////////////////////////////////////////////////////////////////////
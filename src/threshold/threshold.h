@@ -24,6 +24,9 @@
 ////////////////////////////////////////////////////////////////////////
 
 #include "base/abc/abc.h"
+#include "aig/gia/gia.h"
+#include "misc/util/utilStream.h"
+#include "threApi.h"
 #include "stdio.h"
 #include <math.h>
 
@@ -47,6 +50,7 @@ typedef struct Thre_S_       Thre_S;
 typedef struct Pair_S_       Pair_S;
 typedef struct Th_Stat_      Th_Stat;
 typedef struct Th_Set_       Th_Set;
+typedef struct Th_Pack_t_    Th_Pack_t;
 
 struct Thre_S_
 {
@@ -90,6 +94,17 @@ struct Th_Stat_
   int redund[50];
 };
 
+// packed gate : fanin IDs and weights in one memory block
+// weights take 16 bits and the gate is promoted to 64-bit weights
+// only if some weight does not fit, so typical gates fit in a cache line
+struct Th_Pack_t_
+{
+  int          nFanins;
+  int          fWide;      // weights are stored as ABC_INT64_T
+  ABC_INT64_T  thre;
+  int          pFanins[0]; // followed by the weights
+};
+
 // for extraction
 struct Th_Set_
 {
@@ -115,6 +130,45 @@ int nPi;
 int nPo;
 int nThres;
 
+////////////////////////////////////////////////////////////////////////
+///                      MACRO DEFINITIONS                           ///
+////////////////////////////////////////////////////////////////////////
+
+// writes the prefix followed by the zero-terminated name kept in vName
+static inline void Th_OstrPutName( Abc_Ostr_t * p, const char * pPrefix, Vec_Str_t * vName )
+{
+  Abc_OstrPutS( p, pPrefix );
+  Abc_OstrPutBuf( p, Vec_StrArray(vName), Vec_StrSize(vName) - 1 );
+}
+
+// packed gate access
+static inline int           Th_PackSize( int nFanins, int fWide )    { return sizeof(Th_Pack_t) + sizeof(int) * (nFanins + (nFanins & 1)) + nFanins * (fWide ? sizeof(ABC_INT64_T) : sizeof(short)); }
+static inline short *       Th_PackWeights16( Th_Pack_t * p )        { return (short *)(p->pFanins + p->nFanins + (p->nFanins & 1));         }
+static inline ABC_INT64_T * Th_PackWeights64( Th_Pack_t * p )        { return (ABC_INT64_T *)(p->pFanins + p->nFanins + (p->nFanins & 1));   }
+static inline ABC_INT64_T   Th_PackWeight( Th_Pack_t * p, int i )    { return p->fWide ? Th_PackWeights64(p)[i] : (ABC_INT64_T)Th_PackWeights16(p)[i]; }
+
+// checked 64-bit arithmetic (sets *pfOver and returns 0 on overflow)
+#define TH_INT64_MAX ((ABC_INT64_T)(~(ABC_UINT64_T)0 >> 1))
+#define TH_INT64_MIN (-TH_INT64_MAX - 1)
+static inline int Th_Fits16( ABC_INT64_T a )  { return a >= -32768 && a <= 32767;         }
+static inline int Th_FitsInt( ABC_INT64_T a ) { return a >= -2147483647-1 && a <= 2147483647; }
+static inline ABC_INT64_T Th_AddCheck( ABC_INT64_T a, ABC_INT64_T b, int * pfOver )
+{
+  if ( (b > 0 && a > TH_INT64_MAX - b) || (b < 0 && a < TH_INT64_MIN - b) )
+    { *pfOver = 1; return 0; }
+  return a + b;
+}
+static inline ABC_INT64_T Th_MulCheck( ABC_INT64_T a, ABC_INT64_T b, int * pfOver )
+{
+  ABC_INT64_T r;
+  if ( a == 0 || b == 0 )
+    return 0;
+  r = (ABC_INT64_T)((ABC_UINT64_T)a * (ABC_UINT64_T)b);
+  if ( (a == -1 && b == TH_INT64_MIN) || (b == -1 && a == TH_INT64_MIN) || r / b != a )
+    { *pfOver = 1; return 0; }
+  return r;
+}
+
 ////////////////////////////////////////////////////////////////////////
 ///                    FUNCTION DECLARATIONS                         ///
 ////////////////////////////////////////////////////////////////////////
@@ -132,9 +186,9 @@ extern void         dumpTh2FileNZ(Vec_Ptr_t * , char*);
 //===threEC.c===================================//
 
 extern void        func_EC_writePB(Abc_Ntk_t *, Vec_Ptr_t *, char*);
-extern Vec_Ptr_t*  thre_PB(FILE*, Vec_Ptr_t *);
-extern Vec_Ptr_t*  alan_PB(FILE*, Abc_Ntk_t *);
-extern void        miter_PB(FILE*, Vec_Ptr_t*, Vec_Ptr_t *);
+extern Vec_Ptr_t*  thre_PB(Abc_Ostr_t*, Vec_Ptr_t *);
+extern Vec_Ptr_t*  alan_PB(Abc_Ostr_t*, Abc_Ntk_t *);
+extern void        miter_PB(Abc_Ostr_t*, Vec_Ptr_t*, Vec_Ptr_t *);
 extern int         Max_Thre(Thre_S *);
 extern int         min_Thre(Thre_S *);
 
@@ -168,6 +222,15 @@ extern void       Th_DumpMergeObj        ( const Thre_S * , const Thre_S * , con
 extern void       mergeThreNtk_Iter      ( Vec_Ptr_t * , int );
 extern void       deleteNode             ( Vec_Ptr_t * , Thre_S * );
 
+//===threPack.c===================================//
+
+extern Th_Pack_t* Th_PackAlloc          ( int , int );
+extern Th_Pack_t* Th_PackFromObj        ( const Thre_S * );
+extern int        Th_PackToObj          ( Th_Pack_t * , Thre_S * );
+extern ABC_INT64_T Th_PackMaxF          ( Th_Pack_t * , int , int * );
+extern ABC_INT64_T Th_PackMinF          ( Th_Pack_t * , int , int * );
+extern Th_Pack_t* Th_PackMerge          ( const Thre_S * , const Thre_S * , const Pair_S * , int , int );
+
 //===threStat.c===================================//
 
 extern void       Th_PrintStat          ( Vec_Ptr_t * );
@@ -200,6 +263,10 @@ extern void       func_CNF_compareTH    ( Vec_Ptr_t * , Vec_Ptr_t * );
 extern void       Th_CollapseNtk         ( Vec_Ptr_t * , int , int );
 extern void       Th_NtkDfs              ();
 
+//===threGiaMap.c===================================//
+
+extern Vec_Ptr_t* Th_MapGia              ( Gia_Man_t * , Th_MapPar_t * );
+
 //===threTh2Blif.c===================================//
 
 extern void       Th_WriteBlif           ( Vec_Ptr_t * thre_list , const char * );
@@ -14,28 +14,33 @@ Compare two threNtk, PB
 
 
 void       func_EC_compareTH( Vec_Ptr_t*, Vec_Ptr_t*);
-Vec_Ptr_t* thre1_PB( FILE*, Vec_Ptr_t *);
-Vec_Ptr_t* thre2_PB( FILE*, Vec_Ptr_t *);
-void       comp_miter_PB(FILE*, Vec_Ptr_t*, Vec_Ptr_t*);
+Vec_Ptr_t* thre1_PB( Abc_Ostr_t*, Vec_Ptr_t *);
+Vec_Ptr_t* thre2_PB( Abc_Ostr_t*, Vec_Ptr_t *);
+void       comp_miter_PB(Abc_Ostr_t*, Vec_Ptr_t*, Vec_Ptr_t*);
 ///////////////////////////////
 
 void func_EC_compareTH( Vec_Ptr_t * tList_1, Vec_Ptr_t * tList_2 )
 {
     char* fileName = "compTH.opb";
-    FILE* oFile = fopen(fileName, "w");
+    Abc_Ostr_t* oFile = Abc_OstrStart(fileName, 0);
+    if ( oFile == NULL ){
+        printf("\tERROR: cannot open output file %s\n", fileName);
+        return;
+    }
     printf("\tchecking Equalivance of cut_TList and current_TList...\n");
     printf("\tOutputFile: %s\n", fileName);
-    fprintf(oFile, "min: -1*Z;\n");
+    Abc_OstrPutS(oFile, "min: -1*Z;\n");
     Vec_Ptr_t* thPO_1  = thre1_PB(oFile, tList_1);
     Vec_Ptr_t* thPO_2  = thre2_PB(oFile, tList_2);
     comp_miter_PB(oFile, thPO_1, thPO_2);
     
     Vec_PtrFree(thPO_1);
     Vec_PtrFree(thPO_2);
-    fclose(oFile);
+    if ( !Abc_OstrStop(oFile) )
+        printf("\tERROR: writing file %s has failed\n", fileName);
 }
 //////////////////////////////////////////////////////////////////
-void comp_miter_PB(FILE* oFile, Vec_Ptr_t *th1, Vec_Ptr_t * th2){
+void comp_miter_PB(Abc_Ostr_t* oFile, Vec_Ptr_t *th1, Vec_Ptr_t * th2){
     // VAR naming:
     // th1_PO  : O1_<id>
     // th2_PO  : O2_<id>
@@ -70,25 +75,21 @@ void comp_miter_PB(FILE* oFile, Vec_Ptr_t *th1, Vec_Ptr_t * th2){
         Vec_StrPrintNum(sMit, i);
         Vec_StrPush(sMit, '\0');
 
-        fprintf(oFile, "+1*%s -1*%s +1*%s >= 0;\n", 
-               sTh1->pArray, sTh2->pArray, sMit->pArray);
-        fprintf(oFile, "+1*%s +1*%s -1*%s >= 0;\n", 
-               sTh1->pArray, sTh2->pArray, sMit->pArray);
-        fprintf(oFile, "+1*%s -1*%s -1*%s <= 0;\n", 
-               sTh1->pArray, sTh2->pArray, sMit->pArray);
-        fprintf(oFile, "+1*%s +1*%s +1*%s <= 2;\n", 
-               sTh1->pArray, sTh2->pArray, sMit->pArray);
+        Th_OstrPutName(oFile, "+1*", sTh1); Th_OstrPutName(oFile, " -1*", sTh2); Th_OstrPutName(oFile, " +1*", sMit); Abc_OstrPutS(oFile, " >= 0;\n");
+        Th_OstrPutName(oFile, "+1*", sTh1); Th_OstrPutName(oFile, " +1*", sTh2); Th_OstrPutName(oFile, " -1*", sMit); Abc_OstrPutS(oFile, " >= 0;\n");
+        Th_OstrPutName(oFile, "+1*", sTh1); Th_OstrPutName(oFile, " -1*", sTh2); Th_OstrPutName(oFile, " -1*", sMit); Abc_OstrPutS(oFile, " <= 0;\n");
+        Th_OstrPutName(oFile, "+1*", sTh1); Th_OstrPutName(oFile, " +1*", sTh2); Th_OstrPutName(oFile, " +1*", sMit); Abc_OstrPutS(oFile, " <= 2;\n");
     }
     Vec_StrPrintStr(sOR, "+1*M_0");
-    fprintf(oFile, "-1*M_0 +1*Z >= 0;\n");
+    Abc_OstrPutS(oFile, "-1*M_0 +1*Z >= 0;\n");
     for( i = 1; i < Vec_PtrSize(th1); i++){
         Vec_StrAppend(sOR, " +1*M_");
         Vec_StrPrintNum(sOR, i);
-        fprintf(oFile, "-1*M_%d +1*Z >= 0;\n", i);
+        Abc_OstrPutS(oFile, "-1*M_"); Abc_OstrPutNum(oFile, i); Abc_OstrPutS(oFile, " +1*Z >= 0;\n");
     }
     Vec_StrAppend(sOR, " -1*Z >= 0;\n");
     Vec_StrPush(sOR, '\0');
-    fprintf(oFile, sOR->pArray);
+    Abc_OstrPutS(oFile, sOR->pArray);
     
     printf("\tdone\n");
     Vec_StrFree(sTh1);
@@ -99,7 +100,7 @@ void comp_miter_PB(FILE* oFile, Vec_Ptr_t *th1, Vec_Ptr_t * th2){
 
 //////////////////////////////////////////////////////////////////
 
-Vec_Ptr_t* thre1_PB(FILE* oFile, Vec_Ptr_t *thList){
+Vec_Ptr_t* thre1_PB(Abc_Ostr_t* oFile, Vec_Ptr_t *thList){
     Vec_Ptr_t * thPOList = Vec_PtrAlloc(10);
     /* Reminder:
      * Con1: (M-T+1)y - sigma_N ( wixi ) >= 1-T
@@ -199,7 +200,8 @@ Vec_Ptr_t* thre1_PB(FILE* oFile, Vec_Ptr_t *thList){
         Vec_StrAppend(sCon2, ";\n");
         Vec_StrPush(sCon2, '\0');
 
-        fprintf(oFile, "%s%s",sCon1->pArray ,sCon2->pArray);
+        Abc_OstrPutBuf(oFile, Vec_StrArray(sCon1), Vec_StrSize(sCon1)-1);
+        Abc_OstrPutBuf(oFile, Vec_StrArray(sCon2), Vec_StrSize(sCon2)-1);
     }
     Vec_StrFree( sNode );
     Vec_StrFree( sFin  );
@@ -208,7 +210,7 @@ Vec_Ptr_t* thre1_PB(FILE* oFile, Vec_Ptr_t *thList){
     return thPOList;
 }
 
-Vec_Ptr_t* thre2_PB(FILE* oFile, Vec_Ptr_t *thList){
+Vec_Ptr_t* thre2_PB(Abc_Ostr_t* oFile, Vec_Ptr_t *thList){
     Vec_Ptr_t * thPOList = Vec_PtrAlloc(10);
     /* Reminder:
      * Con1: (M-T+1)y - sigma_N ( wixi ) >= 1-T
@@ -308,7 +310,8 @@ Vec_Ptr_t* thre2_PB(FILE* oFile, Vec_Ptr_t *thList){
         Vec_StrAppend(sCon2, ";\n");
         Vec_StrPush(sCon2, '\0');
 
-        fprintf(oFile, "%s%s",sCon1->pArray ,sCon2->pArray);
+        Abc_OstrPutBuf(oFile, Vec_StrArray(sCon1), Vec_StrSize(sCon1)-1);
+        Abc_OstrPutBuf(oFile, Vec_StrArray(sCon2), Vec_StrSize(sCon2)-1);
     }
     Vec_StrFree( sNode );
     Vec_StrFree( sFin  );
@@ -322,12 +325,18 @@ Compare two threNtk, CNF
 *************************************************************/
 
 void       func_CNF_compareTH(Vec_Ptr_t*, Vec_Ptr_t*);
-Vec_Ptr_t* thre1_CNF( FILE*, Vec_Ptr_t *);
-Vec_Ptr_t* thre2_CNF( FILE*, Vec_Ptr_t *);
-void       comp_miter_CNF(FILE*, Vec_Ptr_t*, Vec_Ptr_t*);
+Vec_Ptr_t* thre1_CNF( Abc_Ostr_t*, Vec_Ptr_t *);
+Vec_Ptr_t* thre2_CNF( Abc_Ostr_t*, Vec_Ptr_t *);
+void       comp_miter_CNF(Abc_Ostr_t*, Vec_Ptr_t*, Vec_Ptr_t*);
 /////
-void       Recurrsive_TH1(FILE*, Thre_S*, Vec_Str_t*, int, int);
-void       Recurrsive_TH2(FILE*, Vec_Ptr_t*, Thre_S*, Vec_Str_t*, int, int);
+void       Recurrsive_TH1(Abc_Ostr_t*, Thre_S*, Vec_Str_t*, int, int);
+void       Recurrsive_TH2(Abc_Ostr_t*, Vec_Ptr_t*, Thre_S*, Vec_Str_t*, int, int);
+extern void       Recurrsive_CNF(Abc_Ostr_t*, Thre_S*, Vec_Str_t*, int, int);
+extern void       my_Vec_StrPrintNum(Vec_Str_t *, int);
+extern Thre_S*    slow_sortByAbsWeights(Thre_S *);
+extern void       delete_sortedNode(Thre_S *);
+extern int        Thre_LocalMax(Thre_S *, int);
+extern int        Thre_LocalMin(Thre_S *, int);
 /////
 
 ///////////////////////////////////////////////////////
@@ -335,20 +344,25 @@ void       Recurrsive_TH2(FILE*, Vec_Ptr_t*, Thre_S*, Vec_Str_t*, int, int);
 void func_CNF_compareTH( Vec_Ptr_t * tList_1, Vec_Ptr_t * tList_2 )
 {
     char* fileName = "compTH.dimacs";
-    FILE* oFile = fopen(fileName, "w");
+    Abc_Ostr_t* oFile = Abc_OstrStart(fileName, 0);
+    if ( oFile == NULL ){
+        printf("\tERROR: cannot open output file %s\n", fileName);
+        return;
+    }
     printf("\tchecking Equalivance of cut_TList and current_TList...\n");
     printf("\tOutputFile: %s\n", fileName);
-    fprintf(oFile, "c CNF file for th<->th equiv checking\n");
+    Abc_OstrPutS(oFile, "c CNF file for th<->th equiv checking\n");
     Vec_Ptr_t* thPO_1  = thre1_CNF(oFile, tList_1);
     Vec_Ptr_t* thPO_2  = thre2_CNF(oFile, tList_2);
     comp_miter_CNF(oFile, thPO_1, thPO_2);
     
     Vec_PtrFree(thPO_1);
     Vec_PtrFree(thPO_2);
-    fclose(oFile);
+    if ( !Abc_OstrStop(oFile) )
+        printf("\tERROR: writing file %s has failed\n", fileName);
 }
 ///////////////////////////////////////////////////////////
-void comp_miter_CNF(FILE* oFile, Vec_Ptr_t* th1, Vec_Ptr_t * th2){
+void comp_miter_CNF(Abc_Ostr_t* oFile, Vec_Ptr_t* th1, Vec_Ptr_t * th2){
     // VAR naming:
     // th1_PO    : 3*id
     // th2_PO    : 3*id+1
@@ -377,29 +391,25 @@ void comp_miter_CNF(FILE* oFile, Vec_Ptr_t* th1, Vec_Ptr_t * th2){
         Vec_StrClear(sMit);
         my_Vec_StrPrintNum( sMit, i*3 + 2 );
         
-        fprintf(oFile, "-%s  %s  %s 0\n", 
-               sTh1->pArray, sTh2->pArray, sMit->pArray);
-        fprintf(oFile, " %s -%s  %s 0\n", 
-               sTh1->pArray, sTh2->pArray, sMit->pArray);
-        fprintf(oFile, " %s  %s -%s 0\n", 
-               sTh1->pArray, sTh2->pArray, sMit->pArray);
-        fprintf(oFile, "-%s -%s -%s 0\n", 
-               sTh1->pArray, sTh2->pArray, sMit->pArray);
+        Th_OstrPutName(oFile, "-", sTh1); Th_OstrPutName(oFile, "  ", sTh2); Th_OstrPutName(oFile, "  ", sMit); Abc_OstrPutS(oFile, " 0\n");
+        Th_OstrPutName(oFile, " ", sTh1); Th_OstrPutName(oFile, " -", sTh2); Th_OstrPutName(oFile, "  ", sMit); Abc_OstrPutS(oFile, " 0\n");
+        Th_OstrPutName(oFile, " ", sTh1); Th_OstrPutName(oFile, "  ", sTh2); Th_OstrPutName(oFile, " -", sMit); Abc_OstrPutS(oFile, " 0\n");
+        Th_OstrPutName(oFile, "-", sTh1); Th_OstrPutName(oFile, " -", sTh2); Th_OstrPutName(oFile, " -", sMit); Abc_OstrPutS(oFile, " 0\n");
     }
     int PO_size = Vec_PtrSize(th1);
     Vec_StrPrintStr(sOR, " 2 ");
-    fprintf(oFile, "-2 %d 0\n" , PO_size*3 +2 );
+    Abc_OstrPutS(oFile, "-2 "); Abc_OstrPutNum(oFile, PO_size*3 +2); Abc_OstrPutS(oFile, " 0\n");
     for( i = 1; i < PO_size; ++i ){
         Vec_StrPrintNum(sOR, i*3+2);
         Vec_StrAppend(sOR, " ");
-        fprintf(oFile, "-%d %d 0\n", i*3+2, PO_size*3+2);
+        Abc_OstrPutC(oFile, '-'); Abc_OstrPutNum(oFile, i*3+2); Abc_OstrPutC(oFile, ' '); Abc_OstrPutNum(oFile, PO_size*3+2); Abc_OstrPutS(oFile, " 0\n");
     }
     Vec_StrAppend(sOR, "-");
     Vec_StrPrintNum(sOR, PO_size*3 + 2);
     Vec_StrAppend(sOR, " 0\n");
     Vec_StrPush(sOR, '\0');
-    fprintf(oFile,sOR->pArray);
-    fprintf(oFile," %d 0\n", PO_size*3 +2);
+    Abc_OstrPutS(oFile, sOR->pArray);
+    Abc_OstrPutC(oFile, ' '); Abc_OstrPutNum(oFile, PO_size*3 +2); Abc_OstrPutS(oFile, " 0\n");
 
     printf("\tdone\n");
     Vec_StrFree(sTh1);
@@ -409,7 +419,7 @@ void comp_miter_CNF(FILE* oFile, Vec_Ptr_t* th1, Vec_Ptr_t * th2){
     
 }
 ///////////////////////////////////////////////////////////
-Vec_Ptr_t* thre1_CNF(FILE* oFile, Vec_Ptr_t* TList )
+Vec_Ptr_t* thre1_CNF(Abc_Ostr_t* oFile, Vec_Ptr_t* TList )
 {
     Vec_Ptr_t * thPOList = Vec_PtrAlloc(10);
     /*
@@ -447,60 +457,13 @@ Vec_Ptr_t* thre1_CNF(FILE* oFile, Vec_Ptr_t* TList )
     return thPOList;
 }
 
-void Recurrsive_TH1(FILE* oFile, Thre_S* t, Vec_Str_t* sCNF, int thre, int lvl)
+// same encoding as Recurrsive_CNF() in threCNF.c (PI/PO/TH: 3*id)
+void Recurrsive_TH1(Abc_Ostr_t* oFile, Thre_S* t, Vec_Str_t* sCNF, int thre, int lvl)
 {
-    //if (lvl >= Vec_IntSize(t->Fanins))  return;
-    assert(lvl < Vec_IntSize(t->Fanins));
-   
-    Vec_Str_t * pos_cof_CNF = Vec_StrDup( sCNF );
-    Vec_StrAppend( pos_cof_CNF, "-" );
-    // ID X 3
-    Vec_StrPrintNum( pos_cof_CNF, 3 * Vec_IntEntry(t->Fanins, lvl));
-    Vec_StrAppend( pos_cof_CNF, " ");
-
-    Vec_Str_t * neg_cof_CNF = Vec_StrDup( sCNF );
-    // ID X3
-    Vec_StrPrintNum( neg_cof_CNF, 3 * Vec_IntEntry(t->Fanins, lvl));
-    Vec_StrAppend( neg_cof_CNF, " ");
-    
-    
-    int current_w = Vec_IntEntry(t->weights, lvl);
-    int maxF  = Thre_LocalMax(t, lvl);
-    int minF  = Thre_LocalMin(t, lvl);
-    
-    int pos_cof_thre = thre - current_w;
-    if ( pos_cof_thre <= minF) {
-        // on-set
-        Vec_StrPush( pos_cof_CNF, '\0');
-        fprintf(oFile,"%s%d 0\n", pos_cof_CNF->pArray, 3*t->Id);
-    }
-    else if ( maxF < pos_cof_thre ){
-        // off-set
-        Vec_StrPush( pos_cof_CNF, '\0');
-        fprintf(oFile,"%s-%d 0\n", pos_cof_CNF->pArray, 3*t->Id);
-    }
-    else
-        Recurrsive_TH1(oFile, t, pos_cof_CNF, pos_cof_thre, lvl+1);
-    
-    int neg_cof_thre = thre;
-    if( neg_cof_thre <= minF){
-        // on-set
-        Vec_StrPush( neg_cof_CNF, '\0');
-        fprintf(oFile,"%s%d 0\n", neg_cof_CNF->pArray, 3*t->Id);
-    }
-    else if ( maxF < neg_cof_thre ){
-        // off-set
-        Vec_StrPush( neg_cof_CNF, '\0');
-        fprintf(oFile,"%s-%d 0\n", neg_cof_CNF->pArray, 3*t->Id);
-    }
-    else
-        Recurrsive_TH1(oFile, t, neg_cof_CNF, neg_cof_thre, lvl+1);
-    Vec_StrFree(pos_cof_CNF);
-    Vec_StrFree(neg_cof_CNF);
-    
+    Recurrsive_CNF(oFile, t, sCNF, thre, lvl);
 } 
 
-Vec_Ptr_t* thre2_CNF(FILE* oFile, Vec_Ptr_t* TList )
+Vec_Ptr_t* thre2_CNF(Abc_Ostr_t* oFile, Vec_Ptr_t* TList )
 {
     Vec_Ptr_t * thPOList = Vec_PtrAlloc(10);
     /*
@@ -538,61 +501,51 @@ Vec_Ptr_t* thre2_CNF(FILE* oFile, Vec_Ptr_t* TList )
     return thPOList;
 }
 
-void Recurrsive_TH2(FILE* oFile, Vec_Ptr_t* tList, Thre_S* t, Vec_Str_t* sCNF, int thre, int lvl)
+// writes the clause "<prefix> [-]y 0" for the cofactor or recurs further
+static void Recurrsive_TH2Cof(Abc_Ostr_t* oFile, Vec_Ptr_t* tList, Thre_S* t, Vec_Str_t* sCNF, int thre, int lvl, int minF, int maxF)
 {
-    //if (lvl >= Vec_IntSize(t->Fanins))  return;
-    assert(lvl < Vec_IntSize(t->Fanins));
-   
-    Vec_Str_t * pos_cof_CNF = Vec_StrDup( sCNF );
-    Vec_Str_t * neg_cof_CNF = Vec_StrDup( sCNF );
-    Vec_StrAppend( pos_cof_CNF, "-" );
-    // <others = (id * 3) +1> <PI = 3*id>
-    int finId = Vec_IntEntry(t->Fanins, lvl);
-    if ( ((Thre_S*)Vec_PtrEntry(tList,finId))->Type == 1){
-        Vec_StrPrintNum( pos_cof_CNF, 3 * finId);
-        Vec_StrPrintNum( neg_cof_CNF, 3 * finId);
-    }
-    else{
-        Vec_StrPrintNum( pos_cof_CNF, 3 * finId+1);
-        Vec_StrPrintNum( neg_cof_CNF, 3 * finId+1);
-    }
-    Vec_StrAppend( pos_cof_CNF, " ");
-    Vec_StrAppend( neg_cof_CNF, " ");
-    
-    int current_w = Vec_IntEntry(t->weights, lvl);
-    int maxF  = Thre_LocalMax(t, lvl);
-    int minF  = Thre_LocalMin(t, lvl);
-    
-    int pos_cof_thre = thre - current_w;
-    if ( pos_cof_thre <= minF) {
-        // on-set
-        Vec_StrPush( pos_cof_CNF, '\0');
-        fprintf(oFile,"%s%d 0\n", pos_cof_CNF->pArray, 3*t->Id+1);
-    }
-    else if ( maxF < pos_cof_thre ){
-        // off-set
-        Vec_StrPush( pos_cof_CNF, '\0');
-        fprintf(oFile,"%s-%d 0\n", pos_cof_CNF->pArray, 3*t->Id+1);
-    }
-    else
-        Recurrsive_TH2(oFile, tList, t, pos_cof_CNF, pos_cof_thre, lvl+1);
-    
-    int neg_cof_thre = thre;
-    if( neg_cof_thre <= minF){
+    if ( thre <= minF ) {
         // on-set
-        Vec_StrPush( neg_cof_CNF, '\0');
-        fprintf(oFile,"%s%d 0\n", neg_cof_CNF->pArray, 3*t->Id+1);
+        Abc_OstrPutBuf(oFile, Vec_StrArray(sCNF), Vec_StrSize(sCNF));
+        Abc_OstrPutNum(oFile, 3*t->Id+1);
+        Abc_OstrPutS(oFile, " 0\n");
     }
-    else if ( maxF < neg_cof_thre ){
+    else if ( maxF < thre ){
         // off-set
-        Vec_StrPush( neg_cof_CNF, '\0');
-        fprintf(oFile,"%s-%d 0\n", neg_cof_CNF->pArray, 3*t->Id+1);
+        Abc_OstrPutBuf(oFile, Vec_StrArray(sCNF), Vec_StrSize(sCNF));
+        Abc_OstrPutC(oFile, '-');
+        Abc_OstrPutNum(oFile, 3*t->Id+1);
+        Abc_OstrPutS(oFile, " 0\n");
     }
     else
-        Recurrsive_TH2(oFile, tList, t, neg_cof_CNF, neg_cof_thre, lvl+1);
-    Vec_StrFree(pos_cof_CNF);
-    Vec_StrFree(neg_cof_CNF);
-    
-} 
+        Recurrsive_TH2(oFile, tList, t, sCNF, thre, lvl+1);
+}
+void Recurrsive_TH2(Abc_Ostr_t* oFile, Vec_Ptr_t* tList, Thre_S* t, Vec_Str_t* sCNF, int thre, int lvl)
+{
+    //if (lvl >= Vec_IntSize(t->Fanins))  return;
+    assert(lvl < Vec_IntSize(t->Fanins));
+    // the clause prefix is extended in place and restored after each cofactor
+    int nPrefix   = Vec_StrSize(sCNF);
+    int current_w = Vec_IntEntry(t->weights, lvl);
+    int maxF  = Thre_LocalMax(t, lvl);
+    int minF  = Thre_LocalMin(t, lvl);
+    // <others = (id * 3) +1> <PI = 3*id>
+    int finId = Vec_IntEntry(t->Fanins, lvl);
+    int finVar = ((Thre_S*)Vec_PtrEntry(tList,finId))->Type == 1 ? 3 * finId : 3 * finId+1;
+
+    // positive cofactor
+    Vec_StrPush( sCNF, '-' );
+    Vec_StrPrintNum( sCNF, finVar );
+    Vec_StrPush( sCNF, ' ' );
+    Recurrsive_TH2Cof(oFile, tList, t, sCNF, thre - current_w, lvl, minF, maxF);
+    Vec_StrShrink( sCNF, nPrefix );
+
+    // negative cofactor
+    Vec_StrPrintNum( sCNF, finVar );
+    Vec_StrPush( sCNF, ' ' );
+    Recurrsive_TH2Cof(oFile, tList, t, sCNF, thre, lvl, minF, maxF);
+    Vec_StrShrink( sCNF, nPrefix );
+}
+ 
 
 